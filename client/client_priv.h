@@ -171,6 +171,8 @@ enum options_client {
   OPT_SSL_MODE,
   OPT_PRINT_TABLE_METADATA,
   OPT_SSL_FIPS_MODE,
+  OPT_MYSQLBINLOG_REPLAY_CONNECTIONS,
+  OPT_MYSQLBINLOG_REPLAY_PRESERVE_COMMIT_ORDER,
   /* Add new option above this */
   OPT_MAX_CLIENT_OPTION
 };
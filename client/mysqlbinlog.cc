@@ -49,6 +49,7 @@
 
 #include "caching_sha2_passwordopt-vars.h"
 #include "client/client_priv.h"
+#include "client/mysqlbinlog_replay.h"
 #include "my_dbug.h"
 #include "my_default.h"
 #include "my_dir.h"
@@ -347,6 +348,17 @@ Gtid_set *gtid_set_excluded = NULL;
 
 static bool opt_print_table_metadata;
 
+/// Delimiter of the printed statements, safe for things like CREATE PROCEDURE
+#define SAFE_DELIMITER "/*!*/;"
+
+static uint opt_replay_connections = 0;
+static bool opt_replay_preserve_commit_order = true;
+/**
+  Applies the events to a server instead of printing them, if
+  --replay-connections is given.
+*/
+static Binlog_replayer *replayer = NULL;
+
 /**
   Pointer to the Format_description_log_event of the currently active binlog.
 
@@ -886,6 +898,9 @@ static bool shall_skip_gtids(Log_event *ev) {
   @param[in|out] print_event_info Context state determining how to print.
 */
 void end_binlog(PRINT_EVENT_INFO *print_event_info) {
+  if (replayer && (in_transaction || seen_gtid))
+    replayer->discard_transaction();
+
   if (in_transaction) {
     fprintf(result_file, "ROLLBACK /* added by mysqlbinlog */ %s\n",
             print_event_info->delimiter);
@@ -910,6 +925,48 @@ void end_binlog(PRINT_EVENT_INFO *print_event_info) {
   in_transaction = false;
 }
 
+/**
+  Forget the session settings printed so far, so that the next
+  Query_log_event prints all of them. When replaying, the transactions
+  are applied on different connections, so each transaction must set up
+  its session.
+
+  @param[in,out] print_event_info Context state determining how to print.
+*/
+static void forget_printed_session(PRINT_EVENT_INFO *print_event_info) {
+  print_event_info->db[0] = '\0';
+  print_event_info->flags2_inited = false;
+  print_event_info->sql_mode_inited = false;
+  print_event_info->auto_increment_increment = 0;
+  print_event_info->auto_increment_offset = 0;
+  print_event_info->charset_inited = false;
+  print_event_info->time_zone_str[0] = '\0';
+  print_event_info->lc_time_names_number = ~0U;
+  print_event_info->charset_database_number = ILLEGAL_CHARSET_INFO_NUMBER;
+  print_event_info->default_collation_for_utf8mb4_number =
+      ILLEGAL_CHARSET_INFO_NUMBER;
+  print_event_info->thread_id_printed = false;
+}
+
+/**
+  Tell the replayer that the statement committing the current transaction
+  is printed next.
+
+  @retval true The transaction has no Gtid_log_event, so it can not be
+  replayed.
+*/
+static bool mark_replayed_commit() {
+  if (!seen_gtid) {
+    error(
+        "--replay-connections requires a Gtid_log_event or "
+        "Anonymous_gtid_log_event before each transaction, as written "
+        "by MySQL 5.7 and later.");
+    return true;
+  }
+  replayer->mark_commit();
+  return false;
+}
+
 /**
   Print the given event, and either delete it or delegate the deletion
   to someone else.
@@ -996,6 +1053,15 @@ static Exit_status process_event(PRINT_EVENT_INFO *print_event_info,
         bool ends_group = ((Query_log_event *)ev)->ends_group();
         bool starts_group = ((Query_log_event *)ev)->starts_group();
 
+        /*
+          A COMMIT or ROLLBACK, or a statement which commits implicitly,
+          ends the transaction.
+        */
+        if (replayer && (ends_group || (!in_transaction && !starts_group)) &&
+            mark_replayed_commit())
+          goto err;
+        if (replayer) replayer->set_thread_id(qle->thread_id);
+
         for (size_t i = 0; i < buff_ev->size(); i++) {
           buff_event_info pop_event_array = buff_ev->at(i);
           Log_event *temp_event = pop_event_array.event;
@@ -1308,11 +1374,33 @@ static Exit_status process_event(PRINT_EVENT_INFO *print_event_info,
                   print_event_info->delimiter);
         print_event_info->skipped_event_in_transaction = false;
 
+        if (replayer) {
+          Gtid_log_event *gtid_ev = (Gtid_log_event *)ev;
+          forget_printed_session(print_event_info);
+          if (replayer->begin_transaction(gtid_ev->last_committed,
+                                          gtid_ev->sequence_number))
+            goto err;
+        }
+
         ev->print(result_file, print_event_info);
         if (head->error == -1) goto err;
         break;
       }
+      case binary_log::XA_PREPARE_LOG_EVENT:
+        /*
+          When replaying, the prepared transaction ends here. It is
+          committed or rolled back by a transaction of its own.
+        */
+        if (replayer) {
+          if (mark_replayed_commit()) goto err;
+          in_transaction = false;
+          seen_gtid = false;
+        }
+        ev->print(result_file, print_event_info);
+        if (head->error == -1) goto err;
+        break;
       case binary_log::XID_EVENT: {
+        if (replayer && mark_replayed_commit()) goto err;
         in_transaction = false;
         print_event_info->skipped_event_in_transaction = false;
         seen_gtid = false;
@@ -1320,6 +1408,36 @@ static Exit_status process_event(PRINT_EVENT_INFO *print_event_info,
         if (head->error == -1) goto err;
         break;
       }
+      case binary_log::TRANSACTION_PAYLOAD_EVENT: {
+        /*
+          The events of the payload are processed as if they were in the
+          log themselves, at the position of the payload.
+        */
+        Transaction_payload_log_event *tpev =
+            (Transaction_payload_log_event *)ev;
+        const char *read_error = NULL;
+        Log_event *inner;
+
+        ev->print(result_file, print_event_info);
+        if (head->error == -1 ||
+            copy_event_cache_to_file_and_reinit(head, result_file,
+                                                stop_never /* flush */))
+          goto err;
+
+        if (!tpev->uncompress_events(&read_error))
+          while ((inner = tpev->next_event(glob_description_event,
+                                           &read_error)) != NULL) {
+            retval = process_event(print_event_info, inner, pos, logname);
+            if (retval != OK_CONTINUE) goto end;
+          }
+        if (read_error != NULL) {
+          error("Could not read the events of the Transaction_payload at %s: "
+                "%s.",
+                llstr(pos, ll_buff), read_error);
+          goto err;
+        }
+        goto end;
+      }
       case binary_log::PREVIOUS_GTIDS_LOG_EVENT:
         if (one_database && !opt_skip_gtids)
           warning(
@@ -1345,6 +1463,10 @@ static Exit_status process_event(PRINT_EVENT_INFO *print_event_info,
 err:
   retval = ERROR_STOP;
 end:
+  // The statement committing the transaction is in result_file now.
+  if (replayer && replayer->commit_marked() && retval != ERROR_STOP &&
+      replayer->end_transaction())
+    retval = ERROR_STOP;
   rec_count++;
   /*
     Destroy the log_event object.
@@ -1468,6 +1590,21 @@ static struct my_option my_long_options[] = {
      "Requires -R. Output raw binlog data instead of SQL "
      "statements, output is to log files.",
      &raw_mode, &raw_mode, 0, GET_BOOL, NO_ARG, 0, 0, 0, 0, 0, 0},
+    {"replay-connections", OPT_MYSQLBINLOG_REPLAY_CONNECTIONS,
+     "Instead of printing the events, apply them to the server given by "
+     "the connection options, over this many connections. Transactions "
+     "which the logical timestamps in the binary log show to be "
+     "independent are applied concurrently. Only local binary logs can "
+     "be replayed. 0, the default, prints the events.",
+     &opt_replay_connections, &opt_replay_connections, 0, GET_UINT,
+     REQUIRED_ARG, 0, 0, 256, 0, 0, 0},
+    {"replay-preserve-commit-order",
+     OPT_MYSQLBINLOG_REPLAY_PRESERVE_COMMIT_ORDER,
+     "With --replay-connections, commit the transactions in the order of "
+     "the binary log. Use --skip-replay-preserve-commit-order to let "
+     "independent transactions commit in any order.",
+     &opt_replay_preserve_commit_order, &opt_replay_preserve_commit_order, 0,
+     GET_BOOL, NO_ARG, 1, 0, 0, 0, 0, 0},
     {"result-file", 'r',
      "Direct output to a given file. With --raw this is a "
      "prefix for the file names.",
@@ -1820,26 +1957,9 @@ static int parse_args(int *argc, char ***argv) {
 }
 
 /**
-  Create and initialize the global mysql object, and connect to the
-  server.
-
-  @retval ERROR_STOP An error occurred - the program should terminate.
-  @retval OK_CONTINUE No error, the program should continue.
+  Set the options given on the command line for connecting to the server.
 */
-static Exit_status safe_connect() {
-  /*
-    A possible old connection's resources are reclaimed now
-    at new connect attempt. The final safe_connect resources
-    are mysql_closed at the end of program, explicitly.
-  */
-  mysql_close(mysql);
-  mysql = mysql_init(NULL);
-
-  if (!mysql) {
-    error("Failed on mysql_init.");
-    return ERROR_STOP;
-  }
-
+static void set_connection_options(MYSQL *mysql) {
   SSL_SET_OPTIONS(mysql);
 
   if (opt_plugin_dir && *opt_plugin_dir)
@@ -1859,10 +1979,34 @@ static Exit_status safe_connect() {
   mysql_options(mysql, MYSQL_OPT_CONNECT_ATTR_RESET, 0);
   mysql_options4(mysql, MYSQL_OPT_CONNECT_ATTR_ADD, "program_name",
                  "mysqlbinlog");
-  mysql_options4(mysql, MYSQL_OPT_CONNECT_ATTR_ADD, "_client_role",
-                 "binary_log_listener");
   set_server_public_key(mysql);
   set_get_server_public_key_option(mysql);
+}
+
+/**
+  Create and initialize the global mysql object, and connect to the
+  server.
+
+  @retval ERROR_STOP An error occurred - the program should terminate.
+  @retval OK_CONTINUE No error, the program should continue.
+*/
+static Exit_status safe_connect() {
+  /*
+    A possible old connection's resources are reclaimed now
+    at new connect attempt. The final safe_connect resources
+    are mysql_closed at the end of program, explicitly.
+  */
+  mysql_close(mysql);
+  mysql = mysql_init(NULL);
+
+  if (!mysql) {
+    error("Failed on mysql_init.");
+    return ERROR_STOP;
+  }
+
+  set_connection_options(mysql);
+  mysql_options4(mysql, MYSQL_OPT_CONNECT_ATTR_ADD, "_client_role",
+                 "binary_log_listener");
 
   if (!mysql_real_connect(mysql, host, user, pass, 0, port, sock, 0)) {
     error("Failed on connect: %s", mysql_error(mysql));
@@ -1872,6 +2016,35 @@ static Exit_status safe_connect() {
   return OK_CONTINUE;
 }
 
+/**
+  Open a connection for --replay-connections.
+
+  The connection accepts several statements in one query, as the session
+  settings printed before the first binary log are, and LOAD DATA LOCAL
+  for the Execute_load_query_log_events.
+
+  @return The connection, or NULL on error.
+*/
+static MYSQL *replay_connect() {
+  MYSQL *conn = mysql_init(NULL);
+  if (!conn) {
+    error("Failed on mysql_init.");
+    return NULL;
+  }
+
+  set_connection_options(conn);
+  uint local_infile = 1;
+  mysql_options(conn, MYSQL_OPT_LOCAL_INFILE, &local_infile);
+
+  if (!mysql_real_connect(conn, host, user, pass, 0, port, sock,
+                          CLIENT_MULTI_STATEMENTS)) {
+    error("Failed on connect: %s", mysql_error(conn));
+    mysql_close(conn);
+    return NULL;
+  }
+  return conn;
+}
+
 /**
   High-level function for dumping a named binlog.
 
@@ -1916,10 +2089,10 @@ static Exit_status dump_multiple_logs(int argc, char **argv) {
      Set safe delimiter, to dump things
      like CREATE PROCEDURE safely
   */
-  if (!raw_mode) {
+  if (!raw_mode && !replayer) {
     fprintf(result_file, "DELIMITER /*!*/;\n");
   }
-  my_stpcpy(print_event_info.delimiter, "/*!*/;");
+  my_stpcpy(print_event_info.delimiter, SAFE_DELIMITER);
 
   print_event_info.verbose = short_form ? 0 : verbose;
   print_event_info.short_form = short_form;
@@ -1968,7 +2141,7 @@ static Exit_status dump_multiple_logs(int argc, char **argv) {
 
     end_binlog(&print_event_info);
 
-    fprintf(result_file, "DELIMITER ;\n");
+    if (!replayer) fprintf(result_file, "DELIMITER ;\n");
     my_stpcpy(print_event_info.delimiter, ";");
   }
   DBUG_RETURN(rc);
@@ -2641,6 +2814,26 @@ static int args_post_process(void) {
     DBUG_RETURN(ERROR_STOP);
   }
 
+  if (opt_replay_connections) {
+    if (opt_remote_proto != BINLOG_LOCAL) {
+      error("The --replay-connections option requires local binary logs.");
+      DBUG_RETURN(ERROR_STOP);
+    }
+
+    if (output_file) {
+      error("You cannot use --replay-connections and --result-file together.");
+      DBUG_RETURN(ERROR_STOP);
+    }
+
+    if (short_form || opt_base64_output_mode == BASE64_OUTPUT_DECODE_ROWS) {
+      error(
+          "You cannot use --replay-connections with --short-form or "
+          "--base64-output=DECODE-ROWS, since the output can not be "
+          "applied.");
+      DBUG_RETURN(ERROR_STOP);
+    }
+  }
+
   if (raw_mode) {
     if (one_database)
       warning("The --database option is ignored with --raw mode");
@@ -2804,6 +2997,26 @@ int main(int argc, char **argv) {
   else
     load_processor.init_by_cur_dir();
 
+  /*
+    When replaying, the events are printed to a temporary file, out of
+    which the replayer takes them.
+  */
+  char replay_file_name[FN_REFLEN];
+  if (opt_replay_connections) {
+    File file = create_temp_file(replay_file_name, dirname_for_local_load,
+                                 "mysqlbinlog_replay", O_CREAT | O_RDWR,
+                                 MYF(MY_WME));
+    if (file < 0 || !(result_file = my_fdopen(file, replay_file_name,
+                                              O_RDWR | MY_FOPEN_BINARY,
+                                              MYF(MY_WME)))) {
+      error("Could not create a temporary file for replaying.");
+      return EXIT_FAILURE;
+    }
+    replayer = new Binlog_replayer(result_file, SAFE_DELIMITER,
+                                   opt_replay_connections,
+                                   opt_replay_preserve_commit_order);
+  }
+
   if (!raw_mode) {
     fprintf(result_file, "/*!50530 SET @@SESSION.PSEUDO_SLAVE_MODE=1*/;\n");
 
@@ -2838,7 +3051,10 @@ int main(int argc, char **argv) {
     fprintf(result_file,
             "/*!50700 SET @@SESSION.RBR_EXEC_MODE=IDEMPOTENT*/;\n\n");
 
-  retval = dump_multiple_logs(argc, argv);
+  if (replayer && replayer->start(replay_connect))
+    retval = ERROR_STOP;
+  else
+    retval = dump_multiple_logs(argc, argv);
 
   if (!raw_mode) {
     fprintf(result_file, "# End of log file\n");
@@ -2865,8 +3081,15 @@ int main(int argc, char **argv) {
   if (idempotent_mode)
     fprintf(result_file, "/*!50700 SET @@SESSION.RBR_EXEC_MODE=STRICT*/;\n");
 
+  if (replayer) {
+    if (replayer->finish(retval != ERROR_STOP)) retval = ERROR_STOP;
+    delete replayer;
+    replayer = NULL;
+  }
+
   if (tmpdir.list) free_tmpdir(&tmpdir);
   if (result_file && (result_file != stdout)) my_fclose(result_file, MYF(0));
+  if (opt_replay_connections) my_delete(replay_file_name, MYF(0));
   cleanup();
 
   my_free_open_file_info();
@@ -0,0 +1,462 @@
+/* Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "client/mysqlbinlog_replay.h"
+
+#include <string.h>
+#include <algorithm>
+
+#include "client/mysqlbinlog.h"
+#include "my_dbug.h"
+#include "mysqld_error.h"
+
+Binlog_replayer::Binlog_replayer(FILE *file, const char *delimiter,
+                                 uint num_connections,
+                                 bool preserve_commit_order)
+    : m_file(file),
+      m_delimiter(delimiter),
+      m_num_connections(num_connections),
+      m_preserve_commit_order(preserve_commit_order),
+      m_last_committed(0),
+      m_sequence_number(0),
+      m_commit_offset(-1),
+      m_thread_id(0),
+      m_has_thread_id(false),
+      m_last_sequence_number(0),
+      m_handed_over(0),
+      m_committed(0),
+      m_stop(false),
+      m_error(false) {
+  native_mutex_init(&m_lock, NULL);
+  native_cond_init(&m_cond);
+}
+
+Binlog_replayer::~Binlog_replayer() {
+  DBUG_ASSERT(m_workers.empty());
+  native_cond_destroy(&m_cond);
+  native_mutex_destroy(&m_lock);
+}
+
+extern "C" void *replay_worker(void *arg) {
+  Binlog_replayer::Worker *worker = static_cast<Binlog_replayer::Worker *>(arg);
+  if (!mysql_thread_init()) {
+    worker->replayer->run(worker);
+    mysql_thread_end();
+  }
+  return NULL;
+}
+
+bool Binlog_replayer::start(Connect_function connect) {
+  std::string text;
+  if (read_text(&text)) return true;
+
+  for (uint i = 0; i < m_num_connections; i++) {
+    m_workers.emplace_back(new Worker());
+    Worker *worker = m_workers.back().get();
+    worker->replayer = this;
+    worker->thread_started = false;
+    worker->busy = false;
+    worker->sequence_number = 0;
+    worker->order = 0;
+    worker->restart = false;
+    worker->sessions = 0;
+#ifndef DBUG_OFF
+    worker->simulate_temporary_error = false;
+#endif
+    if (!(worker->mysql = connect())) return true;
+  }
+
+  // The session settings printed before the first binary log.
+  if (apply_on_all(text)) return true;
+
+  for (auto &worker : m_workers) {
+    if (my_thread_create(&worker->thread, NULL, replay_worker,
+                         worker.get()) != 0) {
+      error("Could not create replay thread.");
+      return true;
+    }
+    worker->thread_started = true;
+  }
+  return false;
+}
+
+/**
+  Take the text printed since the last call out of the file.
+
+  @param[out] text  the text
+
+  @return true on error
+*/
+bool Binlog_replayer::read_text(std::string *text) {
+  long length = ftell(m_file);
+  if (length < 0 || fflush(m_file)) {
+    error("Could not read back the events to replay.");
+    return true;
+  }
+  text->resize(length);
+  rewind(m_file);
+  if (length > 0 && fread(&(*text)[0], 1, length, m_file) != (size_t)length) {
+    error("Could not read back the events to replay.");
+    return true;
+  }
+  /*
+    Later writes overwrite the text from the start of the file. Only what
+    was written since is read back, so there is no need to truncate.
+  */
+  rewind(m_file);
+  return false;
+}
+
+/**
+  Call a function on each statement of a text printed by mysqlbinlog.
+
+  Statements end with the delimiter. The comments that mysqlbinlog prints
+  between statements, on lines starting with '#', are skipped, as are
+  the \\C commands which change the character set of the mysql client.
+  A statement may consist of several statements separated by ';', which
+  the connections are opened to accept.
+
+  @return true if the function returned true for some statement
+*/
+template <class Function>
+static bool for_each_statement(const std::string &text,
+                               const std::string &delimiter, Function func) {
+  size_t pos = 0;
+  while (pos < text.size()) {
+    size_t end = text.find(delimiter, pos);
+    if (end == std::string::npos) end = text.size();
+    size_t next = std::min(end + delimiter.size(), text.size());
+
+    // Skip whitespace and comment lines.
+    while (pos < end) {
+      if (isspace(static_cast<uchar>(text[pos])))
+        pos++;
+      else if (text[pos] == '#') {
+        pos = text.find('\n', pos);
+        if (pos == std::string::npos || pos > end) pos = end;
+      } else
+        break;
+    }
+
+    static const char charset_command[] = "/*!\\C ";
+    if (pos < end &&
+        text.compare(pos, sizeof(charset_command) - 1, charset_command) != 0 &&
+        func(text.data() + pos, end - pos))
+      return true;
+    pos = next;
+  }
+  return false;
+}
+
+/**
+  Execute the statements of a text on the connection of a worker.
+
+  @param worker           the worker
+  @param text             the statements
+  @param temporary_error  if not NULL, a deadlock or a lock wait timeout
+                          is not stored as an error, but sets this to
+                          true, so that the transaction can be retried
+
+  @return true on error, which is then stored in m_error_message unless
+  it is a temporary one
+*/
+bool Binlog_replayer::apply(Worker *worker, const std::string &text,
+                            bool *temporary_error) {
+  MYSQL *mysql = worker->mysql;
+  return for_each_statement(
+      text, m_delimiter,
+      [this, mysql, temporary_error](const char *query, size_t length) {
+        bool failed = mysql_real_query(mysql, query, length) != 0;
+        while (!failed) {
+          MYSQL_RES *result = mysql_store_result(mysql);
+          if (result != NULL)
+            mysql_free_result(result);
+          else if (mysql_field_count(mysql) != 0)
+            failed = true;
+          if (failed) break;
+          int status = mysql_next_result(mysql);
+          if (status < 0) break;
+          failed = status > 0;
+        }
+        if (failed && temporary_error != NULL &&
+            (mysql_errno(mysql) == ER_LOCK_DEADLOCK ||
+             mysql_errno(mysql) == ER_LOCK_WAIT_TIMEOUT)) {
+          *temporary_error = true;
+        } else if (failed) {
+          native_mutex_lock(&m_lock);
+          if (!m_error) {
+            m_error = true;
+            char buf[512];
+            snprintf(buf, sizeof(buf), "Error %u replaying '%.*s': %s",
+                     mysql_errno(mysql), (int)std::min<size_t>(length, 256),
+                     query, mysql_error(mysql));
+            m_error_message = buf;
+          }
+          native_cond_broadcast(&m_cond);
+          native_mutex_unlock(&m_lock);
+        }
+        return failed;
+      });
+}
+
+/**
+  Wait until all workers are free, or there has been an error.
+  The caller must hold m_lock.
+*/
+void Binlog_replayer::wait_for_workers() {
+  for (auto &worker : m_workers)
+    while (worker->busy && !m_error) native_cond_wait(&m_cond, &m_lock);
+}
+
+/**
+  Apply a text printed outside of transactions on every connection, once
+  all transactions handed over have committed.
+
+  @return true on error
+*/
+bool Binlog_replayer::apply_on_all(const std::string &text) {
+  bool empty = !for_each_statement(
+      text, m_delimiter, [](const char *, size_t) { return true; });
+  if (empty) return false;
+
+  native_mutex_lock(&m_lock);
+  wait_for_workers();
+  bool failed = m_error;
+  native_mutex_unlock(&m_lock);
+
+  // The workers are waiting, so their connections can be used here.
+  for (auto &worker : m_workers)
+    if (!failed) failed = apply(worker.get(), text);
+  return failed;
+}
+
+bool Binlog_replayer::begin_transaction(longlong last_committed,
+                                        longlong sequence_number) {
+  std::string text;
+  if (read_text(&text) || apply_on_all(text)) return true;
+  m_last_committed = last_committed;
+  m_sequence_number = sequence_number;
+  m_commit_offset = -1;
+  m_has_thread_id = false;
+  return false;
+}
+
+void Binlog_replayer::mark_commit() {
+  m_commit_offset = ftell(m_file);
+  DBUG_ASSERT(m_commit_offset >= 0);
+}
+
+void Binlog_replayer::discard_transaction() {
+  rewind(m_file);
+  m_commit_offset = -1;
+  m_has_thread_id = false;
+}
+
+bool Binlog_replayer::end_transaction() {
+  std::string text;
+  if (read_text(&text)) return true;
+  const size_t commit_offset = std::min<size_t>(m_commit_offset, text.size());
+  m_commit_offset = -1;
+
+  /*
+    Without logical timestamps, or when they restart in a new binary log,
+    the transaction waits for all others to commit.
+  */
+  const bool wait_for_all = m_sequence_number <= 0 ||
+                            m_sequence_number <= m_last_sequence_number ||
+                            m_last_committed >= m_sequence_number;
+
+  /*
+    The transactions of a session go to the connection which applied the
+    first transaction of the session, and the first transaction of a
+    session goes to the free connection with the fewest sessions.
+  */
+  Worker *session_worker = NULL;
+  if (m_has_thread_id) {
+    auto it = m_sessions.find(m_thread_id);
+    if (it != m_sessions.end()) session_worker = it->second;
+  }
+
+  native_mutex_lock(&m_lock);
+  Worker *free_worker = NULL;
+  while (!m_error) {
+    /*
+      Transactions are handed over in the order of sequence_number, so all
+      transactions before the first one still running have committed.
+    */
+    longlong committed_up_to = m_last_sequence_number;
+    bool any_busy = false;
+    free_worker = NULL;
+    for (auto &worker : m_workers) {
+      if (worker->busy) {
+        any_busy = true;
+        committed_up_to =
+            std::min(committed_up_to, worker->sequence_number - 1);
+      } else if (free_worker == NULL ||
+                 worker->sessions < free_worker->sessions)
+        free_worker = worker.get();
+    }
+    if (session_worker != NULL)
+      free_worker = session_worker->busy ? NULL : session_worker;
+    bool ready = wait_for_all ? !any_busy : committed_up_to >= m_last_committed;
+    if (ready && free_worker != NULL) break;
+    native_cond_wait(&m_cond, &m_lock);
+  }
+
+  bool failed = m_error;
+  if (!failed) {
+    free_worker->body.assign(text, 0, commit_offset);
+    free_worker->commit.assign(text, commit_offset, std::string::npos);
+    free_worker->sequence_number = m_sequence_number;
+    free_worker->order = ++m_handed_over;
+    free_worker->restart = false;
+#ifndef DBUG_OFF
+    free_worker->simulate_temporary_error =
+        DBUG_EVALUATE_IF("replay_simulate_temporary_error", true, false);
+#endif
+    free_worker->busy = true;
+    if (m_has_thread_id && session_worker == NULL) {
+      m_sessions[m_thread_id] = free_worker;
+      free_worker->sessions++;
+    }
+    m_last_sequence_number = m_sequence_number;
+    native_cond_broadcast(&m_cond);
+  }
+  native_mutex_unlock(&m_lock);
+  return failed;
+}
+
+/**
+  Ask the transactions after the one of a worker which wait for their turn
+  to commit to roll back, as they may hold the locks it waits for.
+*/
+void Binlog_replayer::restart_later_transactions(const Worker *worker) {
+  native_mutex_lock(&m_lock);
+  for (auto &other : m_workers)
+    if (other->busy && other->order > worker->order) other->restart = true;
+  native_cond_broadcast(&m_cond);
+  native_mutex_unlock(&m_lock);
+}
+
+/**
+  Apply the transaction handed over to a worker. After a deadlock or a
+  lock wait timeout, or when asked to by an earlier transaction, the
+  transaction is rolled back and applied again, once it is next to commit
+  if the commit order is preserved.
+
+  @return true on error
+*/
+bool Binlog_replayer::apply_transaction(Worker *worker) {
+  uint retries = 0;
+  bool wait_for_turn = false;
+  for (;;) {
+    bool temporary_error = false;
+    bool restart = false;
+
+    native_mutex_lock(&m_lock);
+    if (wait_for_turn) {
+      while (m_committed + 1 != worker->order && !m_error)
+        native_cond_wait(&m_cond, &m_lock);
+      worker->restart = false;
+    }
+    bool failed = m_error;
+    native_mutex_unlock(&m_lock);
+
+    if (!failed)
+      failed = apply(worker, worker->body,
+                     retries < MAX_RETRIES ? &temporary_error : NULL);
+#ifndef DBUG_OFF
+    if (!failed && worker->simulate_temporary_error) {
+      worker->simulate_temporary_error = false;
+      failed = temporary_error = true;
+    }
+#endif
+
+    if (!failed) {
+      native_mutex_lock(&m_lock);
+      if (m_preserve_commit_order) {
+        while (m_committed + 1 != worker->order && !m_error &&
+               !worker->restart)
+          native_cond_wait(&m_cond, &m_lock);
+        restart = m_committed + 1 != worker->order && !m_error;
+        worker->restart = false;
+      }
+      failed = m_error;
+      native_mutex_unlock(&m_lock);
+
+      if (!failed && !restart)
+        failed = apply(worker, worker->commit,
+                       retries < MAX_RETRIES ? &temporary_error : NULL);
+    }
+
+    if (!temporary_error && !restart) return failed;
+
+    if (temporary_error) {
+      retries++;
+      if (m_preserve_commit_order) restart_later_transactions(worker);
+    }
+    if (apply(worker, "ROLLBACK")) return true;
+    wait_for_turn = m_preserve_commit_order;
+  }
+}
+
+/**
+  Apply the transactions handed over to a worker until stopped.
+*/
+void Binlog_replayer::run(Worker *worker) {
+  native_mutex_lock(&m_lock);
+  for (;;) {
+    while (!worker->busy && !m_stop) native_cond_wait(&m_cond, &m_lock);
+    if (!worker->busy) break;
+    native_mutex_unlock(&m_lock);
+
+    bool failed = apply_transaction(worker);
+
+    native_mutex_lock(&m_lock);
+    if (!failed) m_committed = worker->order;
+    worker->busy = false;
+    native_cond_broadcast(&m_cond);
+  }
+  native_mutex_unlock(&m_lock);
+}
+
+bool Binlog_replayer::finish(bool apply) {
+  std::string text;
+  bool failed = false;
+  if (apply && !m_workers.empty())
+    failed = read_text(&text) || apply_on_all(text);
+
+  native_mutex_lock(&m_lock);
+  wait_for_workers();
+  m_stop = true;
+  native_cond_broadcast(&m_cond);
+  native_mutex_unlock(&m_lock);
+
+  for (auto &worker : m_workers) {
+    if (worker->thread_started) my_thread_join(&worker->thread, NULL);
+    mysql_close(worker->mysql);
+  }
+  m_workers.clear();
+
+  if (m_error) error("%s", m_error_message.c_str());
+  return failed || m_error;
+}
@@ -0,0 +1,220 @@
+/* Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef MYSQLBINLOG_REPLAY_INCLUDED
+#define MYSQLBINLOG_REPLAY_INCLUDED
+
+/**
+  @file client/mysqlbinlog_replay.h
+
+  Applying the output of mysqlbinlog to a server over several connections.
+
+  mysqlbinlog prints the events to a temporary file as usual. The text of
+  each transaction, from its Gtid_log_event to its commit, is taken out of
+  the file and handed to one of the connections. A transaction is started
+  once all transactions with a sequence_number up to its last_committed
+  have committed, which is the same rule as the LOGICAL_CLOCK scheduler
+  of the slave applier uses. So transactions which committed in the same
+  group on the master are applied concurrently.
+
+  Text printed between transactions, like the Format_description_log_event
+  which the BINLOG statements of row events depend on, is applied on every
+  connection once all previous transactions have committed.
+
+  Each transaction prints all the session settings it needs. Temporary
+  tables, which statement based binary logs may use across transactions,
+  are only visible to the connection that created them, so all
+  transactions of a session on the master, as told by the thread id of
+  their Query_log_events, are applied on the same connection. A
+  connection applies several sessions when there are more sessions than
+  connections, and these then share its temporary tables.
+
+  A transaction which fails with a deadlock or a lock wait timeout is
+  rolled back and applied again, like the slave applier does. When the
+  commit order is preserved, the later transactions waiting to commit are
+  rolled back too, as they may hold the locks it waits for, and are
+  applied again one at a time.
+*/
+
+#include <stdio.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "my_inttypes.h"
+#include "my_thread.h"
+#include "mysql.h"
+#include "thr_cond.h"
+#include "thr_mutex.h"
+
+extern "C" void *replay_worker(void *arg);
+
+class Binlog_replayer {
+ public:
+  typedef MYSQL *(*Connect_function)();
+
+  /**
+    @param file                   where mysqlbinlog prints the events; it
+                                  must be open for reading and writing
+    @param delimiter              the delimiter ending each statement
+    @param num_connections        number of connections to apply on
+    @param preserve_commit_order  commit in the order of the binary log
+  */
+  Binlog_replayer(FILE *file, const char *delimiter, uint num_connections,
+                  bool preserve_commit_order);
+  ~Binlog_replayer();
+
+  /**
+    Open the connections, and apply the text printed so far on each of
+    them.
+
+    @return true on error
+  */
+  bool start(Connect_function connect);
+
+  /**
+    Start reading a transaction. The text printed so far is applied on
+    every connection.
+
+    @param last_committed   the logical timestamps of the transaction,
+    @param sequence_number  or 0 if the binary log does not have them
+
+    @return true on error
+  */
+  bool begin_transaction(longlong last_committed, longlong sequence_number);
+
+  /**
+    Set the session of the transaction being read, from the thread id of
+    its first Query_log_event.
+  */
+  void set_thread_id(uint32 thread_id) {
+    if (!m_has_thread_id) {
+      m_thread_id = thread_id;
+      m_has_thread_id = true;
+    }
+  }
+
+  /// The statement committing the transaction is printed next.
+  void mark_commit();
+
+  /// @return true if the commit of the transaction has been printed
+  bool commit_marked() const { return m_commit_offset >= 0; }
+
+  /**
+    Hand the transaction to a connection, waiting for the transactions it
+    depends on to commit, and for a connection to be free.
+
+    @return true on error
+  */
+  bool end_transaction();
+
+  /// Forget the text of a transaction which is not complete.
+  void discard_transaction();
+
+  /**
+    Apply the text printed after the last transaction, wait for all
+    transactions to commit and close the connections. Errors which
+    happened on the connections are reported.
+
+    @param apply  false to skip applying the remaining text
+
+    @return true if there was an error
+  */
+  bool finish(bool apply);
+
+ private:
+  /// Times a transaction is applied again after a temporary error
+  static const uint MAX_RETRIES = 10;
+
+  struct Worker {
+    Binlog_replayer *replayer;
+    MYSQL *mysql;
+    my_thread_handle thread;
+    bool thread_started;
+    /// True from the time a transaction is handed over until it commits
+    bool busy;
+    /// Statements of the transaction before the one that commits it
+    std::string body;
+    /// Statements of the transaction from the one that commits it
+    std::string commit;
+    longlong sequence_number;
+    /// Position of the transaction among those handed over
+    ulonglong order;
+    /**
+      Set when an earlier transaction may wait for the locks of this one,
+      which then rolls back and starts over once it is next to commit
+    */
+    bool restart;
+    /// Number of sessions of the master applied on this connection
+    uint sessions;
+#ifndef DBUG_OFF
+    bool simulate_temporary_error;
+#endif
+  };
+
+  friend void *replay_worker(void *arg);
+
+  bool read_text(std::string *text);
+  bool apply_on_all(const std::string &text);
+  bool apply(Worker *worker, const std::string &text,
+             bool *temporary_error = NULL);
+  bool apply_transaction(Worker *worker);
+  void restart_later_transactions(const Worker *worker);
+  void run(Worker *worker);
+  void wait_for_workers();
+
+  FILE *const m_file;
+  const std::string m_delimiter;
+  const uint m_num_connections;
+  const bool m_preserve_commit_order;
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  /// Worker applying the transactions of each session of the master
+  std::unordered_map<uint32, Worker *> m_sessions;
+
+  /// Logical timestamps of the transaction being read
+  longlong m_last_committed;
+  longlong m_sequence_number;
+  /// Position in m_file of the commit of the transaction, or -1
+  long m_commit_offset;
+  /// Session of the transaction being read, if m_has_thread_id
+  uint32 m_thread_id;
+  bool m_has_thread_id;
+
+  /// Protects the members below, and the busy state of the workers
+  native_mutex_t m_lock;
+  /// Signaled when a worker is handed a transaction or becomes free
+  native_cond_t m_cond;
+
+  /// sequence_number of the last transaction handed over
+  longlong m_last_sequence_number;
+  /// Number of transactions handed over
+  ulonglong m_handed_over;
+  /// Number of transactions committed, when preserving the commit order
+  ulonglong m_committed;
+  bool m_stop;
+  bool m_error;
+  std::string m_error_message;
+};
+
+#endif  // MYSQLBINLOG_REPLAY_INCLUDED
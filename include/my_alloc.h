@@ -78,6 +78,7 @@ struct MEM_ROOT {
  private:
   struct Block {
     Block *prev{nullptr}; /** Previous block; used for freeing. */
+    size_t size{0};       /** Usable size, not including this header. */
   };
 
  public:
@@ -101,8 +102,13 @@ struct MEM_ROOT {
         m_allocated_size(other.m_allocated_size),
         m_error_for_capacity_exceeded(other.m_error_for_capacity_exceeded),
         m_error_handler(other.m_error_handler),
-        m_psi_key(other.m_psi_key) {
+        m_psi_key(other.m_psi_key),
+        m_free_blocks(other.m_free_blocks),
+        m_retain_size(other.m_retain_size),
+        m_blocks_allocated(other.m_blocks_allocated),
+        m_blocks_reused(other.m_blocks_reused) {
     other.m_current_block = nullptr;
+    other.m_free_blocks = nullptr;
     other.m_allocated_size = 0;
     other.m_block_size = m_orig_block_size;
     other.m_current_free_start = &s_dummy_target;
@@ -182,6 +188,17 @@ struct MEM_ROOT {
    */
   void ClearForReuse();
 
+  /**
+   * Similar to ClearForReuse(), but anticipates that the MEM_ROOT will be
+   * used again for a workload of about the same size, e.g. the next
+   * statement of a connection. Instead of only the last block, a set of
+   * blocks whose total size follows the recent peak usage of the MEM_ROOT
+   * is kept, and reused by AllocSlow() before asking the OS for new memory.
+   * The size of the set adapts: it grows immediately to the usage at the
+   * time of the call, and shrinks by 1/8 per call when the usage is lower.
+   */
+  void ClearAndRetainBlocks();
+
   /**
     Whether the constructor has run or not.
 
@@ -228,6 +245,18 @@ struct MEM_ROOT {
    */
   size_t allocated_size() const { return m_allocated_size; }
 
+  /**
+   * Number of blocks allocated from the operating system since the last
+   * time the MEM_ROOT was cleared.
+   */
+  size_t blocks_allocated() const { return m_blocks_allocated; }
+
+  /**
+   * Number of blocks retained by ClearAndRetainBlocks() that were reused
+   * since the last time the MEM_ROOT was cleared.
+   */
+  size_t blocks_reused() const { return m_blocks_reused; }
+
   /**
    * Set the desired size of the next block to be allocated. Note that future
    * allocations
@@ -250,6 +279,12 @@ struct MEM_ROOT {
   */
   Block *AllocBlock(size_t length);
 
+  /**
+    Take a retained block of at least the given length (not including the
+    block header) from the free list. Returns nullptr if there is none.
+  */
+  Block *TakeFreeBlock(size_t length);
+
   /** Allocate memory that doesn't fit into the current free block. */
   void *AllocSlow(size_t length);
 
@@ -290,6 +325,18 @@ struct MEM_ROOT {
   void (*m_error_handler)(void) = nullptr;
 
   PSI_memory_key m_psi_key = 0;
+
+  /** Blocks kept by ClearAndRetainBlocks(), none of them in use. */
+  Block *m_free_blocks = nullptr;
+
+  /** Total size of the blocks that ClearAndRetainBlocks() may keep. */
+  size_t m_retain_size = 0;
+
+  /** Number of blocks allocated from the OS since the last clear. */
+  size_t m_blocks_allocated = 0;
+
+  /** Number of blocks taken from m_free_blocks since the last clear. */
+  size_t m_blocks_reused = 0;
 };
 
 // Legacy C thunks. Do not use in new code.
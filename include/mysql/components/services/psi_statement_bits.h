@@ -51,12 +51,19 @@ typedef unsigned int PSI_statement_key;
 */
 #define PSI_STATEMENT_VERSION_1 1
 
+/**
+  @def PSI_STATEMENT_VERSION_2
+  Performance Schema Statement Interface number for version 2.
+  This version is supported.
+*/
+#define PSI_STATEMENT_VERSION_2 2
+
 /**
   @def PSI_CURRENT_STATEMENT_VERSION
   Performance Schema Statement Interface number for the most recent version.
-  The most current version is @c PSI_STATEMENT_VERSION_1
+  The most current version is @c PSI_STATEMENT_VERSION_2
 */
-#define PSI_CURRENT_STATEMENT_VERSION 1
+#define PSI_CURRENT_STATEMENT_VERSION 2
 
 /**
   Interface for an instrumented statement.
@@ -175,6 +182,8 @@ struct PSI_statement_locker_state_v1 {
   unsigned long m_sort_rows;
   /** Metric, number of sort scans. */
   unsigned long m_sort_scan;
+  /** Metric, estimated cost of the statement. */
+  double m_query_cost;
   /** Statement digest. */
   const struct sql_digest_storage *m_digest;
   /** Current schema name. */
@@ -391,6 +400,16 @@ typedef void (*set_statement_no_index_used_t)(
 typedef void (*set_statement_no_good_index_used_t)(
     struct PSI_statement_locker *locker);
 
+/**
+  Set a statement event "query cost" metric, the cost of the query plan
+  estimated by the optimizer.
+  @param locker the statement locker
+  @param cost the estimated cost
+  @since PSI_STATEMENT_VERSION_2
+*/
+typedef void (*set_statement_query_cost_t)(struct PSI_statement_locker *locker,
+                                           double cost);
+
 /**
   End a statement event.
   @param locker the statement locker
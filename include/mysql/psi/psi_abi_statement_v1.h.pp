@@ -64,6 +64,7 @@ struct PSI_statement_locker_state_v1 {
   unsigned long m_sort_range;
   unsigned long m_sort_rows;
   unsigned long m_sort_scan;
+  double m_query_cost;
   const struct sql_digest_storage *m_digest;
   char m_schema_name[(64 * 3)];
   unsigned int m_schema_name_length;
@@ -130,6 +131,8 @@ typedef void (*set_statement_no_index_used_t)(
     struct PSI_statement_locker *locker);
 typedef void (*set_statement_no_good_index_used_t)(
     struct PSI_statement_locker *locker);
+typedef void (*set_statement_query_cost_t)(struct PSI_statement_locker *locker,
+                                           double cost);
 typedef void (*end_statement_v1_t)(struct PSI_statement_locker *locker,
                                    void *stmt_da);
 typedef PSI_prepared_stmt *(*create_prepared_stmt_v1_t)(
@@ -207,5 +210,42 @@ struct PSI_statement_service_v1 {
   end_sp_v1_t end_sp;
   drop_sp_v1_t drop_sp;
 };
-typedef struct PSI_statement_service_v1 PSI_statement_service_t;
+struct PSI_statement_service_v2 {
+  register_statement_v1_t register_statement;
+  get_thread_statement_locker_v1_t get_thread_statement_locker;
+  refine_statement_v1_t refine_statement;
+  start_statement_v1_t start_statement;
+  set_statement_text_v1_t set_statement_text;
+  set_statement_lock_time_t set_statement_lock_time;
+  set_statement_rows_sent_t set_statement_rows_sent;
+  set_statement_rows_examined_t set_statement_rows_examined;
+  inc_statement_created_tmp_disk_tables_t inc_statement_created_tmp_disk_tables;
+  inc_statement_created_tmp_tables_t inc_statement_created_tmp_tables;
+  inc_statement_select_full_join_t inc_statement_select_full_join;
+  inc_statement_select_full_range_join_t inc_statement_select_full_range_join;
+  inc_statement_select_range_t inc_statement_select_range;
+  inc_statement_select_range_check_t inc_statement_select_range_check;
+  inc_statement_select_scan_t inc_statement_select_scan;
+  inc_statement_sort_merge_passes_t inc_statement_sort_merge_passes;
+  inc_statement_sort_range_t inc_statement_sort_range;
+  inc_statement_sort_rows_t inc_statement_sort_rows;
+  inc_statement_sort_scan_t inc_statement_sort_scan;
+  set_statement_no_index_used_t set_statement_no_index_used;
+  set_statement_no_good_index_used_t set_statement_no_good_index_used;
+  set_statement_query_cost_t set_statement_query_cost;
+  end_statement_v1_t end_statement;
+  create_prepared_stmt_v1_t create_prepared_stmt;
+  destroy_prepared_stmt_v1_t destroy_prepared_stmt;
+  reprepare_prepared_stmt_v1_t reprepare_prepared_stmt;
+  execute_prepared_stmt_v1_t execute_prepared_stmt;
+  set_prepared_stmt_text_v1_t set_prepared_stmt_text;
+  digest_start_v1_t digest_start;
+  digest_end_v1_t digest_end;
+  get_sp_share_v1_t get_sp_share;
+  release_sp_share_v1_t release_sp_share;
+  start_sp_v1_t start_sp;
+  end_sp_v1_t end_sp;
+  drop_sp_v1_t drop_sp;
+};
+typedef struct PSI_statement_service_v2 PSI_statement_service_t;
 extern PSI_statement_service_t *psi_statement_service;
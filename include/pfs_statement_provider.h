@@ -105,6 +105,8 @@ void pfs_inc_statement_sort_scan_v1(PSI_statement_locker *locker, ulong count);
 void pfs_set_statement_no_index_used_v1(PSI_statement_locker *locker);
 
 void pfs_set_statement_no_good_index_used_v1(PSI_statement_locker *locker);
+void pfs_set_statement_query_cost_v1(PSI_statement_locker *locker,
+                                     double cost);
 
 void pfs_end_statement_v1(PSI_statement_locker *locker, void *stmt_da);
 
@@ -330,6 +330,14 @@ enum Log_event_type {
   */
   PARTIAL_UPDATE_ROWS_EVENT = 39,
 
+  /**
+    Compressed container for the events of a transaction, which is
+    written in place of them, after the GTID of the transaction.
+    It has no post-header, and is not listed in the
+    Format_description_event.
+  */
+  TRANSACTION_PAYLOAD_EVENT = 40,
+
   /**
     Add new events here - right above this comment!
     Existing events (except ENUM_END_EVENT) should never change their numbers
@@ -729,9 +737,11 @@ class Binary_log_event {
   /*
      The number of types we handle in Format_description_event (UNKNOWN_EVENT
      is not to be handled, it does not exist in binlogs, it does not have a
-     format).
+     format). TRANSACTION_PAYLOAD_EVENT is left out, so that the
+     Format_description_event keeps its size and the positions in the
+     binary log do not change.
   */
-  static const int LOG_EVENT_TYPES = (ENUM_END_EVENT - 1);
+  static const int LOG_EVENT_TYPES = (TRANSACTION_PAYLOAD_EVENT - 1);
 
   /**
     The lengths for the fixed data part of each event.
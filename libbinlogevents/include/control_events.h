@@ -1234,6 +1234,126 @@ class View_change_event : public Binary_log_event {
   std::map<std::string, std::string> certification_info;
 };
 
+/**
+  @class Transaction_payload_event
+
+  Holds the events of a transaction, from the BEGIN to the event that
+  commits it, compressed as a whole. It is written to the binary log
+  in place of those events, right after the Gtid_log_event of the
+  transaction. The events in the payload are stored without checksums.
+
+  @section Transaction_payload_event_binary_format Binary Format
+
+  The event has no Post-Header, so that it does not need an entry in
+  the Format_description_event.
+
+  <table>
+  <caption>Body for Transaction_payload_event</caption>
+
+  <tr>
+    <th>Name</th>
+    <th>Format</th>
+    <th>Description</th>
+  </tr>
+
+  <tr>
+    <td>compression_type</td>
+    <td>1 byte integer</td>
+    <td>The algorithm the payload is compressed with, see
+    Compression_type.</td>
+  </tr>
+
+  <tr>
+    <td>uncompressed_size</td>
+    <td>8 byte integer</td>
+    <td>The size of the events in the payload, before compression.</td>
+  </tr>
+
+  <tr>
+    <td>payload</td>
+    <td>variable length</td>
+    <td>The compressed events, extending to the end of the event.</td>
+  </tr>
+  </table>
+*/
+class Transaction_payload_event : public Binary_log_event {
+ public:
+  enum Compression_type {
+    /// The events are stored as they are
+    COMPRESSION_NONE = 0,
+    /// The events are compressed with zlib
+    COMPRESSION_ZLIB = 1
+  };
+
+  /// Larger transactions are written without compression
+  static const uint64_t MAX_UNCOMPRESSED_SIZE = 1024 * 1024 * 1024;
+
+  /// Length of the compression type and size ahead of the payload
+  static const int PAYLOAD_INFO_LEN = 1 + 8;
+
+  /**
+    Decodes the Transaction_payload_event. The payload is not copied,
+    so the buffer must outlive the event.
+
+    @param buf                Contains the serialized event.
+    @param event_len          Length of the serialized event.
+    @param description_event  An FDE event, used to get the
+                              following information
+                              -binlog_version
+                              -server_version
+                              -post_header_len
+                              -common_header_len
+                              The content of this object
+                              depends on the binlog-version currently in use.
+  */
+  Transaction_payload_event(const char *buf, unsigned int event_len,
+                            const Format_description_event *description_event);
+
+  Transaction_payload_event(const char *payload, uint64_t payload_size,
+                            uint8_t compression_type,
+                            uint64_t uncompressed_size)
+      : Binary_log_event(TRANSACTION_PAYLOAD_EVENT),
+        m_payload(payload),
+        m_payload_size(payload_size),
+        m_compression_type(compression_type),
+        m_uncompressed_size(uncompressed_size) {}
+
+  /**
+    Decompress the payload.
+
+    @param[out] dst  buffer of get_uncompressed_size() bytes
+
+    @retval false  Success.
+    @retval true   The payload is corrupt, or the compression type is
+                   unknown.
+  */
+  bool uncompress(unsigned char *dst) const;
+
+  /// @return the name of a compression type, or NULL if it is unknown
+  static const char *get_compression_type_name(uint8_t type);
+
+  const char *get_payload() const { return m_payload; }
+  uint64_t get_payload_size() const { return m_payload_size; }
+  uint8_t get_compression_type() const { return m_compression_type; }
+  uint64_t get_uncompressed_size() const { return m_uncompressed_size; }
+
+#ifndef HAVE_MYSYS
+  void print_event_info(std::ostream &info);
+  void print_long_info(std::ostream &info);
+#endif
+
+ protected:
+  // 1 byte length.
+  static const int COMPRESSION_TYPE_OFFSET = 0;
+  // 8 bytes length.
+  static const int UNCOMPRESSED_SIZE_OFFSET = 1;
+
+  const char *m_payload;
+  uint64_t m_payload_size;
+  uint8_t m_compression_type;
+  uint64_t m_uncompressed_size;
+};
+
 /**
   @class Heartbeat_event
 
@@ -832,6 +832,64 @@ Heartbeat_event::Heartbeat_event(
   if (ident_len > FN_REFLEN - 1) ident_len = FN_REFLEN - 1;
 }
 
+Transaction_payload_event::Transaction_payload_event(
+    const char *buf, unsigned int event_len,
+    const Format_description_event *description_event)
+    : Binary_log_event(&buf, description_event->binlog_version),
+      m_payload(NULL),
+      m_payload_size(0),
+      m_compression_type(COMPRESSION_NONE),
+      m_uncompressed_size(0) {
+  // buf is advanced in Binary_log_event constructor to point to
+  // beginning of the body, as the event has no post-header
+  unsigned int header_len =
+      description_event->common_header_len + PAYLOAD_INFO_LEN;
+
+  /* Avoid reading out of buffer */
+  if (event_len < header_len) return;
+
+  m_compression_type = buf[COMPRESSION_TYPE_OFFSET];
+  memcpy(&m_uncompressed_size, buf + UNCOMPRESSED_SIZE_OFFSET,
+         sizeof(m_uncompressed_size));
+  m_uncompressed_size = le64toh(m_uncompressed_size);
+
+  m_payload = buf + PAYLOAD_INFO_LEN;
+  m_payload_size = event_len - header_len;
+}
+
+bool Transaction_payload_event::uncompress(unsigned char *dst) const {
+  if (m_payload == NULL) return true;
+
+  switch (m_compression_type) {
+    case COMPRESSION_NONE:
+      if (m_payload_size != m_uncompressed_size) return true;
+      memcpy(dst, m_payload, m_payload_size);
+      return false;
+    case COMPRESSION_ZLIB: {
+      uLongf dst_len = static_cast<uLongf>(m_uncompressed_size);
+      if (::uncompress(dst, &dst_len,
+                       reinterpret_cast<const Bytef *>(m_payload),
+                       static_cast<uLong>(m_payload_size)) != Z_OK)
+        return true;
+      return dst_len != m_uncompressed_size;
+    }
+    default:
+      return true;
+  }
+}
+
+const char *Transaction_payload_event::get_compression_type_name(
+    uint8_t type) {
+  switch (type) {
+    case COMPRESSION_NONE:
+      return "NONE";
+    case COMPRESSION_ZLIB:
+      return "ZLIB";
+    default:
+      return NULL;
+  }
+}
+
 #ifndef HAVE_MYSYS
 void Rotate_event::print_event_info(std::ostream &info) {
   info << "Binlog Position: " << pos;
@@ -875,6 +933,19 @@ void Xid_event::print_long_info(std::ostream &info) {
   this->print_event_info(info);
 }
 
+void Transaction_payload_event::print_event_info(std::ostream &info) {
+  const char *name = get_compression_type_name(m_compression_type);
+  info << "Compression: " << (name ? name : "UNKNOWN");
+  info << ", Payload size: " << m_payload_size;
+  info << ", Uncompressed size: " << m_uncompressed_size;
+}
+
+void Transaction_payload_event::print_long_info(std::ostream &info) {
+  info << "Timestamp: " << header()->when.tv_sec;
+  info << "\t";
+  this->print_event_info(info);
+}
+
 #endif  // end HAVE_MYSYS
 
 }  // end namespace binary_log
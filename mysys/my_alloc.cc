@@ -34,6 +34,7 @@
 #include <stdarg.h>
 #include <string.h>
 #include <sys/types.h>
+#include <algorithm>
 
 #include "my_alloc.h"
 #include "my_compiler.h"
@@ -75,7 +76,9 @@ MEM_ROOT::Block *MEM_ROOT::AllocBlock(size_t length) {
     DBUG_RETURN(nullptr);
   }
 
+  new_block->size = length;
   m_allocated_size += length;
+  ++m_blocks_allocated;
 
   // Make the default block size 50% larger next time.
   // This ensures O(1) total mallocs (assuming Clear() is not called).
@@ -83,6 +86,25 @@ MEM_ROOT::Block *MEM_ROOT::AllocBlock(size_t length) {
   DBUG_RETURN(new_block);
 }
 
+MEM_ROOT::Block *MEM_ROOT::TakeFreeBlock(size_t length) {
+  for (Block **link = &m_free_blocks; *link != nullptr; link = &(*link)->prev) {
+    Block *block = *link;
+    if (block->size < length) continue;
+
+    // Leave it to AllocBlock() to handle the capacity being exceeded.
+    if (m_max_capacity != 0 &&
+        (m_allocated_size > m_max_capacity ||
+         block->size > m_max_capacity - m_allocated_size))
+      return nullptr;
+
+    *link = block->prev;
+    m_allocated_size += block->size;
+    ++m_blocks_reused;
+    return block;
+  }
+  return nullptr;
+}
+
 void *MEM_ROOT::AllocSlow(size_t length) {
   DBUG_ENTER("MEM_ROOT::alloc");
   DBUG_PRINT("enter", ("root: %p", this));
@@ -94,21 +116,23 @@ void *MEM_ROOT::AllocSlow(size_t length) {
   if (length >= m_block_size || MEM_ROOT_SINGLE_CHUNKS) {
     // The next block we'd allocate would _not_ be big enough
     // (or we're in Valgrind/ASAN mode, and want everything in single chunks).
-    // Allocate an entirely new block, not disturbing anything;
+    // Use an entirely new (or retained) block, not disturbing anything;
     // since the new block isn't going to be used for the next allocation
     // anyway, we can just as well keep the previous one.
-    Block *new_block = AllocBlock(length);
+    Block *new_block = TakeFreeBlock(length);
+    if (new_block == nullptr) new_block = AllocBlock(length);
     if (new_block == nullptr) DBUG_RETURN(nullptr);
 
     if (m_current_block == nullptr) {
       // This is the only block, so it has to be the current block, too.
-      // However, it will be full, so we won't be allocating from it
-      // unless ClearForReuse() is called.
+      // However, it will be (nearly) full, so we won't be allocating much
+      // from it unless ClearForReuse() is called.
       new_block->prev = nullptr;
       m_current_block = new_block;
-      m_current_free_end = pointer_cast<char *>(new_block) +
-                           ALIGN_SIZE(sizeof(*new_block)) + length;
-      m_current_free_start = m_current_free_end;
+      char *new_mem =
+          pointer_cast<char *>(new_block) + ALIGN_SIZE(sizeof(*new_block));
+      m_current_free_start = new_mem + length;
+      m_current_free_end = new_mem + new_block->size;
     } else {
       // Insert the new block in the second-to-last position.
       new_block->prev = m_current_block->prev;
@@ -118,11 +142,14 @@ void *MEM_ROOT::AllocSlow(size_t length) {
     DBUG_RETURN(pointer_cast<char *>(new_block) +
                 ALIGN_SIZE(sizeof(*new_block)));
   } else {
-    // The normal case: Throw away the current block, allocate a new block,
-    // and use that to satisfy the new allocation.
-    const size_t new_block_size = m_block_size;
-    Block *new_block = AllocBlock(new_block_size);  // Will modify block_size.
-    if (new_block == nullptr) DBUG_RETURN(nullptr);
+    // The normal case: Throw away the current block, take a retained block
+    // or allocate a new one, and use that to satisfy the new allocation.
+    Block *new_block = TakeFreeBlock(length);
+    if (new_block == nullptr) {
+      new_block = AllocBlock(m_block_size);  // Will modify block_size.
+      if (new_block == nullptr) DBUG_RETURN(nullptr);
+    }
+    const size_t new_block_size = new_block->size;
 
     new_block->prev = m_current_block;
     m_current_block = new_block;
@@ -139,8 +166,17 @@ void MEM_ROOT::Clear() {
   DBUG_ENTER("MEM_ROOT::Clear()");
   DBUG_PRINT("enter", ("root: %p", this));
 
+  Block *free_blocks = m_free_blocks;
+  m_free_blocks = nullptr;
+  m_retain_size = 0;
+  m_blocks_allocated = 0;
+  m_blocks_reused = 0;
+
   // Already cleared, or memset() to zero, so just ignore.
-  if (m_current_block == nullptr) DBUG_VOID_RETURN;
+  if (m_current_block == nullptr) {
+    FreeBlocks(free_blocks);
+    DBUG_VOID_RETURN;
+  }
 
   Block *start = m_current_block;
 
@@ -150,6 +186,7 @@ void MEM_ROOT::Clear() {
   m_current_free_end = &s_dummy_target;
   m_allocated_size = 0;
 
+  FreeBlocks(free_blocks);
   FreeBlocks(start);
   DBUG_VOID_RETURN;
 }
@@ -169,13 +206,68 @@ void MEM_ROOT::ClearForReuse() {
   m_current_free_start = pointer_cast<char *>(m_current_block) +
                          ALIGN_SIZE(sizeof(*m_current_block));
   Block *start = m_current_block->prev;
+  Block *free_blocks = m_free_blocks;
   m_current_block->prev = nullptr;
+  m_free_blocks = nullptr;
+  m_retain_size = 0;
+  m_blocks_allocated = 0;
+  m_blocks_reused = 0;
   m_allocated_size = m_current_free_end - m_current_free_start;
 
+  FreeBlocks(free_blocks);
   FreeBlocks(start);
   DBUG_VOID_RETURN;
 }
 
+void MEM_ROOT::ClearAndRetainBlocks() {
+  DBUG_ENTER("MEM_ROOT::ClearAndRetainBlocks()");
+
+  if (MEM_ROOT_SINGLE_CHUNKS) {
+    Clear();
+    DBUG_VOID_RETURN;
+  }
+
+  // Already cleared, or memset() to zero, so just ignore.
+  if (m_current_block == nullptr) DBUG_VOID_RETURN;
+
+  // Follow the peak usage up at once, and down slowly.
+  m_retain_size =
+      std::max(m_allocated_size, m_retain_size - m_retain_size / 8);
+
+  // Keep the last block as the current one, like ClearForReuse().
+  m_current_free_start = pointer_cast<char *>(m_current_block) +
+                         ALIGN_SIZE(sizeof(*m_current_block));
+  m_allocated_size = m_current_free_end - m_current_free_start;
+  m_blocks_allocated = 0;
+  m_blocks_reused = 0;
+
+  // Keep the other blocks in use and the retained ones within the budget.
+  size_t retained = m_allocated_size;
+  Block *lists[] = {m_current_block->prev, m_free_blocks};
+  Block *kept = nullptr;
+  Block *to_free = nullptr;
+  m_current_block->prev = nullptr;
+
+  for (Block *block : lists) {
+    while (block != nullptr) {
+      Block *prev = block->prev;
+      if (retained + block->size <= m_retain_size) {
+        retained += block->size;
+        block->prev = kept;
+        kept = block;
+      } else {
+        block->prev = to_free;
+        to_free = block;
+      }
+      block = prev;
+    }
+  }
+  m_free_blocks = kept;
+
+  FreeBlocks(to_free);
+  DBUG_VOID_RETURN;
+}
+
 void MEM_ROOT::FreeBlocks(Block *start) {
   // The MEM_ROOT might be allocated on itself, so make sure we don't
   // touch it after we've started freeing.
@@ -193,6 +285,9 @@ void MEM_ROOT::Claim() {
   for (Block *block = m_current_block; block != nullptr; block = block->prev) {
     my_claim(block);
   }
+  for (Block *block = m_free_blocks; block != nullptr; block = block->prev) {
+    my_claim(block);
+  }
 
   DBUG_VOID_RETURN;
 }
@@ -436,7 +436,7 @@ void Certifier::compute_group_available_gtid_intervals() {
   // The fist interval: UUID:100 -> we have the interval 1-99
   if ((iv = ivit.get()) != NULL) {
     if (iv->start > 1) {
-      Gtid_set::Interval interval = {1, iv->start - 1, NULL};
+      Gtid_set::Interval interval = {1, iv->start - 1};
       group_available_gtid_intervals.push_back(interval);
     }
   }
@@ -452,13 +452,13 @@ void Certifier::compute_group_available_gtid_intervals() {
     if (iv_next != NULL) end = iv_next->start - 1;
 
     DBUG_ASSERT(start <= end);
-    Gtid_set::Interval interval = {start, end, NULL};
+    Gtid_set::Interval interval = {start, end};
     group_available_gtid_intervals.push_back(interval);
   }
 
   // No GTIDs used, so the available interval is the complete set.
   if (group_available_gtid_intervals.size() == 0) {
-    Gtid_set::Interval interval = {1, MAX_GNO, NULL};
+    Gtid_set::Interval interval = {1, MAX_GNO};
     group_available_gtid_intervals.push_back(interval);
   }
 
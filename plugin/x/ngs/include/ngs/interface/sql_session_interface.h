@@ -51,6 +51,13 @@ class Sql_session_interface {
       bool allow_expired_passwords) = 0;
   virtual Error_code execute(const char *sql, std::size_t sql_len,
                              Resultset_interface *rset) = 0;
+  virtual Error_code prepare_prep_stmt(const char *sql, std::size_t sql_len,
+                                       uint32_t *stmt_id) = 0;
+  virtual Error_code execute_prep_stmt(uint32_t stmt_id,
+                                       const PS_PARAM *parameters,
+                                       std::size_t parameters_count,
+                                       Resultset_interface *rset) = 0;
+  virtual Error_code deallocate_prep_stmt(uint32_t stmt_id) = 0;
 
   virtual Error_code attach() = 0;
   virtual Error_code detach() = 0;
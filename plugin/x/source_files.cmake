@@ -66,6 +66,7 @@ SET(xplugin_HDRS
   "${MYSQLX_PROJECT_DIR}/src/query_string_builder.h"
   "${MYSQLX_PROJECT_DIR}/src/expr_generator.h"
   "${MYSQLX_PROJECT_DIR}/src/crud_cmd_handler.h"
+  "${MYSQLX_PROJECT_DIR}/src/crud_statement_cache.h"
   "${MYSQLX_PROJECT_DIR}/src/buffering_command_delegate.h"
   "${MYSQLX_PROJECT_DIR}/src/callback_command_delegate.h"
   "${MYSQLX_PROJECT_DIR}/src/streaming_command_delegate.h"
@@ -128,6 +129,7 @@ SET(xplugin_SRC
   "${MYSQLX_PROJECT_DIR}/src/query_string_builder.cc"
   "${MYSQLX_PROJECT_DIR}/src/expr_generator.cc"
   "${MYSQLX_PROJECT_DIR}/src/crud_cmd_handler.cc"
+  "${MYSQLX_PROJECT_DIR}/src/crud_statement_cache.cc"
   "${MYSQLX_PROJECT_DIR}/src/buffering_command_delegate.cc"
   "${MYSQLX_PROJECT_DIR}/src/callback_command_delegate.cc"
   "${MYSQLX_PROJECT_DIR}/src/streaming_command_delegate.cc"
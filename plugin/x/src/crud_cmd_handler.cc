@@ -24,6 +24,8 @@
 
 #include "plugin/x/src/crud_cmd_handler.h"
 
+#include "my_byteorder.h"
+#include "my_dbug.h"
 #include "plugin/x/ngs/include/ngs/interface/client_interface.h"
 #include "plugin/x/ngs/include/ngs/interface/document_id_generator_interface.h"
 #include "plugin/x/ngs/include/ngs/interface/server_interface.h"
@@ -32,6 +34,7 @@
 #include "plugin/x/src/expr_generator.h"
 #include "plugin/x/src/find_statement_builder.h"
 #include "plugin/x/src/insert_statement_builder.h"
+#include "plugin/x/src/mysql_variables.h"
 #include "plugin/x/src/notices.h"
 #include "plugin/x/src/sql_data_result.h"
 #include "plugin/x/src/update_statement_builder.h"
@@ -44,12 +47,10 @@
 namespace xpl {
 
 template <typename B, typename M>
-ngs::Error_code Crud_command_handler::execute(
-    Session &session, const B &builder, const M &msg,
-    ngs::Resultset_interface &resultset, Status_variable variable,
-    bool (ngs::Protocol_encoder_interface::*send_ok)()) {
-  session.update_status(variable);
+ngs::Error_code Crud_command_handler::build_query(const B &builder,
+                                                  const M &msg) {
   m_qb.clear();
+  m_prep_stmt_placeholders.clear();
   try {
     builder.build(msg);
   } catch (const Expression_generator::Error &exc) {
@@ -57,15 +58,142 @@ ngs::Error_code Crud_command_handler::execute(
   } catch (const ngs::Error_code &error) {
     return error;
   }
-  log_debug("CRUD query: %s", m_qb.get().c_str());
-  ngs::Error_code error = session.data_context().execute(
-      m_qb.get().data(), m_qb.get().length(), &resultset);
+  return ngs::Success();
+}
+
+template <typename B, typename M>
+ngs::Error_code Crud_command_handler::execute(
+    Session &session, const B &builder, const M &msg,
+    ngs::Resultset_interface &resultset, Status_variable variable,
+    bool (ngs::Protocol_encoder_interface::*send_ok)(),
+    Expression_generator *prep_stmt_gen) {
+  session.update_status(variable);
+  if (prep_stmt_gen)
+    prep_stmt_gen->set_prep_stmt_placeholder_list(&m_prep_stmt_placeholders);
+  ngs::Error_code error = build_query(builder, msg);
+  if (error) return error;
+
+  bool executed = false;
+  if (prep_stmt_gen) {
+    error = execute_prep_stmt(session, prep_stmt_gen->args(), &resultset,
+                              &executed);
+    if (!executed) {
+      // The statement can't be prepared, inline the argument values instead
+      prep_stmt_gen->set_prep_stmt_placeholder_list(nullptr);
+      error = build_query(builder, msg);
+      if (error) return error;
+    }
+  }
+
+  if (!executed) {
+    log_debug("CRUD query: %s", m_qb.get().c_str());
+    error = session.data_context().execute(m_qb.get().data(),
+                                           m_qb.get().length(), &resultset);
+  }
   if (error) return error_handling(error, msg);
   notice_handling(session, resultset.get_info(), builder, msg);
   (session.proto().*send_ok)();
   return ngs::Success();
 }
 
+namespace {
+
+/**
+  Use a cached prepared statement only when the collection is qualified
+  with a schema. Unqualified names would be resolved against the default
+  schema that was current when the statement was prepared.
+*/
+template <typename M>
+inline bool use_prep_stmt(const M &msg) {
+  return msg.collection().has_schema() && !msg.collection().schema().empty();
+}
+
+}  // namespace
+
+ngs::Error_code Crud_command_handler::execute_prep_stmt(
+    Session &session, const Expression_generator::Args &args,
+    ngs::Resultset_interface *resultset, bool *executed) {
+  ngs::Sql_session_interface &context = session.data_context();
+  const std::string query(m_qb.get().data(), m_qb.get().length());
+
+  Crud_statement_cache::Statement_id stmt_id;
+  if (!m_prep_stmt_cache.find(query, &stmt_id)) {
+    // Cached statements count against max_prepared_stmt_count, leave the
+    // upper half of it to the statements prepared by applications
+    if (!mysqld::is_prepared_stmt_count_low()) {
+      *executed = false;
+      return ngs::Success();
+    }
+    if (context.prepare_prep_stmt(query.data(), query.length(), &stmt_id))
+      stmt_id = Crud_statement_cache::k_not_prepared;
+    deallocate_prep_stmt(session, m_prep_stmt_cache.add(query, stmt_id));
+  }
+
+  *executed = stmt_id != Crud_statement_cache::k_not_prepared;
+  if (!*executed) return ngs::Success();
+
+  log_debug("CRUD prepared statement %u: %s", stmt_id, query.c_str());
+
+  // Integer values are passed in the binary protocol format
+  const std::size_t count = m_prep_stmt_placeholders.size();
+  m_prep_stmt_params.resize(count);
+  m_prep_stmt_param_buffer.resize(count * sizeof(longlong));
+  for (std::size_t i = 0; i < count; ++i) {
+    const Mysqlx::Datatypes::Scalar &arg =
+        args.Get(m_prep_stmt_placeholders[i]);
+    PS_PARAM &param = m_prep_stmt_params[i];
+    unsigned char *const int_value =
+        &m_prep_stmt_param_buffer[i * sizeof(longlong)];
+
+    param.null_bit = false;
+    param.unsigned_type = false;
+    switch (arg.type()) {
+      case Mysqlx::Datatypes::Scalar::V_SINT:
+        int8store(int_value, arg.v_signed_int());
+        param.type = MYSQL_TYPE_LONGLONG;
+        param.value = int_value;
+        param.length = sizeof(longlong);
+        break;
+
+      case Mysqlx::Datatypes::Scalar::V_UINT:
+        int8store(int_value, arg.v_unsigned_int());
+        param.type = MYSQL_TYPE_LONGLONG;
+        param.unsigned_type = true;
+        param.value = int_value;
+        param.length = sizeof(longlong);
+        break;
+
+      case Mysqlx::Datatypes::Scalar::V_STRING:
+        param.type = MYSQL_TYPE_STRING;
+        param.value = reinterpret_cast<const unsigned char *>(
+            arg.v_string().value().data());
+        param.length = arg.v_string().value().length();
+        break;
+
+      default:
+        DBUG_ASSERT(arg.type() == Mysqlx::Datatypes::Scalar::V_OCTETS);
+        param.type = MYSQL_TYPE_STRING;
+        param.value = reinterpret_cast<const unsigned char *>(
+            arg.v_octets().value().data());
+        param.length = arg.v_octets().value().length();
+    }
+  }
+
+  ngs::Error_code error = context.execute_prep_stmt(
+      stmt_id, m_prep_stmt_params.data(), count, resultset);
+  if (error) {
+    // Don't keep a statement that may have become invalid, e.g. after DDL
+    deallocate_prep_stmt(session, m_prep_stmt_cache.remove(query));
+  }
+  return error;
+}
+
+void Crud_command_handler::deallocate_prep_stmt(
+    Session &session, const Crud_statement_cache::Statement_id stmt_id) {
+  if (stmt_id != Crud_statement_cache::k_not_prepared)
+    session.data_context().deallocate_prep_stmt(stmt_id);
+}
+
 template <typename B, typename M>
 void Crud_command_handler::notice_handling(
     Session &session, const ngs::Resultset_interface::Info &info,
@@ -158,7 +286,8 @@ ngs::Error_code Crud_command_handler::execute_crud_update(
   Empty_resultset rset;
   return execute(session, Update_statement_builder(gen), msg, rset,
                  &ngs::Common_status_variables::m_crud_update,
-                 &ngs::Protocol_encoder_interface::send_exec_ok);
+                 &ngs::Protocol_encoder_interface::send_exec_ok,
+                 use_prep_stmt(msg) ? &gen : nullptr);
 }
 
 template <>
@@ -196,7 +325,8 @@ ngs::Error_code Crud_command_handler::execute_crud_delete(
   Empty_resultset rset;
   return execute(session, Delete_statement_builder(gen), msg, rset,
                  &ngs::Common_status_variables::m_crud_delete,
-                 &ngs::Protocol_encoder_interface::send_exec_ok);
+                 &ngs::Protocol_encoder_interface::send_exec_ok,
+                 use_prep_stmt(msg) ? &gen : nullptr);
 }
 
 template <>
@@ -216,7 +346,8 @@ ngs::Error_code Crud_command_handler::execute_crud_find(
   Streaming_resultset rset(&session.proto(), false);
   return execute(session, Find_statement_builder(gen), msg, rset,
                  &ngs::Common_status_variables::m_crud_find,
-                 &ngs::Protocol_encoder_interface::send_exec_ok);
+                 &ngs::Protocol_encoder_interface::send_exec_ok,
+                 use_prep_stmt(msg) ? &gen : nullptr);
 }
 
 template <>
@@ -29,6 +29,8 @@
 #include "plugin/x/ngs/include/ngs/interface/resultset_interface.h"
 #include "plugin/x/ngs/include/ngs/protocol_fwd.h"
 #include "plugin/x/ngs/include/ngs/session_status_variables.h"
+#include "plugin/x/src/crud_statement_cache.h"
+#include "plugin/x/src/expr_generator.h"
 #include "plugin/x/src/query_string_builder.h"
 #include "plugin/x/src/sql_data_context.h"
 
@@ -63,7 +65,18 @@ class Crud_command_handler {
   ngs::Error_code execute(Session &session, const B &builder, const M &msg,
                           ngs::Resultset_interface &resultset,
                           Status_variable variable,
-                          bool (ngs::Protocol_encoder_interface::*send_ok)());
+                          bool (ngs::Protocol_encoder_interface::*send_ok)(),
+                          Expression_generator *prep_stmt_gen = nullptr);
+
+  template <typename B, typename M>
+  ngs::Error_code build_query(const B &builder, const M &msg);
+
+  ngs::Error_code execute_prep_stmt(Session &session,
+                                    const Expression_generator::Args &args,
+                                    ngs::Resultset_interface *resultset,
+                                    bool *executed);
+  void deallocate_prep_stmt(Session &session,
+                            const Crud_statement_cache::Statement_id stmt_id);
 
   template <typename M>
   ngs::Error_code error_handling(const ngs::Error_code &error,
@@ -80,6 +93,10 @@ class Crud_command_handler {
                               const ngs::Resultset_interface::Info &info) const;
 
   Query_string_builder m_qb;
+  Expression_generator::Prep_stmt_placeholder_list m_prep_stmt_placeholders;
+  std::vector<PS_PARAM> m_prep_stmt_params;
+  std::vector<unsigned char> m_prep_stmt_param_buffer;
+  Crud_statement_cache m_prep_stmt_cache;
 };
 
 }  // namespace xpl
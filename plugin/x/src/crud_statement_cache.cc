@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms,
+ * as designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+#include "plugin/x/src/crud_statement_cache.h"
+
+namespace xpl {
+
+const Crud_statement_cache::Statement_id Crud_statement_cache::k_not_prepared;
+const std::size_t Crud_statement_cache::k_default_capacity;
+
+bool Crud_statement_cache::find(const std::string &query,
+                                Statement_id *stmt_id) {
+  const auto it = m_index.find(query);
+  if (it == m_index.end()) return false;
+
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  *stmt_id = it->second->second;
+  return true;
+}
+
+Crud_statement_cache::Statement_id Crud_statement_cache::add(
+    const std::string &query, const Statement_id stmt_id) {
+  Statement_id evicted = remove(query);
+  if (m_capacity == 0) return stmt_id;
+
+  if (m_entries.size() >= m_capacity) {
+    evicted = m_entries.back().second;
+    m_index.erase(m_entries.back().first);
+    m_entries.pop_back();
+  }
+
+  m_entries.emplace_front(query, stmt_id);
+  m_index[query] = m_entries.begin();
+  return evicted;
+}
+
+Crud_statement_cache::Statement_id Crud_statement_cache::remove(
+    const std::string &query) {
+  const auto it = m_index.find(query);
+  if (it == m_index.end()) return k_not_prepared;
+
+  const Statement_id stmt_id = it->second->second;
+  m_entries.erase(it->second);
+  m_index.erase(it);
+  return stmt_id;
+}
+
+}  // namespace xpl
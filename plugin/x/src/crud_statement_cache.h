@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms,
+ * as designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+#ifndef XPL_CRUD_STATEMENT_CACHE_H_
+#define XPL_CRUD_STATEMENT_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace xpl {
+
+/**
+  Per session cache of server side prepared statements created for CRUD
+  messages.
+
+  Statements are identified by the text of the generated query, in which
+  the values of the message arguments are replaced by parameter markers.
+  A cached statement id of zero records a query that could not be
+  prepared, so that the preparation is not retried for every message.
+  The least recently used statement is evicted when the cache is full.
+*/
+class Crud_statement_cache {
+ public:
+  using Statement_id = uint32_t;
+
+  static const Statement_id k_not_prepared = 0;
+  static const std::size_t k_default_capacity = 16;
+
+  explicit Crud_statement_cache(
+      const std::size_t capacity = k_default_capacity)
+      : m_capacity(capacity) {}
+
+  /**
+    Look up the statement prepared for the query and mark it as the most
+    recently used one.
+
+    @param[in]  query     text of the query
+    @param[out] stmt_id   cached statement id, k_not_prepared if the query
+                          could not be prepared
+
+    @return true if the query is in the cache
+  */
+  bool find(const std::string &query, Statement_id *stmt_id);
+
+  /**
+    Put the statement prepared for the query in the cache.
+
+    @param[in] query      text of the query
+    @param[in] stmt_id    id of the prepared statement or k_not_prepared
+
+    @return id of the statement that was evicted from the cache and must be
+            deallocated by the caller, k_not_prepared if there is none
+  */
+  Statement_id add(const std::string &query, const Statement_id stmt_id);
+
+  /**
+    Remove the query from the cache.
+
+    @return id of the removed statement, k_not_prepared if the query was
+            not cached
+  */
+  Statement_id remove(const std::string &query);
+
+  std::size_t size() const { return m_entries.size(); }
+  std::size_t capacity() const { return m_capacity; }
+
+ private:
+  using Entry = std::pair<std::string, Statement_id>;
+  using Entry_list = std::list<Entry>;
+
+  /** Most recently used entry first. */
+  Entry_list m_entries;
+  std::map<std::string, Entry_list::iterator> m_index;
+  const std::size_t m_capacity;
+};
+
+}  // namespace xpl
+
+#endif  // XPL_CRUD_STATEMENT_CACHE_H_
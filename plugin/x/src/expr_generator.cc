@@ -276,8 +276,35 @@ void Expression_generator::validate_placeholder(const Placeholder &arg) const {
     throw Error(ER_X_EXPR_BAD_VALUE, "Invalid value of placeholder");
 }
 
+namespace {
+
+bool is_bindable(const Mysqlx::Datatypes::Scalar &arg) {
+  switch (arg.type()) {
+    case Mysqlx::Datatypes::Scalar::V_SINT:
+    case Mysqlx::Datatypes::Scalar::V_UINT:
+      return true;
+
+    case Mysqlx::Datatypes::Scalar::V_STRING:
+      // A parameter takes the connection collation, not the one requested
+      return !arg.v_string().has_collation();
+
+    case Mysqlx::Datatypes::Scalar::V_OCTETS:
+      return arg.v_octets().content_type() == Expression_generator::CT_PLAIN;
+
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
 void Expression_generator::generate(const Placeholder &arg) const {
   validate_placeholder(arg);
+  if (m_generate_markers && is_bindable(m_args.Get(arg))) {
+    m_qb->put("?");
+    m_prep_stmt_placeholders->push_back(arg);
+    return;
+  }
   generate(m_args.Get(arg));
 }
 
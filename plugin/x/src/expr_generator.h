@@ -27,6 +27,7 @@
 
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "plugin/x/ngs/include/ngs_common/protocol_protobuf.h"
 #include "plugin/x/src/query_string_builder.h"
@@ -40,6 +41,8 @@ class Expression_generator {
       ::google::protobuf::RepeatedPtrField<::Mysqlx::Datatypes::Scalar>;
   using Document_path =
       ::google::protobuf::RepeatedPtrField<::Mysqlx::Expr::DocumentPathItem>;
+  using Placeholder = ::google::protobuf::uint32;
+  using Prep_stmt_placeholder_list = std::vector<Placeholder>;
 
   class Error : public std::invalid_argument {
     int m_error;
@@ -71,13 +74,32 @@ class Expression_generator {
     generate(expr);
   }
 
+  /**
+    Generate the expression like feed() does, but emit prepared statement
+    parameter markers for placeholders that hold a plain value (integer or
+    string). Position of each bound argument is appended to the list set
+    by set_prep_stmt_placeholder_list(). Without such list it behaves
+    exactly like feed().
+  */
+  template <typename T>
+  inline void feed_with_markers(const T &expr) const {
+    m_generate_markers = m_prep_stmt_placeholders != nullptr;
+    generate(expr);
+    m_generate_markers = false;
+  }
+
+  void set_prep_stmt_placeholder_list(Prep_stmt_placeholder_list *list) {
+    m_prep_stmt_placeholders = list;
+  }
+  const Prep_stmt_placeholder_list *prep_stmt_placeholder_list() const {
+    return m_prep_stmt_placeholders;
+  }
+
   Expression_generator clone(Query_string_builder *qb) const;
   Query_string_builder &query_string_builder() const { return *m_qb; }
   const Args &args() const { return m_args; }
 
  private:
-  using Placeholder = ::google::protobuf::uint32;
-
   void generate(const Mysqlx::Expr::Expr &arg) const;
   void generate(const Mysqlx::Expr::Identifier &arg,
                 const bool is_function = false) const;
@@ -128,6 +150,8 @@ class Expression_generator {
   const Args &m_args;
   const std::string &m_default_schema;
   const bool &m_is_relational;
+  Prep_stmt_placeholder_list *m_prep_stmt_placeholders{nullptr};
+  mutable bool m_generate_markers{false};
 };
 
 template <typename T>
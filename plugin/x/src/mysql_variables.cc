@@ -38,4 +38,11 @@ const CHARSET_INFO *get_charset_utf8mb4_general_ci() {
   return &my_charset_utf8mb4_general_ci;
 }
 
+bool is_prepared_stmt_count_low() {
+  mysql_mutex_lock(&LOCK_prepared_stmt_count);
+  const bool is_low = prepared_stmt_count < max_prepared_stmt_count / 2;
+  mysql_mutex_unlock(&LOCK_prepared_stmt_count);
+  return is_low;
+}
+
 }  // namespace mysqld
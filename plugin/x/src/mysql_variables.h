@@ -35,6 +35,7 @@ namespace mysqld {
 bool is_terminating();
 const char *get_my_localhost();
 const CHARSET_INFO *get_charset_utf8mb4_general_ci();
+bool is_prepared_stmt_count_low();
 
 }  // namespace mysqld
 
@@ -360,23 +360,31 @@ ngs::Error_code Sql_data_context::execute_kill_sql_session(
 
 ngs::Error_code Sql_data_context::execute_sql(const char *sql, size_t length,
                                               ngs::Command_delegate *deleg) {
-  if (!m_auth_ok && !m_query_without_authentication)
-    throw std::logic_error(
-        "Attempt to execute query in non-authenticated session");
-
   COM_DATA data;
 
   data.com_query.query = sql;
   data.com_query.length = static_cast<unsigned int>(length);
 
+  ngs::Error_code error = execute_server_command(COM_QUERY, data, deleg);
+  if (error.error == ER_X_SERVICE_ERROR)
+    log_debug("Error running command: %s (%i %s)", sql, m_last_sql_errno,
+              m_last_sql_error.c_str());
+  return error;
+}
+
+ngs::Error_code Sql_data_context::execute_server_command(
+    const enum_server_command cmd, const COM_DATA &cmd_data,
+    ngs::Command_delegate *deleg) {
+  if (!m_auth_ok && !m_query_without_authentication)
+    throw std::logic_error(
+        "Attempt to execute query in non-authenticated session");
+
   deleg->reset();
 
-  if (command_service_run_command(m_mysql_session, COM_QUERY, &data,
+  if (command_service_run_command(m_mysql_session, cmd, &cmd_data,
                                   mysqld::get_charset_utf8mb4_general_ci(),
                                   deleg->callbacks(), deleg->representation(),
                                   deleg)) {
-    log_debug("Error running command: %s (%i %s)", sql, m_last_sql_errno,
-              m_last_sql_error.c_str());
     return ngs::Error_code(ER_X_SERVICE_ERROR,
                            "Internal error executing query");
   }
@@ -387,6 +395,7 @@ ngs::Error_code Sql_data_context::execute_sql(const char *sql, size_t length,
     // we run a command to check just in case... (some commands are still
     // allowed in expired password mode)
     Callback_command_delegate d;
+    COM_DATA data;
     data.com_query.query = "select 1";
     data.com_query.length =
         static_cast<unsigned int>(strlen(data.com_query.query));
@@ -434,6 +443,50 @@ ngs::Error_code Sql_data_context::execute(const char *sql, std::size_t sql_len,
   return execute_sql(sql, sql_len, &rset->get_callbacks());
 }
 
+ngs::Error_code Sql_data_context::prepare_prep_stmt(const char *sql,
+                                                    std::size_t sql_len,
+                                                    uint32_t *stmt_id) {
+  COM_DATA data;
+  data.com_stmt_prepare.query = sql;
+  data.com_stmt_prepare.length = static_cast<unsigned int>(sql_len);
+
+  // The statement id is sent in the first column of the first row
+  Collect_resultset rset;
+  ngs::Error_code error =
+      execute_server_command(COM_STMT_PREPARE, data, &rset.get_callbacks());
+  if (error) return error;
+
+  const auto &rows = rset.get_row_list();
+  if (rows.empty() || rows.front().fields.empty() ||
+      rows.front().fields[0] == nullptr)
+    return ngs::Error_code(ER_X_SERVICE_ERROR,
+                           "Internal error preparing statement");
+
+  *stmt_id = static_cast<uint32_t>(rows.front().fields[0]->value.v_long);
+  return ngs::Success();
+}
+
+ngs::Error_code Sql_data_context::execute_prep_stmt(
+    uint32_t stmt_id, const PS_PARAM *parameters, std::size_t parameters_count,
+    ngs::Resultset_interface *rset) {
+  COM_DATA data;
+  data.com_stmt_execute.stmt_id = stmt_id;
+  data.com_stmt_execute.open_cursor = false;
+  data.com_stmt_execute.parameters = const_cast<PS_PARAM *>(parameters);
+  data.com_stmt_execute.parameter_count = parameters_count;
+  data.com_stmt_execute.has_new_types = true;
+
+  return execute_server_command(COM_STMT_EXECUTE, data, &rset->get_callbacks());
+}
+
+ngs::Error_code Sql_data_context::deallocate_prep_stmt(uint32_t stmt_id) {
+  COM_DATA data;
+  data.com_stmt_close.stmt_id = stmt_id;
+
+  Empty_resultset rset;
+  return execute_server_command(COM_STMT_CLOSE, data, &rset.get_callbacks());
+}
+
 ngs::Error_code Sql_data_context::attach() {
   THD *previous_thd = nullptr;
 
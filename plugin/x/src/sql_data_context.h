@@ -83,6 +83,13 @@ class Sql_data_context : public ngs::Sql_session_interface {
   // can only be executed once authenticated
   ngs::Error_code execute(const char *sql, std::size_t sql_len,
                           ngs::Resultset_interface *rset) override;
+  ngs::Error_code prepare_prep_stmt(const char *sql, std::size_t sql_len,
+                                    uint32_t *stmt_id) override;
+  ngs::Error_code execute_prep_stmt(uint32_t stmt_id,
+                                    const PS_PARAM *parameters,
+                                    std::size_t parameters_count,
+                                    ngs::Resultset_interface *rset) override;
+  ngs::Error_code deallocate_prep_stmt(uint32_t stmt_id) override;
 
   ngs::Error_code attach() override;
   ngs::Error_code detach() override;
@@ -112,6 +119,9 @@ class Sql_data_context : public ngs::Sql_session_interface {
 
   ngs::Error_code execute_sql(const char *sql, size_t length,
                               ngs::Command_delegate *deleg);
+  ngs::Error_code execute_server_command(const enum_server_command cmd,
+                                         const COM_DATA &data,
+                                         ngs::Command_delegate *deleg);
 
   ngs::Error_code switch_to_user(const char *username, const char *hostname,
                                  const char *address, const char *db);
@@ -40,7 +40,8 @@ void xpl::Statement_builder::add_collection(
 }
 
 void xpl::Crud_statement_builder::add_filter(const Filter &filter) const {
-  if (filter.IsInitialized()) m_builder.put(" WHERE ").put_expr(filter);
+  if (filter.IsInitialized())
+    m_builder.put(" WHERE ").put_expr_with_markers(filter);
 }
 
 void xpl::Crud_statement_builder::add_order_item(const Order_item &item) const {
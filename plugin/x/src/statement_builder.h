@@ -62,6 +62,12 @@ class Statement_builder {
       return *this;
     }
 
+    template <typename T>
+    const Generator &put_expr_with_markers(const T &expr) const {
+      m_gen.feed_with_markers(expr);
+      return *this;
+    }
+
     template <typename I, typename Op>
     const Generator &put_each(I begin, I end, Op generate) const {
       std::for_each(begin, end, generate);
@@ -0,0 +1,189 @@
+/* Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "sql/approximate_aggregates.h"
+
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "my_dbug.h"
+
+void Hyperloglog::clear() { memset(m_registers, 0, sizeof(m_registers)); }
+
+void Hyperloglog::merge(const Hyperloglog &other) {
+  for (size_t i = 0; i < NUM_REGISTERS; ++i)
+    m_registers[i] = std::max(m_registers[i], other.m_registers[i]);
+}
+
+ulonglong Hyperloglog::estimate() const {
+  const double m = static_cast<double>(NUM_REGISTERS);
+  double sum = 0.0;
+  size_t zeros = 0;
+  for (size_t i = 0; i < NUM_REGISTERS; ++i) {
+    sum += std::ldexp(1.0, -m_registers[i]);
+    if (m_registers[i] == 0) ++zeros;
+  }
+
+  const double alpha = 0.7213 / (1.0 + 1.079 / m);
+  double estimate = alpha * m * m / sum;
+
+  /*
+    Use linear counting for small cardinalities, where the raw estimate is
+    biased. With 64 bit hashes no correction is needed at the high end.
+  */
+  if (estimate <= 2.5 * m && zeros != 0)
+    estimate = m * std::log(m / static_cast<double>(zeros));
+
+  return static_cast<ulonglong>(estimate + 0.5);
+}
+
+/**
+  Scale function k(q) of the t-digest, which maps a quantile to the
+  number of centroids to its left. A centroid may span at most one unit.
+*/
+static double digest_k(double q) {
+  return Quantile_digest::COMPRESSION / (2.0 * M_PI) * std::asin(2.0 * q - 1.0);
+}
+
+/// Inverse of digest_k().
+static double digest_k_inverse(double k) {
+  const double k_max = Quantile_digest::COMPRESSION / 4.0;
+  if (k >= k_max) return 1.0;
+  return (std::sin(k * 2.0 * M_PI / Quantile_digest::COMPRESSION) + 1.0) / 2.0;
+}
+
+void Quantile_digest::clear() {
+  m_num_centroids = 0;
+  m_total_weight = 0.0;
+  m_buffered = 0;
+  m_min = std::numeric_limits<double>::infinity();
+  m_max = -std::numeric_limits<double>::infinity();
+}
+
+/**
+  Merge the buffered values into the centroids.
+*/
+void Quantile_digest::compress() {
+  if (m_buffered == 0) return;
+
+  std::sort(m_buffer, m_buffer + m_buffered,
+            [](const Centroid &a, const Centroid &b) { return a.mean < b.mean; });
+
+  Centroid centroids[MAX_CENTROIDS];
+  const size_t num_centroids = m_num_centroids;
+  std::copy(m_centroids, m_centroids + num_centroids, centroids);
+  merge_runs(centroids, num_centroids, m_buffer, m_buffered);
+  m_buffered = 0;
+}
+
+/**
+  Replace the centroids by the merge of two runs of centroids, each sorted
+  on their mean.
+*/
+void Quantile_digest::merge_runs(const Centroid *a, size_t na,
+                                 const Centroid *b, size_t nb) {
+  double total = 0.0;
+  for (size_t i = 0; i < na; ++i) total += a[i].weight;
+  for (size_t i = 0; i < nb; ++i) total += b[i].weight;
+
+  size_t n = 0;
+  double weight_so_far = 0.0;
+  double weight_limit = total * digest_k_inverse(digest_k(0.0) + 1.0);
+
+  for (size_t i = 0, j = 0; i < na || j < nb;) {
+    const Centroid &next =
+        (j == nb || (i < na && a[i].mean <= b[j].mean)) ? a[i++] : b[j++];
+
+    if (n == 0) {
+      m_centroids[n++] = next;
+      continue;
+    }
+
+    Centroid &current = m_centroids[n - 1];
+    const double proposed = current.weight + next.weight;
+    if (weight_so_far + proposed <= weight_limit || n == MAX_CENTROIDS) {
+      current.mean += (next.mean - current.mean) * next.weight / proposed;
+      current.weight = proposed;
+    } else {
+      weight_so_far += current.weight;
+      weight_limit =
+          total * digest_k_inverse(digest_k(weight_so_far / total) + 1.0);
+      m_centroids[n++] = next;
+    }
+  }
+
+  m_num_centroids = n;
+  m_total_weight = total;
+}
+
+void Quantile_digest::merge(const Quantile_digest &other) {
+  Quantile_digest copy(other);
+  copy.compress();
+  compress();
+
+  Centroid centroids[MAX_CENTROIDS];
+  const size_t num_centroids = m_num_centroids;
+  std::copy(m_centroids, m_centroids + num_centroids, centroids);
+  merge_runs(centroids, num_centroids, copy.m_centroids,
+             copy.m_num_centroids);
+
+  m_min = std::min(m_min, other.m_min);
+  m_max = std::max(m_max, other.m_max);
+}
+
+double Quantile_digest::quantile(double q) {
+  DBUG_ASSERT(!empty());
+  DBUG_ASSERT(q >= 0.0 && q <= 1.0);
+
+  compress();
+
+  if (m_num_centroids == 1) return m_centroids[0].mean;
+
+  /*
+    Each centroid is assumed to have half of its weight on each side of its
+    mean. Interpolate linearly between the means of neighbouring centroids,
+    and between the extreme centroids and the exact minimum and maximum.
+  */
+  const double target = q * m_total_weight;
+  const Centroid &first = m_centroids[0];
+  const Centroid &last = m_centroids[m_num_centroids - 1];
+
+  if (target < first.weight / 2)
+    return m_min + (first.mean - m_min) * target / (first.weight / 2);
+
+  double cumulative = first.weight / 2;
+  for (size_t i = 0; i + 1 < m_num_centroids; ++i) {
+    const double step =
+        (m_centroids[i].weight + m_centroids[i + 1].weight) / 2;
+    if (cumulative + step >= target) {
+      const double fraction = (target - cumulative) / step;
+      return m_centroids[i].mean +
+             fraction * (m_centroids[i + 1].mean - m_centroids[i].mean);
+    }
+    cumulative += step;
+  }
+
+  const double tail = std::min(target - cumulative, last.weight / 2);
+  return last.mean + (m_max - last.mean) * tail / (last.weight / 2);
+}
@@ -0,0 +1,155 @@
+#ifndef APPROXIMATE_AGGREGATES_INCLUDED
+#define APPROXIMATE_AGGREGATES_INCLUDED
+
+/* Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/**
+  @file sql/approximate_aggregates.h
+
+  Fixed size sketches used by the approximate aggregate functions
+  APPROX_COUNT_DISTINCT and APPROX_PERCENTILE. Both sketches use a bounded
+  amount of memory regardless of the number of values added, and two
+  sketches of the same kind can be merged.
+*/
+
+#include <stddef.h>
+
+#include "my_inttypes.h"
+
+/**
+  HyperLogLog estimator of the number of distinct values in a multiset.
+
+  The caller hashes each value to 64 bits, equal values must give equal
+  hashes. With 2^PRECISION registers the standard error of the estimate
+  is about 1.04 / sqrt(2^PRECISION), i.e. 1.6%.
+*/
+class Hyperloglog {
+ public:
+  static const uint PRECISION = 12;
+  static const size_t NUM_REGISTERS = size_t(1) << PRECISION;
+
+  Hyperloglog() { clear(); }
+
+  /// Forget all values added so far.
+  void clear();
+
+  /// Add a value, given its 64 bit hash.
+  void add(ulonglong hash) {
+    const size_t idx = static_cast<size_t>(hash >> (64 - PRECISION));
+    const ulonglong rest = hash << PRECISION;
+    /* Position of the first set bit among the remaining 64 - PRECISION. */
+    uchar rank = 1;
+    for (ulonglong bit = ulonglong(1) << 63;
+         rank <= 64 - PRECISION && (rest & bit) == 0; bit >>= 1)
+      ++rank;
+    if (rank > m_registers[idx]) m_registers[idx] = rank;
+  }
+
+  /// Add all the values seen by another sketch.
+  void merge(const Hyperloglog &other);
+
+  /// @return the estimated number of distinct values added.
+  ulonglong estimate() const;
+
+  /**
+    Mix the bits of a 64 bit value, so that it can be used as the hash of
+    an integer, or to finish a weaker hash.
+  */
+  static ulonglong mix(ulonglong x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+  }
+
+ private:
+  uchar m_registers[NUM_REGISTERS];
+};
+
+/**
+  Merging t-digest estimating the quantiles of a set of values.
+
+  Values are buffered, then sorted and merged into at most about
+  COMPRESSION centroids whose size is bounded by the arcsine scale
+  function. Centroids are small near the extremes of the distribution,
+  so estimates of tail quantiles are especially accurate.
+*/
+class Quantile_digest {
+ public:
+  static const size_t COMPRESSION = 100;
+
+  Quantile_digest() { clear(); }
+
+  /// Forget all values added so far.
+  void clear();
+
+  /// Add a value.
+  void add(double value) {
+    if (m_buffered == BUFFER_SIZE) compress();
+    m_buffer[m_buffered].mean = value;
+    m_buffer[m_buffered].weight = 1.0;
+    ++m_buffered;
+    if (value < m_min) m_min = value;
+    if (value > m_max) m_max = value;
+  }
+
+  /// Add all the values seen by another digest.
+  void merge(const Quantile_digest &other);
+
+  /// @return true if no value has been added.
+  bool empty() const { return m_buffered == 0 && m_num_centroids == 0; }
+
+  /**
+    Estimate a quantile of the values added. Must not be called on an
+    empty digest.
+
+    @param q  the quantile, between 0 and 1
+    @return the estimated value at quantile q
+  */
+  double quantile(double q);
+
+ private:
+  struct Centroid {
+    double mean;
+    double weight;
+  };
+
+  static const size_t MAX_CENTROIDS = COMPRESSION + 1;
+  static const size_t BUFFER_SIZE = 4 * COMPRESSION;
+
+  void compress();
+  void merge_runs(const Centroid *a, size_t na, const Centroid *b, size_t nb);
+
+  Centroid m_centroids[MAX_CENTROIDS];
+  size_t m_num_centroids;
+  /// Total weight of m_centroids.
+  double m_total_weight;
+  Centroid m_buffer[BUFFER_SIZE];
+  size_t m_buffered;
+  double m_min;
+  double m_max;
+};
+
+#endif  // APPROXIMATE_AGGREGATES_INCLUDED
@@ -117,6 +117,7 @@ bool caching_sha2_rsa_auth_status();
 
 /* sql_auth_cache */
 void rebuild_check_host(void);
+void invalidate_acl_users_by_name();
 ACL_USER *find_acl_user(const char *host, const char *user, bool exact);
 ACL_PROXY_USER *acl_find_proxy_user(const char *user, const char *host,
                                     const char *ip, char *authenticated_as,
@@ -126,6 +126,13 @@ Prealloced_array<ACL_USER, ACL_PREALLOC_SIZE> *acl_users = NULL;
 Prealloced_array<ACL_PROXY_USER, ACL_PREALLOC_SIZE> *acl_proxy_users = NULL;
 Prealloced_array<ACL_DB, ACL_PREALLOC_SIZE> *acl_dbs = NULL;
 Prealloced_array<ACL_HOST_AND_IP, ACL_PREALLOC_SIZE> *acl_wild_hosts = NULL;
+/**
+  The accounts of acl_users by user name, each list in the order of
+  acl_users. Anonymous accounts are under the empty name. Built together
+  with acl_check_hosts, and NULL while acl_users is being changed.
+*/
+static malloc_unordered_map<std::string, Acl_user_ptr_list>
+    *acl_users_by_name = nullptr;
 Db_access_map acl_db_map;
 Default_roles *g_default_roles = NULL;
 std::vector<Role_id> *g_mandatory_roles = NULL;
@@ -809,8 +816,8 @@ ACL_USER *find_acl_user(const char *host, const char *user, bool exact) {
   DBUG_ASSERT(assert_acl_cache_read_lock(current_thd));
 
   if (likely(acl_users)) {
-    for (ACL_USER *acl_user = acl_users->begin(); acl_user != acl_users->end();
-         ++acl_user) {
+    Acl_user_candidates candidates(user, false);
+    while (ACL_USER *acl_user = candidates.next()) {
       DBUG_PRINT("info",
                  ("strcmp('%s','%s'), compare_hostname('%s','%s'),", user,
                   acl_user->user ? acl_user->user : "", host,
@@ -1080,9 +1087,71 @@ static void init_check_host(void) {
     }
   }
   acl_wild_hosts->shrink_to_fit();
+
+  delete acl_users_by_name;
+  acl_users_by_name =
+      new malloc_unordered_map<std::string, Acl_user_ptr_list>(
+          key_memory_acl_mem);
+  if (acl_users_size) {
+    const Acl_user_ptr_list empty_list{
+        Malloc_allocator<ACL_USER *>(key_memory_acl_mem)};
+    for (ACL_USER *acl_user = acl_users->begin(); acl_user != acl_users->end();
+         ++acl_user)
+      acl_users_by_name
+          ->emplace(acl_user->user ? acl_user->user : "", empty_list)
+          .first->second.push_back(acl_user);
+  }
   DBUG_VOID_RETURN;
 }
 
+/**
+  Forget the index of acl_users by user name, before changing acl_users.
+  Lookups scan acl_users until rebuild_check_host() is called.
+*/
+void invalidate_acl_users_by_name() {
+  delete acl_users_by_name;
+  acl_users_by_name = nullptr;
+}
+
+Acl_user_candidates::Acl_user_candidates(const char *user,
+                                         bool with_anonymous)
+    : m_named(nullptr),
+      m_anonymous(nullptr),
+      m_named_pos(0),
+      m_anonymous_pos(0),
+      m_scan_pos(nullptr) {
+  if (acl_users_by_name == nullptr) {
+    m_scan_pos = acl_users->begin();
+    return;
+  }
+  const auto it = acl_users_by_name->find(user);
+  if (it != acl_users_by_name->end()) m_named = &it->second;
+  if (with_anonymous && user[0] != '\0') {
+    const auto anon = acl_users_by_name->find(std::string());
+    if (anon != acl_users_by_name->end()) m_anonymous = &anon->second;
+  }
+}
+
+ACL_USER *Acl_user_candidates::next() {
+  if (m_scan_pos != nullptr)
+    return m_scan_pos == acl_users->end() ? nullptr : m_scan_pos++;
+
+  // Merge the two lists, which are both in the order of acl_users.
+  ACL_USER *named = m_named != nullptr && m_named_pos < m_named->size()
+                        ? (*m_named)[m_named_pos]
+                        : nullptr;
+  ACL_USER *anonymous =
+      m_anonymous != nullptr && m_anonymous_pos < m_anonymous->size()
+          ? (*m_anonymous)[m_anonymous_pos]
+          : nullptr;
+  if (named != nullptr && (anonymous == nullptr || named < anonymous)) {
+    ++m_named_pos;
+    return named;
+  }
+  if (anonymous != nullptr) ++m_anonymous_pos;
+  return anonymous;
+}
+
 /*
   Rebuild lists used for checking of allowed hosts
 
@@ -1154,8 +1223,8 @@ bool acl_getroot(THD *thd, Security_context *sctx, char *user, char *host,
      a stored procedure; user is set to what is actually a
      priv_user, which can be ''.
   */
-  for (ACL_USER *acl_user_tmp = acl_users->begin();
-       acl_user_tmp != acl_users->end(); ++acl_user_tmp) {
+  Acl_user_candidates candidates(user, false);
+  while (ACL_USER *acl_user_tmp = candidates.next()) {
     if ((!acl_user_tmp->user && !user[0]) ||
         (acl_user_tmp->user && strcmp(user, acl_user_tmp->user) == 0)) {
       if (acl_user_tmp->host.compare_hostname(host, ip)) {
@@ -1477,6 +1546,7 @@ static bool acl_load(THD *thd, TABLE_LIST *tables) {
                        1, false))
     goto end;
   table->use_all_columns();
+  invalidate_acl_users_by_name();
   acl_users->clear();
   /*
    We need to check whether we are working with old database layout. This
@@ -1969,6 +2039,7 @@ void acl_free(bool end /*= false*/) {
   acl_proxy_users = NULL;
   delete acl_check_hosts;
   acl_check_hosts = nullptr;
+  invalidate_acl_users_by_name();
   if (!end)
     clear_and_init_db_cache();
   else {
@@ -2227,6 +2298,7 @@ bool acl_reload(THD *thd, bool locked) {
   acl_wild_hosts = NULL;
   delete acl_check_hosts;
   acl_check_hosts = NULL;
+  invalidate_acl_users_by_name();
   old_dyn_priv_map =
       swap_dynamic_privileges_map(new User_to_dynamic_privileges_map());
 
@@ -2686,8 +2758,8 @@ void acl_update_user(const char *user, const char *host, enum SSL_type ssl_type,
                      LEX_ALTER password_life, ulong what_is_set) {
   DBUG_ENTER("acl_update_user");
   DBUG_ASSERT(assert_acl_cache_write_lock(current_thd));
-  for (ACL_USER *acl_user = acl_users->begin(); acl_user != acl_users->end();
-       ++acl_user) {
+  Acl_user_candidates candidates(user, false);
+  while (ACL_USER *acl_user = candidates.next()) {
     if ((!acl_user->user && !user[0]) ||
         (acl_user->user && !strcmp(user, acl_user->user))) {
       if ((!acl_user->host.get_host() && !host[0]) ||
@@ -2864,6 +2936,7 @@ void acl_insert_user(THD *thd MY_ATTRIBUTE((unused)), const char *user,
   set_user_salt(&acl_user);
   /* New user is not a role by default. */
   acl_user.is_role = false;
+  invalidate_acl_users_by_name();
   acl_users->push_back(acl_user);
   if (acl_user.host.check_allow_all_hosts())
     allow_all_hosts = 1;  // Anyone can connect /* purecov: tested */
@@ -33,6 +33,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "lex_string.h"
 #include "lf.h"
@@ -298,6 +299,35 @@ extern std::unique_ptr<
     proc_priv_hash, func_priv_hash;
 extern collation_unordered_map<std::string, ACL_USER *> *acl_check_hosts;
 extern bool allow_all_hosts;
+
+/// Accounts of acl_users with the same user name
+typedef std::vector<ACL_USER *, Malloc_allocator<ACL_USER *>>
+    Acl_user_ptr_list;
+
+/**
+  Walks the accounts of acl_users which may match a user name, in the
+  order of acl_users: the accounts with that name and, if requested, the
+  anonymous accounts. The accounts are found through an index by user
+  name when it is up to date, and by scanning all of acl_users while it
+  is being rebuilt, so callers must still check the name of each account.
+
+  The acl cache lock must be held while walking.
+*/
+class Acl_user_candidates {
+ public:
+  Acl_user_candidates(const char *user, bool with_anonymous);
+
+  /// @return the next candidate account, or nullptr if there is none.
+  ACL_USER *next();
+
+ private:
+  const Acl_user_ptr_list *m_named;
+  const Acl_user_ptr_list *m_anonymous;
+  size_t m_named_pos;
+  size_t m_anonymous_pos;
+  /// Next account to return when scanning, if there is no index
+  ACL_USER *m_scan_pos;
+};
 extern uint grant_version; /* Version of priv tables */
 
 // Search for a matching grant. Prefer exact grants before non-exact ones.
@@ -1689,8 +1689,8 @@ static bool find_mpvio_user(THD *thd, MPVIO_EXT *mpvio) {
     Acl_cache_lock_guard acl_cache_lock(thd, Acl_cache_lock_mode::READ_MODE);
     if (!acl_cache_lock.lock(false)) DBUG_RETURN(true);
 
-    for (ACL_USER *acl_user_tmp = acl_users->begin();
-         acl_user_tmp != acl_users->end(); ++acl_user_tmp) {
+    Acl_user_candidates candidates(mpvio->auth_info.user_name, true);
+    while (ACL_USER *acl_user_tmp = candidates.next()) {
       if ((!acl_user_tmp->user ||
            !strcmp(mpvio->auth_info.user_name, acl_user_tmp->user)) &&
           acl_user_tmp->host.compare_hostname(mpvio->host, mpvio->ip)) {
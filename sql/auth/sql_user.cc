@@ -1323,6 +1323,8 @@ static int handle_grant_struct(enum enum_acl_lists struct_no, bool drop,
 
   switch (struct_no) {
     case USER_ACL:
+      /* Dropped and renamed accounts are found by scanning until rebuilt */
+      if (drop || user_to) invalidate_acl_users_by_name();
       for (uint idx = 0; idx < acl_users->size(); idx++) {
         ACL_USER *acl_user = &acl_users->at(idx);
         if (!matches(acl_user->user, acl_user->host.get_host())) continue;
@@ -429,6 +429,7 @@ class binlog_cache_data {
 
   int finalize(THD *thd, Log_event *end_event);
   int finalize(THD *thd, Log_event *end_event, XID_STATE *xs);
+  void compress(THD *thd);
   int flush(THD *thd, my_off_t *bytes, bool *wrote_xid);
   int write_event(THD *thd, Log_event *event);
   size_t get_event_counter() { return event_counter; }
@@ -436,6 +437,8 @@ class binlog_cache_data {
   virtual ~binlog_cache_data() {
     DBUG_ASSERT(is_binlog_empty());
     close_cached_file(&cache_log);
+    close_cached_file(&payload_cache);
+    close_cached_file(&compressed_cache);
   }
 
   bool is_binlog_empty() const {
@@ -583,6 +586,14 @@ class binlog_cache_data {
   */
   IO_CACHE cache_log;
 
+  /*
+    Caches the compressed events, and the Transaction_payload_log_event
+    holding them, are written to by compress(). They are opened when the
+    first transaction is compressed, and are empty between transactions.
+  */
+  IO_CACHE payload_cache;
+  IO_CACHE compressed_cache;
+
   /**
     Returns information about the cache content with respect to
     the binlog_format of the events.
@@ -1622,6 +1633,146 @@ int binlog_cache_data::finalize(THD *thd, Log_event *end_event, XID_STATE *xs) {
   return finalize(thd, end_event);
 }
 
+static voidpf binlog_compression_zalloc(voidpf, uInt items, uInt size) {
+  return my_malloc(key_memory_binlog_compression_buffer,
+                   static_cast<size_t>(items) * size, MYF(0));
+}
+
+static void binlog_compression_zfree(voidpf, voidpf address) {
+  my_free(address);
+}
+
+/**
+  Compress the content of a cache into another one with zlib.
+
+  @param from       the cache to read, from its start
+  @param to         the empty cache to write the compressed data to
+  @param level      the zlib compression level
+  @param max_size   the compressed data must be smaller than this
+
+  @retval false  Success.
+  @retval true   An error occurred, or the compressed data would not
+                 have been smaller than max_size.
+*/
+static bool deflate_cache(IO_CACHE *from, IO_CACHE *to, int level,
+                          my_off_t max_size) {
+  DBUG_ENTER("deflate_cache");
+  z_stream stream;
+  uchar out[IO_SIZE];
+  int flush = Z_NO_FLUSH;
+  int ret = Z_OK;
+
+  stream.zalloc = binlog_compression_zalloc;
+  stream.zfree = binlog_compression_zfree;
+  stream.opaque = Z_NULL;
+  if (deflateInit(&stream, level) != Z_OK) DBUG_RETURN(true);
+
+  const my_off_t size = my_b_tell(from);
+  bool error = reinit_io_cache(from, READ_CACHE, 0, 0, 0);
+  size_t length = my_b_bytes_in_cache(from);
+
+  while (!error && flush != Z_FINISH) {
+    stream.next_in = from->read_pos;
+    stream.avail_in = static_cast<uInt>(length);
+    from->read_pos = from->read_end;
+    if (my_b_tell(from) == size) flush = Z_FINISH;
+
+    do {
+      stream.next_out = out;
+      stream.avail_out = sizeof(out);
+      ret = deflate(&stream, flush);
+      error = ret == Z_STREAM_ERROR || stream.total_out >= max_size ||
+              my_b_write(to, out, sizeof(out) - stream.avail_out);
+    } while (!error && stream.avail_out == 0);
+
+    /* The whole cache is read before it ends. */
+    if (!error && flush != Z_FINISH)
+      error = (length = my_b_fill(from)) == 0;
+  }
+
+  deflateEnd(&stream);
+  DBUG_RETURN(error || ret != Z_STREAM_END);
+}
+
+/**
+  Empty a cache compress() writes to.
+*/
+static void reset_compression_cache(IO_CACHE *cache) {
+  reinit_io_cache(cache, WRITE_CACHE, 0, 0, 1);
+  if (cache->file != -1 && my_chsize(cache->file, 0, 0, MYF(MY_WME)))
+    LogErr(WARNING_LEVEL, ER_BINLOG_CANT_RESIZE_CACHE);
+  cache->disk_writes = 0;
+}
+
+/**
+  Replace the events of a finalized transaction with a single
+  Transaction_payload_log_event holding them compressed, if
+  binlog_transaction_compression is enabled.
+
+  Only transactions logged in row format and ending with an
+  Xid_log_event are compressed, so that the applier commits the
+  transaction, and stores its position, when it applies the
+  Xid_log_event of the payload.
+
+  The events are compressed into payload_cache, and the event holding
+  them is written to compressed_cache, which then takes the place of
+  cache_log. If anything fails, or if compressing does not make the
+  transaction smaller, cache_log is left as it is and the transaction
+  is written uncompressed.
+*/
+void binlog_cache_data::compress(THD *thd) {
+  DBUG_ENTER("binlog_cache_data::compress");
+  const my_off_t size = my_b_tell(&cache_log);
+
+  if (!thd->variables.binlog_trx_compression || !flags.finalized ||
+      !flags.with_xid || !flags.with_rbr || flags.with_sbr ||
+      flags.incident || flags.immediate || size == 0 ||
+      size > binary_log::Transaction_payload_event::MAX_UNCOMPRESSED_SIZE)
+    DBUG_VOID_RETURN;
+
+  if ((!my_b_inited(&payload_cache) &&
+       open_cached_file(&payload_cache, mysql_tmpdir, LOG_PREFIX,
+                        binlog_cache_size, MYF(MY_WME))) ||
+      (!my_b_inited(&compressed_cache) &&
+       open_cached_file(&compressed_cache, mysql_tmpdir, LOG_PREFIX,
+                        binlog_cache_size, MYF(MY_WME))))
+    DBUG_VOID_RETURN;
+
+  const my_off_t overhead =
+      LOG_EVENT_HEADER_LEN +
+      binary_log::Transaction_payload_event::PAYLOAD_INFO_LEN;
+  bool compressed =
+      size > overhead &&
+      !deflate_cache(
+          &cache_log, &payload_cache,
+          static_cast<int>(thd->variables.binlog_trx_compression_level),
+          size - overhead);
+
+  if (compressed) {
+    Transaction_payload_log_event ev(
+        thd, &payload_cache, my_b_tell(&payload_cache),
+        binary_log::Transaction_payload_event::COMPRESSION_ZLIB, size);
+    compressed = !ev.write(&compressed_cache);
+  }
+
+  if (compressed) {
+    /* The statistics count the use of the cache the events were in. */
+    ulong disk_writes = cache_log.disk_writes;
+    std::swap(cache_log, compressed_cache);
+    setup_io_cache(&cache_log);
+    setup_io_cache(&compressed_cache);
+    cache_log.end_of_file = saved_max_binlog_cache_size;
+    cache_log.disk_writes = disk_writes;
+    /* The transaction length in the Gtid_log_event counts checksums. */
+    event_counter = 1;
+  } else
+    truncate(size);
+
+  reset_compression_cache(&payload_cache);
+  reset_compression_cache(&compressed_cache);
+  DBUG_VOID_RETURN;
+}
+
 /**
   Flush caches to the binary log.
 
@@ -8033,6 +8184,7 @@ TC_LOG::enum_result MYSQL_BIN_LOG::commit(THD *thd, bool all) {
       Xid_log_event end_evt(thd, xid);
       if (cache_mngr->trx_cache.finalize(thd, &end_evt))
         DBUG_RETURN(RESULT_ABORTED);
+      cache_mngr->trx_cache.compress(thd);
     }
     /*
       No further action needed and no special case applies, log a final
@@ -9029,6 +9181,21 @@ int MYSQL_BIN_LOG::recover(IO_CACHE *log, Format_description_log_event *fdle,
         }
 
         if (!xids.insert(xid).second) goto err1;
+      } else if (ev->get_type_code() ==
+                 binary_log::TRANSACTION_PAYLOAD_EVENT) {
+        /* A payload holds a whole transaction, ending with its XID. */
+        Transaction_payload_log_event *tpev =
+            static_cast<Transaction_payload_log_event *>(ev);
+        const char *error = NULL;
+        Log_event *inner;
+        bool failed = tpev->uncompress_events(&error);
+        while (!failed && (inner = tpev->next_event(fdle, &error)) != NULL) {
+          if (inner->get_type_code() == binary_log::XID_EVENT)
+            failed =
+                !xids.insert(static_cast<Xid_log_event *>(inner)->xid).second;
+          delete inner;
+        }
+        if (failed || error != NULL) goto err1;
       }
 
       /*
@@ -127,10 +127,17 @@ int Clone_handler::validate_dir(const char *in_dir, char *out_dir) {
   /* Convert the path to native os format. */
   convert_dirname(out_dir, in_dir, nullptr);
 
-  /* Check if the data directory exists already. */
+  /* Check if the data directory exists already. A data directory left
+  by a clone can be cloned into again, copying only what has changed. */
   if (mysql_file_stat(key_file_misc, out_dir, &stat_info, MYF(0)) != nullptr) {
-    my_error(ER_DB_CREATE_EXISTS, MYF(0), in_dir);
-    return ER_DB_CREATE_EXISTS;
+    std::string base_file(out_dir);
+    base_file.append(CLONE_BASE_LSN_FILE);
+
+    if (mysql_file_stat(key_file_misc, base_file.c_str(), &stat_info,
+                        MYF(0)) == nullptr) {
+      my_error(ER_DB_CREATE_EXISTS, MYF(0), in_dir);
+      return ER_DB_CREATE_EXISTS;
+    }
   }
 
   /* Check if path is within current data directory */
@@ -36,6 +36,10 @@ Clone handler interface to access clone plugin
 class THD;
 struct Mysql_clone;
 
+/** File a clone leaves in the cloned data directory. An existing data
+directory can be cloned into again only if it has the file. */
+const char CLONE_BASE_LSN_FILE[] = "#clone_base_lsn";
+
 /**
   Clone plugin handler to convenient way to. Takes
 */
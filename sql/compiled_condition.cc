@@ -0,0 +1,640 @@
+/* Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "sql/compiled_condition.h"
+
+#include <algorithm>
+
+#include "binary_log_types.h"
+#include "my_alloc.h"
+#include "my_byteorder.h"
+#include "my_config.h"
+#include "my_dbug.h"
+#include "sql/field.h"
+#include "sql/item.h"
+#include "sql/item_cmpfunc.h"
+#include "sql/item_func.h"
+#include "sql/sql_class.h"
+#include "sql/sql_list.h"
+#include "sql/table.h"
+#include "template_utils.h"
+
+typedef Compiled_condition::Step Step;
+typedef Compiled_condition::Value Value;
+
+static const int OUTCOME_FALSE = Compiled_condition::OUTCOME_FALSE;
+static const int OUTCOME_TRUE = Compiled_condition::OUTCOME_TRUE;
+static const int OUTCOME_UNKNOWN = Compiled_condition::OUTCOME_UNKNOWN;
+
+namespace {
+
+/// Operators of the specialized steps.
+enum Compiled_op {
+  OP_EQ,
+  OP_NE,
+  OP_LT,
+  OP_LE,
+  OP_GT,
+  OP_GE,
+  OP_BETWEEN,
+  OP_NOT_BETWEEN,
+  OP_IN,
+  OP_NOT_IN
+};
+
+/**
+  Type in which a column is compared. All integer columns but BIGINT
+  UNSIGNED fit in a longlong.
+*/
+enum Domain { DOMAIN_NONE, DOMAIN_SIGNED, DOMAIN_UNSIGNED, DOMAIN_REAL };
+
+template <typename T>
+T value_of(const Value &value);
+template <>
+longlong value_of<longlong>(const Value &value) {
+  return value.i;
+}
+template <>
+ulonglong value_of<ulonglong>(const Value &value) {
+  return value.u;
+}
+template <>
+double value_of<double>(const Value &value) {
+  return value.d;
+}
+
+/*
+  Readers of the record formats of the numeric columns, see
+  Field_tiny::val_int() and friends.
+*/
+longlong load_tiny(const uchar *p) { return static_cast<signed char>(p[0]); }
+longlong load_utiny(const uchar *p) { return p[0]; }
+longlong load_short(const uchar *p) { return sint2korr(p); }
+longlong load_ushort(const uchar *p) { return uint2korr(p); }
+longlong load_medium(const uchar *p) { return sint3korr(p); }
+longlong load_umedium(const uchar *p) { return uint3korr(p); }
+longlong load_long(const uchar *p) { return sint4korr(p); }
+longlong load_ulong(const uchar *p) { return uint4korr(p); }
+longlong load_longlong(const uchar *p) { return sint8korr(p); }
+ulonglong load_ulonglong(const uchar *p) { return uint8korr(p); }
+double load_float(const uchar *p) {
+  float f;
+  float4get(&f, p);
+  return f;
+}
+double load_double(const uchar *p) {
+  double d;
+  float8get(&d, p);
+  return d;
+}
+
+template <typename T>
+bool in_list(const Step &step, T v) {
+  const Value *end = step.list + step.list_size;
+  const Value *pos =
+      std::lower_bound(step.list, end, v, [](const Value &a, T b) {
+        return value_of<T>(a) < b;
+      });
+  return pos != end && value_of<T>(*pos) == v;
+}
+
+/**
+  Compare a column value to constants. The switch is resolved at compile
+  time, so each instantiation only compares.
+*/
+template <typename T, Compiled_op op>
+bool compare_field(const Step &step, const T v) {
+  const T low = value_of<T>(step.low);
+  switch (op) {
+    case OP_EQ:
+      return v == low;
+    case OP_NE:
+      return v != low;
+    case OP_LT:
+      return v < low;
+    case OP_LE:
+      return v <= low;
+    case OP_GT:
+      return v > low;
+    case OP_GE:
+      return v >= low;
+    case OP_BETWEEN:
+      return low <= v && v <= value_of<T>(step.high);
+    case OP_NOT_BETWEEN:
+      return v < low || v > value_of<T>(step.high);
+    case OP_IN:
+      return in_list<T>(step, v);
+    case OP_NOT_IN:
+      return !in_list<T>(step, v);
+  }
+  return false;
+}
+
+template <typename T, T (*load)(const uchar *), Compiled_op op>
+int test_field(const Step &step, ulonglong) {
+  if (step.field->is_null()) return OUTCOME_UNKNOWN;
+  return compare_field<T, op>(step, load(step.field->ptr)) ? OUTCOME_TRUE
+                                                           : OUTCOME_FALSE;
+}
+
+/// Evaluate a predicate which could not be specialized.
+int test_item(const Step &step, ulonglong) {
+  if (step.item->val_bool()) return OUTCOME_TRUE;
+  return step.item->null_value ? OUTCOME_UNKNOWN : OUTCOME_FALSE;
+}
+
+/// Final step of an AND which had an operand UNKNOWN, or all TRUE.
+int test_and_unknown(const Step &step, ulonglong unknown) {
+  return (unknown & step.flag) ? OUTCOME_UNKNOWN : OUTCOME_TRUE;
+}
+
+/// Final step of an OR which had an operand UNKNOWN, or all FALSE.
+int test_or_unknown(const Step &step, ulonglong unknown) {
+  return (unknown & step.flag) ? OUTCOME_UNKNOWN : OUTCOME_FALSE;
+}
+
+template <typename T, T (*load)(const uchar *)>
+Step::Test select_test(Compiled_op op) {
+  switch (op) {
+    case OP_EQ:
+      return test_field<T, load, OP_EQ>;
+    case OP_NE:
+      return test_field<T, load, OP_NE>;
+    case OP_LT:
+      return test_field<T, load, OP_LT>;
+    case OP_LE:
+      return test_field<T, load, OP_LE>;
+    case OP_GT:
+      return test_field<T, load, OP_GT>;
+    case OP_GE:
+      return test_field<T, load, OP_GE>;
+    case OP_BETWEEN:
+      return test_field<T, load, OP_BETWEEN>;
+    case OP_NOT_BETWEEN:
+      return test_field<T, load, OP_NOT_BETWEEN>;
+    case OP_IN:
+      return test_field<T, load, OP_IN>;
+    case OP_NOT_IN:
+      return test_field<T, load, OP_NOT_IN>;
+  }
+  DBUG_ASSERT(false);
+  return nullptr;
+}
+
+Step::Test select_test(const Field *field, Compiled_op op) {
+  const bool is_unsigned = down_cast<const Field_num *>(field)->unsigned_flag;
+  switch (field->type()) {
+    case MYSQL_TYPE_TINY:
+      return is_unsigned ? select_test<longlong, load_utiny>(op)
+                         : select_test<longlong, load_tiny>(op);
+    case MYSQL_TYPE_SHORT:
+      return is_unsigned ? select_test<longlong, load_ushort>(op)
+                         : select_test<longlong, load_short>(op);
+    case MYSQL_TYPE_INT24:
+      return is_unsigned ? select_test<longlong, load_umedium>(op)
+                         : select_test<longlong, load_medium>(op);
+    case MYSQL_TYPE_LONG:
+      return is_unsigned ? select_test<longlong, load_ulong>(op)
+                         : select_test<longlong, load_long>(op);
+    case MYSQL_TYPE_LONGLONG:
+      return is_unsigned ? select_test<ulonglong, load_ulonglong>(op)
+                         : select_test<longlong, load_longlong>(op);
+    case MYSQL_TYPE_FLOAT:
+      return select_test<double, load_float>(op);
+    case MYSQL_TYPE_DOUBLE:
+      return select_test<double, load_double>(op);
+    default:
+      DBUG_ASSERT(false);
+      return nullptr;
+  }
+}
+
+/**
+  @return the column of an operand which is a plain column reference
+          of a supported type, or nullptr
+*/
+const Field *compilable_field(Item *item, Domain *domain) {
+  if (item->type() != Item::FIELD_ITEM) return nullptr;
+  const Field *field = down_cast<Item_field *>(item)->field;
+#ifdef WORDS_BIGENDIAN
+  if (!field->table->s->db_low_byte_first) return nullptr;
+#endif
+  switch (field->type()) {
+    case MYSQL_TYPE_TINY:
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+      *domain = DOMAIN_SIGNED;
+      return field;
+    case MYSQL_TYPE_LONGLONG:
+      *domain = down_cast<const Field_num *>(field)->unsigned_flag
+                    ? DOMAIN_UNSIGNED
+                    : DOMAIN_SIGNED;
+      return field;
+    case MYSQL_TYPE_FLOAT:
+    case MYSQL_TYPE_DOUBLE:
+      *domain = DOMAIN_REAL;
+      return field;
+    default:
+      return nullptr;
+  }
+}
+
+/**
+  Evaluate a literal operand in the domain of the column.
+
+  @return false if the operand is not a literal, is NULL, or its value
+          can not be represented in the domain
+*/
+bool constant_value(Item *item, Domain domain, Value *value) {
+  if (!item->basic_const_item()) return false;
+  const Item_result type = item->result_type();
+  if (domain == DOMAIN_REAL) {
+    if (type != INT_RESULT && type != REAL_RESULT) return false;
+    value->d = item->val_real();
+    return !item->null_value;
+  }
+  if (type != INT_RESULT) return false;
+  const longlong v = item->val_int();
+  if (item->null_value) return false;
+  if (v < 0 && item->unsigned_flag != (domain == DOMAIN_UNSIGNED))
+    return false;
+  if (domain == DOMAIN_UNSIGNED)
+    value->u = static_cast<ulonglong>(v);
+  else
+    value->i = v;
+  return true;
+}
+
+/**
+  @return true if the comparator compares its arguments as numbers of the
+          domain, with no conversion the compiled step would miss
+*/
+bool comparator_matches(const Arg_comparator *cmp, Domain domain) {
+  const arg_cmp_func func = cmp->get_compare_func();
+  if (domain == DOMAIN_REAL) return func == &Arg_comparator::compare_real;
+  return func == &Arg_comparator::compare_int_signed ||
+         func == &Arg_comparator::compare_int_unsigned ||
+         func == &Arg_comparator::compare_int_signed_unsigned ||
+         func == &Arg_comparator::compare_int_unsigned_signed;
+}
+
+template <typename T>
+void sort_list(Value *list, size_t size) {
+  std::sort(list, list + size, [](const Value &a, const Value &b) {
+    return value_of<T>(a) < value_of<T>(b);
+  });
+}
+
+}  // namespace
+
+/**
+  Builds the steps of a Compiled_condition. Leaves are emitted from left
+  to right; the number of leaves of each subtree gives the position of the
+  step following it, which is where AND continues on TRUE and UNKNOWN and
+  OR continues on FALSE and UNKNOWN. The final steps of AND and OR, which
+  check their flag, come after all the leaves.
+*/
+class Condition_compiler {
+ public:
+  explicit Condition_compiler(MEM_ROOT *mem_root)
+      : m_mem_root(mem_root),
+        m_steps(nullptr),
+        m_next_leaf(0),
+        m_num_steps(0),
+        m_num_flags(0),
+        m_num_specialized(0) {}
+
+  Compiled_condition *compile(Item *cond) {
+    const size_t num_leaves = count_leaves(cond);
+    const size_t max_steps = num_leaves + count_and_or(cond);
+    m_steps = new (m_mem_root) Step[max_steps];
+    m_num_steps = num_leaves;
+    Targets targets = {Compiled_condition::ACCEPT, Compiled_condition::REJECT,
+                       Compiled_condition::REJECT, 0};
+    if (m_steps == nullptr || add(cond, targets)) return nullptr;
+    DBUG_ASSERT(m_next_leaf == num_leaves && m_num_steps <= max_steps);
+    if (m_num_specialized == 0 || m_num_flags > MAX_FLAGS) return nullptr;
+    return new (m_mem_root) Compiled_condition(m_steps, m_num_steps);
+  }
+
+ private:
+  static bool is_and_or(Item *cond) {
+    if (cond->type() != Item::COND_ITEM) return false;
+    Item_cond *const item_cond = down_cast<Item_cond *>(cond);
+    return (item_cond->functype() == Item_func::COND_AND_FUNC ||
+            item_cond->functype() == Item_func::COND_OR_FUNC) &&
+           !item_cond->argument_list()->is_empty();
+  }
+
+  static size_t count_leaves(Item *cond) {
+    if (!is_and_or(cond)) return 1;
+    size_t count = 0;
+    List_iterator<Item> it(*down_cast<Item_cond *>(cond)->argument_list());
+    Item *item;
+    while ((item = it++)) count += count_leaves(item);
+    return count;
+  }
+
+  static size_t count_and_or(Item *cond) {
+    if (!is_and_or(cond)) return 0;
+    size_t count = 1;
+    List_iterator<Item> it(*down_cast<Item_cond *>(cond)->argument_list());
+    Item *item;
+    while ((item = it++)) count += count_and_or(item);
+    return count;
+  }
+
+  /// Where to go on each outcome of a subtree.
+  struct Targets {
+    int on_true;
+    int on_false;
+    int on_unknown;
+    /// Flags to set when going to on_unknown
+    ulonglong unknown_flags;
+  };
+
+  /// @return true if out of memory
+  bool add(Item *cond, const Targets &targets) {
+    if (!is_and_or(cond)) return add_leaf(cond, targets);
+
+    Item_cond *const item_cond = down_cast<Item_cond *>(cond);
+    const bool is_and = item_cond->functype() == Item_func::COND_AND_FUNC;
+    List<Item> *const args = item_cond->argument_list();
+    Targets last = targets;
+
+    /*
+      A top level AND stops at the first operand which is not TRUE, and
+      is FALSE then, see Item_cond_and::val_int().
+    */
+    if (is_and && item_cond->is_top_level_item()) {
+      last.on_unknown = targets.on_false;
+      last.unknown_flags = 0;
+    }
+
+    /*
+      The flag is only needed if UNKNOWN leads elsewhere than the result
+      the last operand would give otherwise.
+    */
+    const int otherwise = is_and ? last.on_true : last.on_false;
+    ulonglong flag = 0;
+    if (args->elements > 1 && (!is_and || !item_cond->is_top_level_item()) &&
+        (last.on_unknown != otherwise || last.unknown_flags != 0))
+      flag = new_flag();
+
+    List_iterator<Item> it(*args);
+    Item *item;
+    uint remaining = args->elements;
+    while ((item = it++)) {
+      if (--remaining == 0) break;
+      const int next = static_cast<int>(m_next_leaf + count_leaves(item));
+      Targets operand = last;
+      if (is_and) {
+        operand.on_true = next;
+        if (!item_cond->is_top_level_item()) {
+          operand.on_unknown = next;
+          operand.unknown_flags = flag;
+        }
+      } else {
+        operand.on_false = next;
+        operand.on_unknown = next;
+        operand.unknown_flags = flag;
+      }
+      if (add(item, operand)) return true;
+    }
+
+    /*
+      The last operand decides, unless an earlier one was UNKNOWN: then
+      the result is UNKNOWN rather than TRUE for AND, or FALSE for OR.
+    */
+    if (flag != 0) {
+      Step *const check = new_step();
+      check->test = is_and ? test_and_unknown : test_or_unknown;
+      check->flag = flag;
+      check->next[OUTCOME_TRUE] = last.on_true;
+      check->next[OUTCOME_FALSE] = last.on_false;
+      check->next[OUTCOME_UNKNOWN] = last.on_unknown;
+      check->unknown_flags = last.unknown_flags;
+      if (is_and)
+        last.on_true = step_index(check);
+      else
+        last.on_false = step_index(check);
+    }
+    return add(item, last);
+  }
+
+  /// @return a new final step of an AND or OR
+  Step *new_step() {
+    Step *const step = &m_steps[m_num_steps++];
+    step->item = nullptr;
+    step->field = nullptr;
+    step->list = nullptr;
+    step->list_size = 0;
+    step->flag = 0;
+    return step;
+  }
+
+  int step_index(const Step *step) const {
+    return static_cast<int>(step - m_steps);
+  }
+
+  /// @return a flag for an AND or OR, or 0 if there are too many of them
+  ulonglong new_flag() {
+    if (m_num_flags++ >= MAX_FLAGS) return 0;
+    return 1ULL << (m_num_flags - 1);
+  }
+
+  bool add_leaf(Item *cond, const Targets &targets) {
+    Step *const step = &m_steps[m_next_leaf++];
+    step->next[OUTCOME_TRUE] = targets.on_true;
+    step->next[OUTCOME_FALSE] = targets.on_false;
+    step->next[OUTCOME_UNKNOWN] = targets.on_unknown;
+    step->unknown_flags = targets.unknown_flags;
+    step->flag = 0;
+    step->item = cond;
+    step->field = nullptr;
+    step->list = nullptr;
+    step->list_size = 0;
+    step->test = test_item;
+    if (cond->type() != Item::FUNC_ITEM) return false;
+    if (specialize(down_cast<Item_func *>(cond), step)) return true;
+    if (step->test != test_item) ++m_num_specialized;
+    return false;
+  }
+
+  /**
+    Set up a specialized test for a predicate, if it has a supported
+    shape. Leaves the step as it is otherwise.
+
+    @return true if out of memory
+  */
+  bool specialize(Item_func *func, Step *step) {
+    Item **const args = func->arguments();
+    Domain domain = DOMAIN_NONE;
+    Compiled_op op;
+
+    switch (func->functype()) {
+      case Item_func::EQ_FUNC:
+      case Item_func::NE_FUNC:
+      case Item_func::LT_FUNC:
+      case Item_func::LE_FUNC:
+      case Item_func::GT_FUNC:
+      case Item_func::GE_FUNC: {
+        op = comparison_op(func->functype());
+        const Field *field = compilable_field(args[0], &domain);
+        Item *constant = args[1];
+        if (field == nullptr) {
+          field = compilable_field(args[1], &domain);
+          constant = args[0];
+          op = swapped(op);
+        }
+        if (field == nullptr ||
+            !comparator_matches(
+                down_cast<Item_bool_func2 *>(func)->get_comparator(),
+                domain) ||
+            !constant_value(constant, domain, &step->low))
+          return false;
+        step->field = field;
+        break;
+      }
+      case Item_func::BETWEEN: {
+        Item_func_between *const between =
+            down_cast<Item_func_between *>(func);
+        const Field *field = compilable_field(args[0], &domain);
+        if (field == nullptr ||
+            between->cmp_type !=
+                (domain == DOMAIN_REAL ? REAL_RESULT : INT_RESULT) ||
+            between->compare_as_dates_with_strings ||
+            between->compare_as_temporal_dates ||
+            between->compare_as_temporal_times ||
+            !constant_value(args[1], domain, &step->low) ||
+            !constant_value(args[2], domain, &step->high))
+          return false;
+        op = between->negated ? OP_NOT_BETWEEN : OP_BETWEEN;
+        step->field = field;
+        break;
+      }
+      case Item_func::IN_FUNC: {
+        Item_func_in *const in = down_cast<Item_func_in *>(func);
+        const Field *field = compilable_field(args[0], &domain);
+        if (field == nullptr ||
+            in->left_result_type !=
+                (domain == DOMAIN_REAL ? REAL_RESULT : INT_RESULT))
+          return false;
+        const size_t size = func->argument_count() - 1;
+        Value *const list = new (m_mem_root) Value[size];
+        if (list == nullptr) return true;
+        for (size_t i = 0; i < size; ++i)
+          if (!constant_value(args[i + 1], domain, &list[i])) return false;
+        switch (domain) {
+          case DOMAIN_SIGNED:
+            sort_list<longlong>(list, size);
+            break;
+          case DOMAIN_UNSIGNED:
+            sort_list<ulonglong>(list, size);
+            break;
+          default:
+            sort_list<double>(list, size);
+            break;
+        }
+        op = in->negated ? OP_NOT_IN : OP_IN;
+        step->field = field;
+        step->list = list;
+        step->list_size = size;
+        break;
+      }
+      default:
+        return false;
+    }
+
+    step->test = select_test(step->field, op);
+    return false;
+  }
+
+  static Compiled_op comparison_op(Item_func::Functype functype) {
+    switch (functype) {
+      case Item_func::EQ_FUNC:
+        return OP_EQ;
+      case Item_func::NE_FUNC:
+        return OP_NE;
+      case Item_func::LT_FUNC:
+        return OP_LT;
+      case Item_func::LE_FUNC:
+        return OP_LE;
+      case Item_func::GT_FUNC:
+        return OP_GT;
+      default:
+        DBUG_ASSERT(functype == Item_func::GE_FUNC);
+        return OP_GE;
+    }
+  }
+
+  /// @return the operator to use when the operands trade places
+  static Compiled_op swapped(Compiled_op op) {
+    switch (op) {
+      case OP_LT:
+        return OP_GT;
+      case OP_LE:
+        return OP_GE;
+      case OP_GT:
+        return OP_LT;
+      case OP_GE:
+        return OP_LE;
+      default:
+        return op;
+    }
+  }
+
+  /// Number of flags which fit in the evaluation state
+  static const uint MAX_FLAGS = 64;
+
+  MEM_ROOT *const m_mem_root;
+  Step *m_steps;
+  /// Position of the next leaf
+  size_t m_next_leaf;
+  /// Number of steps, leaves and final steps of AND and OR
+  size_t m_num_steps;
+  /// Number of flags of AND and OR
+  uint m_num_flags;
+  /// Number of steps which do not go through the Item
+  size_t m_num_specialized;
+};
+
+bool Compiled_condition::evaluate(const THD *thd) const {
+  ulonglong unknown = 0;
+  int pc = 0;
+  do {
+    DBUG_ASSERT(static_cast<size_t>(pc) < m_num_steps);
+    const Step &step = m_steps[pc];
+    const int outcome = step.test(step, unknown);
+    if (thd->is_error()) return false;
+    if (outcome == OUTCOME_UNKNOWN) unknown |= step.unknown_flags;
+    pc = step.next[outcome];
+  } while (pc >= 0);
+  return pc == ACCEPT;
+}
+
+Compiled_condition *Compiled_condition::compile(MEM_ROOT *mem_root,
+                                                Item *cond) {
+  Condition_compiler compiler(mem_root);
+  return compiler.compile(cond);
+}
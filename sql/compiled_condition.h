@@ -0,0 +1,131 @@
+#ifndef COMPILED_CONDITION_INCLUDED
+#define COMPILED_CONDITION_INCLUDED
+
+/* Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/**
+  @file sql/compiled_condition.h
+
+  Flat evaluator programs for conditions attached to a table in the join.
+
+  A condition is an AND/OR tree whose leaves are predicates. Leaves which
+  compare an integer or floating point column to constants (=, <>, <, <=,
+  >, >=, [NOT] BETWEEN and [NOT] IN) are compiled into steps that read the
+  column directly from the record buffer, through a function specialized
+  on the column type and the operator. Other leaves are evaluated through
+  Item::val_bool(). The AND/OR structure is turned into jumps between the
+  steps, so evaluating the condition is a single loop over the program.
+
+  Leaves are evaluated in the same order and as far as the Item tree
+  evaluates them, so that they raise the same warnings and errors: an AND
+  which is not at the top level goes on after an UNKNOWN operand, like
+  Item_cond_and does. Each such AND, and each OR, has a flag telling
+  whether one of its operands was UNKNOWN, which a final step checks to
+  tell a TRUE or FALSE result from UNKNOWN. The program only tells whether
+  the whole condition is TRUE.
+*/
+
+#include <stddef.h>
+
+#include "my_inttypes.h"
+
+class Field;
+class Item;
+class THD;
+struct MEM_ROOT;
+
+class Compiled_condition {
+ public:
+  /**
+    Compile a condition.
+
+    @param mem_root  where to allocate the program
+    @param cond      the condition
+
+    @return the program, or nullptr if no leaf of the condition could be
+            specialized, or if out of memory
+  */
+  static Compiled_condition *compile(MEM_ROOT *mem_root, Item *cond);
+
+  /**
+    Evaluate the condition for the current row. Evaluation stops at the
+    first step which raises an error.
+
+    @param thd  the thread, checked for errors after each step
+    @return true if the condition is TRUE, false if it is FALSE or
+            UNKNOWN, or on error
+  */
+  bool evaluate(const THD *thd) const;
+
+  /// Outcome of a step, which indexes Step::next.
+  enum Outcome { OUTCOME_FALSE, OUTCOME_TRUE, OUTCOME_UNKNOWN };
+
+  /// A constant operand, in the domain of the column it is compared to.
+  union Value {
+    longlong i;
+    ulonglong u;
+    double d;
+  };
+
+  struct Step {
+    /**
+      @param step     the step
+      @param unknown  the flags set so far
+      @return the Outcome of the step
+    */
+    typedef int (*Test)(const Step &step, ulonglong unknown);
+
+    /// Function evaluating the step, specialized on its shape
+    Test test;
+    /// Next step for each Outcome, or ACCEPT or REJECT
+    int next[3];
+    /// Flags to set when the outcome is UNKNOWN
+    ulonglong unknown_flags;
+    /// The flag tested by the final step of an AND or OR
+    ulonglong flag;
+    /// The predicate, for steps evaluated through the Item
+    Item *item;
+    /// The column, for specialized steps
+    const Field *field;
+    /// Operand of comparisons, lower bound of BETWEEN
+    Value low;
+    /// Upper bound of BETWEEN
+    Value high;
+    /// IN list, sorted in the domain of the column
+    const Value *list;
+    size_t list_size;
+  };
+
+ private:
+  enum { ACCEPT = -1, REJECT = -2 };
+
+  friend class Condition_compiler;
+
+  Compiled_condition(const Step *steps, size_t num_steps)
+      : m_steps(steps), m_num_steps(num_steps) {}
+
+  const Step *const m_steps;
+  const size_t m_num_steps;
+};
+
+#endif  // COMPILED_CONDITION_INCLUDED
@@ -25,8 +25,16 @@
 #include "my_time.h"  // TIME_to_ulonglong_datetime
 #include "sql/dd/cache/dictionary_client.h"
 #include "sql/dd/dd.h"  // dd::create_object
+#include "sql/dd/dd_schema.h"                    // dd::Schema_MDL_locker
+#include "sql/dd/impl/object_key.h"              // dd::Object_key
+#include "sql/dd/impl/raw/raw_record.h"          // dd::Raw_record
+#include "sql/dd/impl/raw/raw_record_set.h"      // dd::Raw_record_set
+#include "sql/dd/impl/raw/raw_table.h"           // dd::Raw_table
+#include "sql/dd/impl/tables/tables.h"           // dd::tables::Tables
+#include "sql/dd/impl/transaction_impl.h"        // dd::Transaction_ro
 #include "sql/dd/properties.h"
 #include "sql/dd/types/index_stat.h"             // dd::Index_stat
+#include "sql/dd/types/schema.h"                 // dd::Schema
 #include "sql/dd/types/table_stat.h"             // dd::Table_stat
 #include "sql/debug_sync.h"                      // DEBUG_SYNC
 #include "sql/error_handler.h"                   // Info_schema_error_handler
@@ -271,6 +279,54 @@ static bool persist_i_s_index_stats(THD *thd, const String &schema_name_ptr,
   return store_statistics_record(thd, obj.get());
 }
 
+/**
+  Read the SE private id and SE private data of the tables of a schema
+  from mysql.tables, without building the table objects.
+
+  @param thd             Thread.
+  @param schema_name_ptr Schema name
+  @param[out] tables     SE private id and data, by table name.
+
+  @returns false on success, otherwise true.
+*/
+
+static bool read_schema_se_private_data(THD *thd,
+                                        const String &schema_name_ptr,
+                                        Schema_table_se_private_data *tables) {
+  dd::Schema_MDL_locker mdl_locker(thd);
+  dd::cache::Dictionary_client::Auto_releaser releaser(thd->dd_client());
+  const dd::Schema *schema = nullptr;
+
+  if (mdl_locker.ensure_locked(schema_name_ptr.ptr()) ||
+      thd->dd_client()->acquire(schema_name_ptr.ptr(), &schema) ||
+      schema == nullptr)
+    return true;
+
+  dd::Transaction_ro trx(thd, ISO_READ_COMMITTED);
+  trx.otx.add_table<dd::tables::Tables>();
+  if (trx.otx.open_tables()) return true;
+
+  dd::Raw_table *table =
+      trx.otx.get_table(dd::tables::Tables::instance().name());
+  std::unique_ptr<dd::Object_key> key(
+      dd::tables::Tables::create_key_by_schema_id(schema->id()));
+  std::unique_ptr<dd::Raw_record_set> rs;
+  if (table->open_record_set(key.get(), rs)) return true;
+
+  dd::Raw_record *r = rs->current_record();
+  while (r) {
+    dd::String_type name = r->read_str(dd::tables::Tables::FIELD_NAME);
+    (*tables)[std::string(name.c_str(), name.length())] = std::make_pair(
+        r->read_uint(dd::tables::Tables::FIELD_SE_PRIVATE_ID,
+                     dd::INVALID_OBJECT_ID),
+        r->read_str(dd::tables::Tables::FIELD_SE_PRIVATE_DATA, ""));
+
+    if (rs->next(r)) return true;
+  }
+
+  return false;
+}
+
 }  // Anonymous namespace
 
 namespace dd {
@@ -488,6 +544,41 @@ ulonglong Table_statistics::read_stat(
   DBUG_RETURN(result);
 }
 
+uint Table_statistics::read_schema_stats_from_SE(THD *thd,
+                                                const String &schema_name_ptr,
+                                                const String &table_name_ptr,
+                                                handlerton *hton, uint flags,
+                                                ha_statistics *stats) {
+  DBUG_ENTER("Table_statistics::read_schema_stats_from_SE");
+
+  if (hton->get_schema_table_statistics == nullptr) DBUG_RETURN(0);
+
+  Schema_stats &schema = m_schema_stats[std::make_pair(
+      hton, String_type(schema_name_ptr.ptr(), schema_name_ptr.length()))];
+
+  if (!schema.m_loaded) {
+    if (++schema.m_tables_read < SCHEMA_STATS_MIN_TABLES) DBUG_RETURN(0);
+
+    schema.m_loaded = true;
+    Schema_table_se_private_data tables;
+    if (read_schema_se_private_data(thd, schema_name_ptr, &tables) ||
+        hton->get_schema_table_statistics(schema_name_ptr.ptr(), tables, flags,
+                                          &schema.m_tables)) {
+      // Read the statistics of each table instead.
+      schema.m_tables.clear();
+      thd->clear_error();
+      DBUG_RETURN(0);
+    }
+  }
+
+  auto it = schema.m_tables.find(
+      std::string(table_name_ptr.ptr(), table_name_ptr.length()));
+  if (it == schema.m_tables.end()) DBUG_RETURN(0);
+
+  *stats = it->second.first;
+  DBUG_RETURN(it->second.second & flags);
+}
+
 // Fetch stats from SE
 ulonglong Table_statistics::read_stat_from_SE(
     THD *thd, const String &schema_name_ptr, const String &table_name_ptr,
@@ -513,25 +604,34 @@ ulonglong Table_statistics::read_stat_from_SE(
   //
   ha_statistics ha_stat;
   uint error = 0;
+  uint flags = HA_STATUS_VARIABLE | HA_STATUS_TIME | HA_STATUS_VARIABLE_EXTRA |
+               HA_STATUS_AUTO;
 
-  // Acquire MDL_EXPLICIT lock on table.
+  // Ask SE only for the statistics not read along with the whole schema.
+  if (stype != enum_table_stats_type::INDEX_COLUMN_CARDINALITY)
+    flags &= ~read_schema_stats_from_SE(thd, schema_name_ptr, table_name_ptr,
+                                        hton, flags, &ha_stat);
+
+  // Acquire MDL_EXPLICIT lock on table, unless there is nothing left to read.
   MDL_request mdl_request;
   MDL_REQUEST_INIT(&mdl_request, MDL_key::TABLE, schema_name_ptr.ptr(),
                    table_name_ptr.ptr(), MDL_SHARED_HIGH_PRIO, MDL_EXPLICIT);
 
-  // Push deadlock error handler
-  Info_schema_error_handler info_schema_error_handler(thd, &schema_name_ptr,
-                                                      &table_name_ptr);
-  thd->push_internal_handler(&info_schema_error_handler);
-  if (thd->mdl_context.acquire_lock(&mdl_request,
-                                    thd->variables.lock_wait_timeout)) {
-    error = -1;
+  if (flags != 0) {
+    // Push deadlock error handler
+    Info_schema_error_handler info_schema_error_handler(thd, &schema_name_ptr,
+                                                        &table_name_ptr);
+    thd->push_internal_handler(&info_schema_error_handler);
+    if (thd->mdl_context.acquire_lock(&mdl_request,
+                                      thd->variables.lock_wait_timeout)) {
+      error = -1;
+    }
+    thd->pop_internal_handler();
   }
-  thd->pop_internal_handler();
 
   DEBUG_SYNC(thd, "after_acquiring_mdl_shared_to_fetch_stats");
 
-  if (error == 0) {
+  if (error == 0 && flags != 0) {
     error = -1;
 
     // Prepare dd::Properties objects for se_private_data and send it to SE.
@@ -558,10 +658,7 @@ ulonglong Table_statistics::read_stat_from_SE(
     } else if (!hton->get_table_statistics(
                    schema_name_ptr.ptr(), table_name_ptr.ptr(), se_private_id,
                    *ts_se_private_data_obj.get(),
-                   *tbl_se_private_data_obj.get(),
-                   HA_STATUS_VARIABLE | HA_STATUS_TIME |
-                       HA_STATUS_VARIABLE_EXTRA | HA_STATUS_AUTO,
-                   &ha_stat)) {
+                   *tbl_se_private_data_obj.get(), flags, &ha_stat)) {
       error = 0;
     }
 
@@ -24,7 +24,9 @@
 #define DD_INFO_SCHEMA_TABLE_STATS_INCLUDED
 
 #include <sys/types.h>
+#include <map>
 #include <string>
+#include <utility>
 
 #include "sql/dd/object_id.h"    // Object_id
 #include "sql/dd/string_type.h"  // dd::String_type
@@ -219,6 +221,7 @@ class Table_statistics {
   void invalidate_cache(void) {
     m_key.clear();
     m_error.clear();
+    m_schema_stats.clear();
   }
 
   // Get error string. Its empty if a error is not reported.
@@ -283,6 +286,28 @@ class Table_statistics {
       const char *tbl_se_private_data, enum_table_stats_type stype,
       handlerton *hton);
 
+  /**
+    Take the statistics of a table from those which the SE read for all
+    tables of the schema in one pass. The SE is asked for them only once
+    the statement has read the statistics of SCHEMA_STATS_MIN_TABLES
+    tables of the schema, so that a statement on a few tables does not
+    read those of the whole schema.
+
+    @param thd                     - Current thread.
+    @param schema_name_ptr         - Schema name of table.
+    @param table_name_ptr          - Table name of which we need stats.
+    @param hton                    - Handle to SE for the given table.
+    @param flags                   - HA_STATUS_* flags of the statistics
+                                     to read.
+    @param[out] stats              - Statistics of the table.
+
+    @return HA_STATUS_* flags of the statistics taken, 0 if none.
+  */
+  uint read_schema_stats_from_SE(THD *thd, const String &schema_name_ptr,
+                                 const String &table_name_ptr,
+                                 handlerton *hton, uint flags,
+                                 ha_statistics *stats);
+
   /**
     Read dynamic table/index statistics by opening the table OR by reading
     cached statistics from SELECT_LEX.
@@ -387,6 +412,24 @@ class Table_statistics {
   // Table checksum value retrieved from SE.
   ulonglong m_checksum;
 
+  // Number of tables of a schema to read before reading the whole schema.
+  static constexpr uint SCHEMA_STATS_MIN_TABLES = 4;
+
+  // Statistics read from SE for all tables of a schema.
+  struct Schema_stats {
+    // Number of tables of the schema read so far.
+    uint m_tables_read = 0;
+
+    // Whether the SE was asked for the statistics of the schema.
+    bool m_loaded = false;
+
+    Schema_table_statistics m_tables;
+  };
+
+  // Statistics of schemas, by engine and schema name.
+  std::map<std::pair<const handlerton *, String_type>, Schema_stats>
+      m_schema_stats;
+
  public:
   // Cached statistics.
   ha_statistics m_stats;
@@ -33,9 +33,11 @@
 #include <sys/types.h>
 #include <time.h>
 #include <algorithm>
+#include <map>
 #include <random>  // std::mt19937
 #include <set>
 #include <string>
+#include <utility>
 
 #include "ft_global.h"  // ft_hints
 #include "lex_string.h"
@@ -1652,6 +1654,46 @@ typedef bool (*get_table_statistics_t)(
     const dd::Properties &tbl_se_private_data, uint flags,
     ha_statistics *stats);
 
+/**
+  Statistics of the tables of a schema read from SE, by table name. Along
+  with the statistics of a table are the HA_STATUS_* flags of those which
+  were read.
+*/
+using Schema_table_statistics =
+    std::map<std::string, std::pair<ha_statistics, uint>>;
+
+/**
+  SE private id and SE private data of the tables of a schema, by table
+  name, as stored in the data dictionary.
+*/
+using Schema_table_se_private_data =
+    std::map<std::string, std::pair<dd::Object_id, dd::String_type>>;
+
+/**
+  @brief
+  Retrieve ha_statistics of all tables of a schema from SE, in one pass.
+
+  @param db_name                  Name of schema
+  @param tables                   SE private id and data of the tables of
+                                  the schema.
+  @param flags                    Type of statistics to retrieve.
+  @param[out] stats               Contains statistics read from SE.
+
+  @note The SE may leave out tables, or some of the statistics of a table,
+        which are then retrieved through get_table_statistics(). So it
+        need not read anything it can not read cheaply.
+
+  @note Handlers that implement this callback/API should adhere
+        to servers expectation that, the implementation would invoke
+        my_error() before returning 'true'/failure from this function.
+
+  @returns false on success,
+           true on failure
+*/
+typedef bool (*get_schema_table_statistics_t)(
+    const char *db_name, const Schema_table_se_private_data &tables,
+    uint flags, Schema_table_statistics *stats);
+
 /**
   @brief
   Retrieve index column cardinality from SE.
@@ -1903,6 +1945,7 @@ struct handlerton {
   rotate_encryption_master_key_t rotate_encryption_master_key;
 
   get_table_statistics_t get_table_statistics;
+  get_schema_table_statistics_t get_schema_table_statistics;
   get_index_column_cardinality_t get_index_column_cardinality;
   get_tablespace_statistics_t get_tablespace_statistics;
 
@@ -130,6 +130,7 @@ class Arg_comparator {
                     bool set_null_arg);
 
   inline int compare() { return (this->*func)(); }
+  arg_cmp_func get_compare_func() const { return func; }
 
   int compare_string();         // compare args[0] & args[1]
   int compare_binary_string();  // compare args[0] & args[1]
@@ -470,6 +471,7 @@ class Item_bool_func2 : public Item_bool_func { /* Bool with 2 string args */
   bool set_cmp_func() {
     return cmp.set_cmp_func(this, tmp_arg, tmp_arg + 1, true);
   }
+  const Arg_comparator *get_comparator() const { return &cmp; }
   optimize_type select_optimize() const override { return OPTIMIZE_OP; }
   virtual enum Functype rev_functype() const { return UNKNOWN_FUNC; }
   bool have_rev_func() const override { return rev_functype() != UNKNOWN_FUNC; }
@@ -1926,6 +1928,7 @@ class Item_cond : public Item_bool_func {
   void split_sum_func(THD *thd, Ref_item_array ref_item_array,
                       List<Item> &fields) override;
   void top_level_item() override { abort_on_null = true; }
+  bool is_top_level_item() const { return abort_on_null; }
   void copy_andor_arguments(THD *thd, Item_cond *item);
   bool walk(Item_processor processor, enum_walk walk, uchar *arg) override;
   Item *transform(Item_transformer transformer, uchar *arg) override;
@@ -1001,8 +1001,13 @@ bool Aggregator_distinct::setup(THD *thd) {
         }
       }
       DBUG_ASSERT(tree == 0);
-      tree = new (*THR_MALLOC) Unique(compare_key, cmp_arg, tree_key_length,
-                                      item_sum->ram_limitation(thd));
+      /*
+        Keys compared with simple_raw_key_cmp are equal only if they are
+        equal byte by byte, so they can be kept in a hash set.
+      */
+      tree = new (*THR_MALLOC)
+          Unique(compare_key, cmp_arg, tree_key_length,
+                 item_sum->ram_limitation(thd), all_binary);
       /*
         The only time tree_key_length could be 0 is if someone does
         count(distinct) on a char(0) field - stupid thing to do,
@@ -1061,7 +1066,7 @@ bool Aggregator_distinct::setup(THD *thd) {
     */
     tree = new (*THR_MALLOC)
         Unique(simple_raw_key_cmp, &tree_key_length, tree_key_length,
-               item_sum->ram_limitation(thd));
+               item_sum->ram_limitation(thd), true);
 
     DBUG_RETURN(tree == 0);
   }
@@ -1533,6 +1538,8 @@ Item_sum_sum::Item_sum_sum(THD *thd, Item_sum_sum *item)
     : Item_sum_num(thd, item),
       hybrid_type(item->hybrid_type),
       curr_dec_buff(item->curr_dec_buff),
+      m_scaled_sum(item->m_scaled_sum),
+      m_has_scaled_sum(item->m_has_scaled_sum),
       m_count(item->m_count),
       m_frame_null_count(item->m_frame_null_count) {
   /* TODO: check if the following assignments are really needed */
@@ -1556,6 +1563,8 @@ void Item_sum_sum::clear() {
     curr_dec_buff = 0;
     my_decimal_set_zero(&dec_buffs[0]);
     my_decimal_set_zero(&dec_buffs[1]);
+    m_scaled_sum = 0;
+    m_has_scaled_sum = false;
   } else
     sum = 0.0;
   m_count = 0;
@@ -1634,9 +1643,27 @@ bool Item_sum_sum::add() {
     my_decimal value;
     const my_decimal *val = aggr->arg_val_decimal(&value);
     if (!aggr->arg_is_null(true)) {
-      my_decimal_add(E_DEC_FATAL_ERROR, dec_buffs + (curr_dec_buff ^ 1), val,
-                     dec_buffs + curr_dec_buff);
-      curr_dec_buff ^= 1;
+      longlong scaled;
+      /*
+        Values with the scale of the argument are added as scaled integers.
+        The other ones would change the scale of the sum, and are added as
+        decimals, like values that do not fit or would overflow the sum.
+        The scale of the argument is used rather than decimals, which AVG
+        increases by prec_increment.
+      */
+      if (val->frac == static_cast<int>(args[0]->decimals) &&
+          decimal2scaled_longlong(val, args[0]->decimals, &scaled) ==
+              E_DEC_OK) {
+        if (scaled > 0 ? m_scaled_sum > LLONG_MAX - scaled
+                       : m_scaled_sum < LLONG_MIN - scaled)
+          decimal_sum();
+        m_scaled_sum += scaled;
+        m_has_scaled_sum = true;
+      } else {
+        my_decimal_add(E_DEC_FATAL_ERROR, dec_buffs + (curr_dec_buff ^ 1), val,
+                       dec_buffs + curr_dec_buff);
+        curr_dec_buff ^= 1;
+      }
       null_value = 0;
     }
   } else {
@@ -1646,6 +1673,25 @@ bool Item_sum_sum::add() {
   DBUG_RETURN(0);
 }
 
+/**
+  Add the scaled integer sum accumulated by add() to the decimal sum.
+
+  @return the decimal sum of all values added
+*/
+my_decimal *Item_sum_sum::decimal_sum() {
+  DBUG_ASSERT(hybrid_type == DECIMAL_RESULT);
+  if (m_has_scaled_sum) {
+    my_decimal value;
+    scaled_longlong2decimal(m_scaled_sum, args[0]->decimals, &value);
+    my_decimal_add(E_DEC_FATAL_ERROR, dec_buffs + (curr_dec_buff ^ 1), &value,
+                   dec_buffs + curr_dec_buff);
+    curr_dec_buff ^= 1;
+    m_scaled_sum = 0;
+    m_has_scaled_sum = false;
+  }
+  return dec_buffs + curr_dec_buff;
+}
+
 longlong Item_sum_sum::val_int() {
   DBUG_ENTER("Item_sum_sum::val_int");
   DBUG_ASSERT(fixed == 1);
@@ -1661,8 +1707,7 @@ longlong Item_sum_sum::val_int() {
   if (aggr) aggr->endup();
   if (hybrid_type == DECIMAL_RESULT) {
     longlong result;
-    my_decimal2int(E_DEC_FATAL_ERROR, dec_buffs + curr_dec_buff, unsigned_flag,
-                   &result);
+    my_decimal2int(E_DEC_FATAL_ERROR, decimal_sum(), unsigned_flag, &result);
     DBUG_RETURN(result);
   }
   longlong result = (longlong)rint(val_real());
@@ -1709,7 +1754,7 @@ double Item_sum_sum::val_real() {
   } else {
     if (aggr) aggr->endup();
     if (hybrid_type == DECIMAL_RESULT)
-      my_decimal2double(E_DEC_FATAL_ERROR, dec_buffs + curr_dec_buff, &sum);
+      my_decimal2double(E_DEC_FATAL_ERROR, decimal_sum(), &sum);
     DBUG_RETURN(sum);
   }
 }
@@ -1781,7 +1826,7 @@ my_decimal *Item_sum_sum::val_decimal(my_decimal *val) {
   }
 
   if (aggr) aggr->endup();
-  if (hybrid_type == DECIMAL_RESULT) return (dec_buffs + curr_dec_buff);
+  if (hybrid_type == DECIMAL_RESULT) return decimal_sum();
   return val_decimal_from_real(val);
 }
 
@@ -2092,7 +2137,7 @@ my_decimal *Item_sum_avg::val_decimal(my_decimal *val) {
       DBUG_RETURN(result);
     }
 
-    sum_dec = dec_buffs + curr_dec_buff;
+    sum_dec = decimal_sum();
     int2my_decimal(E_DEC_FATAL_ERROR, m_count, 0, &cnt);
     my_decimal_div(E_DEC_FATAL_ERROR, val, sum_dec, &cnt, prec_increment);
     DBUG_RETURN(val);
@@ -2468,6 +2513,10 @@ void Item_sum_hybrid::clear() {
   null_value = 1;
   m_cnt = 0;
   m_saved_last_value_at = 0;
+  m_sliding_first = 0;
+  m_sliding_count = 0;
+  m_sliding_added = 0;
+  m_sliding_removed = 0;
 }
 
 bool Item_sum_hybrid::wf_semantics(THD *thd, SELECT_LEX *select,
@@ -2499,7 +2548,15 @@ bool Item_sum_hybrid::wf_semantics(THD *thd, SELECT_LEX *select,
     }
   }
   if (!m_optimize) {
-    r->row_optimizable = false;
+    /*
+      Over a ROWS frame, rows leave the frame in the order they were added,
+      which compute_sliding() exploits to support inversion. A frame starting
+      at UNBOUNDED PRECEDING is never inverted, so add() suffices.
+    */
+    const PT_frame *frame = m_window->frame();
+    m_sliding = frame->m_unit == WFU_ROWS &&
+                frame->m_from->m_border_type != WBT_UNBOUNDED_PRECEDING;
+    if (frame->m_unit != WFU_ROWS) r->row_optimizable = false;
     r->range_optimizable = false;
   }
   return result;
@@ -2613,12 +2670,100 @@ bool Item_sum_hybrid::compute() {
   return null_value || current_thd->is_error();
 }
 
+bool Item_sum_hybrid::compute_sliding() {
+  if (m_sliding_cmp == nullptr) {
+    m_sliding_back = value;
+    m_sliding_values.init(*THR_MALLOC);
+    m_sliding_cmp = new (*THR_MALLOC) Arg_comparator();
+    if (m_sliding_cmp == nullptr ||
+        m_sliding_cmp->set_cmp_func(this, pointer_cast<Item **>(&arg_cache),
+                                    pointer_cast<Item **>(&m_sliding_back),
+                                    false))
+      return true;
+  }
+
+  const size_t mask = m_sliding_values.size() - 1;
+  bool front_changed = false;
+
+  if (m_window->do_inverse()) {
+    /*
+      The row leaving the frame is the oldest one. Its value is in the queue
+      only if no later value is smaller (larger).
+    */
+    if (m_sliding_count > 0 &&
+        m_sliding_values[m_sliding_first].seqno == m_sliding_removed) {
+      m_sliding_first = (m_sliding_first + 1) & mask;
+      m_sliding_count--;
+      front_changed = true;
+    }
+    m_sliding_removed++;
+  } else {
+    const int64 seqno = m_sliding_added++;
+    arg_cache->cache_value();
+    if (!arg_cache->null_value) {
+      /*
+        Drop the values which can no longer become the result. An equal
+        value is kept, so the result is the first of equal values, like
+        with add().
+      */
+      while (m_sliding_count > 0) {
+        m_sliding_back =
+            m_sliding_values[(m_sliding_first + m_sliding_count - 1) & mask]
+                .value;
+        if (m_sliding_cmp->compare() * cmp_sign >= 0) break;
+        m_sliding_count--;
+      }
+
+      if (m_sliding_count == m_sliding_values.size()) {
+        /*
+          The ring buffer is full: double its size, and move the values
+          which wrapped around to the start after the old end, so the queue
+          stays contiguous from m_sliding_first.
+        */
+        const size_t old_size = m_sliding_values.size();
+        const size_t new_size = std::max<size_t>(16, 2 * old_size);
+        if (m_sliding_values.reserve(new_size)) return true;
+        m_sliding_values.resize(new_size, Sliding_value{0, nullptr});
+        for (size_t i = 0; i < m_sliding_first; i++) {
+          m_sliding_values[old_size + i] = m_sliding_values[i];
+          m_sliding_values[i] = Sliding_value{0, nullptr};
+        }
+      }
+
+      Sliding_value &back =
+          m_sliding_values[(m_sliding_first + m_sliding_count) &
+                           (m_sliding_values.size() - 1)];
+      if (back.value == nullptr) {
+        back.value = Item_cache::get_cache(args[0]);
+        if (back.value == nullptr) return true;
+        back.value->setup(args[0]);
+      }
+      back.value->store_and_cache(arg_cache);
+      back.seqno = seqno;
+      front_changed = m_sliding_count++ == 0;
+    }
+  }
+
+  if (m_sliding_count == 0)
+    null_value = true;
+  else if (front_changed || null_value) {
+    value->store_and_cache(m_sliding_values[m_sliding_first].value);
+    null_value = value->null_value;
+  }
+  return null_value || current_thd->is_error();
+}
+
 double Item_sum_hybrid::val_real() {
   DBUG_ASSERT(fixed == 1);
   if (m_is_window_function) {
     if (wf_common_init()) return 0.0;
     bool ret = false;
-    m_optimize ? ret = compute() : add();
+    if (m_optimize)
+      ret = compute();
+    else if (m_sliding)
+      ret = compute_sliding();
+    else
+      add();
     if (ret) return error_real();
   }
   if (null_value) return 0.0;
@@ -2632,7 +2777,12 @@ longlong Item_sum_hybrid::val_int() {
   if (m_is_window_function) {
     if (wf_common_init()) return 0;
     bool ret = false;
-    m_optimize ? ret = compute() : add();
+    if (m_optimize)
+      ret = compute();
+    else if (m_sliding)
+      ret = compute_sliding();
+    else
+      add();
     if (ret) return error_int();
   }
   if (null_value) return 0;
@@ -2665,7 +2815,12 @@ my_decimal *Item_sum_hybrid::val_decimal(my_decimal *val) {
       return null_value ? nullptr : val;
     }
     bool ret = false;
-    m_optimize ? ret = compute() : add();
+    if (m_optimize)
+      ret = compute();
+    else if (m_sliding)
+      ret = compute_sliding();
+    else
+      add();
     if (ret) return nullptr;
   }
   if (null_value) return 0;
@@ -2692,7 +2847,12 @@ String *Item_sum_hybrid::val_str(String *str) {
   if (m_is_window_function) {
     if (wf_common_init()) return nullptr;
     bool ret = false;
-    m_optimize ? ret = compute() : add();
+    if (m_optimize)
+      ret = compute();
+    else if (m_sliding)
+      ret = compute_sliding();
+    else
+      add();
     if (ret) return nullptr;
   }
   if (null_value) return nullptr;
@@ -2727,6 +2887,12 @@ void Item_sum_hybrid::cleanup() {
   forced_const = false;
   destroy(cmp);
   cmp = 0;
+  destroy(m_sliding_cmp);
+  m_sliding_cmp = nullptr;
+  // The array and the caches are allocated for one execution.
+  m_sliding_values.init_empty_const();
+  m_sliding_first = 0;
+  m_sliding_count = 0;
   /*
     by default it is true to avoid true reporting by
     Item_func_not_all/Item_func_nop_all if this item was never called.
@@ -5499,6 +5665,164 @@ Item *Item_sum_json_object::copy_or_same(THD *thd) {
                                     Item_sum_json_object(thd, this);
 }
 
+void Item_sum_approx_count_distinct::clear() { m_sketch.clear(); }
+
+bool Item_sum_approx_count_distinct::add() {
+  Item *arg = args[0];
+  ulonglong hash;
+
+  if (arg->is_temporal()) {
+    const longlong packed = arg->val_temporal_by_field_type();
+    if (arg->null_value) return false;
+    hash = Hyperloglog::mix(packed);
+  } else {
+    switch (arg->result_type()) {
+      case INT_RESULT: {
+        const longlong value = arg->val_int();
+        if (arg->null_value) return false;
+        hash = Hyperloglog::mix(value);
+        break;
+      }
+      case REAL_RESULT: {
+        double value = arg->val_real();
+        if (arg->null_value) return false;
+        if (value == 0.0) value = 0.0;  // -0.0 and 0.0 are equal
+        ulonglong bits;
+        memcpy(&bits, &value, sizeof(bits));
+        hash = Hyperloglog::mix(bits);
+        break;
+      }
+      case DECIMAL_RESULT: {
+        my_decimal buff;
+        const my_decimal *value = arg->val_decimal(&buff);
+        if (arg->null_value) return false;
+        /*
+          Hash the value printed with the argument's scale, so that equal
+          values have the same representation.
+        */
+        if (my_decimal2string(E_DEC_FATAL_ERROR, value, 0, arg->decimals, '0',
+                              &m_value))
+          return true;
+        ulong nr1 = 1, nr2 = 4;
+        my_charset_bin.coll->hash_sort(
+            &my_charset_bin, pointer_cast<const uchar *>(m_value.ptr()),
+            m_value.length(), &nr1, &nr2);
+        hash = Hyperloglog::mix(nr1);
+        break;
+      }
+      case STRING_RESULT: {
+        const String *value = arg->val_str(&m_value);
+        if (arg->null_value) return false;
+        /*
+          The collation's hash function gives the same hash to all strings
+          which compare equal.
+        */
+        const CHARSET_INFO *cs = arg->collation.collation;
+        ulong nr1 = 1, nr2 = 4;
+        cs->coll->hash_sort(cs, pointer_cast<const uchar *>(value->ptr()),
+                            value->length(), &nr1, &nr2);
+        hash = Hyperloglog::mix(nr1);
+        break;
+      }
+      default:
+        DBUG_ASSERT(false);
+        return true;
+    }
+  }
+
+  m_sketch.add(hash);
+  return false;
+}
+
+longlong Item_sum_approx_count_distinct::val_int() {
+  DBUG_ASSERT(fixed);
+  if (m_is_window_function) {
+    if (wf_common_init()) return 0;
+    add();
+  }
+  return static_cast<longlong>(m_sketch.estimate());
+}
+
+Item *Item_sum_approx_count_distinct::copy_or_same(THD *thd) {
+  return m_is_window_function
+             ? this
+             : new (thd->mem_root) Item_sum_approx_count_distinct(thd, this);
+}
+
+bool Item_sum_approx_count_distinct::check_wf_semantics(
+    THD *thd, SELECT_LEX *select, Window::Evaluation_requirements *r) {
+  const bool result = Item_sum::check_wf_semantics(thd, select, r);
+  // A value can't be removed from the sketch: recompute each frame.
+  r->row_optimizable = false;
+  r->range_optimizable = false;
+  return result;
+}
+
+bool Item_sum_approx_percentile::fix_fields(THD *thd, Item **ref) {
+  if (super::fix_fields(thd, ref)) return true;
+
+  /*
+    The quantile must be a constant between 0 and 1. A dynamic parameter
+    is checked when the function is evaluated.
+  */
+  Item *arg = args[1];
+  if (arg->type() == Item::PARAM_ITEM) {
+    // we are in a PREPARE phase, so can't check yet
+  } else if (!arg->const_item() || arg->has_subquery() ||
+             (!arg->is_null() &&
+              (arg->val_real() < 0.0 || arg->val_real() > 1.0))) {
+    my_error(ER_WRONG_ARGUMENTS, MYF(0), func_name());
+    return true;
+  }
+
+  maybe_null = true;
+  return false;
+}
+
+void Item_sum_approx_percentile::clear() { m_digest.clear(); }
+
+bool Item_sum_approx_percentile::add() {
+  const double value = args[0]->val_real();
+  if (args[0]->null_value) return false;
+  m_digest.add(value);
+  return false;
+}
+
+double Item_sum_approx_percentile::val_real() {
+  DBUG_ASSERT(fixed);
+  if (m_is_window_function) {
+    if (wf_common_init()) return 0.0;
+    add();
+  }
+
+  const double quantile = args[1]->val_real();
+  if (args[1]->null_value || m_digest.empty()) {
+    null_value = true;
+    return 0.0;
+  }
+  if (quantile < 0.0 || quantile > 1.0) {
+    my_error(ER_WRONG_ARGUMENTS, MYF(0), func_name());
+    return error_real();
+  }
+  null_value = false;
+  return m_digest.quantile(quantile);
+}
+
+Item *Item_sum_approx_percentile::copy_or_same(THD *thd) {
+  return m_is_window_function
+             ? this
+             : new (thd->mem_root) Item_sum_approx_percentile(thd, this);
+}
+
+bool Item_sum_approx_percentile::check_wf_semantics(
+    THD *thd, SELECT_LEX *select, Window::Evaluation_requirements *r) {
+  const bool result = Item_sum::check_wf_semantics(thd, select, r);
+  // A value can't be removed from the digest: recompute each frame.
+  r->row_optimizable = false;
+  r->range_optimizable = false;
+  return result;
+}
+
 /**
   Resolve the fields in the GROUPING function.
   The GROUPING function can only appear in SELECT list or
@@ -46,6 +46,7 @@
 #include "mysql/udf_registration_types.h"
 #include "mysql_time.h"
 #include "mysqld_error.h"
+#include "sql/approximate_aggregates.h"  // Hyperloglog
 #include "sql/enum_query_type.h"
 #include "sql/item.h"       // Item_result_field
 #include "sql/item_func.h"  // Item_int_func
@@ -440,6 +441,8 @@ class Item_sum : public Item_result_field {
     UDF_SUM_FUNC,         // user defined functions
     GROUP_CONCAT_FUNC,    // GROUP_CONCAT
     JSON_AGG_FUNC,        // JSON_ARRAYAGG and JSON_OBJECTAGG
+    APPROX_COUNT_FUNC,    // APPROX_COUNT_DISTINCT
+    APPROX_PERCENT_FUNC,  // APPROX_PERCENTILE
     ROW_NUMBER_FUNC,      // Window functions
     RANK_FUNC,
     DENSE_RANK_FUNC,
@@ -906,6 +909,9 @@ class Item_sum_num : public Item_sum {
   Item_sum_num(const POS &pos, Item *item_par, PT_window *window)
       : Item_sum(pos, item_par, window), is_evaluated(false) {}
 
+  Item_sum_num(const POS &pos, Item *a, Item *b, PT_window *w)
+      : Item_sum(pos, a, b, w), is_evaluated(false) {}
+
   Item_sum_num(const POS &pos, PT_item_list *list, PT_window *w)
       : Item_sum(pos, list, w), is_evaluated(false) {}
 
@@ -970,7 +976,17 @@ class Item_sum_sum : public Item_sum_num {
   double sum;
   my_decimal dec_buffs[2];
   uint curr_dec_buff;
+  /**
+    Execution state: the sum of the DECIMAL values added since the sum was
+    last read, multiplied by 10^args[0]->decimals. Adding scaled integers is
+    much cheaper than adding decimals, values that do not fit are added to
+    dec_buffs directly.
+  */
+  longlong m_scaled_sum;
+  /// True if m_scaled_sum holds values that are not yet in dec_buffs.
+  bool m_has_scaled_sum;
   bool resolve_type(THD *thd) override;
+  my_decimal *decimal_sum();
   /**
     Execution state: this is for counting rows entering and leaving the window
     frame, see #m_frame_null_count.
@@ -988,6 +1004,8 @@ class Item_sum_sum : public Item_sum_num {
   Item_sum_sum(const POS &pos, Item *item_par, bool distinct, PT_window *window)
       : Item_sum_num(pos, item_par, window),
         hybrid_type(INVALID_RESULT),
+        m_scaled_sum(0),
+        m_has_scaled_sum(false),
         m_count(0),
         m_frame_null_count(0) {
     set_distinct(distinct);
@@ -1236,6 +1254,84 @@ class Item_sum_json_object final : public Item_sum_json {
   Item *copy_or_same(THD *thd) override;
 };
 
+/**
+  Implements APPROX_COUNT_DISTINCT(expr): an estimate of COUNT(DISTINCT expr)
+  computed with a HyperLogLog sketch. Unlike COUNT(DISTINCT), it neither
+  sorts nor stores the values, and uses a fixed amount of memory per group.
+  Values are hashed after being normalized according to their type, so
+  values which compare equal (e.g. strings equal under the argument's
+  collation) are counted once.
+*/
+class Item_sum_approx_count_distinct final : public Item_sum_int {
+  /// The sketch of the values seen in the current group or frame.
+  Hyperloglog m_sketch;
+  /// Buffer for reading string and decimal values.
+  String m_value;
+
+  void clear() override;
+  bool add() override;
+
+ public:
+  Item_sum_approx_count_distinct(const POS &pos, Item *a, PT_window *w)
+      : Item_sum_int(pos, a, w) {
+    quick_group = false;
+  }
+  Item_sum_approx_count_distinct(THD *thd, Item_sum_approx_count_distinct *item)
+      : Item_sum_int(thd, item), m_sketch(item->m_sketch) {}
+  enum Sumfunctype sum_func() const override { return APPROX_COUNT_FUNC; }
+  bool resolve_type(THD *) override {
+    maybe_null = false;
+    null_value = false;
+    return false;
+  }
+  longlong val_int() override;
+  void reset_field() override { DBUG_ASSERT(false); }
+  void update_field() override { DBUG_ASSERT(false); }
+  const char *func_name() const override { return "approx_count_distinct"; }
+  Item *copy_or_same(THD *thd) override;
+  bool check_wf_semantics(THD *thd, SELECT_LEX *select,
+                          Window::Evaluation_requirements *r) override;
+};
+
+/**
+  Implements APPROX_PERCENTILE(expr, q): an estimate of the value at
+  quantile q, 0 <= q <= 1, of the non-NULL values of expr, computed with a
+  t-digest. q must be a constant. The estimate is most accurate for
+  quantiles near 0 and 1, and the minimum and maximum are exact.
+*/
+class Item_sum_approx_percentile final : public Item_sum_num {
+  typedef Item_sum_num super;
+
+  /// The digest of the values seen in the current group or frame.
+  Quantile_digest m_digest;
+
+  void clear() override;
+  bool add() override;
+
+ public:
+  Item_sum_approx_percentile(const POS &pos, Item *a, Item *b, PT_window *w)
+      : Item_sum_num(pos, a, b, w) {
+    quick_group = false;
+  }
+  Item_sum_approx_percentile(THD *thd, Item_sum_approx_percentile *item)
+      : Item_sum_num(thd, item), m_digest(item->m_digest) {}
+  enum Sumfunctype sum_func() const override { return APPROX_PERCENT_FUNC; }
+  bool fix_fields(THD *thd, Item **ref) override;
+  bool resolve_type(THD *) override {
+    set_data_type_double();
+    maybe_null = true;
+    return false;
+  }
+  double val_real() override;
+  enum Item_result result_type() const override { return REAL_RESULT; }
+  void reset_field() override { DBUG_ASSERT(false); }
+  void update_field() override { DBUG_ASSERT(false); }
+  const char *func_name() const override { return "approx_percentile"; }
+  Item *copy_or_same(THD *thd) override;
+  bool check_wf_semantics(THD *thd, SELECT_LEX *select,
+                          Window::Evaluation_requirements *r) override;
+};
+
 class Item_sum_avg final : public Item_sum_sum {
  public:
   uint prec_increment;
@@ -1491,6 +1587,43 @@ class Item_sum_hybrid : public Item_sum {
   */
   int64 m_saved_last_value_at;
 
+  /**
+    Set to true when min/max is evaluated over a ROWS frame whose start
+    moves, without the ordering optimization (m_optimize). The frame is
+    then maintained incrementally, see compute_sliding().
+  */
+  bool m_sliding;
+
+  /**
+    A value added to a sliding frame, together with the sequence number of
+    its row in the order rows were added to the frame.
+  */
+  struct Sliding_value {
+    int64 seqno;
+    Item_cache *value;
+  };
+
+  /**
+    Execution state for m_sliding: a ring buffer used as a double ended
+    queue of the values in the frame which can still become the min (max)
+    of the frame as older rows leave it. The values are ordered on both
+    seqno and value, so the result is the front value. Slots outside of the
+    queue keep their cache for reuse. The size is zero or a power of two.
+  */
+  Mem_root_array_YY<Sliding_value> m_sliding_values;
+  /// Position of the front of the queue in m_sliding_values.
+  size_t m_sliding_first;
+  /// Number of values in the queue.
+  size_t m_sliding_count;
+  /// Number of rows added to the frame, including NULLs.
+  int64 m_sliding_added;
+  /// Number of rows removed from the frame by inversion.
+  int64 m_sliding_removed;
+  /// Compares arg_cache to m_sliding_back.
+  Arg_comparator *m_sliding_cmp;
+  /// The queue value being compared by m_sliding_cmp.
+  Item_cache *m_sliding_back;
+
   bool wf_semantics(THD *thd, SELECT_LEX *select,
                     Window::Evaluation_requirements *r, bool min);
   /**
@@ -1505,6 +1638,16 @@ class Item_sum_hybrid : public Item_sum {
   */
   bool compute();
 
+  /**
+    This function implements min/max over a sliding ROWS frame. Rows leave
+    the frame in the order they were added to it, so a monotonic queue of
+    the values in the frame gives the result in amortized constant time
+    per row, instead of evaluating the entire frame for each row.
+
+    @return true if computation yielded a NULL or error
+  */
+  bool compute_sliding();
+
  public:
   Item_sum_hybrid(Item *item_par, int sign)
       : Item_sum(item_par),
@@ -1518,7 +1661,15 @@ class Item_sum_hybrid : public Item_sum {
         m_optimize(false),
         m_want_first(false),
         m_cnt(0),
-        m_saved_last_value_at(0) {
+        m_saved_last_value_at(0),
+        m_sliding(false),
+        m_sliding_first(0),
+        m_sliding_count(0),
+        m_sliding_added(0),
+        m_sliding_removed(0),
+        m_sliding_cmp(nullptr),
+        m_sliding_back(nullptr) {
+    m_sliding_values.init_empty_const();
     collation.set(&my_charset_bin);
   }
 
@@ -1534,7 +1685,15 @@ class Item_sum_hybrid : public Item_sum {
         m_optimize(false),
         m_want_first(false),
         m_cnt(0),
-        m_saved_last_value_at(0) {
+        m_saved_last_value_at(0),
+        m_sliding(false),
+        m_sliding_first(0),
+        m_sliding_count(0),
+        m_sliding_added(0),
+        m_sliding_removed(0),
+        m_sliding_cmp(nullptr),
+        m_sliding_back(nullptr) {
+    m_sliding_values.init_empty_const();
     collation.set(&my_charset_bin);
   }
 
@@ -1549,7 +1708,16 @@ class Item_sum_hybrid : public Item_sum {
         m_optimize(item->m_optimize),
         m_want_first(item->m_want_first),
         m_cnt(item->m_cnt),
-        m_saved_last_value_at(0) {}
+        m_saved_last_value_at(0),
+        m_sliding(item->m_sliding),
+        m_sliding_first(0),
+        m_sliding_count(0),
+        m_sliding_added(0),
+        m_sliding_removed(0),
+        m_sliding_cmp(nullptr),
+        m_sliding_back(nullptr) {
+    m_sliding_values.init_empty_const();
+  }
 
   bool fix_fields(THD *, Item **) override;
   bool setup_hybrid(Item *item, Item *value_arg);
@@ -756,6 +756,8 @@ static const SYMBOL symbols[] = {
      order)
     */
     {SYM_FN("ADDDATE", ADDDATE_SYM)},
+    {SYM_FN("APPROX_COUNT_DISTINCT", APPROX_COUNT_DISTINCT_SYM)},
+    {SYM_FN("APPROX_PERCENTILE", APPROX_PERCENTILE_SYM)},
     {SYM_FN("BIT_AND", BIT_AND)},
     {SYM_FN("BIT_OR", BIT_OR)},
     {SYM_FN("BIT_XOR", BIT_XOR)},
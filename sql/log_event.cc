@@ -896,6 +896,8 @@ const char *Log_event::get_type_str(Log_event_type type) {
       return "XA_prepare";
     case binary_log::PARTIAL_UPDATE_ROWS_EVENT:
       return "Update_rows_partial";
+    case binary_log::TRANSACTION_PAYLOAD_EVENT:
+      return "Transaction_payload";
     default:
       return "Unknown"; /* impossible */
   }
@@ -1690,6 +1692,11 @@ Log_event *Log_event::read_log_event(
 
   if (event_type > description_event->number_of_event_types &&
       event_type != binary_log::FORMAT_DESCRIPTION_EVENT &&
+      /*
+        A Transaction_payload has no post-header, so it is not listed
+        in the Format_description_log_event.
+      */
+      event_type != binary_log::TRANSACTION_PAYLOAD_EVENT &&
       /*
         Skip the event type check when simulating an
         unknown ignorable log event.
@@ -1805,6 +1812,10 @@ Log_event *Log_event::read_log_event(
       case binary_log::PARTIAL_UPDATE_ROWS_EVENT:
         ev = new Update_rows_log_event(buf, event_len, description_event);
         break;
+      case binary_log::TRANSACTION_PAYLOAD_EVENT:
+        ev = new Transaction_payload_log_event(buf, event_len,
+                                               description_event);
+        break;
       default:
         /*
           Create an object of Ignorable_log_event for unrecognized sub-class.
@@ -3004,6 +3015,7 @@ bool Log_event::contains_partition_info(bool end_group_sets_max_dbs) {
   switch (get_type_code()) {
     case binary_log::TABLE_MAP_EVENT:
     case binary_log::EXECUTE_LOAD_QUERY_EVENT:
+    case binary_log::TRANSACTION_PAYLOAD_EVENT:
       res = true;
 
       break;
@@ -3271,7 +3283,8 @@ Slave_worker *Log_event::get_slave_worker(Relay_log_info *rli) {
       DBUG_ASSERT((!ends_group() ||
                    (get_type_code() == binary_log::QUERY_EVENT &&
                     static_cast<Query_log_event *>(this)->is_query_prefix_match(
-                        STRING_WITH_LEN("XA ROLLBACK")))) ||
+                        STRING_WITH_LEN("XA ROLLBACK"))) ||
+                   get_type_code() == binary_log::TRANSACTION_PAYLOAD_EVENT) ||
                   empty_group_with_gtids ||
                   (rli->mts_end_group_sets_max_dbs &&
                    (begin_load_query_event || delete_file_event)));
@@ -13476,6 +13489,297 @@ void View_change_log_event::set_certification_info(
   DBUG_VOID_RETURN;
 }
 
+  /**************************************************************************
+          Transaction_payload_log_event methods
+  **************************************************************************/
+
+#ifdef MYSQL_SERVER
+Transaction_payload_log_event::Transaction_payload_log_event(
+    THD *thd_arg, IO_CACHE *payload, uint64 payload_size,
+    uint8 compression_type, uint64 uncompressed_size)
+    : binary_log::Transaction_payload_event(NULL, payload_size,
+                                            compression_type,
+                                            uncompressed_size),
+      Log_event(thd_arg, 0, Log_event::EVENT_TRANSACTIONAL_CACHE,
+                Log_event::EVENT_NORMAL_LOGGING, header(), footer()),
+      m_payload_cache(payload),
+      m_mts_dbs(0),
+      m_events(NULL),
+      m_next_event_offset(0) {
+  is_valid_param = true;
+}
+#endif
+
+Transaction_payload_log_event::Transaction_payload_log_event(
+    const char *buffer, uint event_len,
+    const Format_description_event *descr_event)
+    : binary_log::Transaction_payload_event(buffer, event_len, descr_event),
+      Log_event(header(), footer()),
+#ifdef MYSQL_SERVER
+      m_payload_cache(NULL),
+      m_mts_dbs(0),
+#endif
+      m_events(NULL),
+      m_next_event_offset(0) {
+  if (m_payload != NULL) is_valid_param = true;
+}
+
+Transaction_payload_log_event::~Transaction_payload_log_event() {
+  my_free(m_events);
+}
+
+size_t Transaction_payload_log_event::to_string(char *buf, ulong len) const {
+  const char *name = get_compression_type_name(m_compression_type);
+  return snprintf(buf, len,
+                  "compression='%s', payload_size=%llu, "
+                  "uncompressed_size=%llu",
+                  name ? name : "UNKNOWN", (ulonglong)m_payload_size,
+                  (ulonglong)m_uncompressed_size);
+}
+
+bool Transaction_payload_log_event::uncompress_events(const char **error) {
+  DBUG_ENTER("Transaction_payload_log_event::uncompress_events");
+  my_free(m_events);
+  m_next_event_offset = 0;
+  if (m_uncompressed_size > MAX_UNCOMPRESSED_SIZE ||
+      !(m_events = (uchar *)my_malloc(key_memory_log_event,
+                                      m_uncompressed_size + 1, MYF(MY_WME)))) {
+    m_events = NULL;
+    *error = "Could not allocate the events of a Transaction_payload";
+    DBUG_RETURN(true);
+  }
+  if (uncompress(m_events)) {
+    my_free(m_events);
+    m_events = NULL;
+    *error = "Could not decompress the events of a Transaction_payload";
+    DBUG_RETURN(true);
+  }
+  DBUG_RETURN(false);
+}
+
+Log_event *Transaction_payload_log_event::next_event(
+    const Format_description_log_event *fde, const char **error) {
+  DBUG_ENTER("Transaction_payload_log_event::next_event");
+  DBUG_ASSERT(m_events != NULL);
+  if (m_next_event_offset == m_uncompressed_size) DBUG_RETURN(NULL);
+
+  const uchar *event = m_events + m_next_event_offset;
+  size_t remaining = m_uncompressed_size - m_next_event_offset;
+  uint32 event_len =
+      remaining < LOG_EVENT_MINIMAL_HEADER_LEN
+          ? 0
+          : uint4korr(event + EVENT_LEN_OFFSET);
+  if (event_len < LOG_EVENT_MINIMAL_HEADER_LEN || event_len > remaining) {
+    *error = "Truncated event in a Transaction_payload";
+    DBUG_RETURN(NULL);
+  }
+  m_next_event_offset += event_len;
+
+  /*
+    Give the event the end_log_pos of the payload, and the checksum the
+    Format_description_log_event says the events of the log have.
+  */
+  bool checksum = fde->common_footer->checksum_alg ==
+                  binary_log::BINLOG_CHECKSUM_ALG_CRC32;
+  uint buf_len = event_len + (checksum ? BINLOG_CHECKSUM_LEN : 0);
+  char *buf = (char *)my_malloc(key_memory_log_event, buf_len, MYF(MY_WME));
+  if (buf == NULL) {
+    *error = "Out of memory reading the events of a Transaction_payload";
+    DBUG_RETURN(NULL);
+  }
+  memcpy(buf, event, event_len);
+  int4store(buf + LOG_POS_OFFSET, common_header->log_pos);
+  if (checksum) {
+    int4store(buf + EVENT_LEN_OFFSET, buf_len);
+    ha_checksum crc = checksum_crc32(0L, NULL, 0);
+    crc = checksum_crc32(crc, (uchar *)buf, event_len);
+    int4store(buf + event_len, crc);
+  }
+
+  Log_event *ev = Log_event::read_log_event(buf, buf_len, error, fde, false);
+  if (ev == NULL) {
+    my_free(buf);
+    if (*error == NULL)
+      *error = "Could not read an event of a Transaction_payload";
+    DBUG_RETURN(NULL);
+  }
+  ev->register_temp_buf(buf);
+  DBUG_RETURN(ev);
+}
+
+#ifdef MYSQL_SERVER
+int Transaction_payload_log_event::pack_info(Protocol *protocol) {
+  DBUG_ENTER("Transaction_payload_log_event::pack_info");
+  char buf[256];
+  size_t bytes = to_string(buf, sizeof(buf));
+  protocol->store(buf, bytes, &my_charset_bin);
+  DBUG_RETURN(0);
+}
+#endif
+
+#ifndef MYSQL_SERVER
+void Transaction_payload_log_event::print(FILE *,
+                                          PRINT_EVENT_INFO *print_event_info) {
+  DBUG_ENTER("Transaction_payload_log_event::print");
+  char buf[256];
+  IO_CACHE *const head = &print_event_info->head_cache;
+
+  if (!print_event_info->short_form) {
+    to_string(buf, sizeof(buf));
+    print_header(head, print_event_info, false);
+    my_b_printf(head, "\tTransaction_payload\t%s\n", buf);
+  }
+  DBUG_VOID_RETURN;
+}
+#endif
+
+#if defined(MYSQL_SERVER)
+
+uint8 Transaction_payload_log_event::get_mts_dbs(Mts_db_names *arg,
+                                                 Rpl_filter *rpl_filter) {
+  DBUG_ENTER("Transaction_payload_log_event::get_mts_dbs");
+  const char *error = NULL;
+  /* The coordinator, or the worker retrying the transaction */
+  const Format_description_log_event *fde =
+      worker != NULL ? worker->get_rli_description_event() : NULL;
+  Log_event *ev;
+  m_mts_dbs = 0;
+
+  if (fde == NULL || uncompress_events(&error))
+    m_mts_dbs = OVER_MAX_DBS_IN_EVENT_MTS;
+  while (m_mts_dbs != OVER_MAX_DBS_IN_EVENT_MTS &&
+         (ev = next_event(fde, &error)) != NULL) {
+    Mts_db_names ev_dbs;
+    if (!ev->contains_partition_info(false)) {
+      /* Rows, BEGIN and Xid events have the databases of others. */
+    } else if (ev->get_mts_dbs(&ev_dbs, rpl_filter) ==
+               OVER_MAX_DBS_IN_EVENT_MTS)
+      m_mts_dbs = OVER_MAX_DBS_IN_EVENT_MTS;
+    else {
+      for (int i = 0; i < ev_dbs.num && m_mts_dbs != OVER_MAX_DBS_IN_EVENT_MTS;
+           i++) {
+        int k = 0;
+        while (k < m_mts_dbs && strcmp(m_mts_db_names[k], ev_dbs.name[i]))
+          k++;
+        if (k < m_mts_dbs) continue;
+        if (m_mts_dbs == MAX_DBS_IN_EVENT_MTS)
+          m_mts_dbs = OVER_MAX_DBS_IN_EVENT_MTS;
+        else
+          strmake(m_mts_db_names[m_mts_dbs++], ev_dbs.name[i], NAME_LEN - 1);
+      }
+    }
+    delete ev;
+  }
+  my_free(m_events);
+  m_events = NULL;
+
+  /* A payload which can not be read is applied sequentially. */
+  if (error != NULL || m_mts_dbs == 0) m_mts_dbs = OVER_MAX_DBS_IN_EVENT_MTS;
+
+  if (m_mts_dbs == OVER_MAX_DBS_IN_EVENT_MTS)
+    arg->name[0] = "";
+  else
+    for (int i = 0; i < m_mts_dbs; i++) arg->name[i] = m_mts_db_names[i];
+  DBUG_RETURN(arg->num = m_mts_dbs);
+}
+
+/**
+  Apply the events of the payload, one after the other, the way the
+  applier would have applied them if they had been in the relay log
+  themselves. They have the positions of the payload, so the event
+  that commits the transaction stores the position after the payload.
+
+  The applier thread gives each event to apply_event_and_update_pos(),
+  so that it is skipped or applied like any event of the relay log.
+  A worker gives them to Slave_worker::slave_worker_exec_event().
+
+  @param rli  the applier, or the worker applying the transaction
+  @param w    the worker, or NULL if not applying in parallel
+
+  @return 0 on success, non-zero on error
+*/
+int Transaction_payload_log_event::apply_payload(Relay_log_info const *rli,
+                                                 Slave_worker *w) {
+  DBUG_ENTER("Transaction_payload_log_event::apply_payload");
+  const char *error = NULL;
+  int res = 0;
+
+  if (!uncompress_events(&error)) {
+    const Format_description_log_event *fde =
+        rli->get_rli_description_event();
+    Log_event *ev;
+    while (res == 0 && (ev = next_event(fde, &error)) != NULL) {
+      ev->future_event_relay_log_pos = future_event_relay_log_pos;
+      ev->mts_group_idx = mts_group_idx;
+      if (w != NULL) {
+        /*
+          The worker has already claimed the databases of the payload
+          for the transaction.
+        */
+        for (int i = 0; i < MAX_DBS_IN_EVENT_MTS; i++)
+          ev->mts_assigned_partitions[i] = mts_assigned_partitions[0];
+        res = w->slave_worker_exec_event(ev);
+      } else {
+        Relay_log_info *applier = const_cast<Relay_log_info *>(rli);
+        /* apply_event_and_update_pos() releases the lock. */
+        mysql_mutex_lock(&applier->data_lock);
+        res = apply_event_and_update_pos(&ev, thd, applier);
+      }
+      /* A Rows_query_log_event is freed at the end of the statement. */
+      if (ev != NULL && ev->get_type_code() != binary_log::ROWS_QUERY_LOG_EVENT)
+        delete ev;
+    }
+  }
+  my_free(m_events);
+  m_events = NULL;
+
+  if (error != NULL) {
+    rli->report(ERROR_LEVEL, ER_SLAVE_CORRUPT_EVENT,
+                "Could not apply a Transaction_payload event: %s", error);
+    res = 1;
+  }
+  DBUG_RETURN(res);
+}
+
+int Transaction_payload_log_event::do_apply_event(Relay_log_info const *rli) {
+  return apply_payload(rli, NULL);
+}
+
+int Transaction_payload_log_event::do_apply_event_worker(Slave_worker *w) {
+  return apply_payload(w, w);
+}
+
+Log_event::enum_skip_reason Transaction_payload_log_event::do_shall_skip(
+    Relay_log_info *rli) {
+  /*
+    sql_slave_skip_counter counts the events in the payload, which are
+    skipped one by one when the payload is applied.
+  */
+  enum_skip_reason reason = Log_event::do_shall_skip(rli);
+  return reason == EVENT_SKIP_COUNT ? EVENT_SKIP_NOT : reason;
+}
+
+bool Transaction_payload_log_event::write_data_body(IO_CACHE *file) {
+  DBUG_ENTER("Transaction_payload_log_event::write_data_body");
+  uchar buf[PAYLOAD_INFO_LEN];
+
+  buf[COMPRESSION_TYPE_OFFSET] = m_compression_type;
+  int8store(buf + UNCOMPRESSED_SIZE_OFFSET, m_uncompressed_size);
+  if (wrapper_my_b_safe_write(file, buf, sizeof(buf)) ||
+      reinit_io_cache(m_payload_cache, READ_CACHE, 0, 0, 0))
+    DBUG_RETURN(true);
+
+  size_t length = my_b_bytes_in_cache(m_payload_cache);
+  do {
+    if (wrapper_my_b_safe_write(file, m_payload_cache->read_pos, length))
+      DBUG_RETURN(true);
+    m_payload_cache->read_pos = m_payload_cache->read_end;
+  } while ((length = my_b_fill(m_payload_cache)));
+  DBUG_RETURN(m_payload_cache->error == -1);
+}
+
+#endif  // MYSQL_SERVER
+
 #ifndef MYSQL_SERVER
 /**
   The default values for these variables should be values that are
@@ -4185,6 +4185,137 @@ class View_change_log_event : public binary_log::View_change_event,
   rpl_gno get_seq_number() { return seq_number; }
 };
 
+/**
+  @class Transaction_payload_log_event
+
+  This is the subclass of Transaction_payload_event and Log_event. It
+  replaces the events of a transaction in the binary log, when
+  binlog_transaction_compression is enabled.
+
+  The events in the payload are read with uncompress_events() and
+  next_event(). They are returned the way they would have been written
+  to the binary log: with the end_log_pos of this event, and with a
+  checksum if the binary log has them. So they can be applied and
+  printed the same way as events read from the log.
+
+  @internal
+  The inheritance structure is as follows
+
+        Binary_log_event
+               ^
+               |
+               |
+B_l:   Transaction_payload_event      Log_event
+                \                        /
+                 \                      /
+                  \                    /
+                   \                  /
+              Transaction_payload_log_event
+
+  B_l: Namespace Binary_log
+  @endinternal
+*/
+
+class Transaction_payload_log_event
+    : public binary_log::Transaction_payload_event,
+      public Log_event {
+ public:
+#ifdef MYSQL_SERVER
+  /**
+    @param thd                the thread committing the transaction
+    @param payload            the cache holding the compressed events,
+                              which is read when the event is written
+    @param payload_size       size of the compressed events
+    @param compression_type   how the events are compressed
+    @param uncompressed_size  size of the events before compression
+  */
+  Transaction_payload_log_event(THD *thd, IO_CACHE *payload,
+                                uint64 payload_size, uint8 compression_type,
+                                uint64 uncompressed_size);
+#endif
+
+  Transaction_payload_log_event(const char *buffer, uint event_len,
+                                const Format_description_event *descr_event);
+
+  virtual ~Transaction_payload_log_event();
+
+  size_t get_data_size() override { return PAYLOAD_INFO_LEN + m_payload_size; }
+
+  /**
+    Decompress the payload, so that its events can be read.
+
+    @param[out] error  set to a message on error
+
+    @retval false  Success.
+    @retval true   The payload could not be decompressed.
+  */
+  bool uncompress_events(const char **error);
+
+  /**
+    Read the next event of the payload.
+
+    @param fde         the Format_description_log_event of the log this
+                       event was read from
+    @param[out] error  set to a message on error, and left as it is at
+                       the end of the payload
+
+    @return the event, which the caller must delete, or NULL at the end
+            of the payload or on error
+  */
+  Log_event *next_event(const Format_description_log_event *fde,
+                        const char **error);
+
+  /// The payload holds a whole transaction.
+  bool ends_group() const override { return true; }
+
+#ifdef MYSQL_SERVER
+  int pack_info(Protocol *protocol) override;
+
+  /**
+    Decompress the payload to collect the databases its events access,
+    so that the DATABASE scheduler can apply it in parallel with the
+    transactions on other databases.
+
+    @param[out] arg   the databases, or the empty name if there are more
+                      than MAX_DBS_IN_EVENT_MTS or they are not known
+    @param rpl_filter the filter rewriting the database names
+
+    @return the number of databases, or OVER_MAX_DBS_IN_EVENT_MTS
+  */
+  uint8 get_mts_dbs(Mts_db_names *arg, Rpl_filter *rpl_filter) override;
+
+  uint8 mts_number_dbs() override { return m_mts_dbs; }
+#endif
+
+#ifndef MYSQL_SERVER
+  void print(FILE *file, PRINT_EVENT_INFO *print_event_info) override;
+#endif
+
+ private:
+  size_t to_string(char *buf, ulong len) const;
+
+#ifdef MYSQL_SERVER
+  bool write_data_body(IO_CACHE *file) override;
+
+  int do_apply_event(Relay_log_info const *rli) override;
+  int do_apply_event_worker(Slave_worker *w) override;
+  int apply_payload(Relay_log_info const *rli, Slave_worker *w);
+  enum_skip_reason do_shall_skip(Relay_log_info *rli) override;
+
+  /// The cache the compressed events are written from, or NULL
+  IO_CACHE *m_payload_cache;
+  /// The number of databases get_mts_dbs() found
+  uint8 m_mts_dbs;
+  /// The names of the databases get_mts_dbs() found
+  char m_mts_db_names[MAX_DBS_IN_EVENT_MTS][NAME_LEN];
+#endif
+
+  /// The decompressed events, or NULL
+  uchar *m_events;
+  /// Offset in m_events of the event next_event() reads
+  size_t m_next_event_offset;
+};
+
 inline bool is_gtid_event(Log_event *evt) {
   return (evt->get_type_code() == binary_log::GTID_LOG_EVENT ||
           evt->get_type_code() == binary_log::ANONYMOUS_GTID_LOG_EVENT);
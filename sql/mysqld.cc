@@ -6060,8 +6060,11 @@ int mysqld_main(int argc, char **argv)
   /* Save pid of this process in a file */
   if (!opt_initialize) create_pid_file();
 
-  /* Read the optimizer cost model configuration tables */
-  if (!opt_initialize) reload_optimizer_cost_constants();
+  /*
+    Read the optimizer cost model configuration tables, after measuring
+    the cost constants if optimizer_cost_calibration is set
+  */
+  if (!opt_initialize) calibrate_optimizer_cost_constants();
 
   bool abort = false;
   if (
@@ -8039,6 +8042,12 @@ SHOW_VAR status_vars[] = {
      SHOW_SCOPE_GLOBAL},
     {"Max_used_connections_time", (char *)&show_max_used_connections_time,
      SHOW_FUNC, SHOW_SCOPE_GLOBAL},
+    {"Mem_root_blocks_allocated",
+     (char *)offsetof(System_status_var, mem_root_blocks_allocated),
+     SHOW_LONGLONG_STATUS, SHOW_SCOPE_ALL},
+    {"Mem_root_blocks_reused",
+     (char *)offsetof(System_status_var, mem_root_blocks_reused),
+     SHOW_LONGLONG_STATUS, SHOW_SCOPE_ALL},
     {"Not_flushed_delayed_rows", (char *)&delayed_rows_in_use,
      SHOW_LONG_NOFLUSH, SHOW_SCOPE_GLOBAL},
     {"Open_files", (char *)&my_file_opened, SHOW_LONG_NOFLUSH,
@@ -8057,6 +8066,12 @@ SHOW_VAR status_vars[] = {
      SHOW_SCOPE_ALL},
     {"Prepared_stmt_count", (char *)&show_prepared_stmt_count, SHOW_FUNC,
      SHOW_SCOPE_GLOBAL},
+    {"Prepared_stmt_plan_cache_hits",
+     (char *)offsetof(System_status_var, ps_plan_cache_hits),
+     SHOW_LONGLONG_STATUS, SHOW_SCOPE_ALL},
+    {"Prepared_stmt_plan_cache_misses",
+     (char *)offsetof(System_status_var, ps_plan_cache_misses),
+     SHOW_LONGLONG_STATUS, SHOW_SCOPE_ALL},
     {"Queries", (char *)&show_queries, SHOW_FUNC, SHOW_SCOPE_ALL},
     {"Questions", (char *)offsetof(System_status_var, questions),
      SHOW_LONGLONG_STATUS, SHOW_SCOPE_ALL},
@@ -9839,7 +9854,6 @@ static PSI_mutex_info all_server_mutexes[]=
   { &key_RELAYLOG_LOCK_sync_queue, "MYSQL_RELAY_LOG::LOCK_sync_queue", 0, 0, PSI_DOCUMENT_ME},
   { &key_RELAYLOG_LOCK_xids, "MYSQL_RELAY_LOG::LOCK_xids", 0, 0, PSI_DOCUMENT_ME},
   { &key_hash_filo_lock, "hash_filo::lock", 0, 0, PSI_DOCUMENT_ME},
-  { &Gtid_set::key_gtid_executed_free_intervals_mutex, "Gtid_set::gtid_executed::free_intervals_mutex", 0, 0, PSI_DOCUMENT_ME},
   { &key_LOCK_crypt, "LOCK_crypt", PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME},
   { &key_LOCK_error_log, "LOCK_error_log", PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME},
   { &key_LOCK_global_system_variables, "LOCK_global_system_variables", PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME},
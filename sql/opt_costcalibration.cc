@@ -0,0 +1,387 @@
+/* Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "sql/opt_costcalibration.h"
+
+#include <fcntl.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "lex_string.h"
+#include "my_dbug.h"
+#include "my_io.h"
+#include "my_loglevel.h"
+#include "my_rdtsc.h"
+#include "my_sys.h"
+#include "mysql/components/services/log_builtins.h"
+#include "mysqld_error.h"
+#include "sql/field.h"
+#include "sql/handler.h"
+#include "sql/item.h"
+#include "sql/item_cmpfunc.h"
+#include "sql/opt_costconstants.h"
+#include "sql/query_options.h"  // TMP_TABLE_ALL_COLUMNS
+#include "sql/sql_class.h"
+#include "sql/sql_lex.h"
+#include "sql/sql_list.h"
+#include "sql/sql_select.h"     // count_field_types
+#include "sql/sql_tmp_table.h"  // create_tmp_table
+#include "sql/table.h"
+#include "sql/temp_table_param.h"
+
+const double Cost_calibration::MAX_FACTOR = 100.0;
+
+namespace {
+
+/// Size of the pages read by the block read benchmarks
+const size_t CALIBRATION_PAGE_SIZE = 16 * 1024;
+
+/// Alignment of the buffer for reads which bypass the file system cache
+const size_t CALIBRATION_IO_ALIGNMENT = 4096;
+
+/// Pages of the memory read benchmark, 64MB to miss the CPU caches
+const size_t MEMORY_PAGES = 4096;
+const size_t MEMORY_READS = 16384;
+
+/// Pages of the file read by the disk benchmark
+const size_t FILE_PAGES = 4096;
+const size_t FILE_READS = 512;
+
+const size_t KEY_LENGTH = 16;
+const size_t NUM_KEYS = 4096;
+const size_t KEY_COMPARES = 4 * 1024 * 1024;
+
+const uint TEMPTABLE_ROWS = 100000;
+
+/// Results of the benchmarks are added here so they are not optimized away
+volatile ulonglong calibration_sink;
+
+/**
+  Read pages of a buffer much larger than the CPU caches in random order.
+  Each read touches every cache line of the page, as scanning the records
+  of a page does.
+
+  @return nanoseconds per page, or 0 if out of memory
+*/
+double time_memory_block_read() {
+  const size_t words_per_page = CALIBRATION_PAGE_SIZE / sizeof(ulonglong);
+  const size_t words = MEMORY_PAGES * words_per_page;
+  ulonglong *buffer = static_cast<ulonglong *>(
+      my_malloc(PSI_NOT_INSTRUMENTED, words * sizeof(ulonglong), MYF(0)));
+  if (buffer == NULL) return 0.0;
+  for (size_t i = 0; i < words; i++) buffer[i] = i;
+
+  std::minstd_rand rnd;
+  ulonglong sum = 0;
+  const ulonglong start = my_timer_nanoseconds();
+  for (size_t i = 0; i < MEMORY_READS; i++) {
+    const ulonglong *page = buffer + (rnd() % MEMORY_PAGES) * words_per_page;
+    for (size_t word = 0; word < words_per_page; word += 8) sum += page[word];
+  }
+  const ulonglong end = my_timer_nanoseconds();
+
+  calibration_sink += sum;
+  my_free(buffer);
+  return static_cast<double>(end - start) / MEMORY_READS;
+}
+
+/**
+  Read pages of a new file in the given directory in random order. The
+  pages are dropped from the file system cache, and read with O_DIRECT
+  where the file system supports it. Each page is read once.
+
+  @return nanoseconds per page, or 0 if the file could not be written or
+          read
+*/
+double time_io_block_read(const char *dir) {
+  uchar *raw_buffer = static_cast<uchar *>(
+      my_malloc(PSI_NOT_INSTRUMENTED,
+                CALIBRATION_PAGE_SIZE + CALIBRATION_IO_ALIGNMENT, MYF(0)));
+  if (raw_buffer == NULL) return 0.0;
+  uchar *page = reinterpret_cast<uchar *>(
+      (reinterpret_cast<uintptr_t>(raw_buffer) + CALIBRATION_IO_ALIGNMENT -
+       1) &
+      ~static_cast<uintptr_t>(CALIBRATION_IO_ALIGNMENT - 1));
+
+  char path[FN_REFLEN];
+  const File file =
+      create_temp_file(path, dir, "#cost", O_CREAT | O_EXCL | O_RDWR, MYF(0));
+  if (file < 0) {
+    my_free(raw_buffer);
+    return 0.0;
+  }
+
+  // Pages of random bytes, so that the file system can not compress them.
+  std::minstd_rand rnd;
+  for (size_t i = 0; i < CALIBRATION_PAGE_SIZE; i++)
+    page[i] = static_cast<uchar>(rnd());
+
+  bool error = false;
+  for (size_t i = 0; i < FILE_PAGES && !error; i++) {
+    int8store(page, i);
+    error = my_pwrite(file, page, CALIBRATION_PAGE_SIZE,
+                      i * CALIBRATION_PAGE_SIZE, MYF(MY_NABP)) != 0;
+  }
+  if (!error) error = my_sync(file, MYF(0)) != 0;
+
+  double result = 0.0;
+  if (!error) {
+#ifdef POSIX_FADV_DONTNEED
+    posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+#if defined(O_DIRECT) && defined(F_SETFL)
+    // Not all file systems support O_DIRECT; the reads are then buffered.
+    fcntl(file, F_SETFL, fcntl(file, F_GETFL) | O_DIRECT);
+#endif
+
+    std::vector<size_t> pages(FILE_PAGES);
+    for (size_t i = 0; i < FILE_PAGES; i++) pages[i] = i;
+    std::shuffle(pages.begin(), pages.end(), rnd);
+
+    size_t reads = 0;
+    const ulonglong start = my_timer_nanoseconds();
+    for (; reads < FILE_READS; reads++) {
+      if (my_pread(file, page, CALIBRATION_PAGE_SIZE,
+                   pages[reads] * CALIBRATION_PAGE_SIZE, MYF(MY_NABP)))
+        break;
+    }
+    const ulonglong end = my_timer_nanoseconds();
+    if (reads == FILE_READS)
+      result = static_cast<double>(end - start) / FILE_READS;
+  }
+
+  my_close(file, MYF(0));
+  my_delete(path, MYF(0));
+  my_free(raw_buffer);
+  return result;
+}
+
+/**
+  Compare keys of an array in a scattered order. The keys share a prefix,
+  so that comparisons do not stop at the first byte.
+
+  @return nanoseconds per comparison
+*/
+double time_key_compare() {
+  std::vector<uchar> keys(NUM_KEYS * KEY_LENGTH);
+  std::minstd_rand rnd;
+  for (size_t i = 0; i < keys.size(); i++)
+    keys[i] = i % KEY_LENGTH < KEY_LENGTH / 2 ? 'k' : static_cast<uchar>(rnd());
+
+  const uchar *base = keys.data();
+  const size_t key_length = keys.size() / NUM_KEYS;
+  ulonglong less = 0;
+  const ulonglong start = my_timer_nanoseconds();
+  for (size_t i = 0; i < KEY_COMPARES; i++) {
+    const uchar *a = base + (i % NUM_KEYS) * key_length;
+    const uchar *b = base + ((i * 7 + 3) % NUM_KEYS) * key_length;
+    less += memcmp(a, b, key_length) < 0;
+  }
+  const ulonglong end = my_timer_nanoseconds();
+
+  calibration_sink += less;
+  return static_cast<double>(end - start) / KEY_COMPARES;
+}
+
+/**
+  Write rows of two integer columns to an in-memory temporary table, then
+  scan the table and evaluate a condition on each row.
+
+  @param       thd            the THD
+  @param[out]  write_time     nanoseconds per row written, if measured
+  @param[out]  evaluate_time  nanoseconds per row read and evaluated, if
+                              measured
+*/
+void time_temptable_rows(THD *thd, double *write_time,
+                         double *evaluate_time) {
+  List<Item> items;
+  Item *item_a = new (thd->mem_root) Item_int(0);
+  Item *item_b = new (thd->mem_root) Item_int(0);
+  if (item_a == NULL || item_b == NULL || items.push_back(item_a) ||
+      items.push_back(item_b))
+    return;
+
+  Temp_table_param param;
+  count_field_types(thd->lex->current_select(), &param, items, false, false);
+  TABLE *table =
+      create_tmp_table(thd, &param, items, NULL, false, false,
+                       TMP_TABLE_ALL_COLUMNS, HA_POS_ERROR, "calibration");
+  if (table == NULL) return;
+
+  Field *a = table->field[0];
+  Field *b = table->field[1];
+  uint rows = 0;
+  ulonglong start = my_timer_nanoseconds();
+  for (; rows < TEMPTABLE_ROWS; rows++) {
+    a->store(rows, true);
+    b->store(rows % 100, true);
+    if (table->file->ha_write_row(table->record[0])) break;
+  }
+  ulonglong end = my_timer_nanoseconds();
+
+  if (rows == TEMPTABLE_ROWS) {
+    *write_time = static_cast<double>(end - start) / rows;
+
+    // a > rows / 2 AND b < 50
+    const longlong middle = rows / 2;
+    Item *cond = new (thd->mem_root) Item_cond_and(
+        new (thd->mem_root) Item_func_gt(new (thd->mem_root) Item_field(a),
+                                         new (thd->mem_root) Item_int(middle)),
+        new (thd->mem_root) Item_func_lt(new (thd->mem_root) Item_field(b),
+                                         new (thd->mem_root) Item_int(50)));
+    if (cond != NULL && !thd->is_error() && !cond->fix_fields(thd, &cond) &&
+        !table->file->ha_rnd_init(true)) {
+      uint read = 0;
+      ulonglong matched = 0;
+      start = my_timer_nanoseconds();
+      while (!table->file->ha_rnd_next(table->record[0])) {
+        read++;
+        if (cond->val_int()) matched++;
+      }
+      end = my_timer_nanoseconds();
+      table->file->ha_rnd_end();
+
+      calibration_sink += matched;
+      if (read == rows)
+        *evaluate_time = static_cast<double>(end - start) / rows;
+    }
+  }
+
+  free_tmp_table(thd, table);
+  param.cleanup();
+}
+
+}  // namespace
+
+void Cost_calibration::measure(THD *thd, const char *dir) {
+  DBUG_ENTER("Cost_calibration::measure");
+
+  for (int i = 0; i < NUM_CONSTANTS; i++) m_time[i] = 0.0;
+
+  time_temptable_rows(thd, &m_time[MEMORY_TEMPTABLE_ROW],
+                      &m_time[ROW_EVALUATE]);
+  // The cost constant tables are read with this THD next.
+  thd->clear_error();
+  m_time[KEY_COMPARE] = time_key_compare();
+  m_time[MEMORY_BLOCK_READ] = time_memory_block_read();
+  m_time[IO_BLOCK_READ] = time_io_block_read(dir);
+
+  for (int i = 0; i < NUM_CONSTANTS; i++) {
+    if (m_time[i] <= 0.0)
+      LogErr(WARNING_LEVEL, ER_OPTIMIZER_COST_CALIBRATION_FAILED,
+             name(static_cast<Constant>(i)));
+  }
+  LogErr(INFORMATION_LEVEL, ER_OPTIMIZER_COST_CALIBRATED, value(ROW_EVALUATE),
+         value(KEY_COMPARE), value(MEMORY_TEMPTABLE_ROW),
+         value(MEMORY_BLOCK_READ), value(IO_BLOCK_READ));
+
+  DBUG_VOID_RETURN;
+}
+
+bool Cost_calibration::is_measured() const {
+  for (int i = 0; i < NUM_CONSTANTS; i++)
+    if (m_time[i] > 0.0) return true;
+  return false;
+}
+
+double Cost_calibration::value(Constant constant) const {
+  if (m_time[constant] <= 0.0) return 0.0;
+
+  /*
+    The unit is the one for which the mean of the logarithms of the ratios
+    between the calibrated and the default values is 0.
+  */
+  double log_scale = 0.0;
+  int measured = 0;
+  for (int i = 0; i < NUM_CONSTANTS; i++) {
+    if (m_time[i] <= 0.0) continue;
+    log_scale += log(default_value(static_cast<Constant>(i)) / m_time[i]);
+    measured++;
+  }
+  const double value = exp(log_scale / measured) * m_time[constant];
+
+  const double default_val = default_value(constant);
+  return std::min(std::max(value, default_val / MAX_FACTOR),
+                  default_val * MAX_FACTOR);
+}
+
+void Cost_calibration::apply(THD *thd,
+                             Cost_model_constants *cost_constants) const {
+  const LEX_CSTRING default_engine = {STRING_WITH_LEN("default")};
+
+  for (int i = 0; i < NUM_CONSTANTS; i++) {
+    const Constant constant = static_cast<Constant>(i);
+    const double calibrated = value(constant);
+    if (calibrated <= 0.0) continue;
+
+    const LEX_CSTRING cost_name = {name(constant), strlen(name(constant))};
+    cost_constant_error err;
+    if (constant == MEMORY_BLOCK_READ || constant == IO_BLOCK_READ)
+      err = cost_constants->update_engine_cost_constant(thd, default_engine, 0,
+                                                        cost_name, calibrated);
+    else
+      err = cost_constants->update_server_cost_constant(cost_name, calibrated);
+    DBUG_ASSERT(err == COST_CONSTANT_OK);
+    (void)err;
+  }
+}
+
+const char *Cost_calibration::name(Constant constant) {
+  switch (constant) {
+    case ROW_EVALUATE:
+      return "row_evaluate_cost";
+    case KEY_COMPARE:
+      return "key_compare_cost";
+    case MEMORY_TEMPTABLE_ROW:
+      return "memory_temptable_row_cost";
+    case MEMORY_BLOCK_READ:
+      return "memory_block_read_cost";
+    case IO_BLOCK_READ:
+      return "io_block_read_cost";
+    default:
+      DBUG_ASSERT(false); /* purecov: inspected */
+      return "";
+  }
+}
+
+double Cost_calibration::default_value(Constant constant) {
+  const Server_cost_constants server_defaults;
+  const SE_cost_constants engine_defaults;
+  switch (constant) {
+    case ROW_EVALUATE:
+      return server_defaults.row_evaluate_cost();
+    case KEY_COMPARE:
+      return server_defaults.key_compare_cost();
+    case MEMORY_TEMPTABLE_ROW:
+      return server_defaults.memory_temptable_row_cost();
+    case MEMORY_BLOCK_READ:
+      return engine_defaults.memory_block_read_cost();
+    case IO_BLOCK_READ:
+      return engine_defaults.io_block_read_cost();
+    default:
+      DBUG_ASSERT(false); /* purecov: inspected */
+      return 1.0;
+  }
+}
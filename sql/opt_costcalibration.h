@@ -0,0 +1,106 @@
+#ifndef OPT_COSTCALIBRATION_INCLUDED
+#define OPT_COSTCALIBRATION_INCLUDED
+
+/* Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/**
+  @file sql/opt_costcalibration.h
+
+  Measuring the cost constants of the optimizer on the running server.
+
+  Micro-benchmarks time the operations which the cost constants stand for:
+  evaluating a condition on a row, comparing keys, writing a row to an
+  in-memory temporary table, and reading a page from memory and from disk.
+
+  Cost constants are in arbitrary units, so the timings only give their
+  ratios. The unit is chosen to fit the default values as closely as
+  possible: the geometric mean of the ratios between the calibrated and
+  the default values is 1. The constants which are not measured keep
+  their defaults, and stay on the same scale as the calibrated ones.
+*/
+
+class Cost_model_constants;
+class THD;
+
+class Cost_calibration {
+ public:
+  /// The cost constants which are measured.
+  enum Constant {
+    ROW_EVALUATE,
+    KEY_COMPARE,
+    MEMORY_TEMPTABLE_ROW,
+    MEMORY_BLOCK_READ,
+    IO_BLOCK_READ,
+    NUM_CONSTANTS
+  };
+
+  /**
+    A calibrated value never differs from the default by more than this
+    factor, which limits the effect of a disturbed measurement.
+  */
+  static const double MAX_FACTOR;
+
+  Cost_calibration() {
+    for (int i = 0; i < NUM_CONSTANTS; i++) m_time[i] = 0.0;
+  }
+
+  /**
+    Run the benchmarks. The timings which can not be measured are left 0,
+    and are logged as a warning.
+
+    @param thd  the THD, which must not have any tables open
+    @param dir  directory of the file read by the disk benchmark
+  */
+  void measure(THD *thd, const char *dir);
+
+  /// @return true if any timing has been measured
+  bool is_measured() const;
+
+  /// Set the time of an operation, in nanoseconds, or 0 if unknown.
+  void set_time(Constant constant, double time) { m_time[constant] = time; }
+
+  /// @return the time of an operation, in nanoseconds, or 0 if unknown
+  double time(Constant constant) const { return m_time[constant]; }
+
+  /// @return the calibrated value of a cost constant, or 0 if not measured
+  double value(Constant constant) const;
+
+  /**
+    Set the calibrated cost constants. The storage engine constants are
+    set like the ones of the "default" engine in mysql.engine_cost, so
+    they do not change the constants an engine provides itself.
+  */
+  void apply(THD *thd, Cost_model_constants *cost_constants) const;
+
+  /// @return the name of a cost constant in the cost tables
+  static const char *name(Constant constant);
+
+  /// @return the default value of a cost constant
+  static double default_value(Constant constant);
+
+ private:
+  /// Time of each operation in nanoseconds, 0 if not measured
+  double m_time[NUM_CONSTANTS];
+};
+
+#endif  // OPT_COSTCALIBRATION_INCLUDED
@@ -33,7 +33,7 @@
 #include "sql/current_thd.h"  // current_thd
 #include "sql/field.h"        // Field
 #include "sql/log.h"
-#include "sql/mysqld.h"     // key_LOCK_cost_const
+#include "sql/mysqld.h"     // key_LOCK_cost_const, mysql_real_data_home
 #include "sql/records.h"    // READ_RECORD
 #include "sql/sql_base.h"   // open_and_lock_tables
 #include "sql/sql_class.h"  // THD
@@ -49,7 +49,10 @@
 
 Cost_constant_cache *cost_constant_cache = NULL;
 
-static void read_cost_constants(Cost_model_constants *cost_constants);
+bool opt_optimizer_cost_calibration = false;
+
+static void read_cost_constants(Cost_model_constants *cost_constants,
+                                Cost_calibration *calibration, bool measure);
 
 /**
   Minimal initialization of the object. The main initialization is done
@@ -108,15 +111,31 @@ void Cost_constant_cache::close() {
   DBUG_VOID_RETURN;
 }
 
-void Cost_constant_cache::reload() {
+void Cost_constant_cache::reload(bool calibrate) {
   DBUG_ENTER("Cost_constant_cache::reload");
   DBUG_ASSERT(m_inited = true);
 
   // Create cost constants from the constants defined in the source code
   Cost_model_constants *cost_constants = create_defaults();
 
-  // Update the cost constants from the database tables
-  read_cost_constants(cost_constants);
+  Cost_calibration calibration;
+  bool use_calibration = false;
+  if (opt_optimizer_cost_calibration) {
+    mysql_mutex_lock(&LOCK_cost_const);
+    calibration = m_calibration;
+    mysql_mutex_unlock(&LOCK_cost_const);
+    use_calibration = calibrate || calibration.is_measured();
+  }
+
+  // Update the cost constants from the calibration and the database tables
+  read_cost_constants(cost_constants, use_calibration ? &calibration : NULL,
+                      use_calibration && calibrate);
+
+  if (use_calibration && calibrate) {
+    mysql_mutex_lock(&LOCK_cost_const);
+    m_calibration = calibration;
+    mysql_mutex_unlock(&LOCK_cost_const);
+  }
 
   // Set this to be the current set of cost constants
   update_current_cost_constants(cost_constants);
@@ -384,9 +403,13 @@ static void read_engine_cost_constants(THD *thd, TABLE *table,
   calling this function.
 
   @param cost_constants set with cost constants
+  @param calibration    calibration which replaces the default values, or
+                        NULL
+  @param measure        run the calibration benchmarks first
 */
 
-static void read_cost_constants(Cost_model_constants *cost_constants) {
+static void read_cost_constants(Cost_model_constants *cost_constants,
+                                Cost_calibration *calibration, bool measure) {
   DBUG_ENTER("read_cost_constants");
 
   /*
@@ -412,6 +435,11 @@ static void read_cost_constants(Cost_model_constants *cost_constants) {
   tables[0].next_global = tables[0].next_local =
       tables[0].next_name_resolution_table = &tables[1];
 
+  if (calibration != NULL) {
+    if (measure) calibration->measure(thd, mysql_real_data_home);
+    calibration->apply(thd, cost_constants);
+  }
+
   if (!open_and_lock_tables(thd, tables, MYSQL_LOCK_IGNORE_TIMEOUT)) {
     DBUG_ASSERT(tables[0].table != NULL);
     DBUG_ASSERT(tables[1].table != NULL);
@@ -457,5 +485,9 @@ void delete_optimizer_cost_module() {
 }
 
 void reload_optimizer_cost_constants() {
-  if (cost_constant_cache) cost_constant_cache->reload();
+  if (cost_constant_cache) cost_constant_cache->reload(false);
+}
+
+void calibrate_optimizer_cost_constants() {
+  if (cost_constant_cache) cost_constant_cache->reload(true);
 }
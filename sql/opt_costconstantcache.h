@@ -29,7 +29,14 @@
 #include "my_dbug.h"
 #include "mysql/components/services/mysql_mutex_bits.h"
 #include "mysql/psi/mysql_mutex.h"
-#include "sql/opt_costconstants.h"  // Cost_model_constants
+#include "sql/opt_costcalibration.h"  // Cost_calibration
+#include "sql/opt_costconstants.h"    // Cost_model_constants
+
+/**
+  Whether the cost constants measured by Cost_calibration replace the
+  default values.
+*/
+extern bool opt_optimizer_cost_calibration;
 
 /**
   This class implements a cache for "cost constant sets". This cache
@@ -90,9 +97,16 @@ class Cost_constant_cache {
 
   /**
     Reload all cost constants from the configuration tables.
+
+    When opt_optimizer_cost_calibration is set, the calibrated values
+    replace the defaults before the tables are read, so values set in the
+    tables take precedence.
+
+    @param calibrate  run the calibration benchmarks first; otherwise the
+                      result of the last calibration is used
   */
 
-  void reload();
+  void reload(bool calibrate);
 
   /**
     Get the currently used set of cost constants.
@@ -184,6 +198,11 @@ class Cost_constant_cache {
   */
   mysql_mutex_t LOCK_cost_const;
 
+  /**
+    Result of the last calibration. Protected by LOCK_cost_const.
+  */
+  Cost_calibration m_calibration;
+
   bool m_inited;
 };
 
@@ -210,4 +229,13 @@ void delete_optimizer_cost_module();
 */
 void reload_optimizer_cost_constants();
 
+/**
+  Measures the optimizer cost constants on this server if
+  opt_optimizer_cost_calibration is set, and reloads them.
+
+  @note Like reload_optimizer_cost_constants(), this function uses its
+  own temporary THD.
+*/
+void calibrate_optimizer_cost_constants();
+
 #endif /* OPT_COSTCONSTANTCACHE_INCLUDED */
@@ -10357,9 +10357,13 @@ int QUICK_INDEX_MERGE_SELECT::read_keys_and_merge() {
     DBUG_EXECUTE_IF("only_one_Unique_may_be_created",
                     DBUG_SET("+d,index_merge_may_not_create_a_Unique"););
 
+    /*
+      A row always gets the same row id, so duplicates are equal byte by
+      byte and can be removed with a hash set.
+    */
     unique = new (*THR_MALLOC)
         Unique(refpos_order_cmp, (void *)file, file->ref_length,
-               thd->variables.sortbuff_size);
+               thd->variables.sortbuff_size, true);
   } else {
     unique->reset();
     head->unique_result.sorted_result.reset();
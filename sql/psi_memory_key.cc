@@ -48,6 +48,7 @@ PSI_memory_key key_memory_Geometry_objects_data;
 PSI_memory_key key_memory_Gis_read_stream_err_msg;
 PSI_memory_key key_memory_Gtid_state_to_string;
 PSI_memory_key key_memory_HASH_ROW_ENTRY;
+PSI_memory_key key_memory_Hash_group_table;
 PSI_memory_key key_memory_JOIN_CACHE;
 PSI_memory_key key_memory_JSON;
 PSI_memory_key key_memory_LOG_POS_COORD;
@@ -101,6 +102,7 @@ PSI_memory_key key_memory_acl_memex;
 PSI_memory_key key_memory_acl_cache;
 PSI_memory_key key_memory_acl_map_cache;
 PSI_memory_key key_memory_binlog_cache_mngr;
+PSI_memory_key key_memory_binlog_compression_buffer;
 PSI_memory_key key_memory_binlog_pos;
 PSI_memory_key key_memory_binlog_recover_exec;
 PSI_memory_key key_memory_binlog_statement_buffer;
@@ -332,10 +334,13 @@ static PSI_memory_info all_server_memory[] = {
     {&key_memory_HASH_ROW_ENTRY, "HASH_ROW_ENTRY", 0, 0, PSI_DOCUMENT_ME},
     {&key_memory_binlog_statement_buffer, "binlog_statement_buffer", 0, 0,
      PSI_DOCUMENT_ME},
+    {&key_memory_binlog_compression_buffer, "binlog_compression_buffer", 0,
+     0, PSI_DOCUMENT_ME},
     {&key_memory_partition_syntax_buffer, "partition_syntax_buffer", 0, 0,
      PSI_DOCUMENT_ME},
     {&key_memory_READ_INFO, "READ_INFO", 0, 0, PSI_DOCUMENT_ME},
     {&key_memory_JOIN_CACHE, "JOIN_CACHE", 0, 0, PSI_DOCUMENT_ME},
+    {&key_memory_Hash_group_table, "Hash_group_table", 0, 0, PSI_DOCUMENT_ME},
     {&key_memory_TABLE_sort_io_cache, "TABLE::sort_io_cache", 0, 0,
      PSI_DOCUMENT_ME},
     {&key_memory_DD_column_statistics, "dd::column_statistics", 0, 0,
@@ -1185,7 +1185,7 @@ class Gtid_monitoring_info {
   Represents a set of GTIDs.
 
   This is structured as an array, indexed by SIDNO, where each element
-  contains a linked list of intervals.
+  contains a sorted array of intervals.
 
   This data structure OPTIONALLY knows of a Sid_map that gives a
   correspondence between SIDNO and SID.  If the Sid_map is NULL, then
@@ -1204,7 +1204,6 @@ class Gtid_monitoring_info {
 */
 class Gtid_set {
  public:
-  static PSI_mutex_key key_gtid_executed_free_intervals_mutex;
   /**
     Constructs a new, empty Gtid_set.
 
@@ -1266,9 +1265,7 @@ class Gtid_set {
   */
   void _add_gtid(rpl_sidno sidno, rpl_gno gno) {
     DBUG_ENTER("Gtid_set::_add_gtid(sidno, gno)");
-    Interval_iterator ivit(this, sidno);
-    Free_intervals_lock lock(this);
-    add_gno_interval(&ivit, gno, gno + 1, &lock);
+    add_gno_interval(sidno, gno, gno + 1);
     DBUG_VOID_RETURN;
   }
   /**
@@ -1279,11 +1276,7 @@ class Gtid_set {
   */
   void _remove_gtid(rpl_sidno sidno, rpl_gno gno) {
     DBUG_ENTER("Gtid_set::_remove_gtid(rpl_sidno, rpl_gno)");
-    if (sidno <= get_max_sidno()) {
-      Interval_iterator ivit(this, sidno);
-      Free_intervals_lock lock(this);
-      remove_gno_interval(&ivit, gno, gno + 1, &lock);
-    }
+    if (sidno <= get_max_sidno()) remove_gno_interval(sidno, gno, gno + 1);
     DBUG_VOID_RETURN;
   }
   /**
@@ -1465,8 +1458,7 @@ class Gtid_set {
   bool contains_sidno(rpl_sidno sidno) const {
     DBUG_ASSERT(sidno >= 1);
     if (sidno > get_max_sidno()) return false;
-    Const_interval_iterator ivit(this, sidno);
-    return ivit.get() != NULL;
+    return m_intervals[sidno - 1].size != 0;
   }
   /**
     Returns true if the given string is a valid specification of a
@@ -1594,8 +1586,7 @@ class Gtid_set {
   Sid_map *get_sid_map() const { return sid_map; }
 
   /**
-    Represents one element in the linked list of intervals associated
-    with a SIDNO.
+    Represents one interval of GNOs of a SIDNO.
   */
   struct Interval {
    public:
@@ -1607,37 +1598,12 @@ class Gtid_set {
     bool equals(const Interval &other) const {
       return start == other.start && end == other.end;
     }
-    /// Pointer to next interval in list.
-    Interval *next;
   };
 
   /**
-    Provides an array of Intervals that this Gtid_set can use when
-    gtids are subsequently added.  This can be used as an
-    optimization, to reduce allocation for sets that have a known
-    number of intervals.
-
-    @param n_intervals The number of intervals to add.
-    @param intervals_param Array of n_intervals intervals.
+    Iterator over the intervals of a given SIDNO of a const Gtid_set.
   */
-  void add_interval_memory(int n_intervals, Interval *intervals_param) {
-    if (sid_lock != NULL) mysql_mutex_lock(&free_intervals_mutex);
-    add_interval_memory_lock_taken(n_intervals, intervals_param);
-    if (sid_lock != NULL) mysql_mutex_unlock(&free_intervals_mutex);
-  }
-
-  /**
-    Iterator over intervals for a given SIDNO.
-
-    This is an abstract template class, used as a common base class
-    for Const_interval_iterator and Interval_iterator.
-
-    The iterator always points to an interval pointer.  The interval
-    pointer is either the initial pointer into the list, or the next
-    pointer of one of the intervals in the list.
-  */
-  template <typename Gtid_set_p, typename Interval_p>
-  class Interval_iterator_base {
+  class Const_interval_iterator {
    public:
     /**
       Construct a new iterator over the GNO intervals for a given Gtid_set.
@@ -1645,91 +1611,33 @@ class Gtid_set {
       @param gtid_set The Gtid_set.
       @param sidno The SIDNO.
     */
-    Interval_iterator_base(Gtid_set_p gtid_set, rpl_sidno sidno) {
+    Const_interval_iterator(const Gtid_set *gtid_set, rpl_sidno sidno) {
       DBUG_ASSERT(sidno >= 1 && sidno <= gtid_set->get_max_sidno());
       init(gtid_set, sidno);
     }
-    /// Construct a new iterator over the free intervals of a Gtid_set.
-    Interval_iterator_base(Gtid_set_p gtid_set) {
-      p = const_cast<Interval_p *>(&gtid_set->free_intervals);
-    }
+    /// Construct an iterator that is past the last interval.
+    Const_interval_iterator() : m_current(NULL), m_end(NULL) {}
     /// Reset this iterator.
-    inline void init(Gtid_set_p gtid_set, rpl_sidno sidno) {
-      p = const_cast<Interval_p *>(&gtid_set->m_intervals[sidno - 1]);
+    inline void init(const Gtid_set *gtid_set, rpl_sidno sidno) {
+      const Interval_array &array = gtid_set->m_intervals[sidno - 1];
+      m_current = array.intervals;
+      m_end = array.intervals + array.size;
     }
     /// Advance current_elem one step.
     inline void next() {
-      DBUG_ASSERT(*p != NULL);
-      p = const_cast<Interval_p *>(&(*p)->next);
+      DBUG_ASSERT(m_current != m_end);
+      m_current++;
     }
-    /// Return current_elem.
-    inline Interval_p get() const { return *p; }
-
-   protected:
-    /**
-      Holds the address of the 'next' pointer of the previous element,
-      or the address of the initial pointer into the list, if the
-      current element is the first element.
-    */
-    Interval_p *p;
-  };
-
-  /**
-    Iterator over intervals of a const Gtid_set.
-  */
-  class Const_interval_iterator
-      : public Interval_iterator_base<const Gtid_set *, const Interval *> {
-   public:
-    /// Create this Const_interval_iterator.
-    Const_interval_iterator(const Gtid_set *gtid_set, rpl_sidno sidno)
-        : Interval_iterator_base<const Gtid_set *, const Interval *>(gtid_set,
-                                                                     sidno) {}
-    /// Create this Const_interval_iterator.
-    Const_interval_iterator(const Gtid_set *gtid_set)
-        : Interval_iterator_base<const Gtid_set *, const Interval *>(gtid_set) {
+    /// Return current_elem, or NULL if past the last interval.
+    inline const Interval *get() const {
+      return m_current != m_end ? m_current : NULL;
     }
-  };
-
-  /**
-    Iterator over intervals of a non-const Gtid_set, with additional
-    methods to modify the Gtid_set.
-  */
-  class Interval_iterator
-      : public Interval_iterator_base<Gtid_set *, Interval *> {
-   public:
-    /// Create this Interval_iterator.
-    Interval_iterator(Gtid_set *gtid_set, rpl_sidno sidno)
-        : Interval_iterator_base<Gtid_set *, Interval *>(gtid_set, sidno) {}
-    /// Destroy this Interval_iterator.
-    Interval_iterator(Gtid_set *gtid_set)
-        : Interval_iterator_base<Gtid_set *, Interval *>(gtid_set) {}
 
    private:
-    /**
-      Set current_elem to the given Interval but do not touch the
-      next pointer of the given Interval.
-    */
-    inline void set(Interval *iv) { *p = iv; }
-    /// Insert the given element before current_elem.
-    inline void insert(Interval *iv) {
-      iv->next = *p;
-      set(iv);
-    }
-    /// Remove current_elem.
-    inline void remove(Gtid_set *gtid_set) {
-      DBUG_ASSERT(get() != NULL);
-      Interval *next = (*p)->next;
-      gtid_set->put_free_interval(*p);
-      set(next);
-    }
-    /**
-      Only Gtid_set is allowed to use set/insert/remove.
-
-      They are not safe to use from other code because: (1) very easy
-      to make a mistakes (2) they don't clear cached_string_format or
-      cached_string_length.
-    */
-    friend class Gtid_set;
+    /// The current interval.
+    const Interval *m_current;
+    /// The position after the last interval.
+    const Interval *m_end;
   };
 
   /**
@@ -1738,7 +1646,7 @@ class Gtid_set {
   */
   class Gtid_iterator {
    public:
-    Gtid_iterator(const Gtid_set *gs) : gtid_set(gs), sidno(0), ivit(gs) {
+    Gtid_iterator(const Gtid_set *gs) : gtid_set(gs), sidno(0), ivit() {
       if (gs->sid_lock != NULL) gs->sid_lock->assert_some_wrlock();
       next_sidno();
     }
@@ -1812,17 +1720,29 @@ class Gtid_set {
 
  private:
   /**
-    Contains a list of intervals allocated by this Gtid_set.  When a
-    method of this class needs a new interval and there are no more
-    free intervals, a new Interval_chunk is allocated and the
-    intervals of it are added to the list of free intervals.
-  */
-  struct Interval_chunk {
-    Interval_chunk *next;
-    Interval intervals[1];
+    The intervals of one SIDNO, sorted on the first GNO.
+
+    The intervals are disjoint and never adjacent, so they are also
+    sorted on the last GNO, and the interval that contains a GNO can be
+    found by a binary search.  The memory is not shared with other
+    SIDNOs, so threads holding different SIDNO locks can update their
+    SIDNOs concurrently.
+  */
+  struct Interval_array {
+    /// The intervals, or NULL if nothing was allocated.
+    Interval *intervals;
+    /// The number of intervals.
+    size_t size;
+    /// The number of intervals that fit in the allocated memory.
+    size_t capacity;
   };
-  /// The default number of intervals in an Interval_chunk.
-  static const int CHUNK_GROW_SIZE = 8;
+  /// The number of intervals allocated for a SIDNO when it gets its first.
+  static const size_t INITIAL_INTERVAL_ARRAY_SIZE = 8;
+  /**
+    Sets of at most this many intervals are added or removed one
+    interval at a time, rather than by merging the two arrays.
+  */
+  static const size_t MAX_INTERVALS_ADDED_ONE_BY_ONE = 2;
 
   /**
     Return true if the given sidno of this Gtid_set contains the same
@@ -1840,13 +1760,7 @@ class Gtid_set {
 
   /// Return the number of intervals for the given sidno.
   int get_n_intervals(rpl_sidno sidno) const {
-    Const_interval_iterator ivit(this, sidno);
-    int ret = 0;
-    while (ivit.get() != NULL) {
-      ret++;
-      ivit.next();
-    }
-    return ret;
+    return static_cast<int>(m_intervals[sidno - 1].size);
   }
   /// Return the number of intervals in this Gtid_set.
   int get_n_intervals() const {
@@ -1858,161 +1772,80 @@ class Gtid_set {
     return ret;
   }
   /**
-    Allocates a new chunk of Intervals and adds them to the list of
-    unused intervals.
-
-    @param size The number of intervals in this chunk
-  */
-  void create_new_chunk(int size);
-  /**
-    Returns a fresh new Interval object.
+    Allocates memory for the given number of intervals.
 
-    This usually does not require any real allocation, it only pops
-    the first interval from the list of free intervals.  If there are
-    no free intervals, it calls create_new_chunk.
+    If the memory can not be allocated after a few tries, the server
+    is terminated, since GTIDs could otherwise be lost.
 
-    @param out The resulting Interval* will be stored here.
+    @param n_intervals The number of intervals.
+    @return The allocated memory.
   */
-  void get_free_interval(Interval **out);
+  static Interval *allocate_intervals(size_t n_intervals);
   /**
-    Puts the given interval in the list of free intervals.  Does not
-    unlink it from its place in any other list.
+    Grows the given array, if needed, so that it has room for the
+    given number of intervals.
+
+    @param array The array of intervals.
+    @param n_intervals The number of intervals it must have room for.
   */
-  void put_free_interval(Interval *iv);
+  static void reserve_intervals(Interval_array *array, size_t n_intervals);
   /**
-    Like add_interval_memory, but does not acquire
-    free_intervals_mutex.
-    @see Gtid_set::add_interval_memory
+    Returns the position of the first interval of the given array that
+    ends after the given GNO, or the size of the array if there is none.
   */
-  void add_interval_memory_lock_taken(int n_ivs, Interval *ivs);
+  static size_t find_interval(const Interval_array &array, rpl_gno gno);
 
   /// Read-write lock that protects updates to the number of SIDs.
   mutable Checkable_rwlock *sid_lock;
-  /**
-    Lock protecting the list of free intervals.  This lock is only
-    used if sid_lock is not NULL.
-  */
-  mysql_mutex_t free_intervals_mutex;
-  /**
-    Class representing a lock on free_intervals_mutex.
-
-    This is used by the add_* and remove_* functions.  The lock is
-    declared by the top-level function and a pointer to the lock is
-    passed down to low-level functions. If the low-level function
-    decides to access the free intervals list, then it acquires the
-    lock.  The lock is then automatically released by the destructor
-    when the top-level function returns.
-
-    The lock is not taken if Gtid_set->sid_lock == NULL; such
-    Gtid_sets are assumed to be thread-local.
-  */
-  class Free_intervals_lock {
-   public:
-    /// Create a new lock, but do not acquire it.
-    Free_intervals_lock(Gtid_set *_gtid_set)
-        : gtid_set(_gtid_set), locked(false) {}
-    /// Lock the lock if it is not already locked.
-    void lock_if_not_locked() {
-      if (gtid_set->sid_lock && !locked) {
-        mysql_mutex_lock(&gtid_set->free_intervals_mutex);
-        locked = true;
-      }
-    }
-    /// Lock the lock if it is locked.
-    void unlock_if_locked() {
-      if (gtid_set->sid_lock && locked) {
-        mysql_mutex_unlock(&gtid_set->free_intervals_mutex);
-        locked = false;
-      }
-    }
-    /// Destroy this object and unlock the lock if it is locked.
-    ~Free_intervals_lock() { unlock_if_locked(); }
-
-   private:
-    Gtid_set *gtid_set;
-    bool locked;
-  };
-  void assert_free_intervals_locked() {
-    if (sid_lock != NULL) mysql_mutex_assert_owner(&free_intervals_mutex);
-  }
 
   /**
-    Adds the interval (start, end) to the given Interval_iterator.
+    Adds the interval (start, end) to the given SIDNO.
 
     This is the lowest-level function that adds gtids; this is where
-    Interval objects are added, grown, or merged.
+    intervals are added, grown, or merged.
 
-    @param ivitp Pointer to iterator.  After this function returns,
-    the current_element of the iterator will be the interval that
-    contains start and end.
+    @param sidno The SIDNO.
     @param start The first GNO in the interval.
     @param end The first GNO after the interval.
-    @param lock If this function has to add or remove an interval,
-    then this lock will be taken unless it is already taken.  This
-    mechanism means that the lock will be taken lazily by
-    e.g. add_gtid_set() the first time that the list of free intervals
-    is accessed, and automatically released when add_gtid_set()
-    returns.
   */
-  void add_gno_interval(Interval_iterator *ivitp, rpl_gno start, rpl_gno end,
-                        Free_intervals_lock *lock);
+  void add_gno_interval(rpl_sidno sidno, rpl_gno start, rpl_gno end);
   /**
-    Removes the interval (start, end) from the given
-    Interval_iterator. This is the lowest-level function that removes
-    gtids; this is where Interval objects are removed, truncated, or
-    split.
+    Removes the interval (start, end) from the given SIDNO. This is the
+    lowest-level function that removes gtids; this is where intervals
+    are removed, truncated, or split.
 
     It is not required that the gtids in the interval exist in this
     Gtid_set.
 
-    @param ivitp Pointer to iterator.  After this function returns,
-    the current_element of the iterator will be the next interval
-    after end.
+    @param sidno The SIDNO.
     @param start The first GNO in the interval.
     @param end The first GNO after the interval.
-    @param lock If this function has to add or remove an interval,
-    then this lock will be taken unless it is already taken.  This
-    mechanism means that the lock will be taken lazily by
-    e.g. add_gtid_set() the first time that the list of free intervals
-    is accessed, and automatically released when add_gtid_set()
-    returns.
   */
-  void remove_gno_interval(Interval_iterator *ivitp, rpl_gno start, rpl_gno end,
-                           Free_intervals_lock *lock);
+  void remove_gno_interval(rpl_sidno sidno, rpl_gno start, rpl_gno end);
   /**
     Adds a list of intervals to the given SIDNO.
 
     The SIDNO must exist in the Gtid_set before this function is called.
 
+    The intervals are appended if they all come after the intervals of
+    the SIDNO, and otherwise the two sorted arrays are merged in one
+    pass.
+
     @param sidno The SIDNO to which intervals will be added.
-    @param ivit Iterator over the intervals to add. This is typically
-    an iterator over some other Gtid_set.
-    @param lock If this function has to add or remove an interval,
-    then this lock will be taken unless it is already taken.  This
-    mechanism means that the lock will be taken lazily by
-    e.g. add_gtid_set() the first time that the list of free intervals
-    is accessed, and automatically released when add_gtid_set()
-    returns.
+    @param other The intervals to add. This is typically the intervals
+    of some other Gtid_set.
   */
-  void add_gno_intervals(rpl_sidno sidno, Const_interval_iterator ivit,
-                         Free_intervals_lock *lock);
+  void add_gno_intervals(rpl_sidno sidno, const Interval_array &other);
   /**
     Removes a list of intervals from the given SIDNO.
 
     It is not required that the intervals exist in this Gtid_set.
 
     @param sidno The SIDNO from which intervals will be removed.
-    @param ivit Iterator over the intervals to remove. This is typically
-    an iterator over some other Gtid_set.
-    @param lock If this function has to add or remove an interval,
-    then this lock will be taken unless it is already taken.  This
-    mechanism means that the lock will be taken lazily by
-    e.g. add_gtid_set() the first time that the list of free intervals
-    is accessed, and automatically released when add_gtid_set()
-    returns.
+    @param other The intervals to remove. This is typically the
+    intervals of some other Gtid_set.
   */
-  void remove_gno_intervals(rpl_sidno sidno, Const_interval_iterator ivit,
-                            Free_intervals_lock *lock);
+  void remove_gno_intervals(rpl_sidno sidno, const Interval_array &other);
 
   /// Returns true if every interval of sub is a subset of some
   /// interval of super.
@@ -2025,33 +1858,19 @@ class Gtid_set {
   /// Sid_map associated with this Gtid_set.
   Sid_map *sid_map;
   /**
-    Array where the N'th element contains the head pointer to the
-    intervals of SIDNO N+1.
+    Array where the N'th element contains the intervals of SIDNO N+1.
   */
-  Prealloced_array<Interval *, 8> m_intervals;
-  /// Linked list of free intervals.
-  Interval *free_intervals;
-  /// Linked list of chunks.
-  Interval_chunk *chunks;
+  Prealloced_array<Interval_array, 8> m_intervals;
   /// If the string is cached.
   mutable bool has_cached_string_length;
   /// The string length.
   mutable size_t cached_string_length;
   /// The String_format that was used when cached_string_length was computed.
   mutable const String_format *cached_string_format;
-#ifndef DBUG_OFF
-  /**
-    The number of chunks.  Used only to check some invariants when
-    DBUG is on.
-  */
-  int n_chunks;
-#endif
   /// Used by unit tests that need to access private members.
 #ifdef FRIEND_OF_GTID_SET
   friend FRIEND_OF_GTID_SET;
 #endif
-  /// Only Free_intervals_lock is allowed to access free_intervals_mutex.
-  friend class Gtid_set::Free_intervals_lock;
 };
 
 /**
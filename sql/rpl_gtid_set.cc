@@ -29,7 +29,6 @@
 
 #include "my_loglevel.h"
 #include "mysql/components/services/log_builtins.h"
-#include "mysql/components/services/psi_mutex_bits.h"
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
@@ -43,7 +42,6 @@
 #include "my_inttypes.h"
 #include "my_stacktrace.h"  // my_safe_printf_stderr
 #include "my_sys.h"
-#include "mysql/psi/mysql_mutex.h"
 #include "mysql/service_mysql_alloc.h"
 #include "prealloced_array.h"
 #include "sql/rpl_gtid.h"
@@ -69,8 +67,6 @@ using std::min;
 
 #define MAX_NEW_CHUNK_ALLOCATE_TRIES 10
 
-PSI_mutex_key Gtid_set::key_gtid_executed_free_intervals_mutex;
-
 const Gtid_set::String_format Gtid_set::default_string_format = {
     "", "", ":", "-", ":", ",\n", "", 0, 0, 1, 1, 1, 2, 0};
 
@@ -102,30 +98,12 @@ void Gtid_set::init() {
   has_cached_string_length = false;
   cached_string_length = 0;
   cached_string_format = NULL;
-  chunks = NULL;
-  free_intervals = NULL;
-  if (sid_lock)
-    mysql_mutex_init(key_gtid_executed_free_intervals_mutex,
-                     &free_intervals_mutex, NULL);
-#ifndef DBUG_OFF
-  n_chunks = 0;
-#endif
   DBUG_VOID_RETURN;
 }
 
 Gtid_set::~Gtid_set() {
   DBUG_ENTER("Gtid_set::~Gtid_set");
-  Interval_chunk *chunk = chunks;
-  while (chunk != NULL) {
-    Interval_chunk *next_chunk = chunk->next;
-    my_free(chunk);
-    chunk = next_chunk;
-#ifndef DBUG_OFF
-    n_chunks--;
-#endif
-  }
-  DBUG_ASSERT(n_chunks == 0);
-  if (sid_lock) mysql_mutex_destroy(&free_intervals_mutex);
+  for (Interval_array &array : m_intervals) my_free(array.intervals);
   DBUG_VOID_RETURN;
 }
 
@@ -161,9 +139,9 @@ enum_return_status Gtid_set::ensure_sidno(rpl_sidno sidno) {
         }
       }
     }
-    Interval *null_p = NULL;
+    Interval_array empty = {NULL, 0, 0};
     for (rpl_sidno i = max_sidno; i < sidno; i++)
-      if (m_intervals.push_back(null_p)) goto error;
+      if (m_intervals.push_back(empty)) goto error;
     if (sid_lock != NULL) {
       if (!is_wrlock) {
         sid_lock->unlock();
@@ -177,37 +155,20 @@ error:
   RETURN_REPORTED_ERROR;
 }
 
-void Gtid_set::add_interval_memory_lock_taken(int n_ivs, Interval *ivs) {
-  DBUG_ENTER("Gtid_set::add_interval_memory");
-  assert_free_intervals_locked();
-  // make ivs a linked list
-  for (int i = 0; i < n_ivs - 1; i++) ivs[i].next = &(ivs[i + 1]);
-  Interval_iterator ivit(this);
-  ivs[n_ivs - 1].next = ivit.get();
-  // add intervals to list of free intervals
-  ivit.set(&(ivs[0]));
-  DBUG_VOID_RETURN;
-}
-
-void Gtid_set::create_new_chunk(int size) {
-  DBUG_ENTER("Gtid_set::create_new_chunk");
+Gtid_set::Interval *Gtid_set::allocate_intervals(size_t n_intervals) {
+  DBUG_ENTER("Gtid_set::allocate_intervals");
   int i = 0;
-  Interval_chunk *new_chunk = NULL;
+  Interval *intervals = NULL;
 
-  assert_free_intervals_locked();
   /*
-    Try to allocate the new chunk in MAX_NEW_CHUNK_ALLOCATE_TRIES
+    Try to allocate the intervals in MAX_NEW_CHUNK_ALLOCATE_TRIES
     tries when encountering 'out of memory' situation.
   */
   while (i < MAX_NEW_CHUNK_ALLOCATE_TRIES) {
-    /*
-      Allocate the new chunk. one element is already pre-allocated, so
-      we only add size-1 elements to the size of the struct.
-    */
-    new_chunk = (Interval_chunk *)my_malloc(
-        key_memory_Gtid_set_Interval_chunk,
-        sizeof(Interval_chunk) + sizeof(Interval) * (size - 1), MYF(MY_WME));
-    if (new_chunk != NULL) {
+    intervals = static_cast<Interval *>(
+        my_malloc(key_memory_Gtid_set_Interval_chunk,
+                  sizeof(Interval) * n_intervals, MYF(MY_WME)));
+    if (intervals != NULL) {
 #ifdef MYSQL_SERVER
       if (i > 0)
         LogErr(WARNING_LEVEL, ER_RPL_GTID_MEMORY_FINALLY_AVAILABLE, i + 1);
@@ -219,7 +180,7 @@ void Gtid_set::create_new_chunk(int size) {
     i++;
   }
   /*
-    Terminate the server after failed to allocate the new chunk
+    Terminate the server after failed to allocate the intervals
     in MAX_NEW_CHUNK_ALLOCATE_TRIES tries.
   */
   if (MAX_NEW_CHUNK_ALLOCATE_TRIES == i ||
@@ -227,65 +188,41 @@ void Gtid_set::create_new_chunk(int size) {
     my_safe_print_system_time();
     my_safe_printf_stderr("%s",
                           "[Fatal] Out of memory while allocating "
-                          "a new chunk of intervals for storing GTIDs.\n");
+                          "intervals for storing GTIDs.\n");
     _exit(MYSQLD_FAILURE_EXIT);
   }
-  // store the chunk in the list of chunks
-  new_chunk->next = chunks;
-  chunks = new_chunk;
-#ifndef DBUG_OFF
-  n_chunks++;
-#endif
-  // add the intervals in the chunk to the list of free intervals
-  add_interval_memory_lock_taken(size, new_chunk->intervals);
-  DBUG_VOID_RETURN;
+  DBUG_RETURN(intervals);
 }
 
-void Gtid_set::get_free_interval(Interval **out) {
-  DBUG_ENTER("Gtid_set::get_free_interval");
-  assert_free_intervals_locked();
-  Interval_iterator ivit(this);
+void Gtid_set::reserve_intervals(Interval_array *array, size_t n_intervals) {
   bool simulate_failure = DBUG_EVALUATE_IF(
       "rpl_gtid_get_free_interval_simulate_out_of_memory", true, false);
   if (simulate_failure) DBUG_SET("+d,rpl_simulate_new_chunk_allocate_failure");
-  if (ivit.get() == NULL || simulate_failure) create_new_chunk(CHUNK_GROW_SIZE);
-  *out = ivit.get();
-  ivit.set((*out)->next);
-  DBUG_VOID_RETURN;
+  if (n_intervals <= array->capacity && !simulate_failure) return;
+  size_t capacity = 2 * array->capacity;
+  if (capacity < INITIAL_INTERVAL_ARRAY_SIZE)
+    capacity = INITIAL_INTERVAL_ARRAY_SIZE;
+  if (capacity < n_intervals) capacity = n_intervals;
+  Interval *intervals = allocate_intervals(capacity);
+  if (array->size > 0)
+    memcpy(intervals, array->intervals, sizeof(Interval) * array->size);
+  my_free(array->intervals);
+  array->intervals = intervals;
+  array->capacity = capacity;
 }
 
-void Gtid_set::put_free_interval(Interval *iv) {
-  DBUG_ENTER("Gtid_set::put_free_interval");
-  assert_free_intervals_locked();
-  Interval_iterator ivit(this);
-  iv->next = ivit.get();
-  ivit.set(iv);
-  DBUG_VOID_RETURN;
+size_t Gtid_set::find_interval(const Interval_array &array, rpl_gno gno) {
+  const Interval *first = std::partition_point(
+      array.intervals, array.intervals + array.size,
+      [gno](const Interval &iv) { return iv.end <= gno; });
+  return first - array.intervals;
 }
 
 void Gtid_set::clear() {
   DBUG_ENTER("Gtid_set::clear");
   has_cached_string_length = false;
   cached_string_length = 0;
-  rpl_sidno max_sidno = get_max_sidno();
-  if (max_sidno == 0) DBUG_VOID_RETURN;
-  Interval_iterator free_ivit(this);
-  for (rpl_sidno sidno = 1; sidno <= max_sidno; sidno++) {
-    /*
-      Link in this list of intervals at the end of the list of
-      free intervals.
-    */
-    Interval_iterator ivit(this, sidno);
-    Interval *iv = ivit.get();
-    if (iv != NULL) {
-      // find the end of the list of free intervals
-      while (free_ivit.get() != NULL) free_ivit.next();
-      // append the present list
-      free_ivit.set(iv);
-      // clear the pointer to the head of this list
-      ivit.set(NULL);
-    }
-  }
+  for (Interval_array &array : m_intervals) array.size = 0;
   DBUG_VOID_RETURN;
 }
 
@@ -297,125 +234,100 @@ void Gtid_set::clear_set_and_sid_map() {
     to a condition were the Gtid_set->get_max_sidno() will be greater than the
     Sid_map->get_max_sidno().
   */
+  for (Interval_array &array : m_intervals) my_free(array.intervals);
   m_intervals.clear();
   sid_map->clear();
   DBUG_ASSERT(get_max_sidno() == sid_map->get_max_sidno());
   DBUG_VOID_RETURN;
 }
 
-void Gtid_set::add_gno_interval(Interval_iterator *ivitp, rpl_gno start,
-                                rpl_gno end, Free_intervals_lock *lock) {
-  DBUG_ENTER(
-      "Gtid_set::add_gno_interval(Interval_iterator*, rpl_gno, rpl_gno)");
+void Gtid_set::add_gno_interval(rpl_sidno sidno, rpl_gno start,
+                                rpl_gno end) {
+  DBUG_ENTER("Gtid_set::add_gno_interval(rpl_sidno, rpl_gno, rpl_gno)");
   DBUG_ASSERT(start > 0);
   DBUG_ASSERT(start < end);
   DBUG_PRINT("info", ("start=%lld end=%lld", start, end));
-  Interval *iv;
-  Interval_iterator ivit = *ivitp;
+  Interval_array *array = &m_intervals[sidno - 1];
   has_cached_string_length = false;
   cached_string_length = 0;
 
-  while ((iv = ivit.get()) != NULL) {
-    if (iv->end >= start) {
-      if (iv->start > end)
-        // (start, end) is strictly before the current interval
-        break;
-      // (start, end) and (iv->start, iv->end) touch or intersect.
-      // Save the start of the merged interval.
-      if (iv->start < start) start = iv->start;
-      // Remove the current interval as long as the new interval
-      // intersects with the next interval.
-      while (iv->next && end >= iv->next->start) {
-        lock->lock_if_not_locked();
-        ivit.remove(this);
-        iv = ivit.get();
-      }
-      // Store the interval in the current interval.
-      iv->start = start;
-      if (iv->end < end) iv->end = end;
-      *ivitp = ivit;
-      DBUG_VOID_RETURN;
-    }
-    ivit.next();
+  // Find the first interval that touches or comes after (start, end).
+  // GTIDs are mostly added after the last interval, so check that first.
+  size_t first = array->size;
+  if (first > 0 && array->intervals[first - 1].end >= start)
+    first = find_interval(*array, start - 1);
+  // Find the first interval after those that touch (start, end).
+  size_t last = first;
+  while (last < array->size && array->intervals[last].start <= end) last++;
+
+  if (first == last) {
+    /*
+      The interval cannot be combined with any existing interval: it
+      is after the previous interval (if any) and before the current
+      interval (if any). So insert it at the current position.
+    */
+    reserve_intervals(array, array->size + 1);
+    Interval *iv = array->intervals + first;
+    memmove(iv + 1, iv, sizeof(Interval) * (array->size - first));
+    iv->start = start;
+    iv->end = end;
+    array->size++;
+    DBUG_VOID_RETURN;
   }
-  /*
-    We come here if the interval cannot be combined with any existing
-    interval: it is after the previous interval (if any) and before
-    the current interval (if any). So we allocate a new interval and
-    insert it at the current position.
-  */
-  Interval *new_iv;
-  lock->lock_if_not_locked();
-  get_free_interval(&new_iv);
-  new_iv->start = start;
-  new_iv->end = end;
-  ivit.insert(new_iv);
-  *ivitp = ivit;
+
+  // Merge (start, end) and the intervals it touches into the first one.
+  Interval *iv = array->intervals + first;
+  iv->start = min(iv->start, start);
+  iv->end = max(array->intervals[last - 1].end, end);
+  memmove(iv + 1, array->intervals + last,
+          sizeof(Interval) * (array->size - last));
+  array->size -= last - first - 1;
   DBUG_VOID_RETURN;
 }
 
-void Gtid_set::remove_gno_interval(Interval_iterator *ivitp, rpl_gno start,
-                                   rpl_gno end, Free_intervals_lock *lock) {
-  DBUG_ENTER(
-      "Gtid_set::remove_gno_interval(Interval_iterator *ivitp, rpl_gno start, "
-      "rpl_gno end)");
+void Gtid_set::remove_gno_interval(rpl_sidno sidno, rpl_gno start,
+                                   rpl_gno end) {
+  DBUG_ENTER("Gtid_set::remove_gno_interval(rpl_sidno, rpl_gno, rpl_gno)");
   DBUG_ASSERT(start < end);
-  Interval_iterator ivit = *ivitp;
-  Interval *iv;
+  Interval_array *array = &m_intervals[sidno - 1];
   has_cached_string_length = false;
   cached_string_length = -1;
 
-  // Skip intervals of 'this' that are completely before the removed interval.
-  while (1) {
-    iv = ivit.get();
-    if (iv == NULL) goto ok;
-    if (iv->end > start) break;
-    ivit.next();
+  // Find the intervals that intersect the removed interval.
+  size_t first = find_interval(*array, start);
+  size_t last = first;
+  while (last < array->size && array->intervals[last].start < end) last++;
+  if (first == last) DBUG_VOID_RETURN;
+
+  Interval *head = array->intervals + first;
+  Interval *tail = array->intervals + last - 1;
+  if (head == tail && head->start < start && head->end > end) {
+    // The removed interval is inside one interval: split it in two.
+    rpl_gno split_end = head->end;
+    head->end = start;
+    reserve_intervals(array, array->size + 1);
+    Interval *iv = array->intervals + first + 1;
+    memmove(iv + 1, iv, sizeof(Interval) * (array->size - first - 1));
+    iv->start = end;
+    iv->end = split_end;
+    array->size++;
+    DBUG_VOID_RETURN;
   }
-
-  // Now iv ends after the beginning of the removed interval.
-  DBUG_ASSERT(iv != NULL && iv->end > start);
-  if (iv->start < start) {
-    if (iv->end > end) {
-      // iv cuts also the end of the removed interval: split iv in two
-      Interval *new_iv;
-      lock->lock_if_not_locked();
-      get_free_interval(&new_iv);
-      new_iv->start = end;
-      new_iv->end = iv->end;
-      iv->end = start;
-      ivit.next();
-      ivit.insert(new_iv);
-      goto ok;
-    }
-    // iv cuts the beginning but not the end of the removed interval:
-    // truncate iv, and iterate one step to next interval
-    iv->end = start;
-    ivit.next();
-    iv = ivit.get();
-    if (iv == NULL) goto ok;
+  // Truncate the intervals that are cut, and remove those that are
+  // completely covered.
+  if (head->start < start) {
+    head->end = start;
+    first++;
   }
-
-  // Now iv starts after the beginning of the removed interval.
-  DBUG_ASSERT(iv != NULL && iv->start >= start);
-  while (iv->end <= end) {
-    // iv ends before the end of the removed interval, so it is
-    // completely covered: remove iv.
-    lock->lock_if_not_locked();
-    ivit.remove(this);
-    iv = ivit.get();
-    if (iv == NULL) goto ok;
+  if (tail->end > end) {
+    tail->start = end;
+    last--;
   }
-
-  // Now iv ends after the removed interval.
-  DBUG_ASSERT(iv != NULL && iv->end > end);
-  if (iv->start < end) {
-    // iv begins before the end of the removed interval: truncate iv
-    iv->start = end;
+  if (first < last) {
+    memmove(array->intervals + first, array->intervals + last,
+            sizeof(Interval) * (array->size - last));
+    array->size -= last - first;
   }
-
-ok:
-  *ivitp = ivit;
   DBUG_VOID_RETURN;
 }
 
@@ -456,23 +368,7 @@ enum_return_status Gtid_set::add_gtid_text(const char *text, bool *anonymous,
     RETURN_OK;
   }
 
-  Free_intervals_lock lock(this);
-
   DBUG_PRINT("info", ("'%s' not only whitespace", text));
-  // Allocate space for all intervals at once, if nothing is allocated.
-  if (chunks == NULL) {
-    // compute number of intervals in text: it is equal to the number of
-    // colons
-    int n_intervals = 0;
-    text = s;
-    for (; *s; s++)
-      if (*s == ':') n_intervals++;
-    // allocate all intervals in one chunk
-    lock.lock_if_not_locked();
-    create_new_chunk(n_intervals);
-    lock.unlock_if_locked();
-    s = text;
-  }
 
   while (1) {
     // Skip commas (we allow empty SID:GNO specifications).
@@ -508,7 +404,6 @@ enum_return_status Gtid_set::add_gtid_text(const char *text, bool *anonymous,
       SKIP_WHITESPACE();
 
       // Iterate over intervals.
-      Interval_iterator ivit(this, sidno);
       while (*s == ':') {
         // Skip ':'.
         s++;
@@ -546,14 +441,7 @@ enum_return_status Gtid_set::add_gtid_text(const char *text, bool *anonymous,
         } else
           end = start + 1;
 
-        if (end > start) {
-          // Add interval.  Use the existing iterator position if the
-          // current interval does not begin before it.  Otherwise iterate
-          // from the beginning.
-          Interval *current = ivit.get();
-          if (current == NULL || start < current->start) ivit.init(this, sidno);
-          add_gno_interval(&ivit, start, end, &lock);
-        }
+        if (end > start) add_gno_interval(sidno, start, end);
       }
     }
 
@@ -619,35 +507,113 @@ bool Gtid_set::is_valid(const char *text) {
 }
 
 void Gtid_set::add_gno_intervals(rpl_sidno sidno,
-                                 Const_interval_iterator other_ivit,
-                                 Free_intervals_lock *lock) {
-  DBUG_ENTER(
-      "Gtid_set::add_gno_intervals(rpl_sidno, Const_interval_iterator, bool "
-      "*)");
+                                 const Interval_array &other) {
+  DBUG_ENTER("Gtid_set::add_gno_intervals(rpl_sidno, const Interval_array &)");
   DBUG_ASSERT(sidno >= 1 && sidno <= get_max_sidno());
-  const Interval *other_iv;
-  Interval_iterator ivit(this, sidno);
-  while ((other_iv = other_ivit.get()) != NULL) {
-    add_gno_interval(&ivit, other_iv->start, other_iv->end, lock);
-    other_ivit.next();
+  Interval_array *array = &m_intervals[sidno - 1];
+  if (other.size == 0 || &other == array) DBUG_VOID_RETURN;
+  has_cached_string_length = false;
+  cached_string_length = 0;
+
+  if (array->size == 0 ||
+      other.intervals[0].start > array->intervals[array->size - 1].end) {
+    // All the intervals come after the existing ones: append them.
+    reserve_intervals(array, array->size + other.size);
+    memcpy(array->intervals + array->size, other.intervals,
+           sizeof(Interval) * other.size);
+    array->size += other.size;
+    DBUG_VOID_RETURN;
+  }
+
+  if (other.size <= MAX_INTERVALS_ADDED_ONE_BY_ONE) {
+    for (size_t i = 0; i < other.size; i++)
+      add_gno_interval(sidno, other.intervals[i].start, other.intervals[i].end);
+    DBUG_VOID_RETURN;
+  }
+
+  // Merge the two sorted arrays into a new one.
+  size_t capacity = array->size + other.size;
+  Interval *merged = allocate_intervals(capacity);
+  size_t n_merged = 0;
+  for (size_t i = 0, j = 0; i < array->size || j < other.size;) {
+    bool take_this = j == other.size ||
+                     (i < array->size &&
+                      array->intervals[i].start < other.intervals[j].start);
+    const Interval &iv =
+        take_this ? array->intervals[i++] : other.intervals[j++];
+    if (n_merged > 0 && iv.start <= merged[n_merged - 1].end) {
+      if (iv.end > merged[n_merged - 1].end) merged[n_merged - 1].end = iv.end;
+    } else
+      merged[n_merged++] = iv;
   }
+  my_free(array->intervals);
+  array->intervals = merged;
+  array->size = n_merged;
+  array->capacity = capacity;
   DBUG_VOID_RETURN;
 }
 
 void Gtid_set::remove_gno_intervals(rpl_sidno sidno,
-                                    Const_interval_iterator other_ivit,
-                                    Free_intervals_lock *lock) {
+                                    const Interval_array &other) {
   DBUG_ENTER(
-      "Gtid_set::remove_gno_intervals(rpl_sidno, Interval_iterator, "
-      "Free_intervals_lock *)");
+      "Gtid_set::remove_gno_intervals(rpl_sidno, const Interval_array &)");
   DBUG_ASSERT(sidno >= 1 && sidno <= get_max_sidno());
-  const Interval *other_iv;
-  Interval_iterator ivit(this, sidno);
-  while ((other_iv = other_ivit.get()) != NULL) {
-    remove_gno_interval(&ivit, other_iv->start, other_iv->end, lock);
-    if (ivit.get() == NULL) break;
-    other_ivit.next();
+  Interval_array *array = &m_intervals[sidno - 1];
+  if (other.size == 0 || array->size == 0) DBUG_VOID_RETURN;
+  has_cached_string_length = false;
+  cached_string_length = -1;
+
+  if (&other == array) {
+    array->size = 0;
+    DBUG_VOID_RETURN;
   }
+
+  if (other.size <= MAX_INTERVALS_ADDED_ONE_BY_ONE) {
+    for (size_t i = 0; i < other.size; i++)
+      remove_gno_interval(sidno, other.intervals[i].start,
+                          other.intervals[i].end);
+    DBUG_VOID_RETURN;
+  }
+
+  /*
+    Subtract the two sorted arrays into a new one.  Each removed
+    interval can split at most one interval in two.
+  */
+  size_t capacity = array->size + other.size;
+  Interval *result = allocate_intervals(capacity);
+  size_t n_result = 0;
+  size_t j = 0;
+  for (size_t i = 0; i < array->size; i++) {
+    rpl_gno start = array->intervals[i].start;
+    rpl_gno end = array->intervals[i].end;
+    // Skip removed intervals that end before this interval.
+    while (j < other.size && other.intervals[j].end <= start) j++;
+    // Cut out the removed intervals that begin inside this interval.
+    while (j < other.size && other.intervals[j].start < end) {
+      const Interval &removed = other.intervals[j];
+      if (removed.start > start) {
+        result[n_result].start = start;
+        result[n_result].end = removed.start;
+        n_result++;
+      }
+      if (removed.end >= end) {
+        // The removed interval may also cut the next interval.
+        start = end;
+        break;
+      }
+      start = removed.end;
+      j++;
+    }
+    if (start < end) {
+      result[n_result].start = start;
+      result[n_result].end = end;
+      n_result++;
+    }
+  }
+  my_free(array->intervals);
+  array->intervals = result;
+  array->size = n_result;
+  array->capacity = capacity;
   DBUG_VOID_RETURN;
 }
 
@@ -655,9 +621,7 @@ void Gtid_set::remove_intervals_for_sidno(Gtid_set *other, rpl_sidno sidno) {
   // Currently only works if this and other use the same Sid_map.
   DBUG_ASSERT(other->sid_map == sid_map || other->sid_map == NULL ||
               sid_map == NULL);
-  Const_interval_iterator other_ivit(other, sidno);
-  Free_intervals_lock lock(this);
-  remove_gno_intervals(sidno, other_ivit, &lock);
+  remove_gno_intervals(sidno, other->m_intervals[sidno - 1]);
 }
 
 enum_return_status Gtid_set::add_gtid_set(const Gtid_set *other) {
@@ -667,24 +631,23 @@ enum_return_status Gtid_set::add_gtid_set(const Gtid_set *other) {
   DBUG_ENTER("Gtid_set::add_gtid_set(const Gtid_set *)");
   if (sid_lock != NULL) sid_lock->assert_some_wrlock();
   rpl_sidno max_other_sidno = other->get_max_sidno();
-  Free_intervals_lock lock(this);
   if (other->sid_map == sid_map || other->sid_map == NULL || sid_map == NULL) {
     PROPAGATE_REPORTED_ERROR(ensure_sidno(max_other_sidno));
     for (rpl_sidno sidno = 1; sidno <= max_other_sidno; sidno++)
-      add_gno_intervals(sidno, Const_interval_iterator(other, sidno), &lock);
+      add_gno_intervals(sidno, other->m_intervals[sidno - 1]);
   } else {
     Sid_map *other_sid_map = other->sid_map;
     Checkable_rwlock *other_sid_lock = other->sid_lock;
     if (other_sid_lock != NULL) other_sid_lock->assert_some_wrlock();
     for (rpl_sidno other_sidno = 1; other_sidno <= max_other_sidno;
          other_sidno++) {
-      Const_interval_iterator other_ivit(other, other_sidno);
-      if (other_ivit.get() != NULL) {
+      const Interval_array &other_array = other->m_intervals[other_sidno - 1];
+      if (other_array.size != 0) {
         const rpl_sid &sid = other_sid_map->sidno_to_sid(other_sidno);
         rpl_sidno this_sidno = sid_map->add_sid(sid);
         if (this_sidno <= 0) RETURN_REPORTED_ERROR;
         PROPAGATE_REPORTED_ERROR(ensure_sidno(this_sidno));
-        add_gno_intervals(this_sidno, other_ivit, &lock);
+        add_gno_intervals(this_sidno, other_array);
       }
     }
   }
@@ -695,23 +658,21 @@ void Gtid_set::remove_gtid_set(const Gtid_set *other) {
   DBUG_ENTER("Gtid_set::remove_gtid_set(Gtid_set *)");
   if (sid_lock != NULL) sid_lock->assert_some_wrlock();
   rpl_sidno max_other_sidno = other->get_max_sidno();
-  Free_intervals_lock lock(this);
   if (other->sid_map == sid_map || other->sid_map == NULL || sid_map == NULL) {
     rpl_sidno max_sidno = min(max_other_sidno, get_max_sidno());
     for (rpl_sidno sidno = 1; sidno <= max_sidno; sidno++)
-      remove_gno_intervals(sidno, Const_interval_iterator(other, sidno), &lock);
+      remove_gno_intervals(sidno, other->m_intervals[sidno - 1]);
   } else {
     Sid_map *other_sid_map = other->sid_map;
     Checkable_rwlock *other_sid_lock = other->sid_lock;
     if (other_sid_lock != NULL) other_sid_lock->assert_some_wrlock();
     for (rpl_sidno other_sidno = 1; other_sidno <= max_other_sidno;
          other_sidno++) {
-      Const_interval_iterator other_ivit(other, other_sidno);
-      if (other_ivit.get() != NULL) {
+      const Interval_array &other_array = other->m_intervals[other_sidno - 1];
+      if (other_array.size != 0) {
         const rpl_sid &sid = other_sid_map->sidno_to_sid(other_sidno);
         rpl_sidno this_sidno = sid_map->sid_to_sidno(sid);
-        if (this_sidno != 0)
-          remove_gno_intervals(this_sidno, other_ivit, &lock);
+        if (this_sidno != 0) remove_gno_intervals(this_sidno, other_array);
       }
     }
   }
@@ -723,16 +684,9 @@ bool Gtid_set::contains_gtid(rpl_sidno sidno, rpl_gno gno) const {
   DBUG_ASSERT(sidno >= 1 && gno >= 1);
   if (sid_lock != NULL) sid_lock->assert_some_lock();
   if (sidno > get_max_sidno()) DBUG_RETURN(false);
-  Const_interval_iterator ivit(this, sidno);
-  const Interval *iv;
-  while ((iv = ivit.get()) != NULL) {
-    if (gno < iv->start)
-      DBUG_RETURN(false);
-    else if (gno < iv->end)
-      DBUG_RETURN(true);
-    ivit.next();
-  }
-  DBUG_RETURN(false);
+  const Interval_array &array = m_intervals[sidno - 1];
+  size_t i = find_interval(array, gno);
+  DBUG_RETURN(i < array.size && array.intervals[i].start <= gno);
 }
 
 rpl_gno Gtid_set::get_last_gno(rpl_sidno sidno) const {
@@ -743,13 +697,8 @@ rpl_gno Gtid_set::get_last_gno(rpl_sidno sidno) const {
 
   if (sidno > get_max_sidno()) DBUG_RETURN(gno);
 
-  Const_interval_iterator ivit(this, sidno);
-  const Gtid_set::Interval *iv = ivit.get();
-  while (iv != NULL) {
-    gno = iv->end - 1;
-    ivit.next();
-    iv = ivit.get();
-  }
+  const Interval_array &array = m_intervals[sidno - 1];
+  if (array.size > 0) gno = array.intervals[array.size - 1].end - 1;
 
   DBUG_RETURN(gno);
 }
@@ -1292,7 +1241,6 @@ enum_return_status Gtid_set::add_gtid_encoding(const uchar *encoded,
   if (sid_lock != NULL) sid_lock->assert_some_wrlock();
   size_t pos = 0;
   uint64 n_sids;
-  Free_intervals_lock lock(this);
   // read number of SIDs
   if (length < 8) {
     DBUG_PRINT("error", ("(length=%lu) < 8", (ulong)length));
@@ -1327,7 +1275,8 @@ enum_return_status Gtid_set::add_gtid_encoding(const uchar *encoded,
                   (ulong)length, (ulong)pos, n_intervals));
       goto report_error;
     }
-    Interval_iterator ivit(this, sidno);
+    Interval_array *array = &m_intervals[sidno - 1];
+    reserve_intervals(array, array->size + n_intervals);
     rpl_gno last = 0;
     for (uint i = 0; i < n_intervals; i++) {
       // read one interval
@@ -1341,13 +1290,8 @@ enum_return_status Gtid_set::add_gtid_encoding(const uchar *encoded,
         goto report_error;
       }
       last = end;
-      // Add interval.  Use the existing iterator position if the
-      // current interval does not begin before it.  Otherwise iterate
-      // from the beginning.
-      Interval *current = ivit.get();
-      if (current == NULL || start < current->start) ivit.init(this, sidno);
       DBUG_PRINT("info", ("adding %d:%lld-%lld", sidno, start, end - 1));
-      add_gno_interval(&ivit, start, end, &lock);
+      add_gno_interval(sidno, start, end);
     }
   }
   DBUG_ASSERT(pos <= length);
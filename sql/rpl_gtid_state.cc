@@ -335,11 +335,6 @@ bool Gtid_state::wait_for_gtid_set(THD *thd, Gtid_set *wait_for,
 
   // The set of GTIDs that we are still waiting for.
   Gtid_set todo(global_sid_map, NULL);
-  // As an optimization, add 100 Intervals that do not need to be
-  // allocated. This avoids allocation of these intervals.
-  static const int preallocated_interval_count = 100;
-  Gtid_set::Interval ivs[preallocated_interval_count];
-  todo.add_interval_memory(preallocated_interval_count, ivs);
 
   /*
     Iterate until we have verified that all GTIDs in the set are
@@ -676,10 +671,6 @@ int Gtid_state::save_gtids_of_last_binlog_into_table(bool on_rotation) {
   */
   Sid_map sid_map(NULL);
   Gtid_set logged_gtids_last_binlog(&sid_map, NULL);
-  // Allocate some intervals on stack to reduce allocation.
-  static const int PREALLOCATED_INTERVAL_COUNT = 64;
-  Gtid_set::Interval iv[PREALLOCATED_INTERVAL_COUNT];
-  logged_gtids_last_binlog.add_interval_memory(PREALLOCATED_INTERVAL_COUNT, iv);
   /*
     logged_gtids_last_binlog= executed_gtids - previous_gtids_logged -
                               gtids_only_in_table
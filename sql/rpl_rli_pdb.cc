@@ -1108,8 +1108,11 @@ void Slave_worker::slave_worker_ends_group(Log_event *ev, int error) {
 
     /*
       DDL that has not yet updated the slave info repository does it now.
+      The Xid_log_event of a Transaction_payload has already done it.
     */
-    if (ev->get_type_code() != binary_log::XID_EVENT && !is_committed_ddl(ev)) {
+    if (ev->get_type_code() != binary_log::XID_EVENT &&
+        ev->get_type_code() != binary_log::TRANSACTION_PAYLOAD_EVENT &&
+        !is_committed_ddl(ev)) {
       commit_positions(ev, ptr_g, true);
       DBUG_EXECUTE_IF(
           "crash_after_commit_and_update_pos",
@@ -1921,6 +1924,8 @@ void Slave_worker::assign_partition_db(Log_event *ev) {
   Mts_db_names mts_dbs;
   int i;
 
+  /* A Transaction_payload reads its events with the format of the worker. */
+  ev->worker = this;
   ev->get_mts_dbs(&mts_dbs, c_rli->rpl_filter);
 
   if (mts_dbs.num == OVER_MAX_DBS_IN_EVENT_MTS)
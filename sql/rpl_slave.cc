@@ -259,14 +259,6 @@ log '%s' at position %s",
       "Slave I/O thread killed during or after a reconnect done to recover from \
 failed read"}};
 
-enum enum_slave_apply_event_and_update_pos_retval {
-  SLAVE_APPLY_EVENT_AND_UPDATE_POS_OK = 0,
-  SLAVE_APPLY_EVENT_AND_UPDATE_POS_APPLY_ERROR = 1,
-  SLAVE_APPLY_EVENT_AND_UPDATE_POS_UPDATE_POS_ERROR = 2,
-  SLAVE_APPLY_EVENT_AND_UPDATE_POS_APPEND_JOB_ERROR = 3,
-  SLAVE_APPLY_EVENT_AND_UPDATE_POS_MAX
-};
-
 static int process_io_rotate(Master_info *mi, Rotate_log_event *rev);
 static bool wait_for_relay_log_space(Relay_log_info *rli);
 static inline bool io_slave_killed(THD *thd, Master_info *mi);
@@ -4238,8 +4230,8 @@ static int sql_delay_event(Log_event *ev, THD *thd, Relay_log_info *rli) {
           append_item_to_jobs() failed, thread was killed while waiting
           for successful enqueue on worker.
 */
-static enum enum_slave_apply_event_and_update_pos_retval
-apply_event_and_update_pos(Log_event **ptr_ev, THD *thd, Relay_log_info *rli) {
+enum enum_slave_apply_event_and_update_pos_retval apply_event_and_update_pos(
+    Log_event **ptr_ev, THD *thd, Relay_log_info *rli) {
   int exec_res = 0;
   bool skip_event = false;
   Log_event *ev = *ptr_ev;
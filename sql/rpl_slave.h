@@ -38,6 +38,7 @@
 #include "sql/current_thd.h"
 #include "sql/debug_sync.h"
 
+class Log_event;
 class Master_info;
 class Relay_log_info;
 class THD;
@@ -502,6 +503,16 @@ extern uint report_port;
 extern char *master_info_file, *relay_log_info_file, *report_user;
 extern char *report_host, *report_password;
 
+enum enum_slave_apply_event_and_update_pos_retval {
+  SLAVE_APPLY_EVENT_AND_UPDATE_POS_OK = 0,
+  SLAVE_APPLY_EVENT_AND_UPDATE_POS_APPLY_ERROR = 1,
+  SLAVE_APPLY_EVENT_AND_UPDATE_POS_UPDATE_POS_ERROR = 2,
+  SLAVE_APPLY_EVENT_AND_UPDATE_POS_APPEND_JOB_ERROR = 3,
+  SLAVE_APPLY_EVENT_AND_UPDATE_POS_MAX
+};
+enum enum_slave_apply_event_and_update_pos_retval apply_event_and_update_pos(
+    Log_event **ptr_ev, THD *thd, Relay_log_info *rli);
+
 bool mts_recovery_groups(Relay_log_info *rli);
 bool mts_checkpoint_routine(Relay_log_info *rli, ulonglong period, bool force,
                             bool need_data_lock);
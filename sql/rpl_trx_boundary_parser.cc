@@ -213,6 +213,14 @@ Transaction_boundary_parser::get_event_boundary_type(
       boundary_type = EVENT_BOUNDARY_TYPE_STATEMENT;
       break;
 
+    /*
+      A Transaction_payload event holds a whole transaction. It follows
+      the GTID of the transaction and ends it, the same way a DDL does.
+    */
+    case binary_log::TRANSACTION_PAYLOAD_EVENT:
+      boundary_type = EVENT_BOUNDARY_TYPE_STATEMENT;
+      break;
+
     /*
       Incident events have their own boundary type.
     */
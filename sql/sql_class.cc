@@ -2156,6 +2156,15 @@ void THD::set_status_no_good_index_used() {
 #endif
 }
 
+void THD::save_current_query_costs() {
+  status_var.last_query_cost = m_current_query_cost;
+  status_var.last_query_partial_plans = m_current_query_partial_plans;
+#ifdef HAVE_PSI_STATEMENT_INTERFACE
+  PSI_STATEMENT_CALL(set_statement_query_cost)
+  (m_statement_psi, m_current_query_cost);
+#endif
+}
+
 void THD::set_command(enum enum_server_command command) {
   m_command = command;
 #ifdef HAVE_PSI_THREAD_INTERFACE
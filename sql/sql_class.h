@@ -949,11 +949,9 @@ class THD : public MDL_context_owner,
       @code SELECT * from performance_schema.session_status
       WHERE VARIABLE_NAME like 'last_query_%' @endcode
     actually reports the previous query, not itself.
+    The cost is also reported to the statement instrumentation.
   */
-  void save_current_query_costs() {
-    status_var.last_query_cost = m_current_query_cost;
-    status_var.last_query_partial_plans = m_current_query_partial_plans;
-  }
+  void save_current_query_costs();
 
   THR_LOCK_INFO lock_info;  // Locking info of this thread
   /**
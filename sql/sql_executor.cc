@@ -63,7 +63,8 @@
 #include "mysql/service_mysql_alloc.h"
 #include "mysql_com.h"
 #include "mysqld_error.h"
-#include "sql/debug_sync.h"  // DEBUG_SYNC
+#include "sql/compiled_condition.h"  // Compiled_condition
+#include "sql/debug_sync.h"          // DEBUG_SYNC
 #include "sql/enum_query_type.h"
 #include "sql/field.h"
 #include "sql/filesort.h"  // Filesort
@@ -1656,6 +1657,17 @@ static int do_sj_reset(SJ_TMP_TABLE *sj_tbl) {
   DBUG_RETURN(0);
 }
 
+bool QEP_TAB::condition_is_true(THD *thd) {
+  Item *const cond = condition();
+  DBUG_ASSERT(cond != NULL);
+  if (cond != m_compiled_for) {
+    m_compiled_condition = Compiled_condition::compile(thd->mem_root, cond);
+    m_compiled_for = cond;
+  }
+  if (m_compiled_condition != NULL) return m_compiled_condition->evaluate(thd);
+  return cond->val_int() != 0;
+}
+
 /**
   @brief Process one row of the nested loop join.
 
@@ -1684,7 +1696,7 @@ static enum_nested_loop_state evaluate_join_record(JOIN *join,
                        condition));
 
   if (condition) {
-    found = condition->val_int();
+    found = qep_tab->condition_is_true(join->thd);
 
     if (join->thd->killed) {
       join->thd->send_kill_message();
@@ -5112,6 +5124,179 @@ end:
   DBUG_RETURN(NESTED_LOOP_OK);
 }
 
+Hash_group_table::Hash_group_table()
+    : m_root(key_memory_Hash_group_table, 8192) {}
+
+bool Hash_group_table::is_usable(const TABLE *table, Item_sum **sum_funcs) {
+  if (!table->group || table->hash_field || table->s->keys == 0 ||
+      table->s->blob_fields > 0)
+    return false;
+
+  for (Item_sum **func_ptr = sum_funcs; *func_ptr; func_ptr++) {
+    switch ((*func_ptr)->sum_func()) {
+      case Item_sum::COUNT_FUNC:
+      case Item_sum::SUM_FUNC:
+      case Item_sum::AVG_FUNC:
+      case Item_sum::MIN_FUNC:
+      case Item_sum::MAX_FUNC:
+      case Item_sum::STD_FUNC:
+      case Item_sum::VARIANCE_FUNC:
+      case Item_sum::SUM_BIT_FUNC:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+bool Hash_group_table::init(TABLE *table, size_t max_size) {
+  if (m_table != table) clear();
+  m_table = table;
+  m_key_length = table->key_info[0].key_length;
+  m_max_size = max_size;
+  if (m_buckets == nullptr) return grow();
+
+  // Reuse the memory of the previous execution
+  remove_groups();
+  return false;
+}
+
+/**
+  Hash the group key in the way the group index compares it: strings by
+  their collation, and NULL and the two zeros of floating point numbers
+  by their value.
+*/
+
+static ulonglong hash_group_key(ORDER *group) {
+  ulonglong crc = 0;
+
+  for (ORDER *ord = group; ord; ord = ord->next) {
+    Field *const field = ord->field_in_tmp_table;
+    if (!field->is_null() && field->result_type() == REAL_RESULT &&
+        field->val_real() == 0.0)
+      crc = (crc << 8) + (crc >> (8 * sizeof(ha_checksum) - 8));
+    else
+      unique_hash(field, &crc);
+  }
+  return crc;
+}
+
+uchar *Hash_group_table::find(const uchar *key) {
+  m_hash = hash_group_key(m_table->group);
+
+  KEY_PART_INFO *const key_part = m_table->key_info[0].key_part;
+  const size_t mask = m_bucket_count - 1;
+  for (size_t i = m_hash & mask;; i = (i + 1) & mask) {
+    const Bucket &bucket = m_buckets[i];
+    if (bucket.group == nullptr) return nullptr;
+    if (bucket.hash == m_hash &&
+        !key_cmp2(key_part, key_of(bucket.group), m_key_length, key,
+                  m_key_length))
+      return record_of(bucket.group);
+  }
+}
+
+bool Hash_group_table::insert(const uchar *key, const uchar *record) {
+  // Keep the load factor below 1/2
+  if (2 * (m_group_count + 1) > m_bucket_count && grow()) return true;
+
+  const size_t reclength = m_table->s->reclength;
+  const size_t size = sizeof(uchar *) + m_key_length + reclength;
+  uchar *const group = static_cast<uchar *>(m_root.Alloc(size));
+  if (group == nullptr) {
+    my_error(ER_OUTOFMEMORY, MYF(ME_FATALERROR), static_cast<int>(size));
+    return true; /* purecov: inspected */
+  }
+
+  next_of(group) = nullptr;
+  memcpy(key_of(group), key, m_key_length);
+  memcpy(record_of(group), record, reclength);
+  *m_last_next = group;
+  m_last_next = &next_of(group);
+
+  const size_t mask = m_bucket_count - 1;
+  size_t i = m_hash & mask;
+  while (m_buckets[i].group != nullptr) i = (i + 1) & mask;
+  m_buckets[i].hash = m_hash;
+  m_buckets[i].group = group;
+  m_group_count++;
+  return false;
+}
+
+bool Hash_group_table::is_full() const {
+  return m_root.allocated_size() + m_bucket_count * sizeof(Bucket) >
+         m_max_size;
+}
+
+/**
+  Double the number of buckets and rehash the groups.
+
+  @returns true if out of memory
+*/
+
+bool Hash_group_table::grow() {
+  const size_t new_count = m_bucket_count == 0 ? 1024 : 2 * m_bucket_count;
+  Bucket *const new_buckets = static_cast<Bucket *>(
+      my_malloc(key_memory_Hash_group_table, new_count * sizeof(Bucket),
+                MYF(MY_WME | MY_ZEROFILL)));
+  if (new_buckets == nullptr) return true; /* purecov: inspected */
+
+  const size_t mask = new_count - 1;
+  for (size_t j = 0; j < m_bucket_count; j++) {
+    if (m_buckets[j].group == nullptr) continue;
+    size_t i = m_buckets[j].hash & mask;
+    while (new_buckets[i].group != nullptr) i = (i + 1) & mask;
+    new_buckets[i] = m_buckets[j];
+  }
+  my_free(m_buckets);
+  m_buckets = new_buckets;
+  m_bucket_count = new_count;
+  return false;
+}
+
+bool Hash_group_table::write_to_table(THD *thd, QEP_TAB *qep_tab) {
+  TABLE *const table = qep_tab->table();
+  Temp_table_param *const tmp_tbl = qep_tab->tmp_table_param;
+  DBUG_ASSERT(table == m_table);
+
+  for (uchar *group = m_first; group; group = next_of(group)) {
+    memcpy(table->record[0], record_of(group), table->s->reclength);
+    int error;
+    if ((error = table->file->ha_write_row(table->record[0]))) {
+      if (create_ondisk_from_heap(thd, table, tmp_tbl->start_recinfo,
+                                  &tmp_tbl->recinfo, error, false, NULL))
+        return true;  // Not a table_is_full error
+      if ((error = table->file->ha_index_init(0, 0))) {
+        table->file->print_error(error, MYF(0));
+        return true;
+      }
+    }
+  }
+
+  remove_groups();
+  return false;
+}
+
+void Hash_group_table::remove_groups() {
+  memset(m_buckets, 0, m_bucket_count * sizeof(Bucket));
+  m_root.ClearForReuse();
+  m_group_count = 0;
+  m_first = nullptr;
+  m_last_next = &m_first;
+}
+
+void Hash_group_table::clear() {
+  my_free(m_buckets);
+  m_buckets = nullptr;
+  m_bucket_count = 0;
+  m_group_count = 0;
+  m_root.Clear();
+  m_first = nullptr;
+  m_last_next = &m_first;
+  m_table = nullptr;
+}
+
 /* ARGSUSED */
 /** Group by searching after group record and updating it if possible. */
 
@@ -5123,7 +5308,13 @@ static enum_nested_loop_state end_update(JOIN *join, QEP_TAB *const qep_tab,
   bool group_found = false;
   DBUG_ENTER("end_update");
 
-  if (end_of_records) DBUG_RETURN(NESTED_LOOP_OK);
+  Hash_group_table *const groups =
+      down_cast<QEP_tmp_table *>(qep_tab->op)->hash_groups();
+  if (end_of_records) {
+    if (groups && groups->write_to_table(join->thd, qep_tab))
+      DBUG_RETURN(NESTED_LOOP_ERROR);
+    DBUG_RETURN(NESTED_LOOP_OK);
+  }
   if (join->thd->killed)  // Aborted by user
   {
     join->thd->send_kill_message();
@@ -5159,8 +5350,17 @@ static enum_nested_loop_state end_update(JOIN *join, QEP_TAB *const qep_tab,
         group->buff[-1] = (char)group->field_in_tmp_table->is_null();
     }
     const uchar *key = tmp_tbl->group_buff;
-    if (!table->file->ha_index_read_map(table->record[1], key, HA_WHOLE_KEY,
-                                        HA_READ_KEY_EXACT))
+    if (groups) {
+      uchar *const group_record = groups->find(key);
+      if (group_record) {
+        /* Update the group in memory */
+        memcpy(table->record[0], group_record, table->s->reclength);
+        update_tmptable_sum_func(join->sum_funcs, table);
+        memcpy(group_record, table->record[0], table->s->reclength);
+        DBUG_RETURN(NESTED_LOOP_OK);
+      }
+    } else if (!table->file->ha_index_read_map(table->record[1], key,
+                                               HA_WHOLE_KEY, HA_READ_KEY_EXACT))
       group_found = true;
   }
   if (group_found) {
@@ -5216,7 +5416,22 @@ static enum_nested_loop_state end_update(JOIN *join, QEP_TAB *const qep_tab,
       DBUG_RETURN(NESTED_LOOP_ERROR); /* purecov: inspected */
   }
   init_tmptable_sum_functions(join->sum_funcs);
-  if ((error = table->file->ha_write_row(table->record[0]))) {
+  if (groups) {
+    if (groups->insert(tmp_tbl->group_buff, table->record[0]))
+      DBUG_RETURN(NESTED_LOOP_ERROR); /* purecov: inspected */
+    if (groups->is_full()) {
+      /*
+        Out of memory for in-memory tmp tables: move the groups to the tmp
+        table, which is converted to an on-disk table when needed, and look
+        up the groups of the remaining rows there. end_update() stays the
+        write function, with the index of the converted table initialized
+        by write_to_table().
+      */
+      down_cast<QEP_tmp_table *>(qep_tab->op)->disable_hash_groups();
+      if (groups->write_to_table(join->thd, qep_tab))
+        DBUG_RETURN(NESTED_LOOP_ERROR);
+    }
+  } else if ((error = table->file->ha_write_row(table->record[0]))) {
     if (create_ondisk_from_heap(join->thd, table, tmp_tbl->start_recinfo,
                                 &tmp_tbl->recinfo, error, false, NULL))
       DBUG_RETURN(NESTED_LOOP_ERROR);  // Not a table_is_full error
@@ -6180,6 +6395,9 @@ bool QEP_tmp_table::prepare_tmp_table() {
     (void)table->file->extra(HA_EXTRA_WRITE_CACHE);
     empty_record(table);
   }
+  // Decide again whether groups are aggregated in memory
+  group_table_state = HASH_GROUPS_UNKNOWN;
+
   /* If it wasn't already, start index scan for grouping using table index. */
   if (!table->file->inited &&
       ((table->group && tmp_tbl->sum_func_count && table->s->keys) ||
@@ -6214,6 +6432,25 @@ enum_nested_loop_state QEP_tmp_table::put_record(bool end_of_records) {
   return rc;
 }
 
+/** Decide on first use whether the groups are aggregated in memory. */
+
+Hash_group_table *QEP_tmp_table::hash_groups() {
+  if (group_table_state == HASH_GROUPS_UNKNOWN) {
+    TABLE *const table = qep_tab->table();
+    THD *const thd = qep_tab->join()->thd;
+    // The same limit as for in-memory tmp tables
+    const size_t max_size = static_cast<size_t>(
+        std::min(thd->variables.tmp_table_size,
+                 thd->variables.max_heap_table_size));
+    if (Hash_group_table::is_usable(table, qep_tab->join()->sum_funcs) &&
+        !group_table.init(table, max_size))
+      group_table_state = HASH_GROUPS_ENABLED;
+    else
+      group_table_state = HASH_GROUPS_DISABLED;
+  }
+  return group_table_state == HASH_GROUPS_ENABLED ? &group_table : nullptr;
+}
+
 /**
   @brief Finish rnd/index scan after accumulating records, switch ref_array,
          and send accumulated records further.
@@ -42,6 +42,7 @@
 #include "sql/table.h"
 #include "sql/temp_table_param.h"  // Temp_table_param
 
+class Compiled_condition;
 class Field;
 class Field_longlong;
 class Filesort;
@@ -238,6 +239,98 @@ class QEP_operation {
   virtual void mem_free(){};
 };
 
+/**
+  In-memory hash table of the groups of a GROUP BY, used by end_update().
+
+  Each group is kept as a copy of its key, in the format of the group index
+  of the tmp table, followed by a copy of the tmp table record holding the
+  aggregated values. Aggregating a row into an existing group then costs a
+  hash probe instead of an index lookup and a row update in the tmp table.
+  The groups are written to the tmp table once, in the order they were
+  created, when all rows have been read or when the memory limit for
+  in-memory tmp tables is reached.
+*/
+
+class Hash_group_table {
+ public:
+  Hash_group_table();
+
+  /**
+    Check whether the groups of a tmp table can be aggregated in memory:
+    the group index must be a regular key, the record must not contain
+    BLOBs and all aggregate functions must keep their state in the record.
+  */
+  static bool is_usable(const TABLE *table, Item_sum **sum_funcs);
+
+  /**
+    Prepare for aggregating the groups of the tmp table. Groups left from a
+    previous execution are removed.
+
+    @param table     tmp table with a group index
+    @param max_size  memory limit for the keys, records and buckets
+
+    @returns true if out of memory
+  */
+  bool init(TABLE *table, size_t max_size);
+
+  /**
+    Find the group of the key built in the group buffer of the tmp table.
+
+    @returns the record of the group, nullptr if there is no such group
+  */
+  uchar *find(const uchar *key);
+
+  /**
+    Add a new group for the key passed to the last call to find().
+
+    @returns true if out of memory
+  */
+  bool insert(const uchar *key, const uchar *record);
+
+  /// Whether the groups use more memory than the limit given to init().
+  bool is_full() const;
+
+  /**
+    Write all groups to the tmp table, converting it to an on-disk table if
+    it becomes full, and remove them from the hash table.
+
+    @returns true on error
+  */
+  bool write_to_table(THD *thd, QEP_TAB *qep_tab);
+
+  /// Remove all groups and release the memory.
+  void clear();
+
+ private:
+  struct Bucket {
+    ulonglong hash;
+    uchar *group;  ///< nullptr if the bucket is empty
+  };
+
+  bool grow();
+  void remove_groups();
+  uchar *key_of(uchar *group) const { return group + sizeof(uchar *); }
+  uchar *record_of(uchar *group) const { return key_of(group) + m_key_length; }
+  uchar *&next_of(uchar *group) const {
+    return *reinterpret_cast<uchar **>(group);
+  }
+
+  /// Keys and records of the groups
+  MEM_ROOT m_root;
+  Bucket *m_buckets{nullptr};
+  /// Number of buckets, a power of 2
+  size_t m_bucket_count{0};
+  size_t m_group_count{0};
+  size_t m_max_size{0};
+  /// Groups in insertion order, linked through their first bytes
+  uchar *m_first{nullptr};
+  uchar **m_last_next{&m_first};
+  TABLE *m_table{nullptr};
+  uint m_key_length{0};
+  /// Hash of the key passed to the last call to find()
+  ulonglong m_hash{0};
+};
+
 /**
   @brief
     Class for accumulating join result in a tmp table, grouping them if
@@ -251,7 +344,8 @@ class QEP_operation {
                          records are expected to be sorted.
       end_update         Perform grouping using the key generated on tmp
                          table. Input records aren't expected to be sorted.
-                         Tmp table uses the heap engine
+                         Tmp table uses the heap engine. Groups are
+                         aggregated in a Hash_group_table when possible.
       end_update_unique  Same as above, but the engine is myisam.
 
     Lazy table initialization is used - the table will be instantiated and
@@ -265,6 +359,10 @@ class QEP_tmp_table : public QEP_operation {
       : QEP_operation(qep_tab_arg), write_func(NULL){};
   enum_op_type type() { return OT_TMP_TABLE; }
   enum_nested_loop_state put_record() { return put_record(false); };
+  void mem_free() {
+    group_table.clear();
+    group_table_state = HASH_GROUPS_UNKNOWN;
+  }
   /*
     Send the result of operation further (to a next operation/client)
     This function is called after all records were put into the buffer
@@ -277,10 +375,24 @@ class QEP_tmp_table : public QEP_operation {
   void set_write_func(Next_select_func new_write_func) {
     write_func = new_write_func;
   }
+  /**
+    Groups aggregated in memory by end_update(), nullptr if the groups are
+    looked up in the tmp table.
+  */
+  Hash_group_table *hash_groups();
+  /** Continue the aggregation in the tmp table until the next execution. */
+  void disable_hash_groups() { group_table_state = HASH_GROUPS_DISABLED; }
 
  private:
   /** Write function that would be used for saving records in tmp table. */
   Next_select_func write_func;
+  /** Groups aggregated in memory, see hash_groups() */
+  Hash_group_table group_table;
+  enum {
+    HASH_GROUPS_UNKNOWN,
+    HASH_GROUPS_ENABLED,
+    HASH_GROUPS_DISABLED
+  } group_table_state{HASH_GROUPS_UNKNOWN};
   enum_nested_loop_state put_record(bool end_of_records);
   MY_ATTRIBUTE((warn_unused_result))
   bool prepare_tmp_table();
@@ -435,7 +547,9 @@ class QEP_TAB : public QEP_shared_owner {
         m_quick_optim(NULL),
         m_keyread_optim(false),
         m_reversed_access(false),
-        m_fetched_rows(0) {}
+        m_fetched_rows(0),
+        m_compiled_for(NULL),
+        m_compiled_condition(NULL) {}
 
   /// Initializes the object from a JOIN_TAB
   void init(JOIN_TAB *jt);
@@ -502,10 +616,20 @@ class QEP_TAB : public QEP_shared_owner {
   bool remove_duplicates();
 
   inline bool skip_record(THD *thd, bool *skip_record_arg) {
-    *skip_record_arg = condition() ? condition()->val_int() == false : false;
+    *skip_record_arg = condition() ? !condition_is_true(thd) : false;
     return thd->is_error();
   }
 
+  /**
+    Evaluate condition() for the current row, through its compiled form
+    when it has one. The condition is compiled on first use, and again
+    whenever it has been replaced.
+
+    @param thd  the thread, whose mem_root holds the compiled form
+    @return true if the condition is TRUE, false if FALSE or UNKNOWN
+  */
+  bool condition_is_true(THD *thd);
+
   /**
      Used to begin a new execution of a subquery. Necessary if this subquery
      has done a filesort which which has cleared condition/quick.
@@ -696,6 +820,12 @@ class QEP_TAB : public QEP_shared_owner {
   */
   ha_rows m_fetched_rows;
 
+  /// The condition m_compiled_condition was compiled from
+  Item *m_compiled_for;
+
+  /// Compiled form of m_compiled_for, or NULL if it has none
+  Compiled_condition *m_compiled_condition;
+
   QEP_TAB(const QEP_TAB &);             // not defined
   QEP_TAB &operator=(const QEP_TAB &);  // not defined
 };
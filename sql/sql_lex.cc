@@ -2069,6 +2069,7 @@ SELECT_LEX::SELECT_LEX(Item *where, Item *having)
       ftfunc_list(&ftfunc_list_alloc),
       ftfunc_list_alloc(),
       join(NULL),
+      saved_join_order(NULL),
       top_join_list(),
       join_list(&top_join_list),
       embedding(NULL),
@@ -130,6 +130,7 @@ class Select_lex_visitor;
 class THD;
 class Window;
 struct MEM_ROOT;
+struct Saved_join_order;
 struct Sql_cmd_srs_attributes;
 
 enum class enum_jt_column;
@@ -1097,6 +1098,11 @@ class SELECT_LEX {
     should be changed only when THD::LOCK_query_plan mutex is taken.
   */
   JOIN *join;
+  /**
+    Join order chosen in an earlier execution of a prepared statement,
+    allocated on the statement MEM_ROOT. See Saved_join_order.
+  */
+  Saved_join_order *saved_join_order;
   /// join list of the top level
   List<TABLE_LIST> top_join_list;
   /// list for the currently parsed join
@@ -1974,18 +1974,23 @@ done:
   /* Freeing the memroot will leave the THD::work_part_info invalid. */
   thd->work_part_info = nullptr;
 
+  thd->status_var.mem_root_blocks_allocated +=
+      thd->mem_root->blocks_allocated();
+  thd->status_var.mem_root_blocks_reused += thd->mem_root->blocks_reused();
+
   /*
     If we've allocated a lot of memory (compared to the user's desired
     preallocation size; note that we don't actually preallocate anymore), free
     it so that one big query won't cause us to hold on to a lot of RAM forever.
-    If not, keep the last block so that the next query will hopefully be able to
-    run without allocating memory from the OS.
+    If not, keep a set of blocks sized after the recent statements, so that
+    the next query will hopefully be able to run without allocating memory
+    from the OS.
 
     The factor 5 is pretty much arbitrary, but ends up allowing three
     allocations (1 + 1.5 + 1.5²) under the current allocation policy.
   */
   if (thd->mem_root->allocated_size() < 5 * thd->variables.query_prealloc_size)
-    thd->mem_root->ClearForReuse();
+    thd->mem_root->ClearAndRetainBlocks();
   else
     thd->mem_root->Clear();
 
@@ -1803,8 +1803,9 @@ bool Optimize_table_order::choose_table_order() {
 
   if (straight_join)
     optimize_straight_join(join_tables);
-  else {
+  else if (!reuse_join_order(join_tables)) {
     if (greedy_search(join_tables)) DBUG_RETURN(true);
+    save_join_order();
   }
 
   // Remaining part of this function not needed when processing semi-join nests.
@@ -1946,6 +1947,116 @@ void Optimize_table_order::optimize_straight_join(table_map join_tables) {
   join->best_rowcount = (ha_rows)rowcount;
 }
 
+/**
+  Check whether the join order of this query block is kept across
+  executions, see Saved_join_order.
+
+  Only complete plans without semijoin nests are kept, which
+  optimize_straight_join() can finalize, and only for prepared
+  statements outside of stored programs.
+*/
+
+bool Optimize_table_order::can_save_join_order() const {
+  const Query_arena *const arena = thd->stmt_arena;
+  return emb_sjm_nest == NULL && join->select_lex->sj_nests.is_empty() &&
+         thd->sp_runtime_ctx == NULL &&
+         (arena->state == Query_arena::STMT_PREPARED ||
+          arena->state == Query_arena::STMT_EXECUTED) &&
+         join->tables - join->const_tables >= 2;
+}
+
+/**
+  Use the join order saved by an earlier execution of the prepared
+  statement, if it is still valid, instead of searching for one.
+
+  @param join_tables   set of the tables in the query
+
+  @return true if the saved order was used, false if a join order must be
+          searched for
+*/
+
+bool Optimize_table_order::reuse_join_order(table_map join_tables) {
+  if (!can_save_join_order()) return false;
+
+  const Saved_join_order *const saved = join->select_lex->saved_join_order;
+  const System_variables &variables = thd->variables;
+  bool valid = saved != NULL && saved->table_count == join->tables &&
+               saved->const_table_map == join->const_table_map &&
+               saved->optimizer_switch == variables.optimizer_switch &&
+               saved->search_depth == variables.optimizer_search_depth &&
+               saved->prune_level == variables.optimizer_prune_level;
+
+  JOIN_TAB **const first = join->best_ref + join->const_tables;
+  JOIN_TAB **const last = join->best_ref + join->tables;
+  for (uint idx = join->const_tables; valid && idx < join->tables; idx++) {
+    JOIN_TAB **const pos =
+        std::find_if(first, last, [saved, idx](const JOIN_TAB *tab) {
+          return tab->table_ref->tableno() == saved->tablenos[idx];
+        });
+    if (pos == last) {
+      valid = false;
+      break;
+    }
+    const double rows = std::max(rows2double((*pos)->found_records), 1.0);
+    const double saved_rows = std::max(saved->rows[idx], 1.0);
+    valid = rows <= saved_rows * Saved_join_order::ROWS_FACTOR &&
+            saved_rows <= rows * Saved_join_order::ROWS_FACTOR;
+  }
+
+  if (!valid) {
+    thd->status_var.ps_plan_cache_misses++;
+    return false;
+  }
+
+  // Put the tables in the saved order.
+  for (uint idx = join->const_tables; idx < join->tables; idx++) {
+    JOIN_TAB **const pos =
+        std::find_if(join->best_ref + idx, last, [saved, idx](JOIN_TAB *tab) {
+          return tab->table_ref->tableno() == saved->tablenos[idx];
+        });
+    std::swap(join->best_ref[idx], *pos);
+  }
+
+  thd->status_var.ps_plan_cache_hits++;
+  optimize_straight_join(join_tables);
+  return true;
+}
+
+/**
+  Save the join order found by greedy_search() for later executions of the
+  prepared statement.
+*/
+
+void Optimize_table_order::save_join_order() {
+  if (!can_save_join_order()) return;
+
+  SELECT_LEX *const select_lex = join->select_lex;
+  Saved_join_order *saved = select_lex->saved_join_order;
+  if (saved == NULL || saved->table_count != join->tables) {
+    MEM_ROOT *const mem_root = thd->stmt_arena->mem_root;
+    saved = new (mem_root) Saved_join_order;
+    if (saved == NULL) return;
+    saved->tablenos = static_cast<uint *>(
+        alloc_root(mem_root, sizeof(uint) * join->tables));
+    saved->rows = static_cast<double *>(
+        alloc_root(mem_root, sizeof(double) * join->tables));
+    if (saved->tablenos == NULL || saved->rows == NULL) return;
+    saved->table_count = join->tables;
+    select_lex->saved_join_order = saved;
+  }
+
+  const System_variables &variables = thd->variables;
+  saved->const_table_map = join->const_table_map;
+  saved->optimizer_switch = variables.optimizer_switch;
+  saved->search_depth = variables.optimizer_search_depth;
+  saved->prune_level = variables.optimizer_prune_level;
+  for (uint idx = join->const_tables; idx < join->tables; idx++) {
+    const JOIN_TAB *const tab = join->best_positions[idx].table;
+    saved->tablenos[idx] = tab->table_ref->tableno();
+    saved->rows[idx] = rows2double(tab->found_records);
+  }
+}
+
 /**
   Check whether a semijoin materialization strategy is allowed for
   the current (semi)join table order.
@@ -43,6 +43,35 @@ struct POSITION;
 
 typedef ulonglong nested_join_map;
 
+/**
+  Join order of a query block of a prepared statement, chosen by
+  Optimize_table_order::greedy_search() in an earlier execution.
+
+  Later executions use it instead of searching for a join order again, as
+  long as the optimizer settings are the same, the same tables were found
+  to be const, and the estimated number of rows read from each table is
+  within ROWS_FACTOR of the estimate the order was chosen with. Access
+  methods are still chosen for each execution, along the saved order.
+
+  DDL on the tables makes the statement be reprepared, which drops the
+  saved order together with the query block.
+*/
+struct Saved_join_order {
+  /// Maximum ratio between the estimates of two executions
+  static constexpr double ROWS_FACTOR = 2.0;
+
+  /// Number of tables, const tables included
+  uint table_count;
+  table_map const_table_map;
+  ulonglong optimizer_switch;
+  ulong search_depth;
+  ulong prune_level;
+  /// TABLE_LIST::tableno() of each table, in join order
+  uint *tablenos;
+  /// Estimated number of rows read from each table, in join order
+  double *rows;
+};
+
 /**
   This class determines the optimal join order for tables within
   a basic query block, ie a query specification clause, possibly extended
@@ -136,6 +165,9 @@ class Optimize_table_order {
                         uint idx);
   void backout_nj_state(const table_map remaining_tables, const JOIN_TAB *tab);
   void optimize_straight_join(table_map join_tables);
+  bool can_save_join_order() const;
+  bool reuse_join_order(table_map join_tables);
+  void save_join_order();
   bool greedy_search(table_map remaining_tables);
   bool best_extension_by_limited_search(table_map remaining_tables, uint idx,
                                         uint current_search_depth);
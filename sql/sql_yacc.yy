@@ -1226,6 +1226,8 @@ void warn_about_deprecated_national(THD *thd)
 %token<keyword> DESCRIPTION_SYM               /* MYSQL */
 %token<keyword> ORGANIZATION_SYM              /* MYSQL */
 %token<keyword> REFERENCE_SYM                 /* MYSQL */
+%token  APPROX_COUNT_DISTINCT_SYM             /* MYSQL-FUNC */
+%token  APPROX_PERCENTILE_SYM                 /* MYSQL-FUNC */
 
 
 /*
@@ -9777,6 +9779,15 @@ sum_expr:
           {
             $$= NEW_PTN Item_sum_json_object(@$, $3, $5, $7);
           }
+        | APPROX_COUNT_DISTINCT_SYM '(' in_sum_expr ')' opt_windowing_clause
+          {
+            $$= NEW_PTN Item_sum_approx_count_distinct(@$, $3, $5);
+          }
+        | APPROX_PERCENTILE_SYM '(' in_sum_expr ',' in_sum_expr ')'
+          opt_windowing_clause
+          {
+            $$= NEW_PTN Item_sum_approx_percentile(@$, $3, $5, $7);
+          }
         | BIT_XOR  '(' in_sum_expr ')' opt_windowing_clause
           {
             $$= NEW_PTN Item_sum_xor(@$, $3, $5);
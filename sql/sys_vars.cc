@@ -99,6 +99,7 @@
 #include "sql/log_event.h"  // MAX_MAX_ALLOWED_PACKET
 #include "sql/mdl.h"
 #include "sql/my_decimal.h"
+#include "sql/opt_costconstantcache.h"  // calibrate_optimizer_cost_constants
 #include "sql/opt_trace_context.h"
 #include "sql/options_mysqld.h"
 #include "sql/protocol_classic.h"
@@ -650,6 +651,16 @@ static Sys_var_ulong Sys_pfs_max_digest_sample_age(
     VALID_RANGE(0, 1024 * 1024), DEFAULT(60), BLOCK_SIZE(1),
     PFS_TRAILING_PROPERTIES);
 
+static Sys_var_ulong Sys_pfs_statement_sample_rate(
+    "performance_schema_statement_sample_rate",
+    "Collect stage and wait events for one in this many top level statements"
+    " of each thread, and scale the summaries of stages and waits"
+    " accordingly. Statement events and digests are always collected."
+    " When the value is 1, every statement is instrumented.",
+    GLOBAL_VAR(pfs_param.m_statement_sample_rate), CMD_LINE(REQUIRED_ARG),
+    VALID_RANGE(1, 1024 * 1024), DEFAULT(1), BLOCK_SIZE(1),
+    PFS_TRAILING_PROPERTIES);
+
 static Sys_var_long Sys_pfs_connect_attrs_size(
     "performance_schema_session_connect_attrs_size",
     "Size of session attribute string buffer per thread."
@@ -1266,6 +1277,21 @@ static Sys_var_bool Sys_binlog_rows_query(
     SESSION_VAR(binlog_rows_query_log_events), CMD_LINE(OPT_ARG),
     DEFAULT(false), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(check_has_super));
 
+static Sys_var_bool Sys_binlog_trx_compression(
+    "binlog_transaction_compression",
+    "Write the events of each transaction logged in row format to the "
+    "binary log compressed, as a single Transaction_payload event.",
+    SESSION_VAR(binlog_trx_compression), CMD_LINE(OPT_ARG), DEFAULT(false),
+    NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(check_has_super));
+
+static Sys_var_uint Sys_binlog_trx_compression_level(
+    "binlog_transaction_compression_level",
+    "The zlib compression level used when binlog_transaction_compression "
+    "is enabled, from 1 (fastest) to 9 (smallest).",
+    SESSION_VAR(binlog_trx_compression_level), CMD_LINE(REQUIRED_ARG),
+    VALID_RANGE(1, 9), DEFAULT(6), BLOCK_SIZE(1), NO_MUTEX_GUARD,
+    NOT_IN_BINLOG, ON_CHECK(check_has_super));
+
 static Sys_var_bool Sys_binlog_order_commits(
     "binlog_order_commits",
     "Issue internal commit calls in the same order as transactions are"
@@ -2853,6 +2879,28 @@ static Sys_var_ulong Sys_optimizer_trace_max_mem_size(
     SESSION_VAR(optimizer_trace_max_mem_size), CMD_LINE(REQUIRED_ARG),
     VALID_RANGE(0, ULONG_MAX), DEFAULT(1024 * 1024), BLOCK_SIZE(1));
 
+static bool update_optimizer_cost_calibration(sys_var *, THD *,
+                                              enum_var_type) {
+  /*
+    The benchmarks take a while, so do not block the other sessions'
+    access to system variables meanwhile.
+  */
+  mysql_mutex_unlock(&LOCK_global_system_variables);
+  calibrate_optimizer_cost_constants();
+  mysql_mutex_lock(&LOCK_global_system_variables);
+  return false;
+}
+
+static Sys_var_bool Sys_optimizer_cost_calibration(
+    "optimizer_cost_calibration",
+    "Measure the optimizer cost constants on this server at startup and "
+    "whenever this variable is set to ON, and use the measured values "
+    "instead of the defaults. Values set in the mysql.server_cost and "
+    "mysql.engine_cost tables take precedence",
+    GLOBAL_VAR(opt_optimizer_cost_calibration), CMD_LINE(OPT_ARG),
+    DEFAULT(false), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(NULL),
+    ON_UPDATE(update_optimizer_cost_calibration));
+
 static Sys_var_charptr Sys_pid_file(
     "pid_file", "Pid file used by safe_mysqld",
     READ_ONLY NON_PERSIST GLOBAL_VAR(pidfile_name_ptr), CMD_LINE(REQUIRED_ARG),
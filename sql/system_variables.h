@@ -299,6 +299,8 @@ struct System_variables {
 
   bool sysdate_is_now;
   bool binlog_rows_query_log_events;
+  bool binlog_trx_compression;
+  uint binlog_trx_compression_level;
 
   double long_query_time_double;
 
@@ -406,6 +408,14 @@ struct System_status_var {
   ulonglong max_execution_time_set;
   ulonglong max_execution_time_set_failed;
 
+  /* Join orders of prepared statements reused and searched for. */
+  ulonglong ps_plan_cache_hits;
+  ulonglong ps_plan_cache_misses;
+
+  /* Blocks of the statement MEM_ROOT allocated from the OS and reused. */
+  ulonglong mem_root_blocks_allocated;
+  ulonglong mem_root_blocks_reused;
+
   /* Number of statements sent from the client. */
   ulonglong questions;
 
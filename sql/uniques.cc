@@ -49,6 +49,7 @@
 #include "my_compiler.h"
 #include "my_dbug.h"
 #include "my_io.h"
+#include "my_murmur3.h"
 #include "my_tree.h"  // element_count
 #include "mysql/psi/mysql_file.h"
 #include "mysql/psi/psi_base.h"
@@ -351,22 +352,163 @@ int unique_write_to_ptrs(uchar *key, element_count, Unique *unique) {
   return 0;
 }
 
+/// Number of elements the hash set makes room for on its first insert.
+static const ulong UNIQUE_HASH_SET_MIN_CAPACITY = 64;
+
+bool Unique_hash_set::insert(const void *key) {
+  if (m_count == m_capacity && grow()) return true;
+
+  const uchar *key_ptr = static_cast<const uchar *>(key);
+  const ulong mask = m_slot_count - 1;
+
+  for (ulong i = murmur3_32(key_ptr, m_element_size, 0) & mask;;
+       i = (i + 1) & mask) {
+    const uint32 slot = m_slots[i];
+    if (slot == 0) {
+      memcpy(element(m_count), key_ptr, m_element_size);
+      m_slots[i] = static_cast<uint32>(++m_count);
+      return false;
+    }
+    if (memcmp(element(slot - 1), key_ptr, m_element_size) == 0) return false;
+  }
+}
+
+/**
+  Make room for more elements, doubling the capacity up to the maximum
+  number of elements, and rehash the elements already in the set.
+
+  @retval false  Success
+  @retval true   Out of memory
+*/
+bool Unique_hash_set::grow() {
+  const ulong capacity = std::max(
+      std::min(std::max(2 * m_capacity, UNIQUE_HASH_SET_MIN_CAPACITY),
+               m_max_elements),
+      m_count + 1);
+
+  /* Keep the load factor of the slots below one half. */
+  ulong slot_count = UNIQUE_HASH_SET_MIN_CAPACITY;
+  while (slot_count <= 2 * capacity) slot_count *= 2;
+
+  if (slot_count != m_slot_count) {
+    uint32 *slots = static_cast<uint32 *>(
+        my_malloc(key_memory_Unique_sort_buffer, slot_count * sizeof(uint32),
+                  MYF(MY_ZEROFILL)));
+    if (slots == nullptr) return true;
+
+    const ulong mask = slot_count - 1;
+    for (ulong idx = 0; idx < m_count; ++idx) {
+      ulong i = murmur3_32(element(idx), m_element_size, 0) & mask;
+      while (slots[i] != 0) i = (i + 1) & mask;
+      slots[i] = static_cast<uint32>(idx + 1);
+    }
+
+    my_free(m_slots);
+    m_slots = slots;
+    m_slot_count = slot_count;
+  }
+
+  /* Allocate at least one byte, elements of size 0 are legal. */
+  uchar *elements = static_cast<uchar *>(my_realloc(
+      key_memory_Unique_sort_buffer, m_elements,
+      std::max<size_t>(static_cast<size_t>(capacity) * m_element_size, 1),
+      MYF(0)));
+  if (elements == nullptr) return true;
+
+  m_elements = elements;
+  m_capacity = capacity;
+  return false;
+}
+
+int Unique_hash_set::walk_sorted(qsort2_cmp compare, const void *compare_arg,
+                                 tree_walk_action action,
+                                 void *walk_action_arg) {
+  if (m_count == 0) return 0;
+
+  uint32 *order = static_cast<uint32 *>(my_malloc(
+      key_memory_Unique_sort_buffer, m_count * sizeof(uint32), MYF(0)));
+  if (order == nullptr) return 1;
+
+  for (ulong idx = 0; idx < m_count; ++idx)
+    order[idx] = static_cast<uint32>(idx);
+  std::sort(order, order + m_count, [&](uint32 a, uint32 b) {
+    return compare(compare_arg, element(a), element(b)) < 0;
+  });
+
+  int res = 0;
+  for (ulong idx = 0; idx < m_count && res == 0; ++idx)
+    res = action(element(order[idx]), 1, walk_action_arg);
+
+  my_free(order);
+  return res;
+}
+
+void Unique_hash_set::clear() {
+  /*
+    Release the memory rather than zero the slots when only a small part
+    of them was used, so that one large group does not make clearing the
+    set expensive for all the groups that follow.
+  */
+  if (m_count <= m_capacity / 4)
+    free_memory();
+  else
+    memset(m_slots, 0, m_slot_count * sizeof(uint32));
+  m_count = 0;
+}
+
+void Unique_hash_set::free_memory() {
+  my_free(m_elements);
+  my_free(m_slots);
+  m_elements = nullptr;
+  m_slots = nullptr;
+  m_capacity = 0;
+  m_slot_count = 0;
+  m_count = 0;
+}
+
+/**
+  Number of elements a Unique keeps in memory before it dumps them to the
+  file.
+
+  @param max_in_memory_size  memory available to the Unique
+  @param size                size of the elements in bytes
+  @param use_hash            whether the elements are kept in a hash set
+                             rather than in a TREE
+*/
+static ulong unique_max_elements(ulonglong max_in_memory_size, uint size,
+                                 bool use_hash) {
+  /*
+    If you change the following, change it in get_max_elements function, too.
+  */
+  if (!use_hash)
+    return (ulong)(max_in_memory_size /
+                   ALIGN_SIZE(sizeof(TREE_ELEMENT) + size));
+
+  /* The hash set addresses its elements with 32 bit indexes. */
+  return (ulong)std::min<ulonglong>(
+      max_in_memory_size / (size + Unique_hash_set::OVERHEAD_PER_ELEMENT),
+      UINT_MAX32 / 4);
+}
+
 Unique::Unique(qsort2_cmp comp_func, void *comp_func_fixed_arg, uint size_arg,
-               ulonglong max_in_memory_size_arg)
+               ulonglong max_in_memory_size_arg, bool use_hash_arg)
     : file_ptrs(PSI_INSTRUMENT_ME),
+      max_elements(
+          unique_max_elements(max_in_memory_size_arg, size_arg, use_hash_arg)),
       max_in_memory_size(max_in_memory_size_arg),
+      hash_set(size_arg, max_elements + 1),
+      use_hash(use_hash_arg),
       record_pointers(NULL),
       size(size_arg),
       elements(0) {
   my_b_clear(&file);
-  init_tree(&tree, (ulong)(max_in_memory_size / 16), 0, size, comp_func, 0,
-            NULL, comp_func_fixed_arg);
-
   /*
-    If you change the following, change it in get_max_elements function, too.
+    The tree is set up even when the hash set is used, its comparison
+    function is used to sort and merge the elements.
   */
-  max_elements =
-      (ulong)(max_in_memory_size / ALIGN_SIZE(sizeof(TREE_ELEMENT) + size));
+  init_tree(&tree, use_hash ? 0 : (ulong)(max_in_memory_size / 16), 0, size,
+            comp_func, 0, NULL, comp_func_fixed_arg);
+
   (void)open_cached_file(&file, mysql_tmpdir, TEMP_PREFIX, DISK_BUFFER_SIZE,
                          MYF(MY_WME));
 }
@@ -628,25 +770,41 @@ Unique::~Unique() {
 /* Write tree to disk; clear tree */
 bool Unique::flush() {
   Merge_chunk file_ptr;
-  elements += tree.elements_in_tree;
-  file_ptr.set_rowcount(tree.elements_in_tree);
+  elements += elements_in_tree();
+  file_ptr.set_rowcount(elements_in_tree());
   file_ptr.set_file_position(my_b_tell(&file));
 
-  if (tree_walk(&tree, (tree_walk_action)unique_write_to_file, (void *)this,
-                left_root_right) ||
+  if (walk_in_memory((tree_walk_action)unique_write_to_file, (void *)this) ||
       file_ptrs.push_back(file_ptr))
     return 1;
-  delete_tree(&tree);
+  if (use_hash)
+    hash_set.clear();
+  else
+    delete_tree(&tree);
   return 0;
 }
 
+/*
+  Walk the elements held in memory in sorted order, without touching those
+  that were flushed to the file.
+*/
+bool Unique::walk_in_memory(tree_walk_action action, void *walk_action_arg) {
+  if (use_hash)
+    return hash_set.walk_sorted(tree.compare, tree.custom_arg, action,
+                                walk_action_arg);
+  return tree_walk(&tree, action, walk_action_arg, left_root_right);
+}
+
 /*
   Clear the tree and the file.
   You must call reset() if you want to reuse Unique after walk().
 */
 
 void Unique::reset() {
-  reset_tree(&tree);
+  if (use_hash)
+    hash_set.clear();
+  else
+    reset_tree(&tree);
   /*
     If elements != 0, some trees were stored in the file (see how
     flush() works). Note, that we can not count on my_b_tell(&file) == 0
@@ -852,7 +1010,7 @@ bool Unique::walk(tree_walk_action action, void *walk_action_arg) {
   uchar *merge_buffer;
 
   if (elements == 0) /* the whole tree is in memory */
-    return tree_walk(&tree, action, walk_action_arg, left_root_right);
+    return walk_in_memory(action, walk_action_arg);
 
   /* flush current tree to the file to have some memory for merge buffer */
   if (flush()) return 1;
@@ -884,18 +1042,18 @@ bool Unique::walk(tree_walk_action action, void *walk_action_arg) {
 */
 
 bool Unique::get(TABLE *table) {
-  table->unique_result.found_records = elements + tree.elements_in_tree;
+  table->unique_result.found_records = elements + elements_in_tree();
 
   if (my_b_tell(&file) == 0) {
     /* Whole tree is in memory;  Don't use disk if you don't need to */
     DBUG_ASSERT(table->unique_result.sorted_result == NULL);
     table->unique_result.sorted_result.reset(
         (uchar *)my_malloc(key_memory_Filesort_info_record_pointers,
-                           size * tree.elements_in_tree, MYF(0)));
+                           size * elements_in_tree(), MYF(0)));
     if ((record_pointers = table->unique_result.sorted_result.get())) {
-      (void)tree_walk(&tree, (tree_walk_action)unique_write_to_ptrs, this,
-                      left_root_right);
-      return 0;
+      if (!walk_in_memory((tree_walk_action)unique_write_to_ptrs, this))
+        return 0;
+      table->unique_result.sorted_result.reset();
     }
   }
   /* Not enough memory; Save the result to file && free memory used by tree */
@@ -38,12 +38,87 @@
 class Cost_model_table;
 struct TABLE;
 
+/**
+  Open addressing hash set of fixed size elements.
+
+  Used by Unique instead of a TREE when elements that compare equal are
+  also equal byte by byte. An insert costs a single hash probe instead of
+  a descent of a red-black tree, and the elements are only sorted when
+  they are read back or written to disk.
+*/
+
+class Unique_hash_set {
+ public:
+  /**
+    @param element_size  size of the elements in bytes
+    @param max_elements  maximum number of elements the set will hold
+  */
+  Unique_hash_set(uint element_size, ulong max_elements)
+      : m_element_size(element_size),
+        m_max_elements(max_elements),
+        m_elements(nullptr),
+        m_capacity(0),
+        m_slots(nullptr),
+        m_slot_count(0),
+        m_count(0) {}
+  ~Unique_hash_set() { free_memory(); }
+
+  /**
+    Add an element to the set unless an equal one is already there.
+
+    @retval false  Success
+    @retval true   Out of memory
+  */
+  bool insert(const void *key);
+
+  /// Number of distinct elements in the set.
+  ulong elements() const { return m_count; }
+
+  /**
+    Call a function for each element, in the order given by a comparison
+    function.
+
+    @return the first non-zero value returned by action, 1 if out of
+    memory, otherwise 0
+  */
+  int walk_sorted(qsort2_cmp compare, const void *compare_arg,
+                  tree_walk_action action, void *walk_action_arg);
+
+  /// Remove all elements.
+  void clear();
+
+  /// Bytes used per element on top of the element itself.
+  static const size_t OVERHEAD_PER_ELEMENT = 3 * sizeof(uint32);
+
+ private:
+  uchar *element(ulong idx) const {
+    return m_elements + static_cast<size_t>(idx) * m_element_size;
+  }
+  bool grow();
+  void free_memory();
+
+  const uint m_element_size;
+  const ulong m_max_elements;
+  /// Elements in insertion order.
+  uchar *m_elements;
+  /// Number of elements m_elements can hold.
+  ulong m_capacity;
+  /// Hash slots holding one plus the index of an element, or 0 if empty.
+  uint32 *m_slots;
+  /// Number of slots, a power of two larger than twice m_capacity.
+  ulong m_slot_count;
+  ulong m_count;
+};
+
 /*
    Unique -- class for unique (removing of duplicates).
    Puts all values to the TREE. If the tree becomes too big,
    it's dumped to the file. User can request sorted values, or
    just iterate through them. In the last case tree merging is performed in
    memory simultaneously with iteration, so it should be ~2-3x faster.
+   If elements that compare equal are always equal byte by byte, the
+   caller may ask for them to be kept in a Unique_hash_set instead, which
+   is only sorted when it is dumped to the file or iterated.
  */
 
 class Unique {
@@ -52,20 +127,27 @@ class Unique {
   ulonglong max_in_memory_size;
   IO_CACHE file;
   TREE tree;
+  /// Used instead of tree if use_hash is set.
+  Unique_hash_set hash_set;
+  const bool use_hash;
   uchar *record_pointers;
   bool flush();
+  bool walk_in_memory(tree_walk_action action, void *walk_action_arg);
   uint size;
 
  public:
   ulong elements;
   Unique(qsort2_cmp comp_func, void *comp_func_fixed_arg, uint size_arg,
-         ulonglong max_in_memory_size_arg);
+         ulonglong max_in_memory_size_arg, bool use_hash_arg = false);
   ~Unique();
-  ulong elements_in_tree() { return tree.elements_in_tree; }
+  ulong elements_in_tree() {
+    return use_hash ? hash_set.elements() : tree.elements_in_tree;
+  }
   inline bool unique_add(void *ptr) {
     DBUG_ENTER("unique_add");
-    DBUG_PRINT("info", ("tree %u - %lu", tree.elements_in_tree, max_elements));
-    if (tree.elements_in_tree > max_elements && flush()) DBUG_RETURN(1);
+    DBUG_PRINT("info", ("tree %lu - %lu", elements_in_tree(), max_elements));
+    if (elements_in_tree() > max_elements && flush()) DBUG_RETURN(1);
+    if (use_hash) DBUG_RETURN(hash_set.insert(ptr));
     DBUG_RETURN(!tree_insert(&tree, ptr, 0, tree.custom_arg));
   }
 
@@ -87,12 +87,15 @@ const uint ARCH_PAGE_FILE_CAPACITY = 8 * 1024;
 dberr_t Page_Arch_Client_Ctx::start() {
   dberr_t err;
 
-  err = arch_page_sys->start(&m_group, &m_start_lsn, &m_start_pos, false);
+  err = arch_page_sys->start(&m_group, &m_start_lsn, &m_start_pos,
+                             m_is_durable);
 
   if (err != DB_SUCCESS) {
     return (err);
   }
 
+  m_group_lsn = m_group->get_begin_lsn();
+
   m_state = ARCH_CLIENT_STATE_STARTED;
 
   ib::info(ER_IB_MSG_20) << "Clone Start PAGE ARCH : start LSN : "
@@ -102,6 +105,20 @@ dberr_t Page_Arch_Client_Ctx::start() {
   return (DB_SUCCESS);
 }
 
+/** Move the start position back so that #get_pages also returns the
+pages modified after an earlier LSN. Must be called after #start.
+@param[in]	lsn	LSN to get the modified pages from
+@return true, if the group has been tracking pages since lsn */
+bool Page_Arch_Client_Ctx::rewind(lsn_t lsn) {
+  ut_ad(m_state == ARCH_CLIENT_STATE_STARTED);
+
+  if (lsn >= m_start_lsn) {
+    return (true);
+  }
+
+  return (arch_page_sys->get_reset_pos(m_group, lsn, &m_start_pos));
+}
+
 /** Stop dirty page tracking and archiving */
 dberr_t Page_Arch_Client_Ctx::stop() {
   dberr_t err;
@@ -276,7 +293,7 @@ void Page_Arch_Client_Ctx::release() {
 
   ut_ad(m_state == ARCH_CLIENT_STATE_STOPPED);
 
-  arch_page_sys->release(m_group, false);
+  arch_page_sys->release(m_group, m_is_durable);
   m_state = ARCH_CLIENT_STATE_INIT;
 }
 
@@ -884,6 +901,7 @@ dberr_t Arch_Page_Sys::start(Arch_Group **group, lsn_t *start_lsn,
     m_write_pos.init();
 
     m_last_lsn = log_sys_lsn;
+    m_reset_points.clear();
 
     m_current_group =
         UT_NEW(Arch_Group(log_sys_lsn, ARCH_PAGE_FILE_HDR_SIZE, &m_mutex),
@@ -927,6 +945,13 @@ dberr_t Arch_Page_Sys::start(Arch_Group **group, lsn_t *start_lsn,
   }
 
   if (!attach_to_current) {
+    Arch_Reset_Point reset_point;
+
+    reset_point.m_lsn = m_last_lsn;
+    reset_point.m_pos = m_last_pos;
+
+    m_reset_points.push_back(reset_point);
+
     m_state = ARCH_STATE_ACTIVE;
     arch_oper_mutex_exit();
 
@@ -1038,6 +1063,80 @@ void Arch_Page_Sys::release(Arch_Group *group, bool is_durable) {
   arch_mutex_exit();
 }
 
+/** Start or stop durable page tracking. While it is on, the current
+group stays active and keeps its archived files, so that a clone can
+get the pages modified since an earlier clone started. Caller must
+serialize the calls.
+@param[in]	enable	true to start, false to stop
+@return error code */
+dberr_t Arch_Page_Sys::set_durable(bool enable) {
+  if (enable == is_durable()) {
+    return (DB_SUCCESS);
+  }
+
+  if (!enable) {
+    auto err = m_durable_ctx->stop();
+
+    /* Fails only if the archiver was aborted at shutdown. */
+    if (err == DB_SUCCESS) {
+      m_durable_ctx->release();
+    }
+
+    UT_DELETE(m_durable_ctx);
+    m_durable_ctx = nullptr;
+
+    return (err);
+  }
+
+  auto ctx = UT_NEW(Page_Arch_Client_Ctx(true), mem_key_archive);
+
+  if (ctx == nullptr) {
+    my_error(ER_OUTOFMEMORY, MYF(0), sizeof(Page_Arch_Client_Ctx));
+    return (DB_OUT_OF_MEMORY);
+  }
+
+  auto err = ctx->start();
+
+  if (err != DB_SUCCESS) {
+    UT_DELETE(ctx);
+    return (err);
+  }
+
+  m_durable_ctx = ctx;
+
+  return (DB_SUCCESS);
+}
+
+/** Get the position from which the pages modified after an LSN are
+archived in a group.
+@param[in]	group	archive group
+@param[in]	lsn	LSN to look up
+@param[out]	pos	position of the last reset point at or before lsn
+@return true, if the group has been tracking pages since lsn */
+bool Arch_Page_Sys::get_reset_pos(Arch_Group *group, lsn_t lsn,
+                                  Arch_Page_Pos *pos) {
+  bool found = false;
+
+  arch_mutex_enter();
+
+  /* Only the current group is still tracking pages. A group which
+  went idle has a gap after its last reset point. */
+  if (group == m_current_group) {
+    for (auto &reset_point : m_reset_points) {
+      if (reset_point.m_lsn > lsn) {
+        break;
+      }
+
+      *pos = reset_point.m_pos;
+      found = true;
+    }
+  }
+
+  arch_mutex_exit();
+
+  return (found);
+}
+
 /** Archive dirty page IDs in current group.
 This interface is for archiver background task to flush page archive
 data to disk by calling it repeatedly over time.
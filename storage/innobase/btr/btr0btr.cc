@@ -39,6 +39,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "btr0cur.h"
 #include "btr0pcur.h"
 #include "btr0sea.h"
+#include "buf0rea.h"
 #include "buf0stats.h"
 #include "dict0boot.h"
 #include "fsp0sysspace.h"
@@ -508,6 +509,35 @@ ulint btr_get_size(dict_index_t *index, /*!< in: index */
   return (n);
 }
 
+/** Issues asynchronous reads of the leaf pages of an index, ahead of a scan
+of the index. Only the pages of the leaf segment are read, and pages which
+are already in the buffer pool are skipped.
+@param[in]	index		index
+@param[in]	max_pages	maximum number of pages to read
+@return number of page read requests queued */
+ulint btr_read_ahead_leaves(dict_index_t *index, page_no_t max_pages) {
+  fseg_page_ranges_t ranges;
+  mtr_t mtr;
+
+  mtr_start(&mtr);
+
+  mtr_s_lock(dict_index_get_lock(index), &mtr);
+
+  if (index->page != FIL_NULL && !dict_index_is_online_ddl(index) &&
+      index->is_committed()) {
+    page_t *root = btr_root_get(index, &mtr);
+
+    /* Collect the pages in the mini-transaction, but issue the reads
+    after it, so that the tablespace is not latched meanwhile. */
+    fseg_get_used_page_ranges(root + PAGE_HEADER + PAGE_BTR_SEG_LEAF,
+                              max_pages, &ranges, &mtr);
+  }
+
+  mtr_commit(&mtr);
+
+  return (ranges.empty() ? 0 : buf_read_ahead_ranges(index->space, ranges));
+}
+
 /** Frees a page used in an ibuf tree. Puts the page to the free list of the
  ibuf tree. */
 static void btr_page_free_for_ibuf(
@@ -31,11 +31,18 @@ this program; if not, write to the Free Software Foundation, Inc.,
  *******************************************************/
 
 #include "btr0bulk.h"
+
+#include <algorithm>
+#include <cmath>
+
 #include "btr0btr.h"
 #include "btr0cur.h"
 #include "btr0pcur.h"
+#include "gis0rtree.h"
 #include "ibuf0ibuf.h"
 #include "lob0lob.h"
+#include "row0merge.h"
+#include "row0row.h"
 
 /** Innodb B-tree index fill factor for bulk load. */
 long innobase_fill_factor;
@@ -91,13 +98,14 @@ dberr_t PageBulk::init() {
     new_page_zip = buf_block_get_page_zip(new_block);
     new_page_no = page_get_page_no(new_page);
 
-    ut_ad(!dict_index_is_spatial(m_index));
     ut_ad(!dict_index_is_sdi(m_index));
 
-    if (new_page_zip) {
+    if (dict_index_is_spatial(m_index)) {
+      /* R-tree pages also need the split sequence number. */
+      btr_page_create(new_block, new_page_zip, m_index, m_level, mtr);
+    } else if (new_page_zip) {
       page_create_zip(new_block, m_index, m_level, 0, mtr, FIL_PAGE_INDEX);
     } else {
-      ut_ad(!dict_index_is_spatial(m_index));
       page_create(new_block, mtr, dict_table_is_comp(m_index->table),
                   FIL_PAGE_INDEX);
       btr_page_set_level(new_page, NULL, m_level, mtr);
@@ -173,7 +181,9 @@ void PageBulk::insert(const rec_t *rec, ulint *offsets) {
     ulint *old_offsets =
         rec_get_offsets(old_rec, m_index, NULL, ULINT_UNDEFINED, &m_heap);
 
-    ut_ad(cmp_rec_rec(rec, old_rec, offsets, old_offsets, m_index) > 0);
+    /* Node pointers of an R-tree may be equal. */
+    ut_ad(cmp_rec_rec(rec, old_rec, offsets, old_offsets, m_index) > 0 ||
+          (dict_index_is_spatial(m_index) && m_level > 0));
   }
 
   m_total_data += rec_size;
@@ -273,7 +283,6 @@ void PageBulk::finish() {
   page_dir_slot_set_rec(slot, page_get_supremum_rec(m_page));
   page_dir_slot_set_n_owned(slot, NULL, count + 1);
 
-  ut_ad(!dict_index_is_spatial(m_index));
   page_dir_set_n_slots(m_page, NULL, 2 + slot_index);
   page_header_set_ptr(m_page, NULL, PAGE_HEAP_TOP, m_heap_top);
   page_dir_set_n_heap(m_page, NULL, PAGE_HEAP_NO_USER_LOW + m_rec_no);
@@ -321,8 +330,19 @@ dtuple_t *PageBulk::getNodePtr() {
   /* Create node pointer */
   first_rec = page_rec_get_next(page_get_infimum_rec(m_page));
   ut_a(page_rec_is_user_rec(first_rec));
-  node_ptr =
-      dict_index_build_node_ptr(m_index, first_rec, m_page_no, m_heap, m_level);
+
+  if (dict_index_is_spatial(m_index)) {
+    /* The node pointer of an R-tree page holds the MBR of
+    all the records in the page. */
+    rtr_mbr_t mbr;
+
+    rtr_page_cal_mbr(m_index, m_block, &mbr, m_heap);
+    node_ptr = rtr_index_build_node_ptr(m_index, &mbr, first_rec, m_page_no,
+                                        m_heap, m_level);
+  } else {
+    node_ptr = dict_index_build_node_ptr(m_index, first_rec, m_page_no, m_heap,
+                                         m_level);
+  }
 
   return (node_ptr);
 }
@@ -524,8 +544,6 @@ dberr_t PageBulk::storeExt(const big_rec_t *big_rec, ulint *offsets) {
 /** Release block by commiting mtr
 Note: log_free_check requires holding no lock/latch in current thread. */
 void PageBulk::release() {
-  ut_ad(!dict_index_is_spatial(m_index));
-
   /* We fix the block because we will re-pin it soon. */
   buf_block_buf_fix_inc(m_block, __FILE__, __LINE__);
 
@@ -906,3 +924,900 @@ dberr_t BtrBulk::finish(dberr_t err) {
   ut_ad(err != DB_SUCCESS || btr_validate_index(m_index, NULL, false));
   return (err);
 }
+
+/** Header of an entry in a run of RtreeBulk. The record follows it. */
+struct rtr_bulk_run_entry_t {
+  /** x coordinate of the centre of the MBR */
+  double x;
+  /** y coordinate of the centre of the MBR */
+  double y;
+  /** size of the record */
+  ulint size;
+  /** size of the record header, before the record origin */
+  ulint extra_size;
+};
+
+/** Writes the entries of runs to a merge file, a block at a time. */
+class RtreeRunWriter {
+ public:
+  /** Constructor
+  @param[in]	fd	merge file
+  @param[in,out]	block	block buffer, which holds the block of
+                        offset if it is not a block boundary
+  @param[in]	offset	where to write, in bytes */
+  RtreeRunWriter(int fd, row_merge_block_t *block, os_offset_t offset)
+      : m_fd(fd),
+        m_block(block),
+        m_block_no(offset / srv_sort_buf_size),
+        m_pos(offset % srv_sort_buf_size) {}
+
+  /** Write an entry.
+  @param[in]	header	header of the entry
+  @param[in]	rec	record, starting with its header
+  @return true on success */
+  bool write(const rtr_bulk_run_entry_t &header, const byte *rec) {
+    return (write(&header, sizeof header) && write(rec, header.size));
+  }
+
+  /** Write the block which is not full yet.
+  @return true on success */
+  bool flush() {
+    return (m_pos == 0 || row_merge_write(m_fd, m_block_no, m_block));
+  }
+
+  /** @return offset of the next entry, in bytes */
+  os_offset_t offset() const {
+    return (static_cast<os_offset_t>(m_block_no) * srv_sort_buf_size + m_pos);
+  }
+
+ private:
+  /** Write data, which may span blocks.
+  @param[in]	data	data to write
+  @param[in]	len	length of data
+  @return true on success */
+  bool write(const void *data, ulint len) {
+    const byte *ptr = static_cast<const byte *>(data);
+
+    while (len > 0) {
+      const ulint n = std::min(len, srv_sort_buf_size - m_pos);
+
+      memcpy(m_block + m_pos, ptr, n);
+      m_pos += n;
+      ptr += n;
+      len -= n;
+
+      if (m_pos == srv_sort_buf_size) {
+        if (!row_merge_write(m_fd, m_block_no, m_block)) {
+          return (false);
+        }
+
+        ++m_block_no;
+        m_pos = 0;
+      }
+    }
+
+    return (true);
+  }
+
+  /** Merge file */
+  int m_fd;
+
+  /** Block buffer */
+  row_merge_block_t *m_block;
+
+  /** Block being written */
+  ulint m_block_no;
+
+  /** Position in the block */
+  ulint m_pos;
+};
+
+/** Reads the entries of a run from a merge file, a block at a time. */
+class RtreeRunReader {
+ public:
+  /** Constructor
+  @param[in]	fd	merge file
+  @param[in,out]	block	block buffer
+  @param[in]	run	run to read */
+  RtreeRunReader(int fd, row_merge_block_t *block, const RtreeBulk::Run &run)
+      : m_fd(fd),
+        m_block(block),
+        m_block_no(run.offset / srv_sort_buf_size),
+        m_pos(run.offset % srv_sort_buf_size),
+        m_loaded(false),
+        m_n_left(run.n_entries) {}
+
+  /** @return true if all the entries of the run were read */
+  bool at_end() const { return (m_n_left == 0); }
+
+  /** Read the header of the next entry.
+  @param[out]	header	header of the entry
+  @return true on success */
+  bool read_header(rtr_bulk_run_entry_t *header) {
+    ut_ad(m_n_left > 0);
+    --m_n_left;
+    return (read(header, sizeof *header));
+  }
+
+  /** Read the record of the entry whose header was read.
+  @param[in]	header	header of the entry
+  @param[out]	rec	record, starting with its header
+  @return true on success */
+  bool read_rec(const rtr_bulk_run_entry_t &header, byte *rec) {
+    return (read(rec, header.size));
+  }
+
+ private:
+  /** Read data, which may span blocks.
+  @param[out]	data	data read
+  @param[in]	len	length of data
+  @return true on success */
+  bool read(void *data, ulint len) {
+    byte *ptr = static_cast<byte *>(data);
+
+    while (len > 0) {
+      if (m_pos == srv_sort_buf_size) {
+        ++m_block_no;
+        m_pos = 0;
+        m_loaded = false;
+      }
+
+      if (!m_loaded) {
+        if (!row_merge_read(m_fd, m_block_no, m_block)) {
+          return (false);
+        }
+
+        m_loaded = true;
+      }
+
+      const ulint n = std::min(len, srv_sort_buf_size - m_pos);
+
+      memcpy(ptr, m_block + m_pos, n);
+      m_pos += n;
+      ptr += n;
+      len -= n;
+    }
+
+    return (true);
+  }
+
+  /** Merge file */
+  int m_fd;
+
+  /** Block buffer */
+  row_merge_block_t *m_block;
+
+  /** Block being read */
+  ulint m_block_no;
+
+  /** Position in the block */
+  ulint m_pos;
+
+  /** Whether m_block holds the block m_block_no */
+  bool m_loaded;
+
+  /** Number of entries not read yet */
+  ulint m_n_left;
+};
+
+/** Merge two runs sorted on x into one.
+@param[in]	fd	merge file of the runs
+@param[in,out]	block_a	block buffer for the first run
+@param[in,out]	block_b	block buffer for the second run
+@param[in]	a	first run
+@param[in]	b	second run, may be empty
+@param[in,out]	writer	writer of the merged run
+@return true on success */
+static bool rtr_bulk_merge_two_runs(int fd, row_merge_block_t *block_a,
+                                    row_merge_block_t *block_b,
+                                    const RtreeBulk::Run &a,
+                                    const RtreeBulk::Run &b,
+                                    RtreeRunWriter *writer) {
+  RtreeRunReader readers[2] = {RtreeRunReader(fd, block_a, a),
+                               RtreeRunReader(fd, block_b, b)};
+  rtr_bulk_run_entry_t headers[2];
+  bool has_header[2] = {false, false};
+  std::vector<byte, ut_allocator<byte>> rec;
+
+  for (;;) {
+    for (ulint i = 0; i < 2; i++) {
+      if (!has_header[i] && !readers[i].at_end()) {
+        if (!readers[i].read_header(&headers[i])) {
+          return (false);
+        }
+
+        has_header[i] = true;
+      }
+    }
+
+    if (!has_header[0] && !has_header[1]) {
+      return (true);
+    }
+
+    /* Take the first run on ties, which keeps the merge stable. */
+    const ulint i =
+        !has_header[1] || (has_header[0] && headers[0].x <= headers[1].x) ? 0
+                                                                          : 1;
+
+    rec.resize(headers[i].size);
+
+    if (!readers[i].read_rec(headers[i], rec.data()) ||
+        !writer->write(headers[i], rec.data())) {
+      return (false);
+    }
+
+    has_header[i] = false;
+  }
+}
+
+/** Constructor
+@param[in]	index		spatial index, which must be empty
+@param[in]	trx_id		transaction id
+@param[in]	observer	flush observer
+@param[in]	max_size	maximum size in bytes of the entries
+                                kept in memory
+@param[in]	path		location for the merge files */
+RtreeBulk::RtreeBulk(dict_index_t *index, trx_id_t trx_id,
+                     FlushObserver *observer, ulint max_size,
+                     const char *path)
+    : m_heap(mem_heap_create(UNIV_PAGE_SIZE)),
+      m_index(index),
+      m_trx_id(trx_id),
+      m_flush_observer(observer),
+      m_max_size(max_size),
+      m_size(0),
+      m_path(path),
+      m_n_entries(0),
+      m_rec_size(0),
+      m_fd(-1),
+      m_tmpfd(-1),
+      m_blocks(NULL),
+      m_end(0) {
+  ut_ad(dict_index_is_spatial(m_index));
+  ut_ad(m_flush_observer != NULL);
+#ifdef UNIV_DEBUG
+  fil_space_inc_redo_skipped_count(m_index->space);
+#endif /* UNIV_DEBUG */
+}
+
+/** Destructor */
+RtreeBulk::~RtreeBulk() {
+  mem_heap_free(m_heap);
+
+  row_merge_file_destroy_low(m_fd);
+  row_merge_file_destroy_low(m_tmpfd);
+
+  if (m_blocks != NULL) {
+    ut_allocator<row_merge_block_t> alloc(mem_key_row_merge_sort);
+    alloc.deallocate_large(m_blocks, &m_blocks_pfx);
+  }
+
+#ifdef UNIV_DEBUG
+  fil_space_dec_redo_skipped_count(m_index->space);
+#endif /* UNIV_DEBUG */
+}
+
+/** Set the centre of the MBR of a record.
+@param[in,out]	entry	entry whose record is set */
+void RtreeBulk::set_centre(Entry *entry) {
+  /* The MBR is the first field of both leaf records and node
+  pointers, and is stored as xmin, xmax, ymin, ymax. */
+  const byte *mbr = entry->rec;
+
+  entry->x = (mach_double_read(mbr) + mach_double_read(mbr + 8)) / 2;
+  entry->y = (mach_double_read(mbr + 16) + mach_double_read(mbr + 24)) / 2;
+
+  /* Keep the sort order strict. */
+  if (std::isnan(entry->x)) {
+    entry->x = 0;
+  }
+
+  if (std::isnan(entry->y)) {
+    entry->y = 0;
+  }
+}
+
+/** Add a leaf entry. The entry is copied.
+@param[in]	tuple	index entry
+@return error code */
+dberr_t RtreeBulk::add(const dtuple_t *tuple) {
+  const ulint rec_size = rec_get_converted_size(m_index, tuple, 0);
+
+  if (m_size + rec_size + sizeof(Entry) > m_max_size && !m_entries.empty()) {
+    dberr_t err = spill();
+
+    if (err != DB_SUCCESS) {
+      return (err);
+    }
+  }
+
+  Entry entry;
+
+  entry.rec = rec_convert_dtuple_to_rec(
+      static_cast<byte *>(mem_heap_alloc(m_heap, rec_size)), m_index, tuple, 0);
+  entry.size = rec_size;
+  set_centre(&entry);
+
+  m_entries.push_back(entry);
+  m_size += rec_size + sizeof(Entry);
+  m_n_entries++;
+  m_rec_size += rec_size;
+
+  return (DB_SUCCESS);
+}
+
+/** Sort the entries in memory on x and write them as a run.
+@return error code */
+dberr_t RtreeBulk::spill() {
+  if (m_blocks == NULL) {
+    ut_allocator<row_merge_block_t> alloc(mem_key_row_merge_sort);
+
+    m_blocks = alloc.allocate_large(3 * srv_sort_buf_size, &m_blocks_pfx);
+
+    if (m_blocks == NULL) {
+      return (DB_OUT_OF_MEMORY);
+    }
+  }
+
+  if (m_fd < 0) {
+    m_fd = row_merge_file_create_low(m_path);
+
+    if (m_fd < 0) {
+      return (DB_OUT_OF_MEMORY);
+    }
+
+    if (srv_disable_sort_file_cache) {
+      os_file_set_nocache(m_fd, "btr0bulk.cc", "sort");
+    }
+  }
+
+  std::sort(m_entries.begin(), m_entries.end(),
+            [](const Entry &a, const Entry &b) { return (a.x < b.x); });
+
+  /* Append to the runs written so far, whose last block is still
+  in the third block buffer. */
+  RtreeRunWriter writer(m_fd, m_blocks + 2 * srv_sort_buf_size, m_end);
+  Run run = {m_end, m_entries.size()};
+  mem_heap_t *heap = mem_heap_create(UNIV_PAGE_SIZE);
+  bool success = true;
+
+  for (const Entry &entry : m_entries) {
+    const ulint *offsets =
+        rec_get_offsets(entry.rec, m_index, NULL, ULINT_UNDEFINED, &heap);
+    const ulint extra_size = rec_offs_extra_size(offsets);
+    const rtr_bulk_run_entry_t header = {entry.x, entry.y, entry.size,
+                                         extra_size};
+
+    success = writer.write(header, entry.rec - extra_size);
+
+    mem_heap_empty(heap);
+
+    if (!success) {
+      break;
+    }
+  }
+
+  mem_heap_free(heap);
+
+  if (!success || !writer.flush()) {
+    return (DB_TEMP_FILE_WRITE_FAIL);
+  }
+
+  m_runs.push_back(run);
+  m_end = writer.offset();
+
+  m_entries.clear();
+  mem_heap_empty(m_heap);
+  m_size = 0;
+
+  if (m_flush_observer->check_interrupted()) {
+    return (DB_INTERRUPTED);
+  }
+
+  return (DB_SUCCESS);
+}
+
+/** Merge the runs two at a time, until there is one.
+@return error code */
+dberr_t RtreeBulk::merge_runs() {
+  while (m_runs.size() > 1) {
+    if (m_tmpfd < 0) {
+      m_tmpfd = row_merge_file_create_low(m_path);
+
+      if (m_tmpfd < 0) {
+        return (DB_OUT_OF_MEMORY);
+      }
+
+      if (srv_disable_sort_file_cache) {
+        os_file_set_nocache(m_tmpfd, "btr0bulk.cc", "sort");
+      }
+    }
+
+    RtreeRunWriter writer(m_tmpfd, m_blocks + 2 * srv_sort_buf_size, 0);
+    run_vector merged;
+
+    for (ulint i = 0; i < m_runs.size(); i += 2) {
+      const Run empty = {0, 0};
+      const Run &a = m_runs[i];
+      const Run &b = i + 1 < m_runs.size() ? m_runs[i + 1] : empty;
+      const Run run = {writer.offset(), a.n_entries + b.n_entries};
+
+      if (!rtr_bulk_merge_two_runs(m_fd, m_blocks,
+                                   m_blocks + srv_sort_buf_size, a, b,
+                                   &writer)) {
+        return (DB_TEMP_FILE_WRITE_FAIL);
+      }
+
+      merged.push_back(run);
+
+      if (m_flush_observer->check_interrupted()) {
+        return (DB_INTERRUPTED);
+      }
+    }
+
+    if (!writer.flush()) {
+      return (DB_TEMP_FILE_WRITE_FAIL);
+    }
+
+    std::swap(m_fd, m_tmpfd);
+    m_runs.swap(merged);
+    m_end = writer.offset();
+  }
+
+  return (DB_SUCCESS);
+}
+
+/** Sort a range of entries in index order.
+@param[in,out]	first	first entry to sort
+@param[in,out]	last	end of the entries to sort */
+void RtreeBulk::sort_in_index_order(Entry *first, Entry *last) {
+  typedef std::pair<Entry, const ulint *> sort_entry;
+
+  mem_heap_t *heap = mem_heap_create(UNIV_PAGE_SIZE);
+  std::vector<sort_entry, ut_allocator<sort_entry>> entries;
+
+  entries.reserve(last - first);
+
+  for (Entry *entry = first; entry < last; ++entry) {
+    entries.push_back(sort_entry(
+        *entry,
+        rec_get_offsets(entry->rec, m_index, NULL, ULINT_UNDEFINED, &heap)));
+  }
+
+  const dict_index_t *index = m_index;
+
+  std::sort(entries.begin(), entries.end(),
+            [index](const sort_entry &a, const sort_entry &b) {
+              return (cmp_rec_rec(a.first.rec, b.first.rec, a.second,
+                                  b.second, index) < 0);
+            });
+
+  for (const sort_entry &entry : entries) {
+    *first++ = entry.first;
+  }
+
+  mem_heap_free(heap);
+}
+
+/** Check whether the entries of a level fit in a single page.
+@param[in]	entries	entries of the level
+@return true if they fit */
+bool RtreeBulk::fit_in_page(const entry_vector &entries) const {
+  const ulint free_space =
+      page_get_free_space_of_empty(dict_table_is_comp(m_index->table));
+  ulint total = page_dir_calc_reserved_space(entries.size());
+
+  for (const Entry &entry : entries) {
+    total += entry.size;
+
+    if (total > free_space) {
+      return (false);
+    }
+  }
+
+  return (true);
+}
+
+/** Finish a page of a level and add its node pointer.
+@param[in,out]	page_bulk	page to finish
+@param[in]	next_page_bulk	next page of the level, or NULL
+@param[out]	node_ptrs	node pointers of the level
+@param[in,out]	heap		memory heap for the node pointers */
+void RtreeBulk::page_commit(PageBulk *page_bulk, PageBulk *next_page_bulk,
+                            entry_vector &node_ptrs, mem_heap_t *heap) {
+  page_bulk->finish();
+
+  if (next_page_bulk != NULL) {
+    page_bulk->setNext(next_page_bulk->getPageNo());
+    next_page_bulk->setPrev(page_bulk->getPageNo());
+  } else {
+    page_bulk->setNext(FIL_NULL);
+  }
+
+  /* Only the first node pointer of the level being built gets the
+  minimum record flag, not the one copied from the page below. */
+  dtuple_t *node_ptr = page_bulk->getNodePtr();
+  dtuple_set_info_bits(node_ptr,
+                       dtuple_get_info_bits(node_ptr) & ~REC_INFO_MIN_REC_FLAG);
+
+  Entry entry;
+
+  entry.size = rec_get_converted_size(m_index, node_ptr, 0);
+  entry.rec = rec_convert_dtuple_to_rec(
+      static_cast<byte *>(mem_heap_alloc(heap, entry.size)), m_index, node_ptr,
+      0);
+  set_centre(&entry);
+
+  node_ptrs.push_back(entry);
+
+  page_bulk->commit(true);
+}
+
+/** Set the minimum record flag in the first record of a non-leaf level.
+@param[in,out]	rec	record
+@param[in]	comp	nonzero=compact page format */
+static void rtr_bulk_set_min_rec_flag(rec_t *rec, ulint comp) {
+  const ulint info_bits = rec_get_info_bits(rec, comp);
+
+  if (comp) {
+    rec_set_info_bits_new(rec, info_bits | REC_INFO_MIN_REC_FLAG);
+  } else {
+    rec_set_info_bits_old(rec, info_bits | REC_INFO_MIN_REC_FLAG);
+  }
+}
+
+/** Get the number of entries per page and per slice of a level.
+@param[in]	n		number of entries
+@param[in]	total_size	size of the entries and of their
+                                page directory slots
+@param[out]	per_page	entries per page
+@param[out]	slice_size	entries per slice */
+void RtreeBulk::plan_level(ulint n, ulint total_size, ulint *per_page,
+                           ulint *slice_size) const {
+  /* Estimate the number of entries per page, keeping the free space
+  asked for by the fill factor. */
+  const ulint usable = page_get_free_space_of_empty(dict_table_is_comp(
+                           m_index->table)) -
+                       UNIV_PAGE_SIZE * (100 - innobase_fill_factor) / 100;
+  *per_page = std::max<ulint>(usable * n / total_size, 2);
+
+  /* Sort-Tile-Recursive: cut the entries sorted on x into about
+  sqrt(pages) slices, and the slices sorted on y into pages. */
+  const ulint n_pages = (n + *per_page - 1) / *per_page;
+  const ulint n_slices =
+      static_cast<ulint>(std::ceil(std::sqrt(static_cast<double>(n_pages))));
+  *slice_size = n_slices * *per_page;
+}
+
+/** Write the entries of a slice, sorted on x, into pages.
+@param[in,out]	first		first entry of the slice
+@param[in,out]	last		end of the slice
+@param[in]	per_page	entries per page
+@param[in]	level		level in the R-tree
+@param[in,out]	page_bulk	page being filled, or NULL
+@param[out]	node_ptrs	node pointers of the pages written
+@param[in,out]	heap		memory heap for the node pointers
+@return error code */
+dberr_t RtreeBulk::build_slice(Entry *first, Entry *last, ulint per_page,
+                               ulint level, PageBulk **page_bulk,
+                               entry_vector &node_ptrs, mem_heap_t *heap) {
+  const ulint comp = dict_table_is_comp(m_index->table);
+
+  std::sort(first, last,
+            [](const Entry &a, const Entry &b) { return (a.y < b.y); });
+
+  for (Entry *tile = first; tile < last; tile += per_page) {
+    Entry *const tile_end = std::min(tile + per_page, last);
+
+    sort_in_index_order(tile, tile_end);
+
+    if (*page_bulk == NULL && level > 0) {
+      rtr_bulk_set_min_rec_flag(tile->rec, comp);
+    }
+
+    for (Entry *entry = tile; entry < tile_end; ++entry) {
+      /* Start a page for each tile, and when the entries of
+      a tile are larger than estimated. */
+      if (*page_bulk == NULL || entry == tile ||
+          !(*page_bulk)->isSpaceAvailable(entry->size)) {
+        PageBulk *new_page_bulk = UT_NEW_NOKEY(
+            PageBulk(m_index, m_trx_id, FIL_NULL, level, m_flush_observer));
+
+        dberr_t err = new_page_bulk->init();
+        if (err != DB_SUCCESS) {
+          UT_DELETE(new_page_bulk);
+          return (err);
+        }
+
+        if (*page_bulk != NULL) {
+          page_commit(*page_bulk, new_page_bulk, node_ptrs, heap);
+          UT_DELETE(*page_bulk);
+        }
+
+        *page_bulk = new_page_bulk;
+
+        /* Check whether trx is interrupted */
+        if (m_flush_observer->check_interrupted()) {
+          return (DB_INTERRUPTED);
+        }
+
+        /* Wake up page cleaner to flush dirty pages. */
+        srv_inc_activity_count();
+        os_event_set(buf_flush_event);
+
+        /* Important: log_free_check whether we need a
+        checkpoint. */
+        if (log_needs_free_check()) {
+          (*page_bulk)->release();
+          log_free_check();
+          (*page_bulk)->latch();
+        }
+      }
+
+      ulint *offsets = rec_get_offsets(entry->rec, m_index, NULL,
+                                       ULINT_UNDEFINED, &(*page_bulk)->m_heap);
+
+      (*page_bulk)->insert(entry->rec, offsets);
+    }
+  }
+
+  return (DB_SUCCESS);
+}
+
+/** Commit the last page of a level, or release it after an error.
+@param[in,out]	page_bulk	page being filled, or NULL
+@param[in]	err		error code of the level so far
+@param[out]	node_ptrs	node pointers of the pages written
+@param[in,out]	heap		memory heap for the node pointers
+@return error code */
+dberr_t RtreeBulk::end_level(PageBulk *page_bulk, dberr_t err,
+                             entry_vector &node_ptrs, mem_heap_t *heap) {
+  if (page_bulk == NULL) {
+    return (err);
+  }
+
+  if (err == DB_SUCCESS) {
+    page_commit(page_bulk, NULL, node_ptrs, heap);
+  } else {
+    page_bulk->commit(false);
+  }
+
+  UT_DELETE(page_bulk);
+
+  return (err);
+}
+
+/** Write the pages of a level and collect their node pointers.
+@param[in,out]	entries		entries of the level
+@param[in]	level		level in the R-tree
+@param[out]	node_ptrs	node pointers of the pages written
+@param[in,out]	heap		memory heap for the node pointers
+@return error code */
+dberr_t RtreeBulk::build_level(entry_vector &entries, ulint level,
+                               entry_vector &node_ptrs, mem_heap_t *heap) {
+  const ulint n = entries.size();
+  ulint total_size = page_dir_calc_reserved_space(n);
+
+  for (const Entry &entry : entries) {
+    total_size += entry.size;
+  }
+
+  ulint per_page;
+  ulint slice_size;
+
+  plan_level(n, total_size, &per_page, &slice_size);
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry &a, const Entry &b) { return (a.x < b.x); });
+
+  PageBulk *page_bulk = NULL;
+  dberr_t err = DB_SUCCESS;
+
+  for (ulint slice = 0; err == DB_SUCCESS && slice < n; slice += slice_size) {
+    err = build_slice(entries.data() + slice,
+                      entries.data() + std::min(n, slice + slice_size),
+                      per_page, level, &page_bulk, node_ptrs, heap);
+  }
+
+  return (end_level(page_bulk, err, node_ptrs, heap));
+}
+
+/** Read entries of the merged run into m_entries and m_heap, which
+are emptied first.
+@param[in,out]	reader	reader of the merged run
+@param[in]	n	maximum number of entries to read
+@return error code */
+dberr_t RtreeBulk::read_entries(RtreeRunReader *reader, ulint n) {
+  m_entries.clear();
+  mem_heap_empty(m_heap);
+
+  while (m_entries.size() < n && !reader->at_end()) {
+    rtr_bulk_run_entry_t header;
+
+    if (!reader->read_header(&header)) {
+      return (DB_IO_ERROR);
+    }
+
+    byte *buf = static_cast<byte *>(mem_heap_alloc(m_heap, header.size));
+
+    if (!reader->read_rec(header, buf)) {
+      return (DB_IO_ERROR);
+    }
+
+    Entry entry;
+
+    entry.x = header.x;
+    entry.y = header.y;
+    entry.rec = buf + header.extra_size;
+    entry.size = header.size;
+
+    m_entries.push_back(entry);
+  }
+
+  return (DB_SUCCESS);
+}
+
+/** Write the leaf pages from the merged run, one slice at a time,
+and collect their node pointers.
+@param[out]	node_ptrs	node pointers of the pages written
+@param[in,out]	heap		memory heap for the node pointers
+@return error code */
+dberr_t RtreeBulk::build_leaf_level_from_run(entry_vector &node_ptrs,
+                                             mem_heap_t *heap) {
+  ut_ad(m_runs.size() == 1);
+  ut_ad(m_entries.empty());
+
+  ulint per_page;
+  ulint slice_size;
+
+  plan_level(m_n_entries,
+             page_dir_calc_reserved_space(m_n_entries) + m_rec_size,
+             &per_page, &slice_size);
+
+  RtreeRunReader reader(m_fd, m_blocks, m_runs.front());
+  PageBulk *page_bulk = NULL;
+  dberr_t err = DB_SUCCESS;
+
+  while (err == DB_SUCCESS && !reader.at_end()) {
+    err = read_entries(&reader, slice_size);
+
+    if (err == DB_SUCCESS) {
+      err = build_slice(m_entries.data(), m_entries.data() + m_entries.size(),
+                        per_page, 0, &page_bulk, node_ptrs, heap);
+    }
+  }
+
+  m_entries.clear();
+
+  return (end_level(page_bulk, err, node_ptrs, heap));
+}
+
+/** Write the top level into the root page.
+@param[in,out]	entries	entries of the top level
+@param[in]	level	level of the root page
+@return error code */
+dberr_t RtreeBulk::build_root(entry_vector &entries, ulint level) {
+  PageBulk root_page_bulk(m_index, m_trx_id, dict_index_get_page(m_index),
+                          level, m_flush_observer);
+
+  dberr_t err = root_page_bulk.init();
+  if (err != DB_SUCCESS) {
+    return (err);
+  }
+
+  sort_in_index_order(entries.data(), entries.data() + entries.size());
+
+  if (level > 0) {
+    rtr_bulk_set_min_rec_flag(entries.front().rec,
+                              dict_table_is_comp(m_index->table));
+  }
+
+  for (const Entry &entry : entries) {
+    ulint *offsets = rec_get_offsets(entry.rec, m_index, NULL, ULINT_UNDEFINED,
+                                     &root_page_bulk.m_heap);
+
+    root_page_bulk.insert(entry.rec, offsets);
+  }
+
+  root_page_bulk.finish();
+  root_page_bulk.commit(true);
+
+  return (DB_SUCCESS);
+}
+
+/** Build the R-tree from the entries added.
+@return error code */
+dberr_t RtreeBulk::finish() {
+  ut_ad(!m_index->table->is_temporary());
+
+  if (m_n_entries == 0) {
+    /* The table is empty. The root page of the index tree
+    is already in a consistent state. */
+    return (DB_SUCCESS);
+  }
+
+  entry_vector entries;
+
+  /* Memory heap of the node pointers in entries, the leaf
+  entries are in m_heap. */
+  mem_heap_t *heap = NULL;
+  ulint level = 0;
+  dberr_t err = DB_SUCCESS;
+
+  if (!m_runs.empty()) {
+    /* Write the entries in memory as the last run, and merge. */
+    err = spill();
+
+    if (err == DB_SUCCESS) {
+      err = merge_runs();
+    }
+
+    if (err != DB_SUCCESS) {
+      return (err);
+    }
+
+    const ulint free_space =
+        page_get_free_space_of_empty(dict_table_is_comp(m_index->table));
+
+    if (page_dir_calc_reserved_space(m_n_entries) + m_rec_size <=
+        free_space) {
+      /* Few entries, build the root page from them. */
+      RtreeRunReader reader(m_fd, m_blocks, m_runs.front());
+
+      err = read_entries(&reader, m_n_entries);
+    } else {
+      heap = mem_heap_create(UNIV_PAGE_SIZE);
+      err = build_leaf_level_from_run(entries, heap);
+      level = 1;
+    }
+
+    if (err != DB_SUCCESS) {
+      if (heap != NULL) {
+        mem_heap_free(heap);
+      }
+
+      return (err);
+    }
+  }
+
+  if (level == 0) {
+    entries.swap(m_entries);
+  }
+
+  while (!fit_in_page(entries)) {
+    entry_vector node_ptrs;
+    mem_heap_t *node_ptr_heap = mem_heap_create(UNIV_PAGE_SIZE);
+
+    err = build_level(entries, level, node_ptrs, node_ptr_heap);
+
+    if (heap != NULL) {
+      mem_heap_free(heap);
+    }
+
+    heap = node_ptr_heap;
+    entries.swap(node_ptrs);
+
+    if (err != DB_SUCCESS) {
+      break;
+    }
+
+    ++level;
+  }
+
+  if (err == DB_SUCCESS) {
+    err = build_root(entries, level);
+  }
+
+  if (heap != NULL) {
+    mem_heap_free(heap);
+  }
+
+#ifdef UNIV_DEBUG
+  dict_sync_check check(true);
+
+  ut_ad(!sync_check_iterate(check));
+#endif /* UNIV_DEBUG */
+
+  ut_ad(err != DB_SUCCESS || btr_validate_index(m_index, NULL, false));
+  return (err);
+}
@@ -63,6 +63,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include <stdarg.h>
 #include <sys/types.h>
 #include <time.h>
+#include <atomic>
 #include <map>
 #include <new>
 #include <sstream>
@@ -296,6 +297,25 @@ if the withdrwa clock has not changed, the pointer is still valid in buffer
 pool. if changed, the pointer might not be in buffer pool any more. */
 volatile ulint buf_withdraw_clock;
 
+/** Sequence number of the critical paths of buf_pool_resize(). It is odd
+while the chunks and the page_hash may be reallocated or freed. The lookups
+of buf_page_hash_get_optimistic(), which do not latch the page_hash, only
+read it. */
+static std::atomic<uint64_t> buf_pool_resize_seq;
+
+/** Number of buf_page_hash_get_optimistic() lookups in progress. There is
+one counter per cache line, and a thread only writes to its own, so that
+the lookups do not write to cache lines shared by all threads. */
+struct alignas(INNOBASE_CACHE_LINE_SIZE) buf_lookup_slot_t {
+  std::atomic<ulint> n_active;
+};
+
+/** Number of buf_lookup_slots */
+static const ulint BUF_LOOKUP_SLOTS = 64;
+
+/** Counters of lookups in progress, by thread */
+static buf_lookup_slot_t buf_lookup_slots[BUF_LOOKUP_SLOTS];
+
 /** Map of buffer pool chunks by its first frame address
 This is newly made by initialization of buffer pool and buf_resize_thread.
 Note: mutex protection is required when creating multiple buffer pools
@@ -1134,6 +1154,8 @@ static void buf_pool_create(buf_pool_t *buf_pool, ulint buf_pool_size,
     buf_pool->no_flush[i] = os_event_create(0);
   }
 
+  buf_pool->LRU_free_event = os_event_create(0);
+
   buf_pool->watch = (buf_page_t *)ut_zalloc_nokey(sizeof(*buf_pool->watch) *
                                                   BUF_POOL_WATCH_SIZE);
   for (i = 0; i < BUF_POOL_WATCH_SIZE; i++) {
@@ -1219,6 +1241,8 @@ static void buf_pool_free_instance(buf_pool_t *buf_pool) {
     os_event_destroy(buf_pool->no_flush[i]);
   }
 
+  os_event_destroy(buf_pool->LRU_free_event);
+
   ut_free(buf_pool->chunks);
   ha_clear(buf_pool->page_hash);
   hash_table_free(buf_pool->page_hash);
@@ -1774,6 +1798,20 @@ static void buf_pool_resize_hash(buf_pool_t *buf_pool) {
   buf_pool->zip_hash = new_hash_table;
 }
 
+/** Wait for the grace period after buf_pool_resize_seq was made odd, that
+is until the lookups which may have read an even sequence number are done.
+Later lookups fall back to latching the page_hash, so that the chunks and
+the page_hash can then be freed. */
+static void buf_pool_wait_for_lookups() {
+  ut_ad(buf_pool_resize_seq.load() & 1);
+
+  for (auto &slot : buf_lookup_slots) {
+    while (slot.n_active.load() != 0) {
+      os_thread_yield();
+    }
+  }
+}
+
 #ifdef UNIV_DEBUG
 /** This is a debug routine to inject an memory allocation failure error. */
 static void buf_pool_resize_chunk_make_null(buf_chunk_t **new_chunks) {
@@ -1970,6 +2008,11 @@ withdraw_retry:
     return;
   }
 
+  /* Stop the lookups without page_hash latches before the chunks and
+  the page_hash can be reallocated. */
+  buf_pool_resize_seq.fetch_add(1);
+  buf_pool_wait_for_lookups();
+
   /* Indicate critical path */
   buf_pool_resizing = true;
 
@@ -2201,6 +2244,8 @@ withdraw_retry:
 
   buf_pool_resizing = false;
 
+  buf_pool_resize_seq.fetch_add(1);
+
   /* Normalize other components, if the new size is too different */
   if (!warning && new_size_too_diff) {
     srv_buf_pool_base_size = srv_buf_pool_size;
@@ -3123,6 +3168,128 @@ static ibool buf_block_is_uncompressed(
   return (buf_pointer_is_block_field_instance(buf_pool, (void *)block));
 }
 
+/** Registers a lookup which does not latch the page_hash for its duration,
+so that buf_pool_resize() does not free the chunks or the page_hash which it
+reads. */
+class Buf_lookup_guard {
+ public:
+  Buf_lookup_guard() : m_slot(buf_lookup_slots[slot_index()]) {
+    /* The increment must be visible before the sequence number is
+    read, as buf_pool_resize() makes the number odd before it reads
+    the counters. */
+    m_slot.n_active.fetch_add(1);
+  }
+
+  ~Buf_lookup_guard() {
+    m_slot.n_active.fetch_sub(1, std::memory_order_release);
+  }
+
+  /** @return true if the chunks and the page_hash stay in place until
+  the guard is destroyed */
+  bool is_stable() const {
+    return ((buf_pool_resize_seq.load() & 1) == 0 && !buf_pool_withdrawing);
+  }
+
+ private:
+  /** @return index of the counter of the current thread */
+  static ulint slot_index() {
+    static std::atomic<ulint> n_threads;
+    thread_local ulint index =
+        n_threads.fetch_add(1, std::memory_order_relaxed) % BUF_LOOKUP_SLOTS;
+    return (index);
+  }
+
+  /** Counter of the current thread */
+  buf_lookup_slot_t &m_slot;
+};
+
+/** Buffer-fix a block if it holds a page, without latching the page_hash.
+The block mutex keeps the block from being evicted or relocated while its
+state is checked, as in buf_page_optimistic_get().
+@param[in]	buf_pool	buffer pool instance
+@param[in,out]	block		block which may hold the page, not
+                                dereferenced unless it is in a chunk
+@param[in]	page_id		page id
+@return true if the block holds the page and was buffer-fixed */
+static bool buf_block_fix_if_page(buf_pool_t *buf_pool, buf_block_t *block,
+                                  const page_id_t &page_id) {
+  if (!buf_block_is_uncompressed(buf_pool, block)) {
+    return (false);
+  }
+
+  buf_page_mutex_enter(block);
+
+  /* A block in the page_hash can not change its state or page id
+  without holding its mutex. Pages which are being read in are left
+  to the caller, which waits for the read with the page_hash latched. */
+  const bool fixed = buf_block_get_state(block) == BUF_BLOCK_FILE_PAGE &&
+                     page_id.equals_to(block->page.id) &&
+                     buf_page_get_io_fix(&block->page) == BUF_IO_NONE;
+
+  if (fixed) {
+    buf_block_fix(block);
+  }
+
+  buf_page_mutex_exit(block);
+
+  return (fixed);
+}
+
+/** Look up a page without latching the page_hash, and buffer-fix the block
+holding it. This avoids writing to the page_hash rw_lock, which is shared
+by many pages, on lookups of pages which are in the pool.
+
+The lookup only reads buf_pool_resize_seq. buf_pool_resize() makes it odd,
+and waits for the lookups in progress, before it frees the chunks or the
+page_hash. The chain is read while other threads may be modifying it, so
+the block found is only a candidate, which buf_block_fix_if_page()
+validates. Only blocks in the chunks are followed.
+@param[in]	buf_pool	buffer pool instance
+@param[in]	page_id		page id
+@param[in]	guess		guessed block or NULL, not dereferenced
+                                unless it is in a chunk
+@return buffer-fixed block, or NULL if the page must be looked up with
+the page_hash latched */
+static buf_block_t *buf_page_hash_get_optimistic(buf_pool_t *buf_pool,
+                                                 const page_id_t &page_id,
+                                                 buf_block_t *guess) {
+  /* Chains are short; a longer one is being modified. */
+  static const ulint MAX_CHAIN_LENGTH = 16;
+
+  Buf_lookup_guard guard;
+
+  if (!guard.is_stable()) {
+    return (NULL);
+  }
+
+  if (guess != NULL && buf_block_fix_if_page(buf_pool, guess, page_id)) {
+    return (guess);
+  }
+
+  hash_table_t *page_hash = buf_pool->page_hash;
+
+  buf_page_t *bpage = static_cast<buf_page_t *>(
+      HASH_GET_FIRST(page_hash, hash_calc_hash(page_id.fold(), page_hash)));
+
+  for (ulint i = 0; bpage != NULL && i < MAX_CHAIN_LENGTH; i++) {
+    buf_block_t *block = reinterpret_cast<buf_block_t *>(bpage);
+
+    /* Watch sentinels and compressed-only pages are looked up with
+    the page_hash latched. */
+    if (!buf_block_is_uncompressed(buf_pool, block)) {
+      return (NULL);
+    }
+
+    if (page_id.equals_to(bpage->id)) {
+      return (buf_block_fix_if_page(buf_pool, block, page_id) ? block : NULL);
+    }
+
+    bpage = bpage->hash;
+  }
+
+  return (NULL);
+}
+
 #if defined UNIV_DEBUG || defined UNIV_IBUF_DEBUG
 /** Return true if probe is enabled.
  @return true if probe enabled. */
@@ -3224,6 +3391,14 @@ buf_block_t *buf_page_get_gen(const page_id_t &page_id,
   buf_pool->stat.n_page_gets++;
   hash_lock = buf_page_hash_lock_get(buf_pool, page_id);
 loop:
+  /* Try the guess and the page_hash without latching the page_hash. */
+  block = buf_page_hash_get_optimistic(buf_pool, page_id, guess);
+
+  if (block != NULL) {
+    fix_block = block;
+    goto got_block;
+  }
+
   block = guess;
 
   rw_lock_s_lock(hash_lock);
@@ -4885,6 +5060,7 @@ bool buf_page_io_complete(buf_page_t *bpage, bool evict) {
 
       if (evict && buf_LRU_free_page(bpage, true)) {
         have_LRU_mutex = false;
+        os_event_set(buf_pool->LRU_free_event);
       } else {
         mutex_exit(buf_page_get_mutex(bpage));
       }
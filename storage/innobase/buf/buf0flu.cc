@@ -77,6 +77,15 @@ static const int buf_flush_page_cleaner_priority = -20;
 modification lsn */
 static const ulint buf_flush_wait_flushed_sleep_time = 10000;
 
+/** Maximum time in microseconds a user thread waits for a running LRU batch
+before it flushes a single page itself */
+static const ulint buf_flush_LRU_batch_wait_time = 10000;
+
+/** The free list headroom predicted from the recent free list consumption
+is capped at 1/BUF_FLUSH_FREE_TARGET_DIV of the buffer pool instance, so that
+a burst of reads cannot make the page cleaner evict most of the LRU list. */
+static const ulint BUF_FLUSH_FREE_TARGET_DIV = 10;
+
 /** Number of pages flushed through non flush_list flushes. */
 static ulint buf_lru_flush_page_count = 0;
 #endif /* !UNIV_HOTBACKUP */
@@ -1620,15 +1629,19 @@ static ulint buf_flush_LRU_list_batch(buf_pool_t *buf_pool, ulint max) {
   ulint count = 0;
   ulint free_len = UT_LIST_GET_LEN(buf_pool->free);
   ulint lru_len = UT_LIST_GET_LEN(buf_pool->LRU);
+  ulint free_target;
   ulint withdraw_depth;
 
   ut_ad(mutex_own(&buf_pool->LRU_list_mutex));
 
+  free_target = ut_max(static_cast<ulint>(srv_LRU_scan_depth),
+                       buf_pool->LRU_free_target);
+
   withdraw_depth = buf_get_withdraw_depth(buf_pool);
 
   for (bpage = UT_LIST_GET_LAST(buf_pool->LRU);
        bpage != NULL && count + evict_count < max &&
-       free_len < srv_LRU_scan_depth + withdraw_depth &&
+       free_len < free_target + withdraw_depth &&
        lru_len > BUF_LRU_MIN_LEN;
        ++scanned, bpage = buf_pool->lru_hp.get()) {
     buf_page_t *prev = UT_LIST_GET_PREV(LRU, bpage);
@@ -1643,6 +1656,7 @@ static ulint buf_flush_LRU_list_batch(buf_pool_t *buf_pool, ulint max) {
       clean and is not IO-fixed or buffer fixed. */
       if (buf_LRU_free_page(bpage, true)) {
         ++evict_count;
+        os_event_set(buf_pool->LRU_free_event);
         mutex_enter(&buf_pool->LRU_list_mutex);
       } else {
         mutex_exit(block_mutex);
@@ -2160,8 +2174,9 @@ bool buf_flush_single_page_from_LRU(buf_pool_t *buf_pool) {
 Clears up tail of the LRU list of a given buffer pool instance:
 * Put replaceable pages at the tail of LRU to the free list
 * Flush dirty pages at the tail of LRU to the disk
-The depth to which we scan each buffer pool is controlled by dynamic
-config parameter innodb_LRU_scan_depth.
+The depth to which we scan each buffer pool is at least the dynamic
+config parameter innodb_LRU_scan_depth, and more if the free list of the
+instance was consumed faster than that since the previous call.
 @param buf_pool buffer pool instance
 @return total pages flushed */
 static ulint buf_flush_LRU_list(buf_pool_t *buf_pool) {
@@ -2170,15 +2185,30 @@ static ulint buf_flush_LRU_list(buf_pool_t *buf_pool) {
 
   ut_ad(buf_pool);
 
-  /* srv_LRU_scan_depth can be arbitrarily large value.
+  /* Predict how many free blocks the user threads will need before
+  the next pass from how many they took since the previous one, so
+  that the free list does not run dry in between and they do not
+  have to flush single pages themselves. */
+  ulint n_free_taken = buf_pool->n_free_taken;
+  ulint demand = n_free_taken - buf_pool->n_free_taken_last;
+
+  buf_pool->n_free_taken_last = n_free_taken;
+  buf_pool->LRU_free_demand = (3 * buf_pool->LRU_free_demand + demand) / 4;
+
+  buf_pool->LRU_free_target =
+      ut_max(static_cast<ulint>(srv_LRU_scan_depth),
+             ut_min(buf_pool->LRU_free_demand,
+                    buf_pool->curr_size / BUF_FLUSH_FREE_TARGET_DIV));
+
+  /* The free target can be arbitrarily large value.
   We cap it with current LRU size. */
   scan_depth = UT_LIST_GET_LEN(buf_pool->LRU);
   withdraw_depth = buf_get_withdraw_depth(buf_pool);
 
-  if (withdraw_depth > srv_LRU_scan_depth) {
+  if (withdraw_depth > buf_pool->LRU_free_target) {
     scan_depth = ut_min(withdraw_depth, scan_depth);
   } else {
-    scan_depth = ut_min(static_cast<ulint>(srv_LRU_scan_depth), scan_depth);
+    scan_depth = ut_min(buf_pool->LRU_free_target, scan_depth);
   }
 
   /* Currently one of page_cleaners is the only thread
@@ -2209,6 +2239,39 @@ void buf_flush_wait_LRU_batch_end(void) {
   }
 }
 
+/** Wait a short while for an LRU batch that is running on a buffer pool
+instance to put blocks on its free list.
+@param[in]	buf_pool	buffer pool instance
+@return true if an LRU batch was running */
+bool buf_flush_wait_LRU_batch_progress(buf_pool_t *buf_pool) {
+  /* Reset before checking, so that a block freed after the check
+  is not missed. */
+  int64_t sig_count = os_event_reset(buf_pool->LRU_free_event);
+
+  mutex_enter(&buf_pool->flush_state_mutex);
+
+  bool running = buf_pool->n_flush[BUF_FLUSH_LRU] > 0 ||
+                 buf_pool->init_flush[BUF_FLUSH_LRU];
+
+  mutex_exit(&buf_pool->flush_state_mutex);
+
+  if (!running) {
+    return (false);
+  }
+
+  /* The batch puts the blocks on the free list one by one, as it
+  evicts clean pages and as the writes of dirty pages complete. Wake
+  up at the first one rather than at the end of the batch. */
+  if (UT_LIST_GET_LEN(buf_pool->free) == 0) {
+    thd_wait_begin(NULL, THD_WAIT_DISKIO);
+    os_event_wait_time_low(buf_pool->LRU_free_event,
+                           buf_flush_LRU_batch_wait_time, sig_count);
+    thd_wait_end(NULL);
+  }
+
+  return (true);
+}
+
 /** Calculates if flushing is required based on number of dirty pages in
  the buffer pool.
  @return percent of io_capacity to flush to manage dirty page ratio */
@@ -87,6 +87,10 @@ static const ulint BUF_LRU_DROP_SEARCH_SIZE = 1024;
 during LRU eviction. */
 static const ulint BUF_LRU_SEARCH_SCAN_THRESHOLD = 100;
 
+/** The page cleaner is woken up when the free list of a buffer pool instance
+drops below 1/BUF_LRU_FREE_LOW_WATER_DIV of its target length. */
+static const ulint BUF_LRU_FREE_LOW_WATER_DIV = 4;
+
 /** If we switch on the InnoDB monitor because there are too few available
 frames in the buffer pool, we set this to TRUE */
 static bool buf_lru_switched_on_innodb_mon = false;
@@ -1090,6 +1094,16 @@ ibool buf_LRU_buf_pool_running_out(void) {
   return (ret);
 }
 
+/** Returns the free list length below which the page cleaner is woken up
+to refill the free list of a buffer pool instance.
+@param[in]	buf_pool	buffer pool instance
+@return low water mark of the free list */
+static inline ulint buf_LRU_free_low_water(const buf_pool_t *buf_pool) {
+  return (ut_max(static_cast<ulint>(srv_LRU_scan_depth),
+                 buf_pool->LRU_free_target) /
+          BUF_LRU_FREE_LOW_WATER_DIV);
+}
+
 /** Returns a free block from the buf_pool.
 The block is taken off the free list.  If it is empty, returns NULL.
 @param[in]	buf_pool	buffer pool instance
@@ -1108,6 +1122,8 @@ buf_block_t *buf_LRU_get_free_only(buf_pool_t *buf_pool) {
     ut_ad(!block->page.in_LRU_list);
     ut_a(!buf_page_in_file(&block->page));
     UT_LIST_REMOVE(buf_pool->free, &block->page);
+    ++buf_pool->n_free_taken;
+    ulint free_len = UT_LIST_GET_LEN(buf_pool->free);
     mutex_exit(&buf_pool->free_list_mutex);
 
     if (!buf_get_withdraw_depth(buf_pool) ||
@@ -1117,6 +1133,15 @@ buf_block_t *buf_LRU_get_free_only(buf_pool_t *buf_pool) {
       a free block. */
       assert_block_ahi_empty(block);
 
+      /* Wake up the page cleaner when the free list drops below
+      the low water mark, so that it refills the free list before
+      user threads find it empty. Blocks are taken off one at a
+      time, so checking for equality signals once per crossing. */
+      if (free_len == buf_LRU_free_low_water(buf_pool) &&
+          !srv_read_only_mode) {
+        os_event_set(buf_flush_event);
+      }
+
       buf_block_set_state(block, BUF_BLOCK_READY_FOR_USE);
 
       UNIV_MEM_ALLOC(block->frame, UNIV_PAGE_SIZE);
@@ -1210,7 +1235,9 @@ we put it to free list to be used.
     * scan LRU up to srv_LRU_scan_depth to find a clean block
     * the above will put the block on free list
     * success:retry the free list
-  * flush one dirty page from tail of LRU to disk
+  * if the page cleaner is running an LRU batch, wait up to 10ms for it
+    * retry the free list
+  * otherwise flush one dirty page from tail of LRU to disk
     * the above will put the block on free list
     * success: retry the free list
 * iteration 1:
@@ -1311,6 +1338,20 @@ loop:
     os_event_set(buf_flush_event);
   }
 
+  /* If the page cleaner is already refilling the free list, let it
+  do so instead of adding a synchronous single page write to the
+  latency of this thread. */
+  if (n_iterations < 2 && !srv_read_only_mode &&
+      buf_flush_wait_LRU_batch_progress(buf_pool)) {
+    MONITOR_INC(MONITOR_LRU_GET_FREE_WAITS);
+
+    srv_stats.buf_pool_wait_free.add(n_iterations, 1);
+
+    n_iterations++;
+
+    goto loop;
+  }
+
   if (n_iterations > 1) {
     MONITOR_INC(MONITOR_LRU_GET_FREE_WAITS);
     os_thread_sleep(10000);
@@ -368,6 +368,62 @@ ibool buf_read_page_background(const page_id_t &page_id,
   return (count > 0);
 }
 
+/** Issues asynchronous read requests for ranges of pages of a tablespace
+which are about to be scanned, like the linear read-ahead does for an
+area. Pages which are already in the buffer pool are skipped.
+@param[in]	space_id	tablespace id
+@param[in]	ranges		ranges of pages to read
+@return number of page read requests queued */
+ulint buf_read_ahead_ranges(space_id_t space_id,
+                            const fseg_page_ranges_t &ranges) {
+  fil_space_t *space = fil_space_acquire_silent(space_id);
+
+  if (space == nullptr) {
+    return (0);
+  }
+
+  const page_size_t page_size(space->flags);
+  ulint count = 0;
+  dberr_t err = DB_SUCCESS;
+
+  for (const auto &range : ranges) {
+    ulint range_count = 0;
+
+    for (page_no_t i = 0; i < range.second && err != DB_TABLESPACE_DELETED;
+         ++i) {
+      range_count += buf_read_page_low(
+          &err, false, IORequest::DO_NOT_WAKE | IORequest::IGNORE_MISSING,
+          BUF_READ_ANY_PAGE, page_id_t(space_id, range.first + i), page_size,
+          false);
+    }
+
+    buf_pool_get(page_id_t(space_id, range.first))->stat.n_ra_pages_read +=
+        range_count;
+
+    count += range_count;
+
+    if (err == DB_TABLESPACE_DELETED) {
+      break;
+    }
+  }
+
+  fil_space_release(space);
+
+  /* In simulated aio we wake the aio handler threads only after
+  queuing all aio requests, in native aio the following call does
+  nothing: */
+
+  os_aio_simulated_wake_handler_threads();
+
+  if (count > 0) {
+    /* Read ahead is considered one I/O operation for the purpose of
+    LRU policy decision. */
+    buf_LRU_stat_inc_io();
+  }
+
+  return (count);
+}
+
 /** Applies linear read-ahead if in the buf_pool the page is a border page of
 a linear read-ahead area and all the pages in the area have been accessed.
 Does not read any page if the read-ahead mechanism is not activated. Note
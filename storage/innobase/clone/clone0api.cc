@@ -321,6 +321,23 @@ void clone_init() {
     clone_sys = UT_NEW(Clone_Sys(), mem_key_clone);
   }
   Clone_Sys::s_clone_sys_state = CLONE_SYS_ACTIVE;
+
+  /* Once the server changes the data directory, it can no longer be
+  cloned into incrementally: the donor does not track the pages changed
+  here. Incremental clone only refreshes data directories that no server
+  has been started on since the previous clone. */
+  if (!srv_read_only_mode) {
+    bool exist = false;
+
+    os_file_delete_if_exists(innodb_clone_file_key, CLONE_BASE_LSN_FILE,
+                             &exist);
+
+    if (exist) {
+      ib::info(ER_IB_MSG_88)
+          << "Removed " << CLONE_BASE_LSN_FILE << ". The next clone into"
+          << " this data directory copies all data.";
+    }
+  }
 }
 
 /** Uninitialize Clone system */
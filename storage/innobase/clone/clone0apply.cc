@@ -29,7 +29,10 @@ this program; if not, write to the Free Software Foundation, Inc.,
 
  *******************************************************/
 
+#include <algorithm>
+
 #include "clone0clone.h"
+#include "dict0dict.h"
 #include "handler.h"
 #include "log0log.h"
 
@@ -106,8 +109,9 @@ dberr_t Clone_Snapshot::add_file_from_desc(Clone_File_Meta *&file_desc,
     name.assign(file_desc->m_file_name);
 
     /* For absolute path, we must ensure that the file is not
-    present. This would always fail for local clone. */
-    if (Fil_path::is_absolute_path(name)) {
+    present. This would always fail for local clone. A file kept
+    from the base clone is only patched with the modified pages. */
+    if (Fil_path::is_absolute_path(name) && !file_desc->m_copy_modified) {
       auto type = Fil_path::get_file_type(name);
 
       if (type != OS_FILE_TYPE_MISSING) {
@@ -146,6 +150,14 @@ dberr_t Clone_Snapshot::add_file_from_desc(Clone_File_Meta *&file_desc,
 
   file_meta->m_file_name_len = name_len;
 
+  /* A file left by an earlier clone into the data directory is copied
+  in full again, unless it is kept. Remove it, so that no stale page is
+  left past the data copied. */
+  if (!file_meta->m_copy_modified) {
+    os_file_delete_if_exists(innodb_clone_file_key, file_meta->m_file_name,
+                             nullptr);
+  }
+
   file_vector[idx] = file_meta;
 
   file_desc = file_meta;
@@ -209,9 +221,211 @@ dberr_t Clone_Handle::apply_state_metadata(Ha_clone_cbk *callback) {
 
   snapshot->set_state_info(&state_desc);
 
+  /* The data directory is complete. Keep the base for cloning it
+  again. */
+  if (state_desc.m_state == CLONE_SNAPSHOT_DONE) {
+    write_base(state_desc);
+  }
+
   return (DB_SUCCESS);
 }
 
+/** Get the path of a file in a data directory, as the clone builds it
+@param[in]	data_dir	data directory
+@param[in]	name		file name relative to the data directory
+@return file path */
+static std::string data_file_path(const char *data_dir, const char *name) {
+  std::string path(data_dir);
+
+  if (path.empty() || path.back() != OS_PATH_SEPARATOR) {
+    path.push_back(OS_PATH_SEPARATOR);
+  }
+
+  path.append(name);
+
+  return (path);
+}
+
+/** Check if a file is still as the base clone left it
+@param[in]	path	file path
+@param[in]	file	file in base
+@return true if the file has the same size and tablespace ID */
+static bool base_file_unchanged(const std::string &path,
+                                const Clone_Base_File &file) {
+  bool exists = false;
+  os_file_type_t type;
+
+  if (!os_file_status(path.c_str(), &exists, &type) || !exists ||
+      type != OS_FILE_TYPE_FILE) {
+    return (false);
+  }
+
+  auto file_size = os_file_get_size(path.c_str());
+
+  if (file_size.m_total_size != file.m_file_size) {
+    return (false);
+  }
+
+  /* A tablespace created again under the same name has a new ID. */
+  auto fp = fopen(path.c_str(), "rb");
+
+  if (fp == nullptr) {
+    return (false);
+  }
+
+  byte buf[FIL_PAGE_SPACE_ID + 4];
+  bool success = (fread(buf, 1, sizeof(buf), fp) == sizeof(buf));
+
+  fclose(fp);
+
+  return (success && mach_read_from_4(buf + FIL_PAGE_SPACE_ID) ==
+                         file.m_space_id);
+}
+
+/** Read and remove the base left in the data directory by the last
+clone into it. Only the files still as the clone left them are kept
+in the base.
+@return true if the data directory has a base */
+bool Clone_Handle::read_base() {
+  m_base.clear();
+  m_base_files.clear();
+
+  if (m_clone_dir == nullptr) {
+    return (false);
+  }
+
+  auto path = data_file_path(m_clone_dir, CLONE_BASE_LSN_FILE);
+  auto file = fopen(path.c_str(), "rb");
+
+  if (file != nullptr) {
+    std::vector<byte> buf;
+    byte read_buf[4096];
+    size_t len;
+
+    while ((len = fread(read_buf, 1, sizeof(read_buf), file)) != 0) {
+      buf.insert(buf.end(), read_buf, read_buf + len);
+    }
+
+    if (ferror(file) == 0 && m_base.deserialize(buf.data(), buf.size())) {
+      m_base_files.swap(m_base.m_files);
+    } else {
+      m_base.clear();
+    }
+
+    fclose(file);
+  }
+
+  /* The files changed since the base clone are copied in full. */
+  for (auto &base_file : m_base_files) {
+    auto file_path = data_file_path(m_clone_dir, base_file.m_file_name.c_str());
+
+    if (base_file_unchanged(file_path, base_file)) {
+      m_base.m_files.push_back(base_file);
+    }
+  }
+
+  /* The data directory is being changed. It can be cloned into
+  incrementally again only after this clone is complete. */
+  os_file_delete_if_exists(innodb_clone_file_key, path.c_str(), nullptr);
+
+  return (m_base.is_set());
+}
+
+/** Write the base for the next clone into the data directory, and
+remove the files left by the last clone which the donor no longer has.
+@param[in]	state_desc	state descriptor of DONE state */
+void Clone_Handle::write_base(const Clone_Desc_State &state_desc) {
+  if (m_clone_dir == nullptr) {
+    return;
+  }
+
+  Clone_Base base;
+  auto snapshot = m_clone_task_manager.get_snapshot();
+
+  snapshot->get_base_files(m_clone_dir, base.m_files);
+
+  /* Remove the files of dropped and renamed tablespaces. Files out of
+  the data directory are left to the user. */
+  for (auto &old_file : m_base_files) {
+    if (Fil_path::is_absolute_path(old_file.m_file_name)) {
+      continue;
+    }
+
+    auto found = std::find_if(base.m_files.begin(), base.m_files.end(),
+                              [&](const Clone_Base_File &file) {
+                                return (file.m_file_name ==
+                                        old_file.m_file_name);
+                              });
+
+    if (found == base.m_files.end()) {
+      auto file_path =
+          data_file_path(m_clone_dir, old_file.m_file_name.c_str());
+
+      os_file_delete_if_exists(innodb_clone_file_key, file_path.c_str(),
+                               nullptr);
+    }
+  }
+
+  m_base_files.clear();
+
+  /* The donor does not track the modified pages for the next clone. */
+  if (state_desc.m_track_lsn == LSN_MAX ||
+      state_desc.m_group_lsn == LSN_MAX) {
+    return;
+  }
+
+  base.m_lsn = state_desc.m_track_lsn;
+  base.m_group_lsn = state_desc.m_group_lsn;
+  base.m_donor_uuid.assign(state_desc.m_donor_uuid);
+
+  std::vector<byte> buf(base.serialized_length());
+  base.serialize(buf.data());
+
+  auto path = data_file_path(m_clone_dir, CLONE_BASE_LSN_FILE);
+  auto file = fopen(path.c_str(), "wb");
+
+  if (file == nullptr) {
+    return;
+  }
+
+  bool success = (fwrite(buf.data(), 1, buf.size(), file) == buf.size());
+  success = (fclose(file) == 0) && success;
+
+  /* Without the file, the next clone copies the data files in full. */
+  if (!success) {
+    os_file_delete_if_exists(innodb_clone_file_key, path.c_str(), nullptr);
+  }
+}
+
+/** Get the data files as the clone left them at destination
+@param[in]	data_dir	destination data directory
+@param[out]	files		data files, named relative to data_dir */
+void Clone_Snapshot::get_base_files(const char *data_dir,
+                                    Clone_Base_Files &files) {
+  ut_ad(m_snapshot_handle_type == CLONE_HDL_APPLY);
+
+  auto prefix = data_file_path(data_dir, "");
+
+  for (auto file_meta : m_data_file_vector) {
+    /* Skip the buffer pool dump file. */
+    if (file_meta == nullptr ||
+        file_meta->m_space_id == dict_sys_t::s_invalid_space_id) {
+      continue;
+    }
+
+    ut_ad(strncmp(file_meta->m_file_name, prefix.c_str(), prefix.length()) ==
+          0);
+
+    Clone_Base_File file;
+
+    file.m_space_id = file_meta->m_space_id;
+    file.m_file_size = file_meta->m_file_size;
+    file.m_file_name.assign(file_meta->m_file_name + prefix.length());
+
+    files.push_back(file);
+  }
+}
+
 /** Create file metadata based on callback
 @param[in]	callback	callback interface
 @return error code */
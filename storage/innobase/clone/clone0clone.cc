@@ -755,10 +755,19 @@ dberr_t Clone_Handle::init(byte *ref_loc, Ha_clone_type type,
     m_clone_id = clone_sys->get_next_id();
     snapshot_id = clone_sys->get_next_id();
 
+    /* The reference locator is from apply clone handle. It has the
+    base if the destination was cloned before. */
+    if (ref_loc != nullptr) {
+      Clone_Desc_Locator loc_desc;
+
+      loc_desc.deserialize(ref_loc, &m_base);
+    }
+
   } else {
     /* Return keeping the clone in INIT state. The locator
-    would only have the version information. */
+    would only have the version and base information. */
     if (ref_loc == nullptr) {
+      read_base();
       return (DB_SUCCESS);
     }
 
@@ -782,6 +791,10 @@ dberr_t Clone_Handle::init(byte *ref_loc, Ha_clone_type type,
     return (DB_ERROR);
   }
 
+  if (is_copy_clone()) {
+    snapshot->set_base(&m_base);
+  }
+
   /* Initialize clone task manager. */
   m_clone_task_manager.init(snapshot);
 
@@ -794,13 +807,23 @@ dberr_t Clone_Handle::init(byte *ref_loc, Ha_clone_type type,
 @param[out]	loc_len	serialized locator length
 @return serialized clone locator */
 byte *Clone_Handle::get_locator(uint &loc_len) {
-  mem_heap_t *heap;
+  mem_heap_t *heap = nullptr;
   Clone_Desc_Locator loc_desc;
 
-  heap = m_clone_task_manager.get_heap();
-
   build_descriptor(&loc_desc);
 
+  if (m_clone_task_manager.get_snapshot() != nullptr) {
+    heap = m_clone_task_manager.get_heap();
+
+  } else if (m_clone_locator == nullptr) {
+    /* No snapshot is attached in INIT state. The locator is only
+    built once and goes to the donor with the base. */
+    m_base_locator.resize(loc_desc.m_header.m_length);
+
+    m_clone_locator = m_base_locator.data();
+    m_locator_length = static_cast<uint>(m_base_locator.size());
+  }
+
   loc_desc.serialize(m_clone_locator, m_locator_length, heap);
 
   loc_len = m_locator_length;
@@ -820,8 +843,16 @@ void Clone_Handle::build_descriptor(Clone_Desc_Locator *loc_desc) {
     snapshot_id = snapshot->get_id();
   }
 
+  /* The apply handle sends the base to the donor before a snapshot
+  is attached. */
+  const Clone_Base *base = nullptr;
+
+  if (!is_copy_clone() && m_clone_handle_state == CLONE_STATE_INIT) {
+    base = &m_base;
+  }
+
   loc_desc->init(m_clone_id, snapshot_id, m_clone_desc_version,
-                 m_clone_arr_index);
+                 m_clone_arr_index, base);
 }
 
 /** Move to next state
@@ -34,6 +34,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "dict0dict.h"
 #include "fsp0sysspace.h"
 #include "handler.h"
+#include "mysqld.h" /* server_uuid */
 #include "srv0start.h"
 
 /** Callback to add an archived redo file to current snapshot
@@ -159,6 +160,23 @@ dberr_t Clone_Snapshot::init_file_copy() {
     return (err);
   }
 
+  /* Copy the data files in full unless the base is from this server
+  and all pages modified since the base LSN are still archived in the
+  same group. Archived page IDs do not survive a restart of this server,
+  so the first clone after a restart is always a full one. */
+  if (is_incremental() &&
+      (m_base->m_donor_uuid != server_uuid ||
+       m_snapshot_type != HA_CLONE_HYBRID ||
+       m_base->m_group_lsn != m_page_ctx.get_group_lsn() ||
+       !m_page_ctx.rewind(m_base_lsn))) {
+    ib::info(ER_IB_MSG_87)
+        << "Clone copies all data: the pages modified since the base LSN "
+        << m_base_lsn << " of the recipient are not tracked, because page"
+        << " tracking was off or this server was restarted since.";
+
+    m_base_lsn = LSN_MAX;
+  }
+
   /* Add buffer pool dump file. Always the first one in the list. */
   err = add_buf_pool_file();
 
@@ -181,7 +199,8 @@ dberr_t Clone_Snapshot::init_file_copy() {
                           << " chunks, "
                           << " chunk size : "
                           << (chunk_size() * UNIV_PAGE_SIZE) / (1024 * 1024)
-                          << " M";
+                          << " M"
+                          << (is_incremental() ? ", incremental" : "");
 
   return (err);
 }
@@ -327,6 +346,8 @@ Clone_File_Meta *Clone_Snapshot::build_file(const char *file_name,
     return (file_meta);
   }
 
+  file_meta->m_copy_modified = false;
+
   /* For redo file with no data, add dummy entry. */
   if (file_name == nullptr) {
     num_chunks = 1;
@@ -420,6 +441,28 @@ dberr_t Clone_Snapshot::add_file(const char *name, ib_uint64_t size_bytes,
     return (DB_OUT_OF_MEMORY);
   }
 
+  /* For incremental clone, only metadata is sent for a tablespace file
+the recipient still has from the base clone. The modified pages are
+sent during page copy. Any other file is copied in full. */
+  if (is_incremental() && space_id != dict_sys_t::s_invalid_space_id) {
+    /* Match the name the recipient creates the file with. */
+    std::string file_name(name);
+
+    if (!fsp_is_ibd_tablespace(static_cast<space_id_t>(space_id)) &&
+        Fil_path::is_absolute_path(file_name)) {
+      file_name.erase(0, file_name.rfind(OS_PATH_SEPARATOR) + 1);
+
+    } else if (Fil_path::has_prefix(file_name, Fil_path::DOT_SLASH)) {
+      file_name.erase(0, 2);
+    }
+
+    if (m_base->has_file(file_name.c_str(), space_id, size_bytes)) {
+      num_chunks = 1;
+      file_meta->m_end_chunk = file_meta->m_begin_chunk;
+      file_meta->m_copy_modified = true;
+    }
+  }
+
   file_meta->m_space_id = space_id;
 
   file_meta->m_file_index = m_num_data_files;
@@ -483,10 +526,6 @@ dberr_t Clone_Snapshot::add_node(fil_node_t *node) {
     size_bytes = file_size.m_total_size;
   }
 
-#ifdef HAVE_PSI_STAGE_INTERFACE
-  m_monitor.add_estimate(size_bytes);
-#endif
-
   /* Add file to snapshot. */
   err = add_file(node->name, size_bytes, space->id, false);
 
@@ -494,6 +533,12 @@ dberr_t Clone_Snapshot::add_node(fil_node_t *node) {
     return (err);
   }
 
+#ifdef HAVE_PSI_STAGE_INTERFACE
+  if (!m_data_file_vector.back()->m_copy_modified) {
+    m_monitor.add_estimate(size_bytes);
+  }
+#endif
+
   /* Add to hash map only for first node of the tablesapce. */
   if (m_data_file_map[space->id] == 0) {
     m_data_file_map[space->id] = m_num_data_files;
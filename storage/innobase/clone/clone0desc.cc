@@ -30,11 +30,15 @@ this program; if not, write to the Free Software Foundation, Inc.,
  *******************************************************/
 
 #include "clone0desc.h"
+#include "log0log.h"
 #include "mach0data.h"
 
 /** Maximum supported descriptor version. The version represents the current
 set of descriptors and its elements. */
-static const uint CLONE_DESC_MAX_VERSION = 100;
+static const uint CLONE_DESC_MAX_VERSION = 101;
+
+/** First descriptor version with the fields for incremental clone */
+static const uint CLONE_DESC_INCREMENTAL_VERSION = 101;
 
 /** Header: Version is in first 4 bytes */
 static const uint CLONE_DESC_VER_OFFSET = 0;
@@ -103,25 +107,180 @@ static const uint CLONE_LOC_SID_OFFSET = CLONE_LOC_CID_OFFSET + 8;
 /** Locator: Clone array index in 4 bytes */
 static const uint CLONE_LOC_IDX_OFFSET = CLONE_LOC_SID_OFFSET + 8;
 
-/** Locator: Total length */
-static const uint CLONE_DESC_LOC_LEN = CLONE_LOC_IDX_OFFSET + 4;
+/** Locator: Total length before version 101 */
+static const uint CLONE_DESC_LOC_BASE_LEN = CLONE_LOC_IDX_OFFSET + 4;
+
+/** Locator: Length of serialized base in 4 bytes */
+static const uint CLONE_LOC_BASE_LEN_OFFSET = CLONE_DESC_LOC_BASE_LEN;
+
+/** Locator: Serialized base of the recipient data directory */
+static const uint CLONE_LOC_BASE_OFFSET = CLONE_LOC_BASE_LEN_OFFSET + 4;
+
+/** Check if there is a base
+@return true if the data directory was made by a clone */
+bool Clone_Base::is_set() const { return (m_lsn != LSN_MAX); }
+
+/** Reset to no base */
+void Clone_Base::clear() {
+  m_lsn = LSN_MAX;
+  m_group_lsn = LSN_MAX;
+  m_donor_uuid.clear();
+  m_files.clear();
+}
+
+/** Get the length of the serialized base
+@return length in bytes */
+size_t Clone_Base::serialized_length() const {
+  /* LSN, group LSN, UUID length and number of files */
+  size_t len = 8 + 8 + 4 + m_donor_uuid.length() + 4;
+
+  /* Tablespace ID, file size and file name length for each file */
+  for (auto &file : m_files) {
+    len += 4 + 8 + 4 + file.m_file_name.length();
+  }
+
+  return (len);
+}
+
+/** Serialize the base. Caller must allocate #serialized_length bytes.
+@param[out]	buf	serialized base */
+void Clone_Base::serialize(byte *buf) const {
+  mach_write_to_8(buf, m_lsn);
+  mach_write_to_8(buf + 8, m_group_lsn);
+  buf += 16;
+
+  mach_write_to_4(buf, m_donor_uuid.length());
+  memcpy(buf + 4, m_donor_uuid.data(), m_donor_uuid.length());
+  buf += 4 + m_donor_uuid.length();
+
+  mach_write_to_4(buf, m_files.size());
+  buf += 4;
+
+  for (auto &file : m_files) {
+    mach_write_to_4(buf, file.m_space_id);
+    mach_write_to_8(buf + 4, file.m_file_size);
+    mach_write_to_4(buf + 12, file.m_file_name.length());
+    buf += 16;
+
+    memcpy(buf, file.m_file_name.data(), file.m_file_name.length());
+    buf += file.m_file_name.length();
+  }
+}
+
+/** Deserialize the base.
+@param[in]	buf	serialized base
+@param[in]	len	length of the serialized base
+@return true if successful, false if the base is not valid */
+bool Clone_Base::deserialize(const byte *buf, size_t len) {
+  const byte *end = buf + len;
+
+  clear();
+
+  if (len < 20) {
+    return (false);
+  }
+
+  lsn_t lsn = mach_read_from_8(buf);
+  m_group_lsn = mach_read_from_8(buf + 8);
+  buf += 16;
+
+  size_t uuid_len = mach_read_from_4(buf);
+  buf += 4;
+
+  if (static_cast<size_t>(end - buf) < uuid_len + 4) {
+    clear();
+    return (false);
+  }
+
+  m_donor_uuid.assign(reinterpret_cast<const char *>(buf), uuid_len);
+  buf += uuid_len;
+
+  ulint num_files = mach_read_from_4(buf);
+  buf += 4;
+
+  for (ulint index = 0; index < num_files; ++index) {
+    if (end - buf < 16) {
+      clear();
+      return (false);
+    }
+
+    Clone_Base_File file;
+
+    file.m_space_id = mach_read_from_4(buf);
+    file.m_file_size = mach_read_from_8(buf + 4);
+    size_t name_len = mach_read_from_4(buf + 12);
+    buf += 16;
+
+    if (static_cast<size_t>(end - buf) < name_len) {
+      clear();
+      return (false);
+    }
+
+    file.m_file_name.assign(reinterpret_cast<const char *>(buf), name_len);
+    buf += name_len;
+
+    m_files.push_back(file);
+  }
+
+  if (buf != end) {
+    clear();
+    return (false);
+  }
+
+  m_lsn = lsn;
+
+  return (true);
+}
+
+/** Check if the recipient still has a donor file as it was left by
+the base clone, so that only the modified pages need to be copied.
+@param[in]	name		file name relative to the data directory
+@param[in]	space_id	tablespace ID for the file
+@param[in]	size		file size in bytes on the donor
+@return true if the file can be copied incrementally */
+bool Clone_Base::has_file(const char *name, ulint space_id,
+                          ib_uint64_t size) const {
+  if (!is_set()) {
+    return (false);
+  }
+
+  for (auto &file : m_files) {
+    if (file.m_space_id == space_id && file.m_file_name == name) {
+      return (file.m_file_size <= size);
+    }
+  }
+
+  return (false);
+}
 
 /** Initialize clone locator.
-@param[in]	id	Clone identifier
-@param[in]	snap_id	Snapshot identifier
-@param[in]	version	Descriptor version
-@param[in]	index	clone index */
+@param[in]	id		Clone identifier
+@param[in]	snap_id		Snapshot identifier
+@param[in]	version		Descriptor version
+@param[in]	index		clone index
+@param[in]	base		base of recipient data directory or nullptr */
 void Clone_Desc_Locator::init(ib_uint64_t id, ib_uint64_t snap_id, uint version,
-                              uint index) {
+                              uint index, const Clone_Base *base) {
   m_header.m_version = version;
 
-  m_header.m_length = CLONE_DESC_LOC_LEN;
+  m_header.m_length = CLONE_DESC_LOC_BASE_LEN;
+
+  if (version >= CLONE_DESC_INCREMENTAL_VERSION) {
+    m_header.m_length = CLONE_LOC_BASE_OFFSET;
+
+    if (base != nullptr && base->is_set()) {
+      m_header.m_length += static_cast<uint>(base->serialized_length());
+    }
+  }
+
   m_header.m_type = CLONE_DESC_LOCATOR;
 
   m_clone_id = id;
   m_snapshot_id = snap_id;
 
   m_clone_index = index;
+
+  m_base = base;
 }
 
 /** Check if the passed locator matches the current one.
@@ -162,11 +321,24 @@ void Clone_Desc_Locator::serialize(byte *&desc_loc, uint &len,
   mach_write_to_8(desc_loc + CLONE_LOC_SID_OFFSET, m_snapshot_id);
 
   mach_write_to_4(desc_loc + CLONE_LOC_IDX_OFFSET, m_clone_index);
+
+  if (m_header.m_version >= CLONE_DESC_INCREMENTAL_VERSION) {
+    uint base_len = m_header.m_length - CLONE_LOC_BASE_OFFSET;
+
+    mach_write_to_4(desc_loc + CLONE_LOC_BASE_LEN_OFFSET, base_len);
+
+    if (base_len != 0) {
+      ut_ad(base_len == m_base->serialized_length());
+      m_base->serialize(desc_loc + CLONE_LOC_BASE_OFFSET);
+    }
+  }
 }
 
 /** Deserialize the descriptor.
-@param[in]	desc_loc	serialized locator */
-void Clone_Desc_Locator::deserialize(byte *desc_loc) {
+@param[in]	desc_loc	serialized locator
+@param[out]	base		base of recipient data directory, if not
+                                nullptr */
+void Clone_Desc_Locator::deserialize(byte *desc_loc, Clone_Base *base) {
   m_header.deserialize(desc_loc);
 
   ut_ad(m_header.m_type == CLONE_DESC_LOCATOR);
@@ -175,6 +347,27 @@ void Clone_Desc_Locator::deserialize(byte *desc_loc) {
   m_snapshot_id = mach_read_from_8(desc_loc + CLONE_LOC_SID_OFFSET);
 
   m_clone_index = mach_read_from_4(desc_loc + CLONE_LOC_IDX_OFFSET);
+
+  m_base = nullptr;
+
+  if (base == nullptr) {
+    return;
+  }
+
+  base->clear();
+
+  if (m_header.m_version < CLONE_DESC_INCREMENTAL_VERSION ||
+      m_header.m_length < CLONE_LOC_BASE_OFFSET) {
+    return;
+  }
+
+  uint base_len = mach_read_from_4(desc_loc + CLONE_LOC_BASE_LEN_OFFSET);
+
+  /* Ignore a malformed base: the clone is then a full clone. */
+  if (base_len == 0 || base_len != m_header.m_length - CLONE_LOC_BASE_OFFSET ||
+      !base->deserialize(desc_loc + CLONE_LOC_BASE_OFFSET, base_len)) {
+    base->clear();
+  }
 }
 
 /** Task: Clone task index in 4 bytes */
@@ -264,6 +457,10 @@ static const uint CLONE_FILE_FNAME_OFFSET = CLONE_FILE_FNAMEL_OFFSET + 4;
 /** File Metadata: Length excluding the file name */
 static const uint CLONE_FILE_BASE_LEN = CLONE_FILE_FNAME_OFFSET;
 
+/** File Metadata: Flag for copying the modified pages only in 4 bytes,
+after the file name from version 101 */
+static const uint CLONE_FILE_FLAG_LEN = 4;
+
 /** Initialize header
 @param[in]	version	descriptor version */
 void Clone_Desc_File_MetaData::init_header(uint version) {
@@ -272,6 +469,10 @@ void Clone_Desc_File_MetaData::init_header(uint version) {
   m_header.m_length = CLONE_FILE_BASE_LEN;
   m_header.m_length += static_cast<uint>(m_file_meta.m_file_name_len);
 
+  if (version >= CLONE_DESC_INCREMENTAL_VERSION) {
+    m_header.m_length += CLONE_FILE_FLAG_LEN;
+  }
+
   m_header.m_type = CLONE_DESC_FILE_METADATA;
 }
 
@@ -285,7 +486,6 @@ void Clone_Desc_File_MetaData::serialize(byte *&desc_file, uint &len,
   /* Allocate descriptor if needed. */
   if (desc_file == nullptr) {
     len = m_header.m_length;
-    ut_ad(len == CLONE_FILE_FNAME_OFFSET + m_file_meta.m_file_name_len);
 
     desc_file = static_cast<byte *>(mem_heap_alloc(heap, len));
   } else {
@@ -316,6 +516,12 @@ void Clone_Desc_File_MetaData::serialize(byte *&desc_file, uint &len,
            static_cast<const void *>(m_file_meta.m_file_name),
            m_file_meta.m_file_name_len);
   }
+
+  if (m_header.m_version >= CLONE_DESC_INCREMENTAL_VERSION) {
+    mach_write_to_4(
+        desc_file + CLONE_FILE_FNAME_OFFSET + m_file_meta.m_file_name_len,
+        m_file_meta.m_copy_modified ? 1 : 0);
+  }
 }
 
 /** Deserialize the descriptor.
@@ -344,8 +550,20 @@ void Clone_Desc_File_MetaData::deserialize(byte *desc_file) {
   m_file_meta.m_file_name_len =
       mach_read_from_4(desc_file + CLONE_FILE_FNAMEL_OFFSET);
 
-  ut_ad(m_header.m_length ==
-        CLONE_FILE_FNAME_OFFSET + m_file_meta.m_file_name_len);
+  m_file_meta.m_copy_modified = false;
+
+  if (m_header.m_version >= CLONE_DESC_INCREMENTAL_VERSION) {
+    ut_ad(m_header.m_length == CLONE_FILE_FNAME_OFFSET +
+                                   m_file_meta.m_file_name_len +
+                                   CLONE_FILE_FLAG_LEN);
+
+    m_file_meta.m_copy_modified =
+        (mach_read_from_4(desc_file + CLONE_FILE_FNAME_OFFSET +
+                          m_file_meta.m_file_name_len) != 0);
+  } else {
+    ut_ad(m_header.m_length ==
+          CLONE_FILE_FNAME_OFFSET + m_file_meta.m_file_name_len);
+  }
 
   if (m_file_meta.m_file_name_len == 0) {
     m_file_meta.m_file_name = nullptr;
@@ -367,15 +585,33 @@ static const uint CLONE_DESC_STATE_NUM_CHUNKS = CLONE_DESC_TASK_OFFSET + 4;
 /** Clone State: Number of files in 4 bytes */
 static const uint CLONE_DESC_STATE_NUM_FILES = CLONE_DESC_STATE_NUM_CHUNKS + 4;
 
+/** Clone State: Total length before version 101 */
+static const uint CLONE_DESC_STATE_BASE_LEN = CLONE_DESC_STATE_NUM_FILES + 4;
+
+/** Clone State: Base LSN of incremental clone in 8 bytes */
+static const uint CLONE_DESC_STATE_BASE_LSN = CLONE_DESC_STATE_BASE_LEN;
+
+/** Clone State: Page tracking start LSN in 8 bytes */
+static const uint CLONE_DESC_STATE_TRACK_LSN = CLONE_DESC_STATE_BASE_LSN + 8;
+
+/** Clone State: Page tracking group start LSN in 8 bytes */
+static const uint CLONE_DESC_STATE_GROUP_LSN = CLONE_DESC_STATE_TRACK_LSN + 8;
+
+/** Clone State: Donor server UUID in UUID_LENGTH bytes */
+static const uint CLONE_DESC_STATE_DONOR_UUID = CLONE_DESC_STATE_GROUP_LSN + 8;
+
 /** Clone State: Total length */
-static const uint CLONE_DESC_STATE_LEN = CLONE_DESC_STATE_NUM_FILES + 4;
+static const uint CLONE_DESC_STATE_LEN =
+    CLONE_DESC_STATE_DONOR_UUID + UUID_LENGTH;
 
 /** Initialize header
 @param[in]	version	descriptor version */
 void Clone_Desc_State::init_header(uint version) {
   m_header.m_version = version;
 
-  m_header.m_length = CLONE_DESC_STATE_LEN;
+  m_header.m_length = (version < CLONE_DESC_INCREMENTAL_VERSION)
+                          ? CLONE_DESC_STATE_BASE_LEN
+                          : CLONE_DESC_STATE_LEN;
 
   m_header.m_type = CLONE_DESC_STATE;
 }
@@ -403,6 +639,15 @@ void Clone_Desc_State::serialize(byte *&desc_state, uint &len,
 
   mach_write_to_4(desc_state + CLONE_DESC_STATE_NUM_CHUNKS, m_num_chunks);
   mach_write_to_4(desc_state + CLONE_DESC_STATE_NUM_FILES, m_num_files);
+
+  if (m_header.m_version >= CLONE_DESC_INCREMENTAL_VERSION) {
+    mach_write_to_8(desc_state + CLONE_DESC_STATE_BASE_LSN, m_base_lsn);
+    mach_write_to_8(desc_state + CLONE_DESC_STATE_TRACK_LSN, m_track_lsn);
+    mach_write_to_8(desc_state + CLONE_DESC_STATE_GROUP_LSN, m_group_lsn);
+
+    memcpy(desc_state + CLONE_DESC_STATE_DONOR_UUID, m_donor_uuid,
+           UUID_LENGTH);
+  }
 }
 
 /** Deserialize the descriptor.
@@ -420,6 +665,23 @@ void Clone_Desc_State::deserialize(byte *desc_state) {
 
   m_num_chunks = mach_read_from_4(desc_state + CLONE_DESC_STATE_NUM_CHUNKS);
   m_num_files = mach_read_from_4(desc_state + CLONE_DESC_STATE_NUM_FILES);
+
+  if (m_header.m_version >= CLONE_DESC_INCREMENTAL_VERSION) {
+    m_base_lsn = mach_read_from_8(desc_state + CLONE_DESC_STATE_BASE_LSN);
+    m_track_lsn = mach_read_from_8(desc_state + CLONE_DESC_STATE_TRACK_LSN);
+    m_group_lsn = mach_read_from_8(desc_state + CLONE_DESC_STATE_GROUP_LSN);
+
+    memcpy(m_donor_uuid, desc_state + CLONE_DESC_STATE_DONOR_UUID,
+           UUID_LENGTH);
+  } else {
+    m_base_lsn = LSN_MAX;
+    m_track_lsn = LSN_MAX;
+    m_group_lsn = LSN_MAX;
+
+    memset(m_donor_uuid, 0, UUID_LENGTH);
+  }
+
+  m_donor_uuid[UUID_LENGTH] = '\0';
 }
 
 /** Clone Data: Snapshot state in 4 bytes */
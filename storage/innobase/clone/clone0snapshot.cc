@@ -31,6 +31,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 
 #include "clone0snapshot.h"
 #include "handler.h"
+#include "mysqld.h" /* server_uuid */
 #include "page0zip.h"
 
 /** Snapshot heap initial size */
@@ -62,6 +63,8 @@ Clone_Snapshot::Clone_Snapshot(Clone_Handle_Type hdl_type,
       m_num_data_files(),
       m_num_data_chunks(),
       m_page_ctx(),
+      m_base(),
+      m_base_lsn(LSN_MAX),
       m_num_pages(),
       m_num_duplicate_pages(),
       m_redo_ctx(),
@@ -98,6 +101,23 @@ void Clone_Snapshot::get_state_info(Clone_Desc_State *state_desc) {
   state_desc->m_state = m_snapshot_state;
   state_desc->m_num_chunks = m_num_current_chunks;
 
+  state_desc->m_base_lsn = m_base_lsn;
+
+  /* Pages modified after the start LSN stay archived only while
+  durable page tracking keeps the group active. */
+  if (arch_page_sys->is_durable()) {
+    state_desc->m_track_lsn = m_page_ctx.get_start_lsn();
+    state_desc->m_group_lsn = m_page_ctx.get_group_lsn();
+  } else {
+    state_desc->m_track_lsn = LSN_MAX;
+    state_desc->m_group_lsn = LSN_MAX;
+  }
+
+  /* The recipient sends it back, so that the base is only used when
+  cloning from the same donor. */
+  memcpy(state_desc->m_donor_uuid, server_uuid, UUID_LENGTH);
+  state_desc->m_donor_uuid[UUID_LENGTH] = '\0';
+
   if (m_snapshot_state == CLONE_SNAPSHOT_FILE_COPY) {
     state_desc->m_num_files = m_num_data_files;
 
@@ -128,6 +148,8 @@ void Clone_Snapshot::set_state_info(Clone_Desc_State *state_desc) {
 
   m_num_current_chunks = state_desc->m_num_chunks;
 
+  m_base_lsn = state_desc->m_base_lsn;
+
   if (m_snapshot_state == CLONE_SNAPSHOT_FILE_COPY) {
     m_num_data_files = state_desc->m_num_files;
     m_num_data_chunks = state_desc->m_num_chunks;
@@ -338,6 +360,7 @@ dberr_t Clone_Snapshot::get_next_block(uint chunk_num, uint &block_num,
   ib_uint64_t chunk_offset = 0;
   uint start_index;
   Clone_File_Meta *current_file;
+  bool metadata_only = false;
 
   /* File index for last chunk. This index value is always increasing
   for a task. We skip all previous index while searching for new file. */
@@ -353,6 +376,9 @@ dberr_t Clone_Snapshot::get_next_block(uint chunk_num, uint &block_num,
     /* Get file for the chunk. */
     current_file =
         get_file(m_data_file_vector, m_num_data_files, chunk_num, start_index);
+
+    /* File kept by the recipient in incremental clone. */
+    metadata_only = current_file->m_copy_modified;
   } else {
     /* For redo copy header and trailer are returned in buffer. */
     ut_ad(m_snapshot_state == CLONE_SNAPSHOT_REDO_COPY);
@@ -412,21 +438,24 @@ dberr_t Clone_Snapshot::get_next_block(uint chunk_num, uint &block_num,
       chunk_offset = m_redo_start_offset / UNIV_PAGE_SIZE;
     }
 
-    /* Dummy redo file entry. Need to send metadata. */
-    if (current_file->m_file_size == 0) {
-      if (block_num != 0) {
-        block_num = 0;
-        return (DB_SUCCESS);
-      }
-      ++block_num;
-
-      *file_meta = *current_file;
-      data_buf = nullptr;
-      data_size = 0;
-      data_offset = 0;
+    /* Dummy redo file entry. */
+    metadata_only = (current_file->m_file_size == 0);
+  }
 
+  /* Need to send metadata only. */
+  if (metadata_only) {
+    if (block_num != 0) {
+      block_num = 0;
       return (DB_SUCCESS);
     }
+    ++block_num;
+
+    *file_meta = *current_file;
+    data_buf = nullptr;
+    data_size = 0;
+    data_offset = 0;
+
+    return (DB_SUCCESS);
   }
 
   /* We have identified the file to transfer data at this point.
@@ -8194,6 +8194,7 @@ dberr_t fil_set_compression(dict_table_t *table, const char *algorithm) {
     compressible tables not otherwise specified. */
     switch (srv_debug_compress) {
       case Compression::LZ4:
+      case Compression::LZ4HC:
       case Compression::ZLIB:
       case Compression::NONE:
 
@@ -2268,6 +2268,65 @@ ulint fseg_n_reserved_pages(
   return (ret);
 }
 
+/** Collects the pages used by a segment as ranges of consecutive pages,
+for reading them ahead. The fragment pages come first, then the used pages
+of each extent of the segment.
+@param[in]	header		segment header
+@param[in]	max_pages	stop once this many pages have been collected
+@param[out]	ranges		ranges of used pages
+@param[in,out]	mtr		mini-transaction
+@return number of pages in ranges */
+page_no_t fseg_get_used_page_ranges(fseg_header_t *header, page_no_t max_pages,
+                                    fseg_page_ranges_t *ranges, mtr_t *mtr) {
+  const space_id_t space_id = page_get_space_id(page_align(header));
+
+  fil_space_t *space = fil_space_get(space_id);
+
+  mtr_x_lock_space(space, mtr);
+
+  const page_size_t page_size(space->flags);
+
+  fseg_inode_t *inode = fseg_inode_get(header, space_id, page_size, mtr);
+
+  page_no_t n_pages = 0;
+
+  for (ulint i = 0; i < FSEG_FRAG_ARR_N_SLOTS && n_pages < max_pages; i++) {
+    const page_no_t page_no = fseg_get_nth_frag_page_no(inode, i, mtr);
+
+    if (page_no != FIL_NULL) {
+      ranges->push_back(std::make_pair(page_no, 1));
+      ++n_pages;
+    }
+  }
+
+  /* The extents in FSEG_FREE have no used pages. */
+  for (ulint list : {FSEG_FULL, FSEG_NOT_FULL}) {
+    fil_addr_t node = flst_get_first(inode + list, mtr);
+
+    while (!fil_addr_is_null(node) && n_pages < max_pages) {
+      xdes_t *descr = xdes_lst_get_descriptor(space_id, page_size, node, mtr);
+
+      const page_no_t first = xdes_get_offset(descr);
+      page_no_t run = 0;
+
+      for (page_no_t i = 0; i <= FSP_EXTENT_SIZE; i++) {
+        if (i < FSP_EXTENT_SIZE && n_pages + run < max_pages &&
+            !xdes_mtr_get_bit(descr, XDES_FREE_BIT, i, mtr)) {
+          ++run;
+        } else if (run > 0) {
+          ranges->push_back(std::make_pair(first + i - run, run));
+          n_pages += run;
+          run = 0;
+        }
+      }
+
+      node = flst_get_next_addr(descr + XDES_FLST_NODE, mtr);
+    }
+  }
+
+  return (n_pages);
+}
+
 /** Tries to fill the free list of a segment with consecutive free extents.
 This happens if the segment is big enough to allow extents in the free list,
 the free list is empty, and the extents can be allocated consecutively from
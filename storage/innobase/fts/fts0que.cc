@@ -3808,10 +3808,11 @@ void fts_query_free_result(
   }
 }
 
-/** FTS Query sort result, returned by fts_query() on fts_ranking_t::rank. */
-void fts_query_sort_result_on_rank(
-    fts_result_t *result) /*!< out: result instance to sort.*/
-{
+/** FTS Query sort result, returned by fts_query() on fts_ranking_t::rank.
+@param[in,out]	result	result instance to sort
+@param[in]	limit	number of best ranked documents to sort, or
+                        ULONG_UNDEFINED to sort all of them */
+void fts_query_sort_result_on_rank(fts_result_t *result, ulonglong limit) {
   const ib_rbt_node_t *node;
   ib_rbt_t *ranked;
 
@@ -3832,6 +3833,19 @@ void fts_query_sort_result_on_rank(
 
     ut_a(ranking->words == NULL);
 
+    /* Keep only the best ranked documents. They are visited in
+    doc id order, so a document that does not rank above the last
+    one kept would be sorted after it, and can be skipped. */
+    if (limit > 0 && rbt_size(ranked) >= limit) {
+      const ib_rbt_node_t *last = rbt_last(ranked);
+
+      if (ranking->rank <= rbt_value(fts_ranking_t, last)->rank) {
+        continue;
+      }
+
+      ut_free(rbt_remove_node(ranked, last));
+    }
+
     rbt_insert(ranked, ranking, ranking);
   }
 
@@ -3840,6 +3854,30 @@ void fts_query_sort_result_on_rank(
   result->rankings_by_rank = ranked;
 }
 
+/** Get the next document of a result sorted on rank.
+@param[in,out]	result	result sorted by fts_query_sort_result_on_rank()
+@return the next ranking node, or NULL if the result is exhausted */
+ib_rbt_node_t *fts_query_next_on_rank(fts_result_t *result) {
+  const ib_rbt_node_t *node =
+      rbt_next(result->rankings_by_rank, result->current);
+
+  if (node == NULL &&
+      rbt_size(result->rankings_by_rank) < rbt_size(result->rankings_by_id)) {
+    /* Only the best ranked documents were sorted, but more are
+    read, e.g. because some of them are not visible to the
+    transaction. Sort all of them and skip the ones already read. */
+    ulint n_read = rbt_size(result->rankings_by_rank);
+
+    fts_query_sort_result_on_rank(result, ULONG_UNDEFINED);
+
+    for (node = rbt_first(result->rankings_by_rank); n_read > 0; --n_read) {
+      node = rbt_next(result->rankings_by_rank, node);
+    }
+  }
+
+  return (const_cast<ib_rbt_node_t *>(node));
+}
+
 /** A debug function to print result doc_id set. */
 static void fts_print_doc_id(
     fts_query_t *query) /*!< in : tree that stores doc_ids.*/
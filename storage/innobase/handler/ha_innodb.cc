@@ -77,6 +77,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include <sql_thd_internal_api.h>
 #include "api0api.h"
 #include "api0misc.h"
+#include "arch0arch.h"
 #include "auth_acls.h"
 #include "btr0btr.h"
 #include "btr0bulk.h"
@@ -1153,6 +1154,16 @@ static bool innobase_get_table_statistics(
     const dd::Properties &tbl_se_private_data, uint flags,
     ha_statistics *stats);
 
+/** Retrieve statistics of the tables of a schema from their persistent
+statistics, for the tables which are not in the cache.
+@param[in]	db_name		database name
+@param[in]	flags		flags used to retrieve specific stats
+@param[out]	stats		statistics of the tables read
+@return false on success, true on failure */
+static bool innobase_get_schema_table_statistics(
+    const char *db_name, const Schema_table_se_private_data &tables,
+    uint flags, Schema_table_statistics *stats);
+
 /** Retrieve index column cardinality.
 @param[in]		db_name			name of schema
 @param[in]		table_name		name of table
@@ -2236,7 +2247,7 @@ bool Compression::is_none(const char *algorithm) {
   return (false);
 }
 
-/** Check for supported COMPRESS := (ZLIB | LZ4 | NONE) supported values
+/** Check for supported COMPRESS := (ZLIB | LZ4 | LZ4HC | NONE) values
 @param[in]	algorithm	Name of the compression algorithm
 @param[out]	compression	The compression algorithm
 @return DB_SUCCESS or DB_UNSUPPORTED */
@@ -2250,6 +2261,9 @@ dberr_t Compression::check(const char *algorithm, Compression *compression) {
   } else if (innobase_strcasecmp(algorithm, "lz4") == 0) {
     compression->m_type = LZ4;
 
+  } else if (innobase_strcasecmp(algorithm, "lz4hc") == 0) {
+    compression->m_type = LZ4HC;
+
   } else {
     return (DB_UNSUPPORTED);
   }
@@ -2257,7 +2271,7 @@ dberr_t Compression::check(const char *algorithm, Compression *compression) {
   return (DB_SUCCESS);
 }
 
-/** Check for supported COMPRESS := (ZLIB | LZ4 | NONE) supported values
+/** Check for supported COMPRESS := (ZLIB | LZ4 | LZ4HC | NONE) values
 @param[in]	algorithm	Name of the compression algorithm
 @return DB_SUCCESS or DB_UNSUPPORTED */
 dberr_t Compression::validate(const char *algorithm) {
@@ -4145,6 +4159,9 @@ static int innodb_init(void *p) {
 
   innobase_hton->get_table_statistics = innobase_get_table_statistics;
 
+  innobase_hton->get_schema_table_statistics =
+      innobase_get_schema_table_statistics;
+
   innobase_hton->get_index_column_cardinality =
       innobase_get_index_column_cardinality;
 
@@ -9241,8 +9258,12 @@ FT_INFO *ha_innobase::ft_init_ext_with_hints(uint keynr,      /* in: key num */
   /* TODO Implement function properly working with FT hint. */
   if (hints->get_flags() & FT_NO_RANKING) {
     m_prebuilt->m_fts_limit = hints->get_limit();
+    m_prebuilt->m_fts_sort_limit = ULONG_UNDEFINED;
   } else {
     m_prebuilt->m_fts_limit = ULONG_UNDEFINED;
+    m_prebuilt->m_fts_sort_limit = (hints->get_flags() & FT_SORTED)
+                                       ? hints->get_limit()
+                                       : ULONG_UNDEFINED;
   }
 
   return (ft_init_ext(hints->get_flags(), keynr, key));
@@ -9318,7 +9339,7 @@ int ha_innobase::ft_read(uchar *buf) /*!< in/out: buf contain result row */
       need to sort the document ids on their rank
       calculation. */
 
-      fts_query_sort_result_on_rank(result);
+      fts_query_sort_result_on_rank(result, m_prebuilt->m_fts_sort_limit);
 
       result->current =
           const_cast<ib_rbt_node_t *>(rbt_first(result->rankings_by_rank));
@@ -9326,8 +9347,7 @@ int ha_innobase::ft_read(uchar *buf) /*!< in/out: buf contain result row */
       ut_a(result->current == NULL);
     }
   } else {
-    result->current = const_cast<ib_rbt_node_t *>(
-        rbt_next(result->rankings_by_rank, result->current));
+    result->current = fts_query_next_on_rank(result);
   }
 
 next_record:
@@ -9380,8 +9400,7 @@ next_record:
         error = 0;
         break;
       case DB_RECORD_NOT_FOUND:
-        result->current = const_cast<ib_rbt_node_t *>(
-            rbt_next(result->rankings_by_rank, result->current));
+        result->current = fts_query_next_on_rank(result);
 
         if (!result->current) {
           /* exhaust the result set, should return
@@ -14656,44 +14675,51 @@ static bool innodb_get_table_statistics_for_uncached(
   TableStatsRecord stat_info;
   space_id_t space_id;
 
-  if (!row_search_table_stats(db_name, tbl_name, stat_info)) {
+  /** The server asks only for the statistics which
+  innobase_get_schema_table_statistics() did not read, which may not
+  need the persistent statistics or the tablespace. */
+  if ((flags & HA_STATUS_VARIABLE) &&
+      !row_search_table_stats(db_name, tbl_name, stat_info)) {
     return (false);
   }
 
-  /** Server passes dummy ts_se_private_data for file_per_table
-  tablespace. In that case, InnoDB should find the space_id using
-  the tablespace name. */
-  bool exists = ts_se_private_data.exists(dd_space_key_strings[DD_SPACE_ID]);
+  page_size_t page_size(univ_page_size);
 
-  if (exists) {
-    ts_se_private_data.get_uint32(dd_space_key_strings[DD_SPACE_ID], &space_id);
-  } else {
-    space_id = fil_space_get_id_by_name(norm_name);
+  if (flags & (HA_STATUS_VARIABLE | HA_STATUS_VARIABLE_EXTRA)) {
+    /** Server passes dummy ts_se_private_data for file_per_table
+    tablespace. In that case, InnoDB should find the space_id using
+    the tablespace name. */
+    bool exists = ts_se_private_data.exists(dd_space_key_strings[DD_SPACE_ID]);
 
-    if (space_id == SPACE_UNKNOWN) {
-      return (false);
+    if (exists) {
+      ts_se_private_data.get_uint32(dd_space_key_strings[DD_SPACE_ID],
+                                    &space_id);
+    } else {
+      space_id = fil_space_get_id_by_name(norm_name);
+
+      if (space_id == SPACE_UNKNOWN) {
+        return (false);
+      }
     }
-  }
 
-  fil_space_t *space;
-  ulint fsp_flags;
+    fil_space_t *space;
 
-  space = fil_space_acquire(space_id);
+    space = fil_space_acquire(space_id);
 
-  /** Tablespace is missing in this case. */
-  if (space == NULL) {
-    return (false);
-  }
+    /** Tablespace is missing in this case. */
+    if (space == NULL) {
+      return (false);
+    }
 
-  fsp_flags = space->flags;
-  page_size_t page_size(fsp_flags);
+    page_size.copy_from(page_size_t(space->flags));
 
-  if (flags & HA_STATUS_VARIABLE_EXTRA) {
-    ulint avail_space = fsp_get_available_space_in_free_extents(space);
-    stats->delete_length = avail_space * 1024;
-  }
+    if (flags & HA_STATUS_VARIABLE_EXTRA) {
+      ulint avail_space = fsp_get_available_space_in_free_extents(space);
+      stats->delete_length = avail_space * 1024;
+    }
 
-  fil_space_release(space);
+    fil_space_release(space);
+  }
 
   if (flags & HA_STATUS_AUTO) {
     stats->auto_increment_value = innodb_get_auto_increment_for_uncached(
@@ -14724,6 +14750,135 @@ static bool innodb_get_table_statistics_for_uncached(
   return (true);
 }
 
+/** Retrieve statistics of the tables of a schema from their persistent
+statistics, for the tables which are not in the cache. This reads the
+records of all tables of the schema from innodb_table_stats in one scan,
+instead of a search for each table. Tables in the cache, partitions and
+tables in shared tablespaces are left to innobase_get_table_statistics().
+@param[in]	db_name		database name
+@param[in]	tables		table ids and se private data of the schema
+@param[in]	flags		flags used to retrieve specific stats
+@param[out]	stats		statistics of the tables read
+@return false on success, true on failure */
+static bool innobase_get_schema_table_statistics(
+    const char *db_name, const Schema_table_se_private_data &tables,
+    uint flags, Schema_table_statistics *stats) {
+  if (!(flags & HA_STATUS_VARIABLE)) {
+    return (false);
+  }
+
+  struct Persistent_stats {
+    std::string tbl_name;
+    ib_uint64_t n_rows;
+    ulint clustered_index_size;
+    ulint sum_of_other_index_sizes;
+  };
+
+  std::vector<Persistent_stats> persistent_stats;
+
+  row_search_schema_table_stats(
+      db_name, [&persistent_stats](const TableStatsRecord &stat_info) {
+        const char *tbl_name = stat_info.get_tbl_name();
+
+        if (tbl_name == nullptr || strstr(tbl_name, "#P#") != nullptr ||
+            strstr(tbl_name, "#p#") != nullptr) {
+          return;
+        }
+
+        persistent_stats.push_back({tbl_name, stat_info.get_n_rows(),
+                          stat_info.get_clustered_index_size(),
+                          stat_info.get_sum_of_other_index_size()});
+      });
+
+  for (const auto &table : persistent_stats) {
+    char norm_name[FN_REFLEN];
+    char buf[2 * NAME_CHAR_LEN * 5 + 2 + 1];
+    bool truncated;
+
+    build_table_filename(buf, sizeof(buf), db_name, table.tbl_name.c_str(),
+                         NULL, 0, &truncated);
+
+    if (truncated) {
+      continue;
+    }
+
+    normalize_table_name(norm_name, buf);
+
+    /** The statistics of a table in the cache may be more recent
+    than the persistent ones. */
+    mutex_enter(&dict_sys->mutex);
+    bool cached = dict_table_check_if_in_cache_low(norm_name) != nullptr;
+    mutex_exit(&dict_sys->mutex);
+
+    if (cached) {
+      continue;
+    }
+
+    space_id_t space_id = fil_space_get_id_by_name(norm_name);
+
+    if (space_id == SPACE_UNKNOWN) {
+      continue;
+    }
+
+    fil_space_t *space = fil_space_acquire_silent(space_id);
+
+    if (space == nullptr) {
+      continue;
+    }
+
+    page_size_t page_size(space->flags);
+    ha_statistics table_stats;
+    uint read_flags = HA_STATUS_VARIABLE;
+
+    if (flags & HA_STATUS_VARIABLE_EXTRA) {
+      ulint avail_space = fsp_get_available_space_in_free_extents(space);
+      table_stats.delete_length = avail_space * 1024;
+      read_flags |= HA_STATUS_VARIABLE_EXTRA;
+    }
+
+    fil_space_release(space);
+
+    if (flags & HA_STATUS_TIME) {
+      table_stats.update_time = (time_t)NULL;
+      read_flags |= HA_STATUS_TIME;
+    }
+
+    auto dd_table = tables.find(table.tbl_name);
+
+    if ((flags & HA_STATUS_AUTO) && dd_table != tables.end() &&
+        dd_table->second.first != dd::INVALID_OBJECT_ID) {
+      std::unique_ptr<dd::Properties> tbl_se_private_data(
+          dd::Properties::parse_properties(dd_table->second.second));
+
+      if (tbl_se_private_data != nullptr) {
+        table_stats.auto_increment_value =
+            innodb_get_auto_increment_for_uncached(dd_table->second.first,
+                                                   *tbl_se_private_data);
+        read_flags |= HA_STATUS_AUTO;
+      }
+    }
+
+    table_stats.records = static_cast<ha_rows>(table.n_rows);
+    table_stats.data_file_length =
+        static_cast<ulonglong>(table.clustered_index_size) *
+        page_size.physical();
+    table_stats.index_file_length =
+        static_cast<ulonglong>(table.sum_of_other_index_sizes) *
+        page_size.physical();
+
+    if (table_stats.records == 0) {
+      table_stats.mean_rec_length = 0;
+    } else {
+      table_stats.mean_rec_length = static_cast<ulong>(
+          table_stats.data_file_length / table_stats.records);
+    }
+
+    (*stats)[table.tbl_name] = std::make_pair(table_stats, read_flags);
+  }
+
+  return (false);
+}
+
 /** Retrieve table satistics.
 @param[in]	db_name			database name
 @param[in]	table_name		table name
@@ -17825,6 +17980,36 @@ static void innodb_cmp_per_index_update(
   srv_cmp_per_index_enabled = !!(*(bool *)save);
 }
 
+/** Update the system variable innodb_page_tracking using the "saved"
+value. This function is registered as a callback with MySQL.
+@param[in]	thd		thread handle
+@param[in]	var		pointer to system variable
+@param[out]	var_ptr		where the formal string goes
+@param[in]	save		immediate result from check function */
+static void innodb_page_tracking_update(THD *thd, SYS_VAR *var,
+                                        void *var_ptr, const void *save) {
+  bool enable = *static_cast<const bool *>(save);
+
+  if (srv_read_only_mode) {
+    push_warning_printf(thd, Sql_condition::SL_WARNING, ER_WRONG_ARGUMENTS,
+                        "InnoDB: Page tracking is not available in"
+                        " read-only mode.");
+    return;
+  }
+
+  if (arch_page_sys->set_durable(enable) != DB_SUCCESS) {
+    /* Keep the reason among the conditions, but let the statement
+    succeed with the old value. */
+    thd->clear_error();
+    push_warning_printf(thd, Sql_condition::SL_WARNING, ER_WRONG_ARGUMENTS,
+                        "InnoDB: Could not %s page tracking.",
+                        enable ? "start" : "stop");
+    return;
+  }
+
+  srv_page_tracking = enable;
+}
+
 /** Update the system variable innodb_old_blocks_pct using the "saved"
  value. This function is registered as a callback with MySQL. */
 static void innodb_old_blocks_pct_update(
@@ -19972,6 +20157,13 @@ static MYSQL_SYSVAR_ULONG(
     " trigger a readahead.",
     NULL, NULL, 56, 0, 64, 0);
 
+static MYSQL_SYSVAR_ULONG(
+    partition_read_ahead, srv_partition_read_ahead, PLUGIN_VAR_RQCMDARG,
+    "Number of upcoming partitions whose clustered index leaf pages are"
+    " read ahead during a full scan of a partitioned table, once the scan"
+    " has left its first partition. 0 disables.",
+    NULL, NULL, 4, 0, 64, 0);
+
 static MYSQL_SYSVAR_STR(monitor_enable, innobase_enable_monitor_counter,
                         PLUGIN_VAR_RQCMDARG, "Turn on a monitor counter",
                         innodb_monitor_validate, innodb_enable_monitor_update,
@@ -20035,6 +20227,14 @@ static MYSQL_SYSVAR_BOOL(
     " may have negative impact on performance (off by default)",
     NULL, innodb_cmp_per_index_update, FALSE);
 
+static MYSQL_SYSVAR_BOOL(
+    page_tracking, srv_page_tracking, PLUGIN_VAR_OPCMDARG,
+    "Track the pages modified since the last clone started, so that"
+    " the next clone of this server copies only those (off by default)."
+    " Tracking starts anew when the server restarts, and a recipient data"
+    " directory that a server was started on is cloned in full.",
+    NULL, innodb_page_tracking_update, FALSE);
+
 static MYSQL_SYSVAR_ENUM(
     default_row_format, innodb_default_row_format, PLUGIN_VAR_RQCMDARG,
     "The default ROW FORMAT for all innodb tables created without explicit"
@@ -20259,6 +20459,7 @@ static SYS_VAR *innobase_system_variables[] = {
 #endif /* UNIV_DEBUG || UNIV_IBUF_DEBUG */
     MYSQL_SYSVAR(random_read_ahead),
     MYSQL_SYSVAR(read_ahead_threshold),
+    MYSQL_SYSVAR(partition_read_ahead),
     MYSQL_SYSVAR(read_only),
 
     MYSQL_SYSVAR(io_capacity),
@@ -20287,6 +20488,7 @@ static SYS_VAR *innobase_system_variables[] = {
     MYSQL_SYSVAR(status_output_locks),
     MYSQL_SYSVAR(print_all_deadlocks),
     MYSQL_SYSVAR(cmp_per_index_enabled),
+    MYSQL_SYSVAR(page_tracking),
     MYSQL_SYSVAR(max_undo_log_size),
     MYSQL_SYSVAR(purge_rseg_truncate_frequency),
     MYSQL_SYSVAR(undo_log_truncate),
@@ -51,6 +51,7 @@ Created Nov 22, 2013 Mattias Jonsson */
 #include "dd/types/table.h"
 
 /* Include necessary InnoDB headers */
+#include "btr0btr.h"
 #include "btr0sea.h"
 #include "dict0dd.h"
 #include "dict0dict.h"
@@ -73,6 +74,7 @@ Created Nov 22, 2013 Mattias Jonsson */
 #include "row0quiesce.h"
 #include "row0sel.h"
 #include "row0upd.h"
+#include "srv0srv.h"
 #include "univ.i"
 #include "ut0ut.h"
 
@@ -599,7 +601,8 @@ ha_innopart::ha_innopart(handlerton *hton, TABLE_SHARE *table_arg)
       m_sql_stat_start_parts(),
       m_pcur(),
       m_clust_pcur(),
-      m_new_partitions() {
+      m_new_partitions(),
+      m_read_ahead_next(MY_BIT_NONE) {
   m_int_table_flags &= ~(HA_INNOPART_DISABLED_TABLE_FLAGS);
 
   /* INNOBASE_SHARE is not used in ha_innopart.
@@ -1991,6 +1994,72 @@ int ha_innopart::read_range_next_in_part(uint part, uchar *record) {
   return (error);
 }
 
+/** Read ahead the clustered index leaf pages of the partitions which an
+unordered table scan will visit after a given partition. Each partition is
+read ahead once per scan, when the scan is innodb_partition_read_ahead
+partitions before it, so that the I/O overlaps with the scan of the
+preceding partitions. The reads are queued to the I/O handler threads like
+the linear read-ahead. Nothing is read ahead until the scan has left its
+first partition, so that short scans, such as ones with a LIMIT, do not
+read partitions which they will not visit.
+@param[in]	part_id	partition which the scan has reached */
+void ha_innopart::read_ahead_partitions(uint part_id) {
+  const ulong lookahead = srv_partition_read_ahead;
+
+  if (lookahead == 0 || m_read_ahead_next == MY_BIT_NONE ||
+      part_id == m_part_info->get_first_used_partition()) {
+    return;
+  }
+
+  /* Let the partitions being read ahead fill at most a quarter of the
+  buffer pool, so that the read ahead does not evict its own pages. */
+  const ulint pool_pages = srv_buf_pool_curr_size / UNIV_PAGE_SIZE;
+
+  const page_no_t max_pages =
+      static_cast<page_no_t>(pool_pages / (4 * lookahead));
+
+  if (max_pages < FSP_EXTENT_SIZE) {
+    m_read_ahead_next = MY_BIT_NONE;
+    return;
+  }
+
+  ulong n = 0;
+
+  for (uint i = m_part_info->get_next_used_partition(part_id);
+       i < MY_BIT_NONE && n < lookahead;
+       i = m_part_info->get_next_used_partition(i), ++n) {
+    if (i < m_read_ahead_next) {
+      continue;
+    }
+
+    m_read_ahead_next = i + 1;
+
+    dict_table_t *part_table = m_part_share->get_table_part(i);
+
+    if (part_table->ibd_file_missing || dict_table_is_discarded(part_table)) {
+      continue;
+    }
+
+    btr_read_ahead_leaves(part_table->first_index(), max_pages);
+  }
+}
+
+/** Initialize a table scan or random access.
+Unordered scans over more than one partition also read ahead the partitions
+which will be scanned next, see read_ahead_partitions().
+@param[in]	scan	true for table scan, false for random access.
+@return	0 or error number. */
+int ha_innopart::rnd_init(bool scan) {
+  /* Only scans over more than one partition can overlap their I/O.
+  Temporary tables are not read ahead. */
+  m_read_ahead_next = (scan && !m_prebuilt->table->is_temporary() &&
+                       m_part_info->num_partitions_used() > 1)
+                          ? 0
+                          : MY_BIT_NONE;
+
+  return (Partition_helper::ph_rnd_init(scan));
+}
+
 /** Initialize a table scan in a specific partition.
 @param[in]	part_id	Partition to initialize.
 @param[in]	scan	True if table/index scan false otherwise (for rnd_pos)
@@ -2009,6 +2078,10 @@ int ha_innopart::rnd_init_in_part(uint part_id, bool scan) {
     m_prebuilt->row_read_type = ROW_READ_WITH_LOCKS;
   }
 
+  if (scan) {
+    read_ahead_partitions(part_id);
+  }
+
   m_start_of_scan = true;
   DBUG_RETURN(err);
 }
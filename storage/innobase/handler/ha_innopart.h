@@ -649,6 +649,15 @@ class ha_innopart : public ha_innobase,
   /** New partitions during ADD/REORG/... PARTITION. */
   Altered_partitions *m_new_partitions;
 
+  /** The lowest partition id which the current table scan has not yet
+  read ahead, or MY_BIT_NONE if the scan does not read ahead. */
+  uint m_read_ahead_next;
+
+  /** Read ahead the partitions which the table scan visits after a
+  partition.
+  @param[in]	part_id	partition which the scan has reached */
+  void read_ahead_partitions(uint part_id);
+
   /** Clear used ins_nodes and upd_nodes. */
   void clear_ins_upd_nodes();
 
@@ -948,7 +957,7 @@ class ha_innopart : public ha_innobase,
 
   int index_end();
 
-  int rnd_init(bool scan) { return (Partition_helper::ph_rnd_init(scan)); }
+  int rnd_init(bool scan);
 
   int rnd_end() { return (Partition_helper::ph_rnd_end()); }
 
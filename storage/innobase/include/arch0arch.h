@@ -213,6 +213,7 @@ bool start_archiver_background();
 
 class Arch_Group;
 class Arch_Log_Sys;
+class Page_Arch_Client_Ctx;
 
 /** Archiver file context.
 Represents a set of fixed size files within a group */
@@ -766,6 +767,20 @@ struct Arch_Page_Pos {
   uint m_offset;
 };
 
+/** Reset point in page ID archiving system. Pages modified after the LSN
+are archived from the position onwards. */
+struct Arch_Reset_Point {
+  /** LSN when page tracking was reset */
+  lsn_t m_lsn;
+
+  /** Position of the first page ID archived after reset */
+  Arch_Page_Pos m_pos;
+};
+
+/** Vector of reset points in a page archive group */
+using Arch_Reset_Vec =
+    std::vector<Arch_Reset_Point, ut_allocator<Arch_Reset_Point>>;
+
 /** In memory data block in Page ID archiving system */
 class Arch_Block {
  public:
@@ -897,9 +912,11 @@ class Arch_Page_Sys {
         m_last_pos(),
         m_last_lsn(LSN_MAX),
         m_current_group(),
+        m_reset_points(),
         m_data(),
         m_flush_pos(),
-        m_write_pos() {
+        m_write_pos(),
+        m_durable_ctx() {
     mutex_create(LATCH_ID_PAGE_ARCH, &m_mutex);
     mutex_create(LATCH_ID_PAGE_ARCH_OPER, &m_oper_mutex);
   }
@@ -909,6 +926,7 @@ class Arch_Page_Sys {
     ut_ad(m_state == ARCH_STATE_INIT || m_state == ARCH_STATE_ABORT);
     ut_ad(m_current_group == nullptr);
     ut_ad(m_group_list.empty());
+    ut_ad(m_durable_ctx == nullptr);
 
     m_data.clean();
 
@@ -941,6 +959,26 @@ class Arch_Page_Sys {
   @param[in]	is_durable	if client needs durable archiving */
   void release(Arch_Group *group, bool is_durable);
 
+  /** Start or stop durable page tracking. While it is on, the current
+  group stays active and keeps its archived files, so that a clone can
+  get the pages modified since an earlier clone started. Caller must
+  serialize the calls.
+  @param[in]	enable	true to start, false to stop
+  @return error code */
+  dberr_t set_durable(bool enable);
+
+  /** Check if durable page tracking is on.
+  @return true, if durable page tracking is on */
+  bool is_durable() const { return (m_durable_ctx != nullptr); }
+
+  /** Get the position from which the pages modified after an LSN are
+  archived in a group.
+  @param[in]	group	archive group
+  @param[in]	lsn	LSN to look up
+  @param[out]	pos	position of the last reset point at or before lsn
+  @return true, if the group has been tracking pages since lsn */
+  bool get_reset_pos(Arch_Group *group, lsn_t lsn, Arch_Page_Pos *pos);
+
   /** Check and add page ID to archived data.
   Check for duplicate page.
   @param[in]	bpage		page to track
@@ -1035,6 +1073,9 @@ class Arch_Page_Sys {
   /** Current archive group */
   Arch_Group *m_current_group;
 
+  /** Reset points of the current group in increasing LSN order */
+  Arch_Reset_Vec m_reset_points;
+
   /** In memory data buffer */
   ArchPageData m_data;
 
@@ -1043,6 +1084,9 @@ class Arch_Page_Sys {
 
   /** Position to add new page ID */
   Arch_Page_Pos m_write_pos;
+
+  /** Client holding the current group for durable page tracking */
+  Page_Arch_Client_Ctx *m_durable_ctx;
 };
 
 /** Redo log archiver system global */
@@ -45,15 +45,36 @@ using Page_Arch_Cbk = dberr_t(void *ctx, byte *buff, uint num_pages);
 /** Dirty page archiver client context */
 class Page_Arch_Client_Ctx {
  public:
-  /** Constructor: Initialize elements */
-  Page_Arch_Client_Ctx() : m_state(ARCH_CLIENT_STATE_INIT) {}
+  /** Constructor: Initialize elements
+  @param[in]	is_durable	if client needs durable archiving */
+  explicit Page_Arch_Client_Ctx(bool is_durable = false)
+      : m_state(ARCH_CLIENT_STATE_INIT),
+        m_is_durable(is_durable),
+        m_start_lsn(LSN_MAX),
+        m_group_lsn(LSN_MAX) {}
 
   /** Start dirty page tracking and archiving */
   dberr_t start();
 
+  /** Move the start position back so that #get_pages also returns the
+  pages modified after an earlier LSN. Must be called after #start.
+  @param[in]	lsn	LSN to get the modified pages from
+  @return true, if the group has been tracking pages since lsn */
+  bool rewind(lsn_t lsn);
+
   /** Stop dirty page tracking and archiving */
   dberr_t stop();
 
+  /** Get the LSN when the client started tracking pages
+  @return start LSN, or LSN_MAX if never started */
+  lsn_t get_start_lsn() const { return (m_start_lsn); }
+
+  /** Get the LSN when the archive group the client is attached to
+  started. A group started later does not have the pages modified
+  before it.
+  @return group start LSN, or LSN_MAX if never started */
+  lsn_t get_group_lsn() const { return (m_group_lsn); }
+
   /** Get archived page Ids
   @param[in]	cbk_func	called repeatedly with page ID buffer
   @param[in]	cbk_ctx		callback function context
@@ -79,12 +100,18 @@ class Page_Arch_Client_Ctx {
   /** Page archiver client state */
   Arch_Client_State m_state;
 
+  /** If client needs durable archiving */
+  bool m_is_durable;
+
   /** Archive group the client is attached to */
   Arch_Group *m_group;
 
   /** Start LSN for archived data */
   lsn_t m_start_lsn;
 
+  /** Start LSN of the archive group */
+  lsn_t m_group_lsn;
+
   /** Stop LSN for archived data */
   lsn_t m_stop_lsn;
 
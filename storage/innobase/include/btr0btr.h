@@ -476,6 +476,13 @@ ulint btr_get_size(dict_index_t *index, /*!< in: index */
                    mtr_t *mtr) /*!< in/out: mini-transaction where index
                                is s-latched */
     MY_ATTRIBUTE((warn_unused_result));
+/** Issues asynchronous reads of the leaf pages of an index, ahead of a scan
+of the index. Only the pages of the leaf segment are read, and pages which
+are already in the buffer pool are skipped.
+@param[in]	index		index
+@param[in]	max_pages	maximum number of pages to read
+@return number of page read requests queued */
+ulint btr_read_ahead_leaves(dict_index_t *index, page_no_t max_pages);
 /** Allocates a new file page to be used in an index tree. NOTE: we assume
  that the caller has made the reservation for free extents!
  @retval NULL if no page could be allocated
@@ -83,9 +83,7 @@ class PageBulk {
         m_total_data(0),
 #endif /* UNIV_DEBUG */
         m_modify_clock(0),
-        m_flush_observer(observer) {
-    ut_ad(!dict_index_is_spatial(m_index));
-  }
+        m_flush_observer(observer) {}
 
   /** Deconstructor */
   ~PageBulk() { mem_heap_free(m_heap); }
@@ -347,4 +345,216 @@ class BtrBulk {
   page_bulk_vector *m_page_bulks;
 };
 
+class RtreeRunReader;
+
+/*
+R-tree bulk load with Sort-Tile-Recursive packing. The entries of a
+spatial index are collected in memory, and BtrBulk cannot be used since
+they do not arrive in index order. On finish, the entries are sorted on
+the x coordinate of the centre of their MBR, cut into vertical slices,
+and each slice is sorted on the y coordinate and cut into pages. The node
+pointers of these pages are packed the same way, one level at a time,
+until they fit in the root page. This gives full pages whose MBRs hardly
+overlap, instead of the half full pages left by R-tree splits.
+
+When the entries exceed the memory limit, they are sorted on x and
+written as a run to a merge sort temporary file, and the memory is
+reused. On finish, the runs are merged two at a time, as row_merge_sort()
+does, and the leaf level is built from the merged run one slice at a
+time. Only a slice, and the node pointers of the leaf pages, are in
+memory then.
+
+The proper function call sequence of RtreeBulk is as below:
+-- RtreeBulk::add (for all entries)
+-- RtreeBulk::finish
+*/
+
+class RtreeBulk {
+ public:
+  /** Constructor
+  @param[in]	index		spatial index, which must be empty
+  @param[in]	trx_id		transaction id
+  @param[in]	observer	flush observer
+  @param[in]	max_size	maximum size in bytes of the entries
+                                kept in memory
+  @param[in]	path		location for the merge files */
+  RtreeBulk(dict_index_t *index, trx_id_t trx_id, FlushObserver *observer,
+            ulint max_size, const char *path);
+
+  /** Destructor */
+  ~RtreeBulk();
+
+  /** Add a leaf entry. The entry is copied.
+  @param[in]	tuple	index entry
+  @return error code */
+  dberr_t add(const dtuple_t *tuple);
+
+  /** Build the R-tree from the entries added.
+  @return error code */
+  dberr_t finish();
+
+  /** An entry of the level being built. */
+  struct Entry {
+    /** x coordinate of the centre of the MBR */
+    double x;
+    /** y coordinate of the centre of the MBR */
+    double y;
+    /** the record */
+    rec_t *rec;
+    /** size of the record */
+    ulint size;
+  };
+
+  /** Entries sorted on x, in a merge file */
+  struct Run {
+    /** offset of the first entry in bytes */
+    os_offset_t offset;
+    /** number of entries */
+    ulint n_entries;
+  };
+
+ private:
+  typedef std::vector<Entry, ut_allocator<Entry>> entry_vector;
+
+  typedef std::vector<Run, ut_allocator<Run>> run_vector;
+
+  /** Set the centre of the MBR of a record.
+  @param[in,out]	entry	entry whose record is set */
+  static void set_centre(Entry *entry);
+
+  /** Sort the entries in memory on x and write them as a run.
+  @return error code */
+  dberr_t spill();
+
+  /** Merge the runs two at a time, until there is one.
+  @return error code */
+  dberr_t merge_runs();
+
+  /** Read entries of the merged run into m_entries and m_heap, which
+  are emptied first.
+  @param[in,out]	reader	reader of the merged run
+  @param[in]	n	maximum number of entries to read
+  @return error code */
+  dberr_t read_entries(RtreeRunReader *reader, ulint n);
+
+  /** Get the number of entries per page and per slice of a level.
+  @param[in]	n		number of entries
+  @param[in]	total_size	size of the entries and of their
+                                page directory slots
+  @param[out]	per_page	entries per page
+  @param[out]	slice_size	entries per slice */
+  void plan_level(ulint n, ulint total_size, ulint *per_page,
+                  ulint *slice_size) const;
+
+  /** Sort a range of entries in index order.
+  @param[in,out]	first	first entry to sort
+  @param[in,out]	last	end of the entries to sort */
+  void sort_in_index_order(Entry *first, Entry *last);
+
+  /** Check whether the entries of a level fit in a single page.
+  @param[in]	entries	entries of the level
+  @return true if they fit */
+  bool fit_in_page(const entry_vector &entries) const;
+
+  /** Write the pages of a level and collect their node pointers.
+  @param[in,out]	entries		entries of the level
+  @param[in]	level		level in the R-tree
+  @param[out]	node_ptrs	node pointers of the pages written
+  @param[in,out]	heap		memory heap for the node pointers
+  @return error code */
+  dberr_t build_level(entry_vector &entries, ulint level,
+                      entry_vector &node_ptrs, mem_heap_t *heap);
+
+  /** Write the leaf pages from the merged run, one slice at a time,
+  and collect their node pointers.
+  @param[out]	node_ptrs	node pointers of the pages written
+  @param[in,out]	heap		memory heap for the node pointers
+  @return error code */
+  dberr_t build_leaf_level_from_run(entry_vector &node_ptrs, mem_heap_t *heap);
+
+  /** Write the entries of a slice, sorted on x, into pages.
+  @param[in,out]	first		first entry of the slice
+  @param[in,out]	last		end of the slice
+  @param[in]	per_page	entries per page
+  @param[in]	level		level in the R-tree
+  @param[in,out]	page_bulk	page being filled, or NULL
+  @param[out]	node_ptrs	node pointers of the pages written
+  @param[in,out]	heap		memory heap for the node pointers
+  @return error code */
+  dberr_t build_slice(Entry *first, Entry *last, ulint per_page, ulint level,
+                      PageBulk **page_bulk, entry_vector &node_ptrs,
+                      mem_heap_t *heap);
+
+  /** Commit the last page of a level, or release it after an error.
+  @param[in,out]	page_bulk	page being filled, or NULL
+  @param[in]	err		error code of the level so far
+  @param[out]	node_ptrs	node pointers of the pages written
+  @param[in,out]	heap		memory heap for the node pointers
+  @return error code */
+  dberr_t end_level(PageBulk *page_bulk, dberr_t err, entry_vector &node_ptrs,
+                    mem_heap_t *heap);
+
+  /** Finish a page of a level and add its node pointer.
+  @param[in,out]	page_bulk	page to finish
+  @param[in]	next_page_bulk	next page of the level, or NULL
+  @param[out]	node_ptrs	node pointers of the level
+  @param[in,out]	heap		memory heap for the node pointers */
+  void page_commit(PageBulk *page_bulk, PageBulk *next_page_bulk,
+                   entry_vector &node_ptrs, mem_heap_t *heap);
+
+  /** Write the top level into the root page.
+  @param[in,out]	entries	entries of the top level
+  @param[in]	level	level of the root page
+  @return error code */
+  dberr_t build_root(entry_vector &entries, ulint level);
+
+  /** Memory heap for the leaf entries */
+  mem_heap_t *m_heap;
+
+  /** Spatial index */
+  dict_index_t *m_index;
+
+  /** Transaction id */
+  trx_id_t m_trx_id;
+
+  /** Flush observer */
+  FlushObserver *m_flush_observer;
+
+  /** Maximum size of the entries in memory */
+  const ulint m_max_size;
+
+  /** Size of the entries in memory */
+  ulint m_size;
+
+  /** Leaf entries in memory */
+  entry_vector m_entries;
+
+  /** Location for the merge files */
+  const char *m_path;
+
+  /** Number of leaf entries added */
+  ulint m_n_entries;
+
+  /** Size of the records of the leaf entries added */
+  ulint m_rec_size;
+
+  /** Merge file with the runs, or -1 */
+  int m_fd;
+
+  /** Merge file for merging the runs, or -1 */
+  int m_tmpfd;
+
+  /** Three blocks of srv_sort_buf_size for the merge files, or NULL */
+  byte *m_blocks;
+
+  /** Allocation of m_blocks */
+  ut_new_pfx_t m_blocks_pfx;
+
+  /** End of the runs in m_fd */
+  os_offset_t m_end;
+
+  /** Runs in m_fd */
+  run_vector m_runs;
+};
+
 #endif
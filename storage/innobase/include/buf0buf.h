@@ -1773,6 +1773,10 @@ struct buf_pool_t {
   when there is no flush batch
   of the given type running. Protected by
   flush_state_mutex. */
+  os_event_t LRU_free_event;
+  /*!< set each time an evicted page is put
+  on the free list by an LRU batch or by the
+  completion of its writes */
   ib_rbt_t *flush_rbt;    /*!< a red-black tree is used
                           exclusively during recovery to
                           speed up insertions in the
@@ -1808,6 +1812,30 @@ struct buf_pool_t {
                           buffer pool. Accessed protected by
                           memory barriers. */
 
+  ulint n_free_taken; /*!< number of blocks taken off the
+                      free list by buf_LRU_get_free_only().
+                      Protected by free_list_mutex. A thread
+                      is allowed to read this for heuristic
+                      purposes without holding the mutex */
+
+  ulint n_free_taken_last; /*!< value of n_free_taken when the
+                           page cleaner last flushed the LRU
+                           list of this instance. Only accessed
+                           by the page cleaner */
+
+  ulint LRU_free_demand; /*!< moving average of the number of
+                         blocks taken off the free list
+                         between two LRU flushes of the page
+                         cleaner. Only accessed by the page
+                         cleaner */
+
+  ulint LRU_free_target; /*!< free list length the page cleaner
+                         keeps for this instance: the larger of
+                         srv_LRU_scan_depth and LRU_free_demand.
+                         Written by the page cleaner only, read
+                         by other threads for heuristic purposes
+                         without holding any mutex */
+
   lsn_t track_page_lsn; /* Pagge Tracking start LSN. */
 
   lsn_t max_lsn_io; /* Maximum LSN for which write io
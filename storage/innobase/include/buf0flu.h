@@ -199,6 +199,12 @@ void buf_flush_page_cleaner_init(size_t n_page_cleaners);
 /** Wait for any possible LRU flushes that are in progress to end. */
 void buf_flush_wait_LRU_batch_end();
 
+/** Wait a short while for an LRU batch that is running on a buffer pool
+instance to put blocks on its free list.
+@param[in]	buf_pool	buffer pool instance
+@return true if an LRU batch was running */
+bool buf_flush_wait_LRU_batch_progress(buf_pool_t *buf_pool);
+
 #if defined UNIV_DEBUG || defined UNIV_BUF_DEBUG
 /** Validates the flush list.
  @return true if ok */
@@ -117,7 +117,9 @@ we put it to free list to be used.
     * scan LRU up to srv_LRU_scan_depth to find a clean block
     * the above will put the block on free list
     * success:retry the free list
-  * flush one dirty page from tail of LRU to disk
+  * if the page cleaner is running an LRU batch, wait up to 10ms for it
+    * retry the free list
+  * otherwise flush one dirty page from tail of LRU to disk
     * the above will put the block on free list
     * success: retry the free list
 * iteration 1:
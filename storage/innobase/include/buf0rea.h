@@ -35,6 +35,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 
 #include "buf0buf.h"
 #include "buf0types.h"
+#include "fsp0fsp.h"
 #include "univ.i"
 
 /** High-level function which reads a page asynchronously from a file to the
@@ -57,6 +58,15 @@ released by the i/o-handler thread.
 ibool buf_read_page_background(const page_id_t &page_id,
                                const page_size_t &page_size, bool sync);
 
+/** Issues asynchronous read requests for ranges of pages of a tablespace
+which are about to be scanned, like the linear read-ahead does for an
+area. Pages which are already in the buffer pool are skipped.
+@param[in]	space_id	tablespace id
+@param[in]	ranges		ranges of pages to read
+@return number of page read requests queued */
+ulint buf_read_ahead_ranges(space_id_t space_id,
+                            const fseg_page_ranges_t &ranges);
+
 /** Applies a random read-ahead in buf_pool if there are at least a threshold
 value of accessed pages from the random read-ahead area. Does not read any
 page, not even the one at the position (space, offset), if the read-ahead
@@ -34,6 +34,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 
 #include "db0err.h"
 #include "handler.h"
+#include "sql/clone_handler.h"
 #include "univ.i"
 #include "ut0mutex.h"
 
@@ -392,6 +393,17 @@ class Clone_Handle {
   @return error code */
   dberr_t apply_data(Ha_clone_cbk *callback);
 
+  /** Read and remove the base left in the data directory by the last
+  clone into it. Only the files still as the clone left them are kept
+  in the base.
+  @return true if the data directory has a base */
+  bool read_base();
+
+  /** Write the base for the next clone into the data directory, and
+  remove the files left by the last clone which the donor no longer has.
+  @param[in]	state_desc	state descriptor of DONE state */
+  void write_base(const Clone_Desc_State &state_desc);
+
   /** Receive data from callback and apply
   @param[in]	task		task that is receiving the information
   @param[in]	offset		file offset for applying data
@@ -427,6 +439,16 @@ class Clone_Handle {
   /** Clone data directory */
   const char *m_clone_dir;
 
+  /** Base of the recipient data directory. Received from the apply
+  handle for copy. Read from the data directory for apply. */
+  Clone_Base m_base;
+
+  /** Files left by the last clone into the data directory, apply only */
+  Clone_Base_Files m_base_files;
+
+  /** Locator with the base, serialized before a snapshot is attached */
+  std::vector<byte> m_base_locator;
+
   /** Clone task manager */
   Clone_Task_Manager m_clone_task_manager;
 };
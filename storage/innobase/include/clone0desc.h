@@ -32,15 +32,20 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #ifndef CLONE_DESC_INCLUDE
 #define CLONE_DESC_INCLUDE
 
+#include "log0types.h"
 #include "mem0mem.h"
+#include "sql/sql_const.h"
 #include "univ.i"
 
+#include <string>
+#include <vector>
+
 /** Invalid locator ID. */
 const ib_uint64_t CLONE_LOC_INVALID_ID = 0;
 
 /** Maximum base length for any serialized descriptor. This is only used for
 optimal allocation and has no impact on version compatibility. */
-const ib_uint64_t CLONE_DESC_MAX_BASE_LEN = 64;
+const ib_uint64_t CLONE_DESC_MAX_BASE_LEN = 128;
 
 /** Snapshot state transfer during clone.
 
@@ -163,6 +168,74 @@ struct Clone_Task_Meta {
   uint m_block_num;
 };
 
+/** A data file left in a data directory by a clone */
+struct Clone_Base_File {
+  /** Tablespace ID for the file */
+  ulint m_space_id;
+
+  /** File size in bytes */
+  ib_uint64_t m_file_size;
+
+  /** File name relative to the data directory */
+  std::string m_file_name;
+};
+
+/** Data files left in a data directory by a clone */
+using Clone_Base_Files = std::vector<Clone_Base_File>;
+
+/** The clone a data directory was made from. When the same donor clones
+into the directory again, it copies the files which are still the same
+only partly: it sends the pages modified since the base LSN. */
+struct Clone_Base {
+  /** Constructor: No base */
+  Clone_Base() { clear(); }
+
+  /** LSN from which the donor tracks the modified pages, LSN_MAX if
+  the data directory has no base. */
+  lsn_t m_lsn;
+
+  /** Start LSN of the page tracking group of the donor. A new group
+  does not have the pages modified before it started. */
+  lsn_t m_group_lsn;
+
+  /** server_uuid of the donor */
+  std::string m_donor_uuid;
+
+  /** Data files as the clone left them */
+  Clone_Base_Files m_files;
+
+  /** Check if there is a base
+  @return true if the data directory was made by a clone */
+  bool is_set() const;
+
+  /** Reset to no base */
+  void clear();
+
+  /** Get the length of the serialized base
+  @return length in bytes */
+  size_t serialized_length() const;
+
+  /** Serialize the base. Caller must allocate #serialized_length bytes.
+  @param[out]	buf	serialized base */
+  void serialize(byte *buf) const;
+
+  /** Deserialize the base.
+  @param[in]	buf	serialized base
+  @param[in]	len	length of the serialized base
+  @return true if successful, false if the base is not valid */
+  bool deserialize(const byte *buf, size_t len);
+
+  /** Check if the recipient still has a donor file as it was left by
+  the base clone, so that only the modified pages need to be copied.
+  The file must have the same tablespace ID and name, and must not be
+  larger than the donor file: a file is only ever extended.
+  @param[in]	name		file name relative to the data directory
+  @param[in]	space_id	tablespace ID for the file
+  @param[in]	size		file size in bytes on the donor
+  @return true if the file can be copied incrementally */
+  bool has_file(const char *name, ulint space_id, ib_uint64_t size) const;
+};
+
 /** CLONE_DESC_LOCATOR: Descriptor for a task for clone operation.
 A task is used by exactly one thread */
 struct Clone_Desc_Locator {
@@ -178,12 +251,18 @@ struct Clone_Desc_Locator {
   /** Index in clone array for fast reference. */
   uint m_clone_index;
 
+  /** Base of the recipient data directory, sent by the apply handle
+  from version 101. Not owned, nullptr for no base. */
+  const Clone_Base *m_base;
+
   /** Initialize clone locator.
-  @param[in]	id	Clone identifier
-  @param[in]	snap_id	Snapshot identifier
-  @param[in]	version	Descriptor version
-  @param[in]	index	clone index */
-  void init(ib_uint64_t id, ib_uint64_t snap_id, uint version, uint index);
+  @param[in]	id		Clone identifier
+  @param[in]	snap_id		Snapshot identifier
+  @param[in]	version		Descriptor version
+  @param[in]	index		clone index
+  @param[in]	base		base of recipient data directory or nullptr */
+  void init(ib_uint64_t id, ib_uint64_t snap_id, uint version, uint index,
+            const Clone_Base *base);
 
   /** Check if the passed locator matches the current one.
   @param[in]	other_desc	input locator descriptor
@@ -198,8 +277,10 @@ struct Clone_Desc_Locator {
   void serialize(byte *&desc_loc, uint &len, mem_heap_t *heap);
 
   /** Deserialize the descriptor.
-  @param[in]	desc_loc	serialized locator */
-  void deserialize(byte *desc_loc);
+  @param[in]	desc_loc	serialized locator
+  @param[out]	base		base of recipient data directory, if not
+                                nullptr */
+  void deserialize(byte *desc_loc, Clone_Base *base = nullptr);
 };
 
 /** CLONE_DESC_TASK_METADATA: Descriptor for a task for clone operation.
@@ -244,6 +325,20 @@ struct Clone_Desc_State {
   /** Number of files in current state */
   uint m_num_files;
 
+  /** LSN the clone copies the modified pages from, or LSN_MAX if
+  the data files are copied in full. */
+  lsn_t m_base_lsn;
+
+  /** LSN from which the donor tracks modified pages for the next
+  incremental clone. LSN_MAX if it does not. */
+  lsn_t m_track_lsn;
+
+  /** Start LSN of the page tracking group of the donor */
+  lsn_t m_group_lsn;
+
+  /** server_uuid of the donor */
+  char m_donor_uuid[UUID_LENGTH + 1];
+
   /** Initialize header
   @param[in]	version	descriptor version */
   void init_header(uint version);
@@ -271,6 +366,10 @@ struct Clone_File_Meta {
   /** File index in clone data file vector */
   uint m_file_index;
 
+  /** Only the pages modified since the base LSN are copied. The
+  recipient keeps its file. */
+  bool m_copy_modified;
+
   /** Chunk number for the first chunk in file */
   uint m_begin_chunk;
 
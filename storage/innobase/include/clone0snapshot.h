@@ -157,6 +157,19 @@ class Clone_Snapshot {
   @return number of data chunks */
   uint get_num_chunks() { return (m_num_current_chunks); }
 
+  /** Set the base of the recipient data directory. The files the
+  recipient still has are then copied incrementally, sending only the
+  pages modified since the base LSN.
+  @param[in]	base	base of recipient data directory, not owned */
+  void set_base(const Clone_Base *base) {
+    m_base = base;
+    m_base_lsn = base->is_set() ? base->m_lsn : LSN_MAX;
+  }
+
+  /** Check if only pages modified since the base LSN are copied
+  @return true for incremental clone */
+  bool is_incremental() const { return (m_base_lsn != LSN_MAX); }
+
   /** Get maximum file length seen till now
   @return file name length */
   size_t get_max_file_name_length() { return (m_max_file_name_len); }
@@ -220,6 +233,11 @@ class Clone_Snapshot {
   @return error code */
   dberr_t add_file_from_desc(Clone_File_Meta *&file_desc, const char *data_dir);
 
+  /** Get the data files as the clone left them at destination
+  @param[in]	data_dir	destination data directory
+  @param[out]	files		data files, named relative to data_dir */
+  void get_base_files(const char *data_dir, Clone_Base_Files &files);
+
   /** Extract file information from node and add to snapshot
   @param[in]	node	file node
   @return error code */
@@ -457,6 +475,12 @@ class Clone_Snapshot {
   /** Page archiver client */
   Page_Arch_Client_Ctx m_page_ctx;
 
+  /** Base of the recipient data directory, set for copy only */
+  const Clone_Base *m_base;
+
+  /** LSN to copy the modified pages from, LSN_MAX for full copy */
+  lsn_t m_base_lsn;
+
   /** Set of unique page IDs */
   Clone_Page_Set m_page_set;
 
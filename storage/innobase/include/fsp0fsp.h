@@ -44,6 +44,9 @@ this program; if not, write to the Free Software Foundation, Inc.,
 
 #include "fsp0types.h"
 
+#include <utility>
+#include <vector>
+
 #ifdef UNIV_HOTBACKUP
 #include "buf0buf.h"
 #endif /* UNIV_HOTBACKUP */
@@ -492,6 +495,21 @@ ulint fseg_n_reserved_pages(
     fseg_header_t *header, /*!< in: segment header */
     ulint *used,           /*!< out: number of pages used (<= reserved) */
     mtr_t *mtr);           /*!< in/out: mini-transaction */
+
+/** Ranges of pages, each given by its first page and number of pages. */
+typedef std::vector<std::pair<page_no_t, page_no_t>> fseg_page_ranges_t;
+
+/** Collects the pages used by a segment as ranges of consecutive pages,
+for reading them ahead. The fragment pages come first, then the used pages
+of each extent of the segment.
+@param[in]	header		segment header
+@param[in]	max_pages	stop once this many pages have been collected
+@param[out]	ranges		ranges of used pages
+@param[in,out]	mtr		mini-transaction
+@return number of pages in ranges */
+page_no_t fseg_get_used_page_ranges(fseg_header_t *header, page_no_t max_pages,
+                                    fseg_page_ranges_t *ranges, mtr_t *mtr);
+
 /** Allocates a single free page from a segment. This function implements
  the intelligent allocation strategy which tries to minimize
  file space fragmentation.
@@ -608,10 +608,19 @@ float fts_retrieve_ranking(
     doc_id_t doc_id);     /*!< in: the interested document
                           doc_id */
 
-/** FTS Query sort result, returned by fts_query() on fts_ranking_t::rank. */
-void fts_query_sort_result_on_rank(
-    fts_result_t *result); /*!< out: result instance
-                           to sort.*/
+/** FTS Query sort result, returned by fts_query() on fts_ranking_t::rank.
+With a limit, only the best ranked documents are sorted, which is all
+that a query ordered on the relevance with a LIMIT usually reads.
+@param[in,out]	result	result instance to sort
+@param[in]	limit	number of best ranked documents to sort, or
+                        ULONG_UNDEFINED to sort all of them */
+void fts_query_sort_result_on_rank(fts_result_t *result, ulonglong limit);
+
+/** Get the next document of a result sorted on rank. If more documents
+are read than were sorted, the rest of the result is sorted on demand.
+@param[in,out]	result	result sorted by fts_query_sort_result_on_rank()
+@return the next ranking node, or NULL if the result is exhausted */
+ib_rbt_node_t *fts_query_next_on_rank(fts_result_t *result);
 
 /** FTS Query free result, returned by fts_query(). */
 void fts_query_free_result(fts_result_t *result); /*!< in: result instance
@@ -772,6 +772,10 @@ struct row_prebuilt_t {
   /** limit value to avoid fts result overflow */
   ulonglong m_fts_limit;
 
+  /** limit value of a fts query ordered on the relevance ranking,
+  only the best ranked documents up to it are sorted up front */
+  ulonglong m_fts_sort_limit;
+
   /** True if exceeded the end_range while filling the prefetch cache. */
   bool m_end_range;
 
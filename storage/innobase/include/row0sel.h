@@ -35,6 +35,8 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #ifndef row0sel_h
 #define row0sel_h
 
+#include <functional>
+
 #include "btr0pcur.h"
 #include "data0data.h"
 #include "dict0stats.h"
@@ -457,6 +459,18 @@ db_name, table_name and fill it in table stats structure.
 bool row_search_table_stats(const char *db_name, const char *tbl_name,
                             TableStatsRecord &table_stats);
 
+/** Callback for the records of innodb_table_stats of a database. The
+index page is latched during the call, so it must not access pages or
+acquire latches. */
+using Table_stats_callback = std::function<void(const TableStatsRecord &)>;
+
+/** Scan the records present in innodb_table_stats table for all tables
+of a database, in table name order.
+@param[in]	db_name		database name
+@param[in]	callback	called with the stats of each table */
+void row_search_schema_table_stats(const char *db_name,
+                                   const Table_stats_callback &callback);
+
 /** Search the record present in innodb_index_stats using
 db_name, table name and index_name and fill the
 cardinality for the each column.
@@ -463,6 +463,7 @@ extern ulint srv_lock_table_size;
 extern ulint srv_n_file_io_threads;
 extern bool srv_random_read_ahead;
 extern ulong srv_read_ahead_threshold;
+extern ulong srv_partition_read_ahead;
 extern ulong srv_n_read_io_threads;
 extern ulong srv_n_write_io_threads;
 
@@ -593,6 +594,9 @@ extern bool srv_print_ddl_logs;
 
 extern bool srv_cmp_per_index_enabled;
 
+/** Track modified pages durably for incremental clone */
+extern bool srv_page_tracking;
+
 /** Status variables to be passed to MySQL */
 extern struct export_var_t export_vars;
 
@@ -62,6 +62,8 @@ const char *Compression::to_string(Type type) {
       return ("Zlib");
     case LZ4:
       return ("LZ4");
+    case LZ4HC:
+      return ("LZ4HC");
   }
 
   ut_ad(0);
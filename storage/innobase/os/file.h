@@ -63,7 +63,12 @@ struct Compression {
     ZLIB = 1,
 
     /** Use LZ4 faster variant, usually lower compression. */
-    LZ4 = 2
+    LZ4 = 2,
+
+    /** Use the LZ4 high compression variant. It is slower to compress
+    than LZ4 but the pages are written in the LZ4 format, so reading
+    them is as fast as with LZ4. */
+    LZ4HC = 3
   };
 
   /** Compressed page meta-data */
@@ -95,6 +100,7 @@ struct Compression {
       case NONE:
       case ZLIB:
       case LZ4:
+      case LZ4HC:
 
       default:
         ut_error;
@@ -81,6 +81,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
 
 #include <errno.h>
 #include <lz4.h>
+#include <lz4hc.h>
 #include "my_aes.h"
 #include "my_rnd.h"
 #include "mysql/service_mysql_keyring.h"
@@ -90,6 +91,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
 #include <zlib.h>
 #include <ctime>
 #include <functional>
+#include <memory>
 #include <new>
 #include <vector>
 
@@ -1322,6 +1324,10 @@ ulint AIO::pending_io_count() const {
   return (reserved);
 }
 
+/** State of the LZ4 high compression variant. It is too large for the
+stack, so every thread that compresses pages allocates one on first use. */
+static thread_local std::unique_ptr<char[]> os_lz4hc_state;
+
 /** Compress a data page
 @param[in]	compression	Compression algorithm
 @param[in]	block_size	File system block size
@@ -1408,6 +1414,40 @@ static byte *os_file_compress_page(Compression compression, ulint block_size,
 
       break;
 
+    case Compression::LZ4HC:
+
+      if (os_lz4hc_state == nullptr) {
+        os_lz4hc_state.reset(new (std::nothrow) char[LZ4_sizeofStateHC()]);
+
+        if (os_lz4hc_state == nullptr) {
+          *dst_len = src_len;
+
+          return (src);
+        }
+      }
+
+      /* innodb_compression_level maps directly to the LZ4HC level,
+      0 selects the library default. */
+      len = LZ4_compress_HC_extStateHC(
+          os_lz4hc_state.get(), reinterpret_cast<char *>(src) + FIL_PAGE_DATA,
+          reinterpret_cast<char *>(dst) + FIL_PAGE_DATA,
+          static_cast<int>(content_len), static_cast<int>(out_len),
+          static_cast<int>(compression_level));
+
+      ut_a(len <= src_len - FIL_PAGE_DATA);
+
+      if (len == 0 || len >= out_len) {
+        *dst_len = src_len;
+
+        return (src);
+      }
+
+      /* The output is in the LZ4 format, record it as such so that it
+      can be read by any server that supports LZ4 compressed pages. */
+      compression.m_type = Compression::LZ4;
+
+      break;
+
     default:
       *dst_len = src_len;
       return (src);
@@ -1904,7 +1944,8 @@ static Block *os_file_compress_page(IORequest &type, void *&buf, ulint *n) {
   ulint n_alloc = *n * 2;
 
   ut_a(n_alloc <= UNIV_PAGE_SIZE_MAX * 2);
-  ut_a(type.compression_algorithm().m_type != Compression::LZ4 ||
+  ut_a((type.compression_algorithm().m_type != Compression::LZ4 &&
+        type.compression_algorithm().m_type != Compression::LZ4HC) ||
        static_cast<ulint>(LZ4_COMPRESSBOUND(*n)) < n_alloc);
 
   Block *block = os_alloc_block();
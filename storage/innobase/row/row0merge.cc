@@ -73,15 +73,22 @@ class index_tuple_info_t {
  public:
   /** constructor
   @param[in]	heap	memory heap
-  @param[in]	index	index to be created */
-  index_tuple_info_t(mem_heap_t *heap, dict_index_t *index) UNIV_NOTHROW {
+  @param[in]	index	index to be created
+  @param[in]	rtr_bulk	bulk loader for the index, or NULL to
+  insert the rows one by one */
+  index_tuple_info_t(mem_heap_t *heap, dict_index_t *index,
+                     RtreeBulk *rtr_bulk) UNIV_NOTHROW {
     m_heap = heap;
     m_index = index;
+    m_rtr_bulk = rtr_bulk;
     m_dtuple_vec = UT_NEW_NOKEY(idx_tuple_vec());
   }
 
   /** destructor */
-  ~index_tuple_info_t() { UT_DELETE(m_dtuple_vec); }
+  ~index_tuple_info_t() {
+    UT_DELETE(m_dtuple_vec);
+    UT_DELETE(m_rtr_bulk);
+  }
 
   /** Get the index object
   @return the index object */
@@ -110,49 +117,36 @@ class index_tuple_info_t {
   @return DB_SUCCESS if successful, else error number */
   dberr_t insert(trx_id_t trx_id, mem_heap_t *row_heap, btr_pcur_t *pcur,
                  mtr_t *scan_mtr, bool *mtr_committed) {
-    big_rec_t *big_rec;
-    rec_t *rec;
-    btr_cur_t ins_cur;
-    mtr_t mtr;
-    rtr_info_t rtr_info;
     ulint *ins_offsets = NULL;
     dberr_t error = DB_SUCCESS;
     dtuple_t *dtuple;
-    ulint count = 0;
     bool force_log_free_check = false;
 
-    const ulint flag = BTR_NO_UNDO_LOG_FLAG | BTR_NO_LOCKING_FLAG |
-                       BTR_KEEP_SYS_FLAG | BTR_CREATE_FLAG;
-
     ut_ad(dict_index_is_spatial(m_index));
 
     DBUG_EXECUTE_IF("row_merge_instrument_log_check_flush",
                     force_log_free_check = true;);
 
-    for (idx_tuple_vec::iterator it = m_dtuple_vec->begin();
-         it != m_dtuple_vec->end(); ++it) {
+    idx_tuple_vec::iterator it = m_dtuple_vec->begin();
+
+    if (m_rtr_bulk != NULL) {
+      /* Collect the rows for the bulk load. The bulk loader
+      spills them to a temporary file past its memory limit. */
+      for (; error == DB_SUCCESS && it != m_dtuple_vec->end(); ++it) {
+        error = m_rtr_bulk->add(*it);
+      }
+
+      m_dtuple_vec->clear();
+      return (error);
+    }
+
+    for (; error == DB_SUCCESS && it != m_dtuple_vec->end(); ++it) {
       dtuple = *it;
       ut_ad(dtuple);
 
       if (log_needs_free_check() || force_log_free_check) {
         if (!(*mtr_committed)) {
-          /* Since the data of the tuple pk fields
-          are pointers of cluster rows. After mtr
-          committed, these pointer could be point
-          to invalid data. Then, we need to copy
-          all these data from cluster rows. */
-          idx_tuple_vec::iterator cp_it;
-          dtuple_t *cp_tuple;
-          for (cp_it = it; cp_it != m_dtuple_vec->end(); ++cp_it) {
-            cp_tuple = *cp_it;
-
-            for (ulint i = 1; i < dtuple_get_n_fields(cp_tuple); i++) {
-              dfield_dup(&cp_tuple->fields[i], m_heap);
-            }
-          }
-          btr_pcur_move_to_prev_on_page(pcur);
-          btr_pcur_store_position(pcur, scan_mtr);
-          mtr_commit(scan_mtr);
+          commit_scan_mtr(it, pcur, scan_mtr);
           *mtr_committed = true;
         }
 
@@ -161,84 +155,142 @@ class index_tuple_info_t {
         force_log_free_check = false;
       }
 
-      mtr.start();
+      error = insert_tuple(trx_id, row_heap, dtuple, &ins_offsets);
+    }
 
-      ins_cur.index = m_index;
-      rtr_init_rtr_info(&rtr_info, false, &ins_cur, m_index, false);
-      rtr_info_update_btr(&ins_cur, &rtr_info);
+    m_dtuple_vec->clear();
 
-      btr_cur_search_to_nth_level(m_index, 0, dtuple, PAGE_CUR_RTREE_INSERT,
-                                  BTR_MODIFY_LEAF, &ins_cur, 0, __FILE__,
-                                  __LINE__, &mtr);
+    return (error);
+  }
 
-      /* It need to update MBR in parent entry,
-      so change search mode to BTR_MODIFY_TREE */
-      if (rtr_info.mbr_adj) {
-        mtr_commit(&mtr);
-        rtr_clean_rtr_info(&rtr_info, true);
-        rtr_init_rtr_info(&rtr_info, false, &ins_cur, m_index, false);
-        rtr_info_update_btr(&ins_cur, &rtr_info);
+  /** Build the index from the rows collected for the bulk load.
+  @return DB_SUCCESS if successful, else error number */
+  dberr_t finish() {
+    if (m_rtr_bulk == NULL) {
+      return (DB_SUCCESS);
+    }
 
-        mtr_start(&mtr);
+    ut_ad(m_dtuple_vec->empty());
+
+    return (m_rtr_bulk->finish());
+  }
+
+ private:
+  /** Cache index rows made from a cluster index scan. Usually
+  for rows on single cluster index page */
+  typedef std::vector<dtuple_t *, ut_allocator<dtuple_t *>> idx_tuple_vec;
 
-        btr_cur_search_to_nth_level(m_index, 0, dtuple, PAGE_CUR_RTREE_INSERT,
-                                    BTR_MODIFY_TREE, &ins_cur, 0, __FILE__,
-                                    __LINE__, &mtr);
+  /** Commit the mini-transaction of the cluster index scan.
+  @param[in]	it		first cached row not inserted yet
+  @param[in]	pcur		cluster index scanning cursor
+  @param[in,out]	scan_mtr	mini-transaction for pcur */
+  void commit_scan_mtr(idx_tuple_vec::iterator it, btr_pcur_t *pcur,
+                       mtr_t *scan_mtr) {
+    /* Since the data of the tuple pk fields
+    are pointers of cluster rows. After mtr
+    committed, these pointer could be point
+    to invalid data. Then, we need to copy
+    all these data from cluster rows. */
+    idx_tuple_vec::iterator cp_it;
+    dtuple_t *cp_tuple;
+    for (cp_it = it; cp_it != m_dtuple_vec->end(); ++cp_it) {
+      cp_tuple = *cp_it;
+
+      for (ulint i = 1; i < dtuple_get_n_fields(cp_tuple); i++) {
+        dfield_dup(&cp_tuple->fields[i], m_heap);
       }
+    }
+    btr_pcur_move_to_prev_on_page(pcur);
+    btr_pcur_store_position(pcur, scan_mtr);
+    mtr_commit(scan_mtr);
+  }
 
-      error = btr_cur_optimistic_insert(flag, &ins_cur, &ins_offsets, &row_heap,
-                                        dtuple, &rec, &big_rec, 0, NULL, &mtr);
+  /** Insert a row into the spatial index.
+  @param[in]	trx_id		transaction id
+  @param[in,out]	row_heap	memory heap
+  @param[in]	dtuple		row to insert
+  @param[in,out]	ins_offsets	record offsets
+  @return DB_SUCCESS if successful, else error number */
+  dberr_t insert_tuple(trx_id_t trx_id, mem_heap_t *row_heap, dtuple_t *dtuple,
+                       ulint **ins_offsets) {
+    big_rec_t *big_rec;
+    rec_t *rec;
+    btr_cur_t ins_cur;
+    mtr_t mtr;
+    rtr_info_t rtr_info;
+    dberr_t error;
 
-      if (error == DB_FAIL) {
-        ut_ad(!big_rec);
+    const ulint flag = BTR_NO_UNDO_LOG_FLAG | BTR_NO_LOCKING_FLAG |
+                       BTR_KEEP_SYS_FLAG | BTR_CREATE_FLAG;
 
-        mtr.commit();
+    mtr.start();
 
-        mtr.start();
+    ins_cur.index = m_index;
+    rtr_init_rtr_info(&rtr_info, false, &ins_cur, m_index, false);
+    rtr_info_update_btr(&ins_cur, &rtr_info);
 
-        rtr_clean_rtr_info(&rtr_info, true);
+    btr_cur_search_to_nth_level(m_index, 0, dtuple, PAGE_CUR_RTREE_INSERT,
+                                BTR_MODIFY_LEAF, &ins_cur, 0, __FILE__,
+                                __LINE__, &mtr);
 
-        rtr_init_rtr_info(&rtr_info, false, &ins_cur, m_index, false);
+    /* It need to update MBR in parent entry,
+    so change search mode to BTR_MODIFY_TREE */
+    if (rtr_info.mbr_adj) {
+      mtr_commit(&mtr);
+      rtr_clean_rtr_info(&rtr_info, true);
+      rtr_init_rtr_info(&rtr_info, false, &ins_cur, m_index, false);
+      rtr_info_update_btr(&ins_cur, &rtr_info);
 
-        rtr_info_update_btr(&ins_cur, &rtr_info);
-        btr_cur_search_to_nth_level(m_index, 0, dtuple, PAGE_CUR_RTREE_INSERT,
-                                    BTR_MODIFY_TREE, &ins_cur, 0, __FILE__,
-                                    __LINE__, &mtr);
+      mtr_start(&mtr);
 
-        error =
-            btr_cur_pessimistic_insert(flag, &ins_cur, &ins_offsets, &row_heap,
-                                       dtuple, &rec, &big_rec, 0, NULL, &mtr);
-      }
+      btr_cur_search_to_nth_level(m_index, 0, dtuple, PAGE_CUR_RTREE_INSERT,
+                                  BTR_MODIFY_TREE, &ins_cur, 0, __FILE__,
+                                  __LINE__, &mtr);
+    }
 
-      DBUG_EXECUTE_IF("row_merge_ins_spatial_fail", error = DB_FAIL;);
+    error = btr_cur_optimistic_insert(flag, &ins_cur, ins_offsets, &row_heap,
+                                      dtuple, &rec, &big_rec, 0, NULL, &mtr);
 
-      if (error == DB_SUCCESS) {
-        if (rtr_info.mbr_adj) {
-          error = rtr_ins_enlarge_mbr(&ins_cur, NULL, &mtr);
-        }
+    if (error == DB_FAIL) {
+      ut_ad(!big_rec);
 
-        if (error == DB_SUCCESS) {
-          page_update_max_trx_id(btr_cur_get_block(&ins_cur),
-                                 btr_cur_get_page_zip(&ins_cur), trx_id, &mtr);
-        }
-      }
+      mtr.commit();
 
-      mtr_commit(&mtr);
+      mtr.start();
 
       rtr_clean_rtr_info(&rtr_info, true);
-      count++;
+
+      rtr_init_rtr_info(&rtr_info, false, &ins_cur, m_index, false);
+
+      rtr_info_update_btr(&ins_cur, &rtr_info);
+      btr_cur_search_to_nth_level(m_index, 0, dtuple, PAGE_CUR_RTREE_INSERT,
+                                  BTR_MODIFY_TREE, &ins_cur, 0, __FILE__,
+                                  __LINE__, &mtr);
+
+      error = btr_cur_pessimistic_insert(flag, &ins_cur, ins_offsets, &row_heap,
+                                         dtuple, &rec, &big_rec, 0, NULL, &mtr);
     }
 
-    m_dtuple_vec->clear();
+    DBUG_EXECUTE_IF("row_merge_ins_spatial_fail", error = DB_FAIL;);
+
+    if (error == DB_SUCCESS) {
+      if (rtr_info.mbr_adj) {
+        error = rtr_ins_enlarge_mbr(&ins_cur, NULL, &mtr);
+      }
+
+      if (error == DB_SUCCESS) {
+        page_update_max_trx_id(btr_cur_get_block(&ins_cur),
+                               btr_cur_get_page_zip(&ins_cur), trx_id, &mtr);
+      }
+    }
+
+    mtr_commit(&mtr);
+
+    rtr_clean_rtr_info(&rtr_info, true);
 
     return (error);
   }
 
- private:
-  /** Cache index rows made from a cluster index scan. Usually
-  for rows on single cluster index page */
-  typedef std::vector<dtuple_t *, ut_allocator<dtuple_t *>> idx_tuple_vec;
-
   /** vector used to cache index rows made from cluster index scan */
   idx_tuple_vec *m_dtuple_vec;
 
@@ -247,11 +299,20 @@ class index_tuple_info_t {
 
   /** memory heap for creating index tuples */
   mem_heap_t *m_heap;
+
+  /** bulk loader collecting all the rows, or NULL if the rows
+  are inserted one by one */
+  RtreeBulk *m_rtr_bulk;
 };
 
 /* Maximum pending doc memory limit in bytes for a fts tokenization thread */
 #define FTS_PENDING_DOC_MEMORY_LIMIT 1000000
 
+/* Maximum size in bytes of the rows kept in memory for the bulk load of
+a spatial index, the bulk loader writes sorted runs of them to temporary
+files past it */
+#define ROW_MERGE_SPATIAL_BULK_MAX_SIZE (16 * 1024 * 1024)
+
 /** Insert sorted data tuples to the index.
 @param[in]	trx		current transaction
 @param[in]	index		index to be inserted
@@ -1445,6 +1506,40 @@ static bool row_geo_field_is_valid(const dtuple_t *row, dict_index_t *index) {
   return (true);
 }
 
+/** Check whether a spatial index can be built by RtreeBulk, rather than
+by inserting the rows one by one.
+@param[in]	index	spatial index
+@return true if the index can be bulk loaded */
+static bool row_merge_spatial_bulk_load(const dict_index_t *index) {
+  ut_ad(dict_index_is_spatial(index));
+
+  /* RtreeBulk does not split pages which fail to compress. */
+  return (!index->table->is_temporary() &&
+          !dict_table_page_size(index->table).is_compressed());
+}
+
+/** Create the bulk loader of a spatial index being built.
+@param[in]	trx	transaction
+@param[in]	index	spatial index
+@return the bulk loader, or NULL if the rows are to be inserted one
+by one */
+static RtreeBulk *row_merge_spatial_bulk_create(const trx_t *trx,
+                                                dict_index_t *index) {
+  if (trx->flush_observer == NULL || !row_merge_spatial_bulk_load(index)) {
+    return (NULL);
+  }
+
+  /* The rows are kept in memory until their size reaches max_size,
+  then written as a sorted run to a temporary file in innodb_tmpdir. */
+  ulint max_size = ROW_MERGE_SPATIAL_BULK_MAX_SIZE;
+
+  DBUG_EXECUTE_IF("row_merge_spatial_bulk_small", max_size = 4096;);
+
+  return (UT_NEW_NOKEY(
+      RtreeBulk(index, trx->id, trx->flush_observer, max_size,
+                thd_innodb_tmpdir(trx->mysql_thd))));
+}
+
 /** Reads clustered index of the table and create temporary files
 containing the index entries for the indexes to be built.
 @param[in]	trx		transaction
@@ -1586,7 +1681,8 @@ static MY_ATTRIBUTE((warn_unused_result)) dberr_t
 
     for (ulint i = 0; i < n_index; i++) {
       if (dict_index_is_spatial(index[i])) {
-        sp_tuples[count] = UT_NEW_NOKEY(index_tuple_info_t(sp_heap, index[i]));
+        sp_tuples[count] = UT_NEW_NOKEY(index_tuple_info_t(
+            sp_heap, index[i], row_merge_spatial_bulk_create(trx, index[i])));
         count++;
       }
     }
@@ -2269,6 +2365,11 @@ all_done:
     UT_DELETE(clust_btr_bulk);
   }
 
+  /* Build the spatial indexes whose rows were collected. */
+  for (ulint i = 0; err == DB_SUCCESS && i < num_spatial; i++) {
+    err = sp_tuples[i]->finish();
+  }
+
   if (prev_fields != NULL) {
     ut_free(prev_fields);
     mem_heap_free(mtuple_heap);
@@ -3523,13 +3624,14 @@ dberr_t row_merge_build_indexes(
   1. online add index: flush dirty pages right before row_log_apply().
   2. table rebuild: flush dirty pages before row_log_table_apply().
 
-  we use bulk load to create all types of indexes except spatial index,
-  for which redo logging is enabled. If we create only spatial indexes,
-  we don't need to flush dirty pages at all. */
+  we use bulk load to create all types of indexes except spatial indexes
+  of compressed tables, for which redo logging is enabled. If we create
+  only such indexes, we don't need to flush dirty pages at all. */
   bool need_flush_observer = (old_table != new_table);
 
   for (i = 0; i < n_indexes; i++) {
-    if (!dict_index_is_spatial(indexes[i])) {
+    if (!dict_index_is_spatial(indexes[i]) ||
+        row_merge_spatial_bulk_load(indexes[i])) {
       need_flush_observer = true;
     }
   }
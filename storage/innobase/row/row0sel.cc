@@ -6106,6 +6106,60 @@ bool row_search_table_stats(const char *db_name, const char *tbl_name,
   return (found_rec);
 }
 
+/** Scan the records present in innodb_table_stats table for all tables
+of a database, in table name order.
+@param[in]	db_name		database name
+@param[in]	callback	called with the stats of each table */
+void row_search_schema_table_stats(const char *db_name,
+                                   const Table_stats_callback &callback) {
+  mtr_t mtr;
+  btr_pcur_t pcur;
+  rec_t *rec;
+  bool move = true;
+  ulint *offsets;
+  dict_table_t *table = dict_sys->table_stats;
+  dict_index_t *clust_index = table->first_index();
+  dtuple_t *dtuple;
+  dfield_t *dfield;
+  mem_heap_t *heap = mem_heap_create(1000);
+
+  /** Search the innodb_table_stats table using (database_name). */
+  dtuple = dtuple_create(heap, 1);
+  dict_index_copy_types(dtuple, clust_index, 1);
+
+  dfield = dtuple_get_nth_field(dtuple, TableStatsRecord::DB_NAME_COL_NO);
+  dfield_set_data(dfield, db_name, strlen(db_name));
+
+  mtr_start(&mtr);
+  btr_pcur_open_with_no_init(clust_index, dtuple, PAGE_CUR_GE, BTR_SEARCH_LEAF,
+                             &pcur, 0, &mtr);
+
+  for (; move == true; move = btr_pcur_move_to_next(&pcur, &mtr)) {
+    rec = btr_pcur_get_rec(&pcur);
+
+    if (page_rec_is_infimum(rec) || page_rec_is_supremum(rec)) {
+      continue;
+    }
+
+    offsets = rec_get_offsets(rec, clust_index, NULL, ULINT_UNDEFINED, &heap);
+
+    if (0 != cmp_dtuple_rec(dtuple, rec, clust_index, offsets)) {
+      break;
+    }
+
+    if (rec_get_deleted_flag(rec, dict_table_is_comp(table))) {
+      continue;
+    }
+
+    TableStatsRecord table_stats;
+    convert_to_table_stats_record(rec, clust_index, offsets, table_stats);
+    callback(table_stats);
+  }
+
+  mtr_commit(&mtr);
+  mem_heap_free(heap);
+}
+
 /** Search the record present in innodb_index_stats using
 db_name, table name and index_name and fill the
 cardinality for the each column.
@@ -395,6 +395,9 @@ bool srv_random_read_ahead = FALSE;
 in the buffer cache and accessed sequentially for InnoDB to trigger a
 readahead request. */
 ulong srv_read_ahead_threshold = 56;
+/* Number of upcoming partitions which a full scan of a partitioned table
+reads ahead, 0 disables the partition read ahead. */
+ulong srv_partition_read_ahead = 4;
 
 /** Maximum on-disk size of change buffer in terms of percentage
 of the buffer pool. */
@@ -468,6 +471,9 @@ bool srv_print_ddl_logs = false;
 /** Enable INFORMATION_SCHEMA.innodb_cmp_per_index */
 bool srv_cmp_per_index_enabled = FALSE;
 
+/** Track modified pages durably for incremental clone */
+bool srv_page_tracking = false;
+
 /** The value of the configuration parameter innodb_fast_shutdown,
 controlling the InnoDB shutdown.
 
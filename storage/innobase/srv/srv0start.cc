@@ -2656,6 +2656,14 @@ void srv_start_threads(bool bootstrap) {
   fts_optimize_init();
 
   srv_start_state_set(SRV_START_STATE_STAT);
+
+  /* Archived page IDs are removed at startup, so tracking starts anew
+  and the next clone of this server is a full one. The group and its
+  reset points are not recovered: pages flushed while the archiver was
+  stopped, at shutdown or during recovery, would be missing from it. */
+  if (srv_page_tracking && arch_page_sys->set_durable(true) != DB_SUCCESS) {
+    srv_page_tracking = false;
+  }
 }
 
 #if 0
@@ -3025,6 +3033,11 @@ void srv_shutdown() {
 
   lsn_t shutdown_lsn;
 
+  /* Let the page archiver go idle before it is aborted. */
+  if (arch_page_sys != nullptr) {
+    arch_page_sys->set_durable(false);
+  }
+
   /* 1. Flush the buffer pool to disk, write the current lsn to
   the tablespace header(s), and copy all log data to archive.
   The step 1 is the real InnoDB shutdown. The remaining steps 2 - ...
@@ -3391,7 +3391,7 @@ PSI_mutex_locker *pfs_start_mutex_wait_v1(PSI_mutex_locker_state *state,
     if (unlikely(pfs_thread == NULL)) {
       return NULL;
     }
-    if (!pfs_thread->m_enabled) {
+    if (!pfs_thread->m_enabled || !pfs_thread->m_sampled) {
       return NULL;
     }
     state->m_thread = reinterpret_cast<PSI_thread *>(pfs_thread);
@@ -3496,7 +3496,7 @@ static PSI_rwlock_locker *pfs_start_rwlock_wait_v1(
     if (unlikely(pfs_thread == NULL)) {
       return NULL;
     }
-    if (!pfs_thread->m_enabled) {
+    if (!pfs_thread->m_enabled || !pfs_thread->m_sampled) {
       return NULL;
     }
     state->m_thread = reinterpret_cast<PSI_thread *>(pfs_thread);
@@ -3623,7 +3623,7 @@ PSI_cond_locker *pfs_start_cond_wait_v1(PSI_cond_locker_state *state,
     if (unlikely(pfs_thread == NULL)) {
       return NULL;
     }
-    if (!pfs_thread->m_enabled) {
+    if (!pfs_thread->m_enabled || !pfs_thread->m_sampled) {
       return NULL;
     }
     state->m_thread = reinterpret_cast<PSI_thread *>(pfs_thread);
@@ -3754,7 +3754,7 @@ PSI_table_locker *pfs_start_table_io_wait_v1(PSI_table_locker_state *state,
     if (pfs_thread == NULL) {
       return NULL;
     }
-    if (!pfs_thread->m_enabled) {
+    if (!pfs_thread->m_enabled || !pfs_thread->m_sampled) {
       return NULL;
     }
     state->m_thread = reinterpret_cast<PSI_thread *>(pfs_thread);
@@ -3876,7 +3876,7 @@ PSI_table_locker *pfs_start_table_lock_wait_v1(PSI_table_locker_state *state,
     if (pfs_thread == NULL) {
       return NULL;
     }
-    if (!pfs_thread->m_enabled) {
+    if (!pfs_thread->m_enabled || !pfs_thread->m_sampled) {
       return NULL;
     }
     state->m_thread = reinterpret_cast<PSI_thread *>(pfs_thread);
@@ -4606,6 +4606,19 @@ void pfs_end_idle_wait_v1(PSI_idle_locker *locker) {
   }
 }
 
+/**
+  Number of waits a measured wait stands for.
+  Waits of an instrumented thread are only collected during sampled
+  statements, each standing for the statements that were skipped.
+  @sa PFS_global_param::m_statement_sample_rate
+*/
+static inline ulonglong sample_weight(uint flags, PSI_thread *thread) {
+  if (flags & STATE_FLAG_THREAD) {
+    return reinterpret_cast<PFS_thread *>(thread)->m_sample_weight;
+  }
+  return 1;
+}
+
 /**
   Implementation of the mutex instrumentation interface.
   @sa PSI_v1::end_mutex_wait.
@@ -4617,6 +4630,7 @@ void pfs_end_mutex_wait_v1(PSI_mutex_locker *locker, int rc) {
 
   ulonglong timer_end = 0;
   ulonglong wait_time = 0;
+  const ulonglong weight = sample_weight(state->m_flags, state->m_thread);
 
   PFS_mutex *mutex = reinterpret_cast<PFS_mutex *>(state->m_mutex);
   DBUG_ASSERT(mutex != NULL);
@@ -4628,10 +4642,10 @@ void pfs_end_mutex_wait_v1(PSI_mutex_locker *locker, int rc) {
     timer_end = get_wait_timer();
     wait_time = timer_end - state->m_timer_start;
     /* Aggregate to EVENTS_WAITS_SUMMARY_BY_INSTANCE (timed) */
-    mutex->m_mutex_stat.m_wait_stat.aggregate_value(wait_time);
+    mutex->m_mutex_stat.m_wait_stat.aggregate_sampled_value(wait_time, weight);
   } else {
     /* Aggregate to EVENTS_WAITS_SUMMARY_BY_INSTANCE (counted) */
-    mutex->m_mutex_stat.m_wait_stat.aggregate_counted();
+    mutex->m_mutex_stat.m_wait_stat.aggregate_counted(weight);
   }
 
   if (likely(rc == 0)) {
@@ -4649,10 +4663,10 @@ void pfs_end_mutex_wait_v1(PSI_mutex_locker *locker, int rc) {
 
     if (flags & STATE_FLAG_TIMED) {
       /* Aggregate to EVENTS_WAITS_SUMMARY_BY_THREAD_BY_EVENT_NAME (timed) */
-      event_name_array[index].aggregate_value(wait_time);
+      event_name_array[index].aggregate_sampled_value(wait_time, weight);
     } else {
       /* Aggregate to EVENTS_WAITS_SUMMARY_BY_THREAD_BY_EVENT_NAME (counted) */
-      event_name_array[index].aggregate_counted();
+      event_name_array[index].aggregate_counted(weight);
     }
 
     if (flags & STATE_FLAG_EVENT) {
@@ -4686,6 +4700,7 @@ void pfs_end_rwlock_rdwait_v1(PSI_rwlock_locker *locker, int rc) {
 
   ulonglong timer_end = 0;
   ulonglong wait_time = 0;
+  const ulonglong weight = sample_weight(state->m_flags, state->m_thread);
 
   PFS_rwlock *rwlock = reinterpret_cast<PFS_rwlock *>(state->m_rwlock);
   DBUG_ASSERT(rwlock != NULL);
@@ -4694,10 +4709,11 @@ void pfs_end_rwlock_rdwait_v1(PSI_rwlock_locker *locker, int rc) {
     timer_end = get_wait_timer();
     wait_time = timer_end - state->m_timer_start;
     /* Aggregate to EVENTS_WAITS_SUMMARY_BY_INSTANCE (timed) */
-    rwlock->m_rwlock_stat.m_wait_stat.aggregate_value(wait_time);
+    rwlock->m_rwlock_stat.m_wait_stat.aggregate_sampled_value(wait_time,
+                                                              weight);
   } else {
     /* Aggregate to EVENTS_WAITS_SUMMARY_BY_INSTANCE (counted) */
-    rwlock->m_rwlock_stat.m_wait_stat.aggregate_counted();
+    rwlock->m_rwlock_stat.m_wait_stat.aggregate_counted(weight);
   }
 
   if (rc == 0) {
@@ -4725,10 +4741,10 @@ void pfs_end_rwlock_rdwait_v1(PSI_rwlock_locker *locker, int rc) {
 
     if (state->m_flags & STATE_FLAG_TIMED) {
       /* Aggregate to EVENTS_WAITS_SUMMARY_BY_THREAD_BY_EVENT_NAME (timed) */
-      event_name_array[index].aggregate_value(wait_time);
+      event_name_array[index].aggregate_sampled_value(wait_time, weight);
     } else {
       /* Aggregate to EVENTS_WAITS_SUMMARY_BY_THREAD_BY_EVENT_NAME (counted) */
-      event_name_array[index].aggregate_counted();
+      event_name_array[index].aggregate_counted(weight);
     }
 
     if (state->m_flags & STATE_FLAG_EVENT) {
@@ -4762,6 +4778,7 @@ void pfs_end_rwlock_wrwait_v1(PSI_rwlock_locker *locker, int rc) {
 
   ulonglong timer_end = 0;
   ulonglong wait_time = 0;
+  const ulonglong weight = sample_weight(state->m_flags, state->m_thread);
 
   PFS_rwlock *rwlock = reinterpret_cast<PFS_rwlock *>(state->m_rwlock);
   DBUG_ASSERT(rwlock != NULL);
@@ -4771,10 +4788,11 @@ void pfs_end_rwlock_wrwait_v1(PSI_rwlock_locker *locker, int rc) {
     timer_end = get_wait_timer();
     wait_time = timer_end - state->m_timer_start;
     /* Aggregate to EVENTS_WAITS_SUMMARY_BY_INSTANCE (timed) */
-    rwlock->m_rwlock_stat.m_wait_stat.aggregate_value(wait_time);
+    rwlock->m_rwlock_stat.m_wait_stat.aggregate_sampled_value(wait_time,
+                                                              weight);
   } else {
     /* Aggregate to EVENTS_WAITS_SUMMARY_BY_INSTANCE (counted) */
-    rwlock->m_rwlock_stat.m_wait_stat.aggregate_counted();
+    rwlock->m_rwlock_stat.m_wait_stat.aggregate_counted(weight);
   }
 
   if (likely(rc == 0)) {
@@ -4797,10 +4815,10 @@ void pfs_end_rwlock_wrwait_v1(PSI_rwlock_locker *locker, int rc) {
 
     if (state->m_flags & STATE_FLAG_TIMED) {
       /* Aggregate to EVENTS_WAITS_SUMMARY_BY_THREAD_BY_EVENT_NAME (timed) */
-      event_name_array[index].aggregate_value(wait_time);
+      event_name_array[index].aggregate_sampled_value(wait_time, weight);
     } else {
       /* Aggregate to EVENTS_WAITS_SUMMARY_BY_THREAD_BY_EVENT_NAME (counted) */
-      event_name_array[index].aggregate_counted();
+      event_name_array[index].aggregate_counted(weight);
     }
 
     if (state->m_flags & STATE_FLAG_EVENT) {
@@ -4834,6 +4852,7 @@ void pfs_end_cond_wait_v1(PSI_cond_locker *locker, int) {
 
   ulonglong timer_end = 0;
   ulonglong wait_time = 0;
+  const ulonglong weight = sample_weight(state->m_flags, state->m_thread);
 
   PFS_cond *cond = reinterpret_cast<PFS_cond *>(state->m_cond);
   /* PFS_mutex *mutex= reinterpret_cast<PFS_mutex *> (state->m_mutex); */
@@ -4842,10 +4861,10 @@ void pfs_end_cond_wait_v1(PSI_cond_locker *locker, int) {
     timer_end = get_wait_timer();
     wait_time = timer_end - state->m_timer_start;
     /* Aggregate to EVENTS_WAITS_SUMMARY_BY_INSTANCE (timed) */
-    cond->m_cond_stat.m_wait_stat.aggregate_value(wait_time);
+    cond->m_cond_stat.m_wait_stat.aggregate_sampled_value(wait_time, weight);
   } else {
     /* Aggregate to EVENTS_WAITS_SUMMARY_BY_INSTANCE (counted) */
-    cond->m_cond_stat.m_wait_stat.aggregate_counted();
+    cond->m_cond_stat.m_wait_stat.aggregate_counted(weight);
   }
 
   if (state->m_flags & STATE_FLAG_THREAD) {
@@ -4858,10 +4877,10 @@ void pfs_end_cond_wait_v1(PSI_cond_locker *locker, int) {
 
     if (state->m_flags & STATE_FLAG_TIMED) {
       /* Aggregate to EVENTS_WAITS_SUMMARY_BY_THREAD_BY_EVENT_NAME (timed) */
-      event_name_array[index].aggregate_value(wait_time);
+      event_name_array[index].aggregate_sampled_value(wait_time, weight);
     } else {
       /* Aggregate to EVENTS_WAITS_SUMMARY_BY_THREAD_BY_EVENT_NAME (counted) */
-      event_name_array[index].aggregate_counted();
+      event_name_array[index].aggregate_counted(weight);
     }
 
     if (state->m_flags & STATE_FLAG_EVENT) {
@@ -4895,6 +4914,7 @@ void pfs_end_table_io_wait_v1(PSI_table_locker *locker, ulonglong numrows) {
 
   ulonglong timer_end = 0;
   ulonglong wait_time = 0;
+  const ulonglong weight = sample_weight(state->m_flags, state->m_thread);
 
   PFS_table *table = reinterpret_cast<PFS_table *>(state->m_table);
   DBUG_ASSERT(table != NULL);
@@ -4932,9 +4952,9 @@ void pfs_end_table_io_wait_v1(PSI_table_locker *locker, ulonglong numrows) {
   if (flags & STATE_FLAG_TIMED) {
     timer_end = get_wait_timer();
     wait_time = timer_end - state->m_timer_start;
-    stat->aggregate_many_value(wait_time, numrows);
+    stat->aggregate_sampled_many_value(wait_time, numrows, weight);
   } else {
-    stat->aggregate_counted(numrows);
+    stat->aggregate_counted(numrows * weight);
   }
 
   if (flags & STATE_FLAG_THREAD) {
@@ -4949,10 +4969,11 @@ void pfs_end_table_io_wait_v1(PSI_table_locker *locker, ulonglong numrows) {
       (for wait/io/table/sql/handler)
     */
     if (flags & STATE_FLAG_TIMED) {
-      event_name_array[GLOBAL_TABLE_IO_EVENT_INDEX].aggregate_many_value(
-          wait_time, numrows);
+      event_name_array[GLOBAL_TABLE_IO_EVENT_INDEX]
+          .aggregate_sampled_many_value(wait_time, numrows, weight);
     } else {
-      event_name_array[GLOBAL_TABLE_IO_EVENT_INDEX].aggregate_counted(numrows);
+      event_name_array[GLOBAL_TABLE_IO_EVENT_INDEX].aggregate_counted(numrows *
+                                                                      weight);
     }
 
     if (flags & STATE_FLAG_EVENT) {
@@ -4989,6 +5010,7 @@ void pfs_end_table_lock_wait_v1(PSI_table_locker *locker) {
 
   ulonglong timer_end = 0;
   ulonglong wait_time = 0;
+  const ulonglong weight = sample_weight(state->m_flags, state->m_thread);
 
   PFS_table *table = reinterpret_cast<PFS_table *>(state->m_table);
   DBUG_ASSERT(table != NULL);
@@ -5001,9 +5023,9 @@ void pfs_end_table_lock_wait_v1(PSI_table_locker *locker) {
   if (flags & STATE_FLAG_TIMED) {
     timer_end = get_wait_timer();
     wait_time = timer_end - state->m_timer_start;
-    stat->aggregate_value(wait_time);
+    stat->aggregate_sampled_value(wait_time, weight);
   } else {
-    stat->aggregate_counted();
+    stat->aggregate_counted(weight);
   }
 
   if (flags & STATE_FLAG_THREAD) {
@@ -5018,10 +5040,10 @@ void pfs_end_table_lock_wait_v1(PSI_table_locker *locker) {
       (for wait/lock/table/sql/handler)
     */
     if (flags & STATE_FLAG_TIMED) {
-      event_name_array[GLOBAL_TABLE_LOCK_EVENT_INDEX].aggregate_value(
-          wait_time);
+      event_name_array[GLOBAL_TABLE_LOCK_EVENT_INDEX].aggregate_sampled_value(
+          wait_time, weight);
     } else {
-      event_name_array[GLOBAL_TABLE_LOCK_EVENT_INDEX].aggregate_counted();
+      event_name_array[GLOBAL_TABLE_LOCK_EVENT_INDEX].aggregate_counted(weight);
     }
 
     if (flags & STATE_FLAG_EVENT) {
@@ -5438,10 +5460,12 @@ PSI_stage_progress *pfs_start_stage_v1(PSI_stage_key key, const char *src_file,
 
       /* Aggregate to EVENTS_STAGES_SUMMARY_BY_THREAD_BY_EVENT_NAME (timed) */
       ulonglong stage_time = timer_value - pfs->m_timer_start;
-      event_name_array[index].aggregate_value(stage_time);
+      event_name_array[index].aggregate_sampled_value(
+          stage_time, pfs_thread->m_stage_sample_weight);
     } else {
       /* Aggregate to EVENTS_STAGES_SUMMARY_BY_THREAD_BY_EVENT_NAME (counted) */
-      event_name_array[index].aggregate_counted();
+      event_name_array[index].aggregate_counted(
+          pfs_thread->m_stage_sample_weight);
     }
 
     if (flag_events_stages_current) {
@@ -5474,7 +5498,12 @@ PSI_stage_progress *pfs_start_stage_v1(PSI_stage_key key, const char *src_file,
     return NULL;
   }
 
+  if (!pfs_thread->m_sampled) {
+    return NULL;
+  }
+
   pfs->m_class = new_klass;
+  pfs_thread->m_stage_sample_weight = pfs_thread->m_sample_weight;
   if (new_klass->m_timed) {
     /*
       Do not call the timer again if we have a
@@ -5553,10 +5582,12 @@ void pfs_end_stage_v1() {
 
       /* Aggregate to EVENTS_STAGES_SUMMARY_BY_THREAD_BY_EVENT_NAME (timed) */
       ulonglong stage_time = timer_value - pfs->m_timer_start;
-      event_name_array[index].aggregate_value(stage_time);
+      event_name_array[index].aggregate_sampled_value(
+          stage_time, pfs_thread->m_stage_sample_weight);
     } else {
       /* Aggregate to EVENTS_STAGES_SUMMARY_BY_THREAD_BY_EVENT_NAME (counted) */
-      event_name_array[index].aggregate_counted();
+      event_name_array[index].aggregate_counted(
+          pfs_thread->m_stage_sample_weight);
     }
 
     if (flag_events_stages_current) {
@@ -5609,6 +5640,24 @@ PSI_statement_locker *pfs_get_thread_statement_locker_v1(
     state->m_thread = reinterpret_cast<PSI_thread *>(pfs_thread);
     flags = STATE_FLAG_THREAD;
 
+    if (sp_share == NULL) {
+      /*
+        Decide if the stages and waits of this top level statement are
+        collected. The decision also holds for its nested statements.
+      */
+      ulong rate = pfs_param.m_statement_sample_rate;
+      if (rate <= 1) {
+        pfs_thread->m_sampled = true;
+        pfs_thread->m_sample_weight = 1;
+      } else {
+        pfs_thread->m_sampled = (++pfs_thread->m_sample_counter >= rate);
+        if (pfs_thread->m_sampled) {
+          pfs_thread->m_sample_counter = 0;
+        }
+        pfs_thread->m_sample_weight = static_cast<uint>(rate);
+      }
+    }
+
     if (klass->m_timed) {
       flags |= STATE_FLAG_TIMED;
     }
@@ -5755,6 +5804,7 @@ PSI_statement_locker *pfs_get_thread_statement_locker_v1(
   state->m_sort_scan = 0;
   state->m_no_index_used = 0;
   state->m_no_good_index_used = 0;
+  state->m_query_cost = 0.0;
 
   state->m_digest = NULL;
   state->m_cs_number = ((CHARSET_INFO *)charset)->number;
@@ -6007,6 +6057,17 @@ void pfs_set_statement_no_good_index_used_v1(PSI_statement_locker *locker) {
   SET_STATEMENT_ATTR_BODY(locker, m_no_good_index_used, 1);
 }
 
+void pfs_set_statement_query_cost_v1(PSI_statement_locker *locker,
+                                     double cost) {
+  PSI_statement_locker_state *state =
+      reinterpret_cast<PSI_statement_locker_state *>(locker);
+  if (unlikely(state == NULL) || state->m_discarded) {
+    return;
+  }
+  /* Only aggregated in the statement summaries, not in the events. */
+  state->m_query_cost = cost;
+}
+
 void pfs_end_statement_v1(PSI_statement_locker *locker, void *stmt_da) {
   PSI_statement_locker_state *state =
       reinterpret_cast<PSI_statement_locker_state *>(locker);
@@ -6014,6 +6075,17 @@ void pfs_end_statement_v1(PSI_statement_locker *locker, void *stmt_da) {
   DBUG_ASSERT(state != NULL);
   DBUG_ASSERT(da != NULL);
 
+  if ((state->m_flags & STATE_FLAG_THREAD) &&
+      state->m_parent_sp_share == NULL) {
+    /*
+      Stages and waits between top level statements, or while statements
+      are not instrumented, are collected and not scaled.
+    */
+    PFS_thread *pfs_thread = reinterpret_cast<PFS_thread *>(state->m_thread);
+    pfs_thread->m_sampled = true;
+    pfs_thread->m_sample_weight = 1;
+  }
+
   if (state->m_discarded) {
     return;
   }
@@ -6162,6 +6234,7 @@ void pfs_end_statement_v1(PSI_statement_locker *locker, void *stmt_da) {
   stat->m_sort_scan += state->m_sort_scan;
   stat->m_no_index_used += state->m_no_index_used;
   stat->m_no_good_index_used += state->m_no_good_index_used;
+  stat->m_query_cost += state->m_query_cost;
 
   if (digest_stat != NULL) {
     bool new_max_wait = false;
@@ -6244,6 +6317,7 @@ void pfs_end_statement_v1(PSI_statement_locker *locker, void *stmt_da) {
     digest_stat->m_stat.m_sort_scan += state->m_sort_scan;
     digest_stat->m_stat.m_no_index_used += state->m_no_index_used;
     digest_stat->m_stat.m_no_good_index_used += state->m_no_good_index_used;
+    digest_stat->m_stat.m_query_cost += state->m_query_cost;
   } else {
     if (flags & STATE_FLAG_TIMED) {
       time_normalizer *normalizer = time_normalizer::get_statement();
@@ -6284,6 +6358,7 @@ void pfs_end_statement_v1(PSI_statement_locker *locker, void *stmt_da) {
       sub_stmt_stat->m_sort_scan += state->m_sort_scan;
       sub_stmt_stat->m_no_index_used += state->m_no_index_used;
       sub_stmt_stat->m_no_good_index_used += state->m_no_good_index_used;
+      sub_stmt_stat->m_query_cost += state->m_query_cost;
     }
   }
 
@@ -6326,6 +6401,7 @@ void pfs_end_statement_v1(PSI_statement_locker *locker, void *stmt_da) {
         prepared_stmt_stat->m_sort_scan += state->m_sort_scan;
         prepared_stmt_stat->m_no_index_used += state->m_no_index_used;
         prepared_stmt_stat->m_no_good_index_used += state->m_no_good_index_used;
+        prepared_stmt_stat->m_query_cost += state->m_query_cost;
       }
     }
   }
@@ -7515,7 +7591,7 @@ PSI_metadata_locker *pfs_start_metadata_wait_v1(
     if (unlikely(pfs_thread == NULL)) {
       return NULL;
     }
-    if (!pfs_thread->m_enabled) {
+    if (!pfs_thread->m_enabled || !pfs_thread->m_sampled) {
       return NULL;
     }
     state->m_thread = reinterpret_cast<PSI_thread *>(pfs_thread);
@@ -7586,6 +7662,7 @@ void pfs_end_metadata_wait_v1(PSI_metadata_locker *locker, int) {
 
   ulonglong timer_end = 0;
   ulonglong wait_time = 0;
+  const ulonglong weight = sample_weight(state->m_flags, state->m_thread);
 
   PFS_thread *thread = reinterpret_cast<PFS_thread *>(state->m_thread);
 
@@ -7602,10 +7679,11 @@ void pfs_end_metadata_wait_v1(PSI_metadata_locker *locker, int) {
 
     if (flags & STATE_FLAG_TIMED) {
       /* Aggregate to EVENTS_WAITS_SUMMARY_BY_THREAD_BY_EVENT_NAME (timed) */
-      event_name_array[GLOBAL_METADATA_EVENT_INDEX].aggregate_value(wait_time);
+      event_name_array[GLOBAL_METADATA_EVENT_INDEX].aggregate_sampled_value(
+          wait_time, weight);
     } else {
       /* Aggregate to EVENTS_WAITS_SUMMARY_BY_THREAD_BY_EVENT_NAME (counted) */
-      event_name_array[GLOBAL_METADATA_EVENT_INDEX].aggregate_counted();
+      event_name_array[GLOBAL_METADATA_EVENT_INDEX].aggregate_counted(weight);
     }
 
     if (flags & STATE_FLAG_EVENT) {
@@ -7628,10 +7706,10 @@ void pfs_end_metadata_wait_v1(PSI_metadata_locker *locker, int) {
   } else {
     if (flags & STATE_FLAG_TIMED) {
       /* Aggregate to EVENTS_WAITS_SUMMARY_GLOBAL_BY_EVENT_NAME (timed) */
-      global_metadata_stat.aggregate_value(wait_time);
+      global_metadata_stat.aggregate_sampled_value(wait_time, weight);
     } else {
       /* Aggregate to EVENTS_WAITS_SUMMARY_GLOBAL_BY_EVENT_NAME (counted) */
-      global_metadata_stat.aggregate_counted();
+      global_metadata_stat.aggregate_counted(weight);
     }
   }
 }
@@ -7956,6 +8034,44 @@ PSI_statement_service_v1 pfs_statement_service_v1 = {
     pfs_end_sp_v1,
     pfs_drop_sp_v1};
 
+PSI_statement_service_v2 pfs_statement_service_v2 = {
+    /* Old interface, for plugins. */
+    pfs_register_statement_v1,
+    pfs_get_thread_statement_locker_v1,
+    pfs_refine_statement_v1,
+    pfs_start_statement_v1,
+    pfs_set_statement_text_v1,
+    pfs_set_statement_lock_time_v1,
+    pfs_set_statement_rows_sent_v1,
+    pfs_set_statement_rows_examined_v1,
+    pfs_inc_statement_created_tmp_disk_tables_v1,
+    pfs_inc_statement_created_tmp_tables_v1,
+    pfs_inc_statement_select_full_join_v1,
+    pfs_inc_statement_select_full_range_join_v1,
+    pfs_inc_statement_select_range_v1,
+    pfs_inc_statement_select_range_check_v1,
+    pfs_inc_statement_select_scan_v1,
+    pfs_inc_statement_sort_merge_passes_v1,
+    pfs_inc_statement_sort_range_v1,
+    pfs_inc_statement_sort_rows_v1,
+    pfs_inc_statement_sort_scan_v1,
+    pfs_set_statement_no_index_used_v1,
+    pfs_set_statement_no_good_index_used_v1,
+    pfs_set_statement_query_cost_v1,
+    pfs_end_statement_v1,
+    pfs_create_prepared_stmt_v1,
+    pfs_destroy_prepared_stmt_v1,
+    pfs_reprepare_prepared_stmt_v1,
+    pfs_execute_prepared_stmt_v1,
+    pfs_set_prepared_stmt_text_v1,
+    pfs_digest_start_v1,
+    pfs_digest_end_v1,
+    pfs_get_sp_share_v1,
+    pfs_release_sp_share_v1,
+    pfs_start_sp_v1,
+    pfs_end_sp_v1,
+    pfs_drop_sp_v1};
+
 SERVICE_TYPE(psi_statement_v1)
 SERVICE_IMPLEMENTATION(performance_schema, psi_statement_v1) = {
     /* New interface, for components. */
@@ -7994,6 +8110,45 @@ SERVICE_IMPLEMENTATION(performance_schema, psi_statement_v1) = {
     pfs_end_sp_v1,
     pfs_drop_sp_v1};
 
+SERVICE_TYPE(psi_statement_v2)
+SERVICE_IMPLEMENTATION(performance_schema, psi_statement_v2) = {
+    /* New interface, for components. */
+    pfs_register_statement_v1,
+    pfs_get_thread_statement_locker_v1,
+    pfs_refine_statement_v1,
+    pfs_start_statement_v1,
+    pfs_set_statement_text_v1,
+    pfs_set_statement_lock_time_v1,
+    pfs_set_statement_rows_sent_v1,
+    pfs_set_statement_rows_examined_v1,
+    pfs_inc_statement_created_tmp_disk_tables_v1,
+    pfs_inc_statement_created_tmp_tables_v1,
+    pfs_inc_statement_select_full_join_v1,
+    pfs_inc_statement_select_full_range_join_v1,
+    pfs_inc_statement_select_range_v1,
+    pfs_inc_statement_select_range_check_v1,
+    pfs_inc_statement_select_scan_v1,
+    pfs_inc_statement_sort_merge_passes_v1,
+    pfs_inc_statement_sort_range_v1,
+    pfs_inc_statement_sort_rows_v1,
+    pfs_inc_statement_sort_scan_v1,
+    pfs_set_statement_no_index_used_v1,
+    pfs_set_statement_no_good_index_used_v1,
+    pfs_set_statement_query_cost_v1,
+    pfs_end_statement_v1,
+    pfs_create_prepared_stmt_v1,
+    pfs_destroy_prepared_stmt_v1,
+    pfs_reprepare_prepared_stmt_v1,
+    pfs_execute_prepared_stmt_v1,
+    pfs_set_prepared_stmt_text_v1,
+    pfs_digest_start_v1,
+    pfs_digest_end_v1,
+    pfs_get_sp_share_v1,
+    pfs_release_sp_share_v1,
+    pfs_start_sp_v1,
+    pfs_end_sp_v1,
+    pfs_drop_sp_v1};
+
 PSI_transaction_service_v1 pfs_transaction_service_v1 = {
     /* Old interface, for plugins. */
     pfs_get_thread_transaction_locker_v1,
@@ -8139,6 +8294,8 @@ static void *get_statement_interface(int version) {
   switch (version) {
     case PSI_STATEMENT_VERSION_1:
       return &pfs_statement_service_v1;
+    case PSI_STATEMENT_VERSION_2:
+      return &pfs_statement_service_v2;
     default:
       return NULL;
   }
@@ -8229,6 +8386,7 @@ PROVIDES_SERVICE(performance_schema, psi_cond_v1),
     PROVIDES_SERVICE(performance_schema, psi_socket_v1),
     PROVIDES_SERVICE(performance_schema, psi_stage_v1),
     PROVIDES_SERVICE(performance_schema, psi_statement_v1),
+    PROVIDES_SERVICE(performance_schema, psi_statement_v2),
     PROVIDES_SERVICE(performance_schema, psi_table_v1),
     PROVIDES_SERVICE(performance_schema, psi_thread_v1),
     PROVIDES_SERVICE(performance_schema, psi_transaction_v1),
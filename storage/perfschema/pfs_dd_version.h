@@ -85,8 +85,14 @@
   performance_schema tables changed in MySQL 8.0.11 are
   - instance_log_resource was renamed to log_resource.
 
-  Version published is now 80011.
+  80012:
+
+  performance_schema tables changed in MySQL 8.0.12 are
+  - events_statements_summary_by_digest (modified, added column
+    SUM_QUERY_COST)
+
+  Version published is now 80012.
 */
-static const uint PFS_DD_VERSION = 80011;
+static const uint PFS_DD_VERSION = 80012;
 
 #endif /* PFS_DD_VERSION_H */
@@ -570,6 +570,10 @@ PFS_thread *create_thread(PFS_thread_class *klass,
     pfs->m_start_time = 0;
     pfs->m_stage = 0;
     pfs->m_stage_progress = NULL;
+    pfs->m_sampled = true;
+    pfs->m_sample_weight = 1;
+    pfs->m_stage_sample_weight = 1;
+    pfs->m_sample_counter = 0;
     pfs->m_processlist_info[0] = '\0';
     pfs->m_processlist_info_length = 0;
     pfs->m_connection_type = NO_VIO_TYPE;
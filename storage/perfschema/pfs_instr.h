@@ -594,6 +594,18 @@ struct PFS_ALIGNED PFS_thread : PFS_connection_slice {
   PFS_stage_key m_stage;
   /** Current stage progress. */
   PSI_stage_progress *m_stage_progress;
+  /**
+    True when stages and waits are collected for the current top level
+    statement. Always true between top level statements.
+    @sa PFS_global_param::m_statement_sample_rate
+  */
+  bool m_sampled;
+  /** Number of statements the current statement stands for. */
+  uint m_sample_weight;
+  /** Sample weight of the statement the current stage belongs to. */
+  uint m_stage_sample_weight;
+  /** Top level statements seen since the last sampled statement. */
+  ulong m_sample_counter;
   /**
     Processlist info.
     Protected by @c m_stmt_lock.
@@ -272,6 +272,12 @@ struct PFS_global_param {
   /** Maximum age in seconds for a query sample. */
   ulong m_max_digest_sample_age;
 
+  /**
+    Stages and waits are collected for one in this many top level
+    statements of each thread, and scaled up in the summaries.
+  */
+  ulong m_statement_sample_rate;
+
   /** Maximum number of error instrumented */
   ulong m_error_sizing;
 
@@ -121,6 +121,30 @@ struct PFS_single_stat {
       m_max = value;
     }
   }
+
+  /**
+    Aggregate a value observed in a sampled statement,
+    standing for @c weight values.
+  */
+  inline void aggregate_sampled_value(ulonglong value, ulonglong weight) {
+    aggregate_sampled_many_value(value, 1, weight);
+  }
+
+  /**
+    Aggregate a value for @c count events observed in a sampled statement,
+    standing for @c weight times as many events.
+  */
+  inline void aggregate_sampled_many_value(ulonglong value, ulonglong count,
+                                           ulonglong weight) {
+    m_count += count * weight;
+    m_sum += value * weight;
+    if (unlikely(m_min > value)) {
+      m_min = value;
+    }
+    if (unlikely(m_max < value)) {
+      m_max = value;
+    }
+  }
 };
 
 /** Combined statistic. */
@@ -324,10 +348,18 @@ struct PFS_stage_stat {
 
   inline void aggregate_counted() { m_timer1_stat.aggregate_counted(); }
 
+  inline void aggregate_counted(ulonglong count) {
+    m_timer1_stat.aggregate_counted(count);
+  }
+
   inline void aggregate_value(ulonglong value) {
     m_timer1_stat.aggregate_value(value);
   }
 
+  inline void aggregate_sampled_value(ulonglong value, ulonglong weight) {
+    m_timer1_stat.aggregate_sampled_value(value, weight);
+  }
+
   inline void aggregate(const PFS_stage_stat *stat) {
     m_timer1_stat.aggregate(&stat->m_timer1_stat);
   }
@@ -393,6 +425,7 @@ struct PFS_statement_stat {
   ulonglong m_sort_scan;
   ulonglong m_no_index_used;
   ulonglong m_no_good_index_used;
+  double m_query_cost;
 
   PFS_statement_stat() { reset(); }
 
@@ -423,6 +456,7 @@ struct PFS_statement_stat {
       m_sort_scan = 0;
       m_no_index_used = 0;
       m_no_good_index_used = 0;
+      m_query_cost = 0.0;
     }
   }
 
@@ -461,6 +495,7 @@ struct PFS_statement_stat {
       m_sort_scan += stat->m_sort_scan;
       m_no_index_used += stat->m_no_index_used;
       m_no_good_index_used += stat->m_no_good_index_used;
+      m_query_cost += stat->m_query_cost;
     }
   }
 };
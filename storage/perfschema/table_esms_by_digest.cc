@@ -87,6 +87,7 @@ Plugin_table table_esms_by_digest::m_table_def(
     "  QUERY_SAMPLE_TEXT LONGTEXT,\n"
     "  QUERY_SAMPLE_SEEN TIMESTAMP(6) NOT NULL default 0,\n"
     "  QUERY_SAMPLE_TIMER_WAIT BIGINT unsigned NOT NULL,\n"
+    "  SUM_QUERY_COST DOUBLE NOT NULL,\n"
     "  UNIQUE KEY (SCHEMA_NAME, DIGEST) USING HASH\n",
     /* Options */
     " ENGINE=PERFORMANCE_SCHEMA",
@@ -340,6 +341,9 @@ int table_esms_by_digest::read_row_values(TABLE *table, unsigned char *buf,
         case 34: /* QUERY_SAMPLE_TIMER_WAIT */
           set_field_ulonglong(f, m_row.m_query_sample_timer_wait);
           break;
+        case 35: /* SUM_QUERY_COST */
+          set_field_double(f, m_row.m_stat.m_query_cost);
+          break;
         default: /* 3, ... COUNT/SUM/MIN/AVG/MAX */
           m_row.m_stat.set_field(f->field_index - 3, f);
           break;
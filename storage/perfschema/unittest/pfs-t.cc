@@ -242,6 +242,8 @@ static void test_bootstrap() {
   ok(psi == NULL, "no statement version 0");
   psi = statement_boot->get_interface(PSI_STATEMENT_VERSION_1);
   ok(psi != NULL, "statement version 1");
+  psi = statement_boot->get_interface(PSI_STATEMENT_VERSION_2);
+  ok(psi != NULL, "statement version 2");
 
   psi = transaction_boot->get_interface(0);
   ok(psi == NULL, "no transaction version 0");
@@ -374,7 +376,7 @@ static void load_perfschema(
   *stage_service =
       (PSI_stage_service_t *)stage_boot->get_interface(PSI_SOCKET_VERSION_1);
   *statement_service = (PSI_statement_service_t *)statement_boot->get_interface(
-      PSI_STATEMENT_VERSION_1);
+      PSI_STATEMENT_VERSION_2);
   *transaction_service =
       (PSI_transaction_service_t *)transaction_boot->get_interface(
           PSI_TRANSACTION_VERSION_1);
@@ -1888,7 +1890,7 @@ static void test_event_name_index() {
       (PSI_stage_service_t *)stage_boot->get_interface(PSI_STAGE_VERSION_1);
   ok(stage_service != NULL, "stage_service");
   statement_service = (PSI_statement_service_t *)statement_boot->get_interface(
-      PSI_STATEMENT_VERSION_1);
+      PSI_STATEMENT_VERSION_2);
   ok(statement_service != NULL, "statement_service");
   transaction_service =
       (PSI_transaction_service_t *)transaction_boot->get_interface(
@@ -2185,7 +2187,7 @@ static void do_all_tests() {
 }
 
 int main(int, char **) {
-  plan(329);
+  plan(330);
 
   MY_INIT("pfs-t");
   do_all_tests();
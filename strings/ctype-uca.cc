@@ -48,6 +48,11 @@
 #include <algorithm>
 #include <bitset>
 #include <iterator>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 #include "m_ctype.h"
 #include "m_string.h"
@@ -1479,6 +1484,39 @@ ALWAYS_INLINE int uca_scanner_900<Mb_wc, LEVELS_FOR_COMPARE>::next_raw() {
   return rtn;
 }
 
+/**
+  Check if all the 16 bytes starting at str are in the range 0x20..0x7e,
+  inclusive, like the four byte check in for_each_weight(), using vector
+  instructions where available.
+*/
+static ALWAYS_INLINE bool is_printable_ascii_16(const uchar *str) {
+#if defined(__SSE2__)
+  const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str));
+  // Bytes 0x80..0xff are negative as signed bytes, so they are below 0x20.
+  const __m128i in_range =
+      _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(0x1f)),
+                    _mm_cmplt_epi8(bytes, _mm_set1_epi8(0x7f)));
+  return _mm_movemask_epi8(in_range) == 0xffff;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+  const uint8x16_t bytes = vld1q_u8(str);
+  const uint8x16_t in_range = vandq_u8(vcgeq_u8(bytes, vdupq_n_u8(0x20)),
+                                       vcleq_u8(bytes, vdupq_n_u8(0x7e)));
+  return vminvq_u8(in_range) == 0xff;
+#else
+  /*
+    The same bitfiddling trick as for four bytes. See the FastOutOfRange64
+    unit test.
+  */
+  uint64 eight_bytes[2];
+  memcpy(eight_bytes, str, sizeof(eight_bytes));
+  return !(((eight_bytes[0] + 0x0101010101010101ULL) |
+            (eight_bytes[0] - 0x2020202020202020ULL) |
+            (eight_bytes[1] + 0x0101010101010101ULL) |
+            (eight_bytes[1] - 0x2020202020202020ULL)) &
+           0x8080808080808080ULL);
+#endif
+}
+
 template <class Mb_wc, int LEVELS_FOR_COMPARE>
 template <class T, class U>
 ALWAYS_INLINE void uca_scanner_900<Mb_wc, LEVELS_FOR_COMPARE>::for_each_weight(
@@ -1505,6 +1543,7 @@ ALWAYS_INLINE void uca_scanner_900<Mb_wc, LEVELS_FOR_COMPARE>::for_each_weight(
     (In particular, this catches the case of sbeg == send == nullptr.)
   */
   const uchar *send_local = (send - sbeg > 3) ? (send - 3) : sbeg;
+  const uchar *send_local16 = (send - sbeg > 15) ? (send - 15) : sbeg;
 
   for (;;) {
     /*
@@ -1523,6 +1562,22 @@ ALWAYS_INLINE void uca_scanner_900<Mb_wc, LEVELS_FOR_COMPARE>::for_each_weight(
       we'd otherwise have to do.
     */
     const uchar *sbeg_local = sbeg;
+
+    /*
+      First consume whole blocks of 16 such characters, which is the common
+      case for long ASCII strings; the weights of a block are looked up and
+      emitted without any further checks.
+    */
+    while (sbeg_local < send_local16 && preaccept_data(16) &&
+           is_printable_ascii_16(sbeg_local)) {
+      for (int i = 0; i < 16; ++i) {
+        const int s_res = ascii_wpage[sbeg_local[i]];
+        DBUG_ASSERT(s_res != 0);
+        func(s_res, /*is_level_separator=*/false);
+      }
+      sbeg_local += 16;
+    }
+
     while (sbeg_local < send_local && preaccept_data(sizeof(uint32))) {
       /*
         Check if all four bytes are in the range 0x20..0x7e, inclusive.
@@ -4769,7 +4824,8 @@ static size_t my_strnxfrm_uca_900_tmpl(const CHARSET_INFO *cs,
           return (dst < dst_end);
         },
         [&dst, dst_end](int num_weights) {
-          return (dst < dst_end - num_weights * 2);
+          // dst_end - num_weights * 2 could point before the buffer.
+          return (dst_end - dst > num_weights * 2);
         });
   }
 
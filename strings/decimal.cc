@@ -1135,6 +1135,96 @@ int decimal2longlong(decimal_t *from, longlong *to) {
   return E_DEC_OK;
 }
 
+/**
+  Convert a decimal value to an integer holding the value multiplied by
+  10^scale, so that decimals with the same scale can be added as integers.
+
+  @param      from   The decimal value to convert from.
+  @param      scale  The number of fractional digits to keep, at most
+                     2 * DIG_PER_DEC1.
+  @param[out] to     The scaled integer, only set on success.
+  @return E_DEC_OK, E_DEC_TRUNCATED if from has more than scale fractional
+          digits, or E_DEC_OVERFLOW if the scaled value does not fit.
+*/
+int decimal2scaled_longlong(const decimal_t *from, int scale, longlong *to) {
+  const ulonglong max = LLONG_MAX;
+  const dec1 *buf = from->buf;
+  ulonglong x = 0;
+  int intg, frac;
+
+  if (unlikely(scale > 2 * DIG_PER_DEC1)) return E_DEC_OVERFLOW;
+  if (unlikely(from->frac > scale)) return E_DEC_TRUNCATED;
+
+  for (intg = from->intg; intg > 0; intg -= DIG_PER_DEC1) {
+    if (unlikely(x > (max - *buf) / DIG_BASE)) return E_DEC_OVERFLOW;
+    x = x * DIG_BASE + *buf++;
+  }
+
+  /*
+    Only the leading digits of the last fractional word are used, the
+    digits beyond from->frac are zero.
+  */
+  for (frac = from->frac; frac > 0; frac -= DIG_PER_DEC1) {
+    const int digits = std::min(scale, DIG_PER_DEC1);
+    const dec1 value = *buf++ / powers10[DIG_PER_DEC1 - digits];
+    if (unlikely(x > (max - value) / powers10[digits]))
+      return E_DEC_OVERFLOW;
+    x = x * powers10[digits] + value;
+    scale -= digits;
+  }
+
+  for (; scale > 0; scale -= DIG_PER_DEC1) {
+    const int digits = std::min(scale, DIG_PER_DEC1);
+    if (unlikely(x > max / powers10[digits])) return E_DEC_OVERFLOW;
+    x *= powers10[digits];
+  }
+
+  *to = from->sign ? -static_cast<longlong>(x) : static_cast<longlong>(x);
+  return E_DEC_OK;
+}
+
+/**
+  Convert an integer holding a value multiplied by 10^scale back to a
+  decimal value. This is the inverse of decimal2scaled_longlong().
+
+  @param      from   The scaled integer.
+  @param      scale  The number of fractional digits of the value, at most
+                     2 * DIG_PER_DEC1.
+  @param[out] to     The decimal value, with exactly scale fractional digits.
+  @return E_DEC_OK on success, error code on error.
+*/
+int scaled_longlong2decimal(longlong from, int scale, decimal_t *to) {
+  ulonglong x = from < 0 ? -static_cast<ulonglong>(from) : from;
+  ulonglong divisor = 1;
+  int error;
+  dec1 *buf;
+
+  DBUG_ASSERT(scale >= 0 && scale <= 2 * DIG_PER_DEC1);
+
+  for (int i = 0; i < scale; i++) divisor *= 10;
+  ulonglong frac_part = x % divisor;
+
+  if (unlikely((error = ull2dec(x / divisor, to)) != E_DEC_OK)) return error;
+  if (unlikely(ROUND_UP(to->intg) + ROUND_UP(scale) > to->len))
+    return E_DEC_OVERFLOW;
+
+  /* The last fractional word is padded with zeros to DIG_PER_DEC1 digits. */
+  buf = to->buf + ROUND_UP(to->intg);
+  for (int digits = scale; digits > 0; digits -= DIG_PER_DEC1) {
+    if (digits > DIG_PER_DEC1) {
+      const dec1 rest = powers10[digits - DIG_PER_DEC1];
+      *buf++ = static_cast<dec1>(frac_part / rest);
+      frac_part %= rest;
+    } else {
+      *buf++ = static_cast<dec1>(frac_part) * powers10[DIG_PER_DEC1 - digits];
+    }
+  }
+
+  to->frac = scale;
+  to->sign = from < 0;
+  return E_DEC_OK;
+}
+
 #define LLDIV_MIN -1000000000000000000LL
 #define LLDIV_MAX 1000000000000000000LL
 
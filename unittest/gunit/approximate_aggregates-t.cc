@@ -0,0 +1,104 @@
+/* Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "sql/approximate_aggregates.h"
+
+namespace approximate_aggregates_unittest {
+
+TEST(HyperloglogTest, Empty) {
+  Hyperloglog hll;
+  EXPECT_EQ(0U, hll.estimate());
+}
+
+TEST(HyperloglogTest, SmallCardinalityIsExact) {
+  Hyperloglog hll;
+  for (int round = 0; round < 3; ++round)
+    for (ulonglong i = 0; i < 10; ++i) hll.add(Hyperloglog::mix(i));
+  EXPECT_EQ(10U, hll.estimate());
+}
+
+TEST(HyperloglogTest, LargeCardinality) {
+  Hyperloglog hll;
+  const ulonglong n = 1000000;
+  for (ulonglong i = 0; i < n; ++i) hll.add(Hyperloglog::mix(i));
+  // Five times the standard error.
+  EXPECT_NEAR(static_cast<double>(n), static_cast<double>(hll.estimate()),
+              n * 0.08);
+}
+
+TEST(HyperloglogTest, Merge) {
+  Hyperloglog a, b, all;
+  for (ulonglong i = 0; i < 60000; ++i) {
+    const ulonglong hash = Hyperloglog::mix(i);
+    (i < 40000 ? a : b).add(hash);
+    if (i >= 20000) a.add(hash);
+    all.add(hash);
+  }
+  a.merge(b);
+  EXPECT_EQ(all.estimate(), a.estimate());
+}
+
+TEST(QuantileDigestTest, SmallSetIsExact) {
+  Quantile_digest digest;
+  EXPECT_TRUE(digest.empty());
+  for (int i = 5; i >= 1; --i) digest.add(i);
+  EXPECT_FALSE(digest.empty());
+  EXPECT_DOUBLE_EQ(1.0, digest.quantile(0.0));
+  EXPECT_DOUBLE_EQ(3.0, digest.quantile(0.5));
+  EXPECT_DOUBLE_EQ(5.0, digest.quantile(1.0));
+
+  digest.clear();
+  EXPECT_TRUE(digest.empty());
+  digest.add(42.0);
+  EXPECT_DOUBLE_EQ(42.0, digest.quantile(0.3));
+}
+
+TEST(QuantileDigestTest, Uniform) {
+  Quantile_digest digest;
+  const int n = 100000;
+  // Add 0..n-1 in a scrambled order.
+  for (int i = 0; i < n; ++i) digest.add((i * 7919) % n);
+
+  EXPECT_DOUBLE_EQ(0.0, digest.quantile(0.0));
+  EXPECT_DOUBLE_EQ(n - 1, digest.quantile(1.0));
+  EXPECT_NEAR(n * 0.5, digest.quantile(0.5), n * 0.01);
+  EXPECT_NEAR(n * 0.99, digest.quantile(0.99), n * 0.002);
+  EXPECT_NEAR(n * 0.001, digest.quantile(0.001), n * 0.0005);
+}
+
+TEST(QuantileDigestTest, Merge) {
+  Quantile_digest low, high;
+  for (int i = 0; i < 50000; ++i) {
+    low.add(i);
+    high.add(50000 + i);
+  }
+  low.merge(high);
+  EXPECT_DOUBLE_EQ(0.0, low.quantile(0.0));
+  EXPECT_DOUBLE_EQ(99999.0, low.quantile(1.0));
+  EXPECT_NEAR(50000.0, low.quantile(0.5), 1000.0);
+  EXPECT_NEAR(90000.0, low.quantile(0.9), 500.0);
+}
+
+}  // namespace approximate_aggregates_unittest
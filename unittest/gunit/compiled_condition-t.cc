@@ -0,0 +1,224 @@
+/* Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include <gtest/gtest.h>
+
+#include "my_bitmap.h"
+#include "sql/compiled_condition.h"
+#include "sql/item_cmpfunc.h"
+#include "sql/parse_tree_helpers.h"
+#include "sql/sql_class.h"
+#include "sql/sql_lex.h"
+#include "unittest/gunit/fake_table.h"
+#include "unittest/gunit/test_utils.h"
+
+namespace compiled_condition_unittest {
+
+using my_testing::Server_initializer;
+
+class CompiledConditionTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    initializer.SetUp();
+    m_table = new Fake_TABLE(2, true);
+    bitmap_set_all(m_table->read_set);
+    m_a = m_table->field[0];
+    m_b = m_table->field[1];
+  }
+
+  virtual void TearDown() {
+    delete m_table;
+    initializer.TearDown();
+  }
+
+  THD *thd() { return initializer.thd(); }
+
+  template <class T>
+  T *fix(T *item) {
+    Item *itm = item;
+    EXPECT_FALSE(item->fix_fields(thd(), &itm));
+    return item;
+  }
+
+  Item *between(Field *field, int low, int high, bool negated) {
+    Parse_context pc(thd(), thd()->lex->current_select());
+    Item *item = new Item_func_between(POS(), new Item_field(field),
+                                       new Item_int(low), new Item_int(high),
+                                       negated);
+    EXPECT_FALSE(item->itemize(&pc, &item));
+    return fix(item);
+  }
+
+  Item *in(Field *field, std::initializer_list<int> values, bool negated) {
+    PT_item_list *list = new (thd()->mem_root) PT_item_list;
+    list->value.push_back(new Item_field(field));
+    for (int value : values) list->value.push_back(new Item_int(value));
+    Parse_context pc(thd(), thd()->lex->current_select());
+    Item *item = new Item_func_in(POS(), list, negated);
+    EXPECT_FALSE(item->itemize(&pc, &item));
+    return fix(item);
+  }
+
+  void set(Field *field, int value) {
+    if (value == NULL_VALUE) {
+      field->set_null();
+    } else {
+      field->set_notnull();
+      field->store(value, false);
+    }
+  }
+
+  /**
+    Compile the condition, and check that the program agrees with the
+    Item tree on all combinations of small values and NULL.
+  */
+  void check_agrees(Item *cond) {
+    const Compiled_condition *compiled =
+        Compiled_condition::compile(thd()->mem_root, cond);
+    ASSERT_NE(nullptr, compiled);
+    for (int a = -4; a <= NULL_VALUE; ++a) {
+      set(m_a, a);
+      for (int b = -4; b <= NULL_VALUE; ++b) {
+        set(m_b, b);
+        SCOPED_TRACE(testing::Message() << "a=" << a << " b=" << b);
+        EXPECT_EQ(cond->val_int() != 0, compiled->evaluate(thd()));
+      }
+    }
+  }
+
+  /// Stands for NULL in set(), and is the last value tried.
+  static const int NULL_VALUE = 5;
+
+  Server_initializer initializer;
+  Fake_TABLE *m_table;
+  Field *m_a;
+  Field *m_b;
+};
+
+TEST_F(CompiledConditionTest, Comparisons) {
+  check_agrees(fix(new Item_func_eq(new Item_field(m_a), new Item_int(1))));
+  check_agrees(fix(new Item_func_ne(new Item_field(m_a), new Item_int(1))));
+  check_agrees(fix(new Item_func_lt(new Item_field(m_a), new Item_int(1))));
+  check_agrees(fix(new Item_func_le(new Item_field(m_a), new Item_int(-2))));
+  check_agrees(fix(new Item_func_gt(new Item_int(0), new Item_field(m_a))));
+  check_agrees(fix(new Item_func_ge(new Item_int(3), new Item_field(m_b))));
+}
+
+TEST_F(CompiledConditionTest, BetweenAndIn) {
+  check_agrees(between(m_a, -1, 2, false));
+  check_agrees(between(m_a, -1, 2, true));
+  check_agrees(in(m_b, {3, -2, 0}, false));
+  check_agrees(in(m_b, {3, -2, 0}, true));
+}
+
+TEST_F(CompiledConditionTest, AndOr) {
+  List<Item> or_args;
+  or_args.push_back(
+      fix(new Item_func_lt(new Item_field(m_a), new Item_int(0))));
+  or_args.push_back(between(m_b, 1, 3, false));
+  Item *or_item = fix(new Item_cond_or(or_args));
+
+  List<Item> and_args;
+  and_args.push_back(or_item);
+  and_args.push_back(
+      fix(new Item_func_ne(new Item_field(m_b), new Item_int(2))));
+  and_args.push_back(in(m_a, {-3, -1, 1, 4}, false));
+  check_agrees(fix(new Item_cond_and(and_args)));
+}
+
+TEST_F(CompiledConditionTest, MixedWithItems) {
+  List<Item> args;
+  args.push_back(fix(new Item_func_isnull(new Item_field(m_a))));
+  args.push_back(fix(new Item_func_gt(new Item_field(m_b), new Item_int(0))));
+  check_agrees(fix(new Item_cond_or(args)));
+}
+
+/// A TRUE leaf which counts how many times it is evaluated.
+class Counting_item : public Item_int {
+ public:
+  Counting_item() : Item_int(1), m_count(0) {}
+  longlong val_int() override {
+    ++m_count;
+    return Item_int::val_int();
+  }
+  int m_count;
+};
+
+TEST_F(CompiledConditionTest, UnknownInAnd) {
+  // (a > 0 AND counter) OR b = 1
+  Counting_item *counter = new Counting_item;
+  List<Item> and_args;
+  and_args.push_back(
+      fix(new Item_func_gt(new Item_field(m_a), new Item_int(0))));
+  and_args.push_back(counter);
+  List<Item> or_args;
+  or_args.push_back(fix(new Item_cond_and(and_args)));
+  or_args.push_back(
+      fix(new Item_func_eq(new Item_field(m_b), new Item_int(1))));
+  Item *cond = fix(new Item_cond_or(or_args));
+  const Compiled_condition *compiled =
+      Compiled_condition::compile(thd()->mem_root, cond);
+  ASSERT_NE(nullptr, compiled);
+
+  // The AND goes on after a > 0 is UNKNOWN, as the Item tree does.
+  set(m_a, NULL_VALUE);
+  set(m_b, 1);
+  EXPECT_TRUE(compiled->evaluate(thd()));
+  EXPECT_EQ(1, counter->m_count);
+  EXPECT_EQ(1, cond->val_int());
+  EXPECT_EQ(2, counter->m_count);
+
+  set(m_b, 2);
+  EXPECT_FALSE(compiled->evaluate(thd()));
+  EXPECT_EQ(3, counter->m_count);
+  check_agrees(cond);
+
+  // A top level AND stops at the first operand which is not TRUE.
+  Counting_item *top_counter = new Counting_item;
+  List<Item> top_args;
+  top_args.push_back(
+      fix(new Item_func_gt(new Item_field(m_a), new Item_int(0))));
+  top_args.push_back(top_counter);
+  Item *top = fix(new Item_cond_and(top_args));
+  top->top_level_item();
+  const Compiled_condition *top_compiled =
+      Compiled_condition::compile(thd()->mem_root, top);
+  ASSERT_NE(nullptr, top_compiled);
+  set(m_a, NULL_VALUE);
+  EXPECT_FALSE(top_compiled->evaluate(thd()));
+  EXPECT_EQ(0, top_counter->m_count);
+  set(m_a, 1);
+  EXPECT_TRUE(top_compiled->evaluate(thd()));
+  EXPECT_EQ(1, top_counter->m_count);
+}
+
+TEST_F(CompiledConditionTest, NotCompiled) {
+  // No leaf can be specialized, so there is nothing to gain.
+  Item *isnull = fix(new Item_func_isnull(new Item_field(m_a)));
+  EXPECT_EQ(nullptr, Compiled_condition::compile(thd()->mem_root, isnull));
+
+  // Comparisons of two columns go through the Item.
+  Item *cmp = fix(new Item_func_eq(new Item_field(m_a), new Item_field(m_b)));
+  EXPECT_EQ(nullptr, Compiled_condition::compile(thd()->mem_root, cmp));
+}
+
+}  // namespace compiled_condition_unittest
@@ -130,6 +130,18 @@ void dump_decimal(decimal_t *d) {
     do_test_d2ll(p1, p2, p3); \
   }
 
+#define test_d2sll(p1, p2, p3, p4) \
+  {                                \
+    SCOPED_TRACE("");              \
+    do_test_d2sll(p1, p2, p3, p4); \
+  }
+
+#define test_sll2d(p1, p2, p3) \
+  {                            \
+    SCOPED_TRACE("");          \
+    do_test_sll2d(p1, p2, p3); \
+  }
+
 #define test_da(p1, p2, p3, p4) \
   {                             \
     SCOPED_TRACE("");           \
@@ -373,6 +385,35 @@ void do_test_d2ll(const char *s, const char *orig, int ex) {
   }
 }
 
+void do_test_d2sll(const char *s, int scale, const char *orig, int ex) {
+  char s1[100], *end;
+  char s2[100];
+  longlong x = 0;
+  int res;
+
+  end = strend(s);
+  string2decimal(s, &a, &end);
+  res = decimal2scaled_longlong(&a, scale, &x);
+  if (full) dump_decimal(&a);
+  longlong10_to_str(x, s1, -10);
+  sprintf(s2, "%-40s => res=%d    %s\n", s, res, s1);
+  check_result_code(res, ex);
+  if (orig) {
+    EXPECT_STREQ(orig, s1) << " arguments were: " << s2;
+  }
+}
+
+void do_test_sll2d(longlong from, int scale, const char *orig) {
+  char s[100];
+  char s1[100];
+  int res;
+
+  res = scaled_longlong2decimal(from, scale, &a);
+  longlong10_to_str(from, s, -10);
+  sprintf(s1, "%-40s %d => res=%d    ", s, scale, res);
+  print_decimal(&a, orig, res, 0, s1);
+}
+
 void do_test_da(const char *s1, const char *s2, const char *orig, int ex) {
   char s[100], *end;
   int res;
@@ -610,6 +651,28 @@ TEST_F(DecimalTest, Decimal2Longlong) {
   test_d2ll("9223372036854775808", "9223372036854775807", 2);
 }
 
+TEST_F(DecimalTest, Decimal2ScaledLonglong) {
+  test_d2sll("123.45", 2, "12345", 0);
+  test_d2sll("-123.45", 4, "-1234500", 0);
+  test_d2sll("0.000000001", 9, "1", 0);
+  test_d2sll("12.1234567891", 12, "12123456789100", 0);
+  test_d2sll("1.23", 0, NULL, 1);
+  test_d2sll("922337203685477580.7", 1, "9223372036854775807", 0);
+  test_d2sll("922337203685477580.8", 1, NULL, 2);
+  test_d2sll("10000000000", 9, NULL, 2);
+  test_d2sll("0", 19, NULL, 2);
+}
+
+TEST_F(DecimalTest, ScaledLonglong2Decimal) {
+  test_sll2d(12345LL, 2, "123.45");
+  test_sll2d(-1234500LL, 4, "-123.4500");
+  test_sll2d(1LL, 9, "0.000000001");
+  test_sll2d(0LL, 3, "0.000");
+  test_sll2d(12123456789100LL, 12, "12.123456789100");
+  test_sll2d(-9223372036854775807LL, 18, "-9.223372036854775807");
+  test_sll2d(9223372036854775807LL, 0, "9223372036854775807");
+}
+
 TEST_F(DecimalTest, DoAdd) {
   test_da(".00012345000098765", "123.45", "123.45012345000098765", 0);
   test_da(".1", ".45", "0.55", 0);
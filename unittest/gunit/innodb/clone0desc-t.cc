@@ -0,0 +1,181 @@
+/* Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/* See http://code.google.com/p/googletest/wiki/Primer */
+
+// First include (the generated) my_config.h, to get correct platform defines.
+#include "my_config.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "storage/innobase/include/univ.i"
+
+#include "storage/innobase/include/clone0desc.h"
+#include "storage/innobase/include/log0log.h"
+
+namespace innodb_clone0desc_unittest {
+
+/** Build the base of a data directory with two data files. */
+static void build_base(Clone_Base *base) {
+  base->m_lsn = 12345678;
+  base->m_group_lsn = 1000;
+  base->m_donor_uuid.assign("0a1b2c3d-0000-1111-2222-333344445555");
+
+  Clone_Base_File file;
+
+  file.m_space_id = 0;
+  file.m_file_size = 12 * 1024 * 1024;
+  file.m_file_name.assign("ibdata1");
+  base->m_files.push_back(file);
+
+  file.m_space_id = 23;
+  file.m_file_size = 112 * 1024;
+  file.m_file_name.assign("test/t1.ibd");
+  base->m_files.push_back(file);
+}
+
+/* A base is written to the data directory and read back. */
+TEST(clone0desc, base_round_trip) {
+  Clone_Base base;
+
+  EXPECT_FALSE(base.is_set());
+
+  build_base(&base);
+  EXPECT_TRUE(base.is_set());
+
+  std::vector<byte> buf(base.serialized_length());
+  base.serialize(&buf[0]);
+
+  Clone_Base read_base;
+
+  ASSERT_TRUE(read_base.deserialize(&buf[0], buf.size()));
+  EXPECT_TRUE(read_base.is_set());
+  EXPECT_EQ(base.m_lsn, read_base.m_lsn);
+  EXPECT_EQ(base.m_group_lsn, read_base.m_group_lsn);
+  EXPECT_EQ(base.m_donor_uuid, read_base.m_donor_uuid);
+
+  ASSERT_EQ(2U, read_base.m_files.size());
+
+  for (size_t index = 0; index < 2; ++index) {
+    EXPECT_EQ(base.m_files[index].m_space_id,
+              read_base.m_files[index].m_space_id);
+    EXPECT_EQ(base.m_files[index].m_file_size,
+              read_base.m_files[index].m_file_size);
+    EXPECT_EQ(base.m_files[index].m_file_name,
+              read_base.m_files[index].m_file_name);
+  }
+}
+
+/* A truncated or padded base is rejected and leaves no base. */
+TEST(clone0desc, base_malformed) {
+  Clone_Base base;
+  build_base(&base);
+
+  std::vector<byte> buf(base.serialized_length() + 1);
+  base.serialize(&buf[0]);
+
+  Clone_Base read_base;
+
+  for (size_t len = 0; len < buf.size() - 1; ++len) {
+    EXPECT_FALSE(read_base.deserialize(&buf[0], len));
+    EXPECT_FALSE(read_base.is_set());
+    EXPECT_TRUE(read_base.m_files.empty());
+  }
+
+  EXPECT_FALSE(read_base.deserialize(&buf[0], buf.size()));
+  EXPECT_FALSE(read_base.is_set());
+}
+
+/* Only a file with the same tablespace ID and name, not larger than
+the donor file, is copied incrementally. */
+TEST(clone0desc, base_has_file) {
+  Clone_Base base;
+
+  /* No base */
+  EXPECT_FALSE(base.has_file("test/t1.ibd", 23, 112 * 1024));
+
+  build_base(&base);
+
+  /* Unchanged and extended on donor */
+  EXPECT_TRUE(base.has_file("test/t1.ibd", 23, 112 * 1024));
+  EXPECT_TRUE(base.has_file("test/t1.ibd", 23, 128 * 1024));
+  EXPECT_TRUE(base.has_file("ibdata1", 0, 12 * 1024 * 1024));
+
+  /* Renamed on donor */
+  EXPECT_FALSE(base.has_file("test/t2.ibd", 23, 112 * 1024));
+
+  /* Created again or rebuilt under the same name */
+  EXPECT_FALSE(base.has_file("test/t1.ibd", 24, 112 * 1024));
+
+  /* Shrunk on donor */
+  EXPECT_FALSE(base.has_file("test/t1.ibd", 23, 96 * 1024));
+
+  /* New file */
+  EXPECT_FALSE(base.has_file("test/t3.ibd", 25, 112 * 1024));
+}
+
+/* The apply locator carries the base to the donor. */
+TEST(clone0desc, locator_with_base) {
+  Clone_Base base;
+  build_base(&base);
+
+  uint version = choose_desc_version(nullptr);
+
+  Clone_Desc_Locator loc_desc;
+  loc_desc.init(0, 0, version, 1, &base);
+
+  std::vector<byte> buf(loc_desc.m_header.m_length);
+  byte *loc = &buf[0];
+  uint loc_len = static_cast<uint>(buf.size());
+
+  loc_desc.serialize(loc, loc_len, nullptr);
+  EXPECT_EQ(buf.size(), loc_len);
+
+  Clone_Desc_Locator read_desc;
+  Clone_Base read_base;
+
+  read_desc.deserialize(loc, &read_base);
+
+  EXPECT_EQ(1U, read_desc.m_clone_index);
+  EXPECT_EQ(version, read_desc.m_header.m_version);
+  EXPECT_EQ(base.m_lsn, read_base.m_lsn);
+  EXPECT_EQ(base.m_donor_uuid, read_base.m_donor_uuid);
+  EXPECT_EQ(base.m_files.size(), read_base.m_files.size());
+
+  /* A locator without base gives no base. */
+  Clone_Desc_Locator empty_desc;
+  empty_desc.init(0, 0, version, 1, nullptr);
+
+  std::vector<byte> empty_buf(empty_desc.m_header.m_length);
+  loc = &empty_buf[0];
+  loc_len = static_cast<uint>(empty_buf.size());
+
+  empty_desc.serialize(loc, loc_len, nullptr);
+  EXPECT_LT(loc_len, buf.size());
+
+  read_desc.deserialize(loc, &read_base);
+  EXPECT_FALSE(read_base.is_set());
+}
+
+}  // namespace innodb_clone0desc_unittest
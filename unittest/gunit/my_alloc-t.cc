@@ -165,4 +165,22 @@ TEST_F(MyAllocTest, ExceptionalBlocksAreNotReusedForLargerAllocations) {
   EXPECT_NE(ptr, ptr2);
 }
 
+TEST_F(MyAllocTest, RetainedBlocksAreReused) {
+  MEM_ROOT alloc(PSI_NOT_INSTRUMENTED, 512);
+  for (int i = 0; i < 10; ++i) (void)alloc.Alloc(400);
+  EXPECT_LT(1U, alloc.blocks_allocated());
+  EXPECT_EQ(0U, alloc.blocks_reused());
+  alloc.ClearAndRetainBlocks();
+
+  if (alloc.allocated_size() == 0) {
+    // Running under Valgrind/ASAN, so no blocks are retained.
+    return;
+  }
+
+  // The same workload again should not need any new blocks.
+  for (int i = 0; i < 10; ++i) (void)alloc.Alloc(400);
+  EXPECT_EQ(0U, alloc.blocks_allocated());
+  EXPECT_LT(0U, alloc.blocks_reused());
+}
+
 }  // namespace my_alloc_unittest
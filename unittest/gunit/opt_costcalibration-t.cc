@@ -0,0 +1,138 @@
+/* Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include <gtest/gtest.h>
+
+#include "sql/opt_costcalibration.h"
+#include "sql/opt_costconstants.h"
+#include "unittest/gunit/test_utils.h"
+
+namespace costcalibration_unittest {
+
+using my_testing::Server_initializer;
+
+typedef Cost_calibration Cal;
+
+/// Set all timings to the default values times a factor.
+static void set_proportional(Cal *calibration, double factor) {
+  for (int i = 0; i < Cal::NUM_CONSTANTS; i++) {
+    const Cal::Constant c = static_cast<Cal::Constant>(i);
+    calibration->set_time(c, Cal::default_value(c) * factor);
+  }
+}
+
+TEST(CostCalibrationTest, NotMeasured) {
+  Cal calibration;
+  EXPECT_FALSE(calibration.is_measured());
+  for (int i = 0; i < Cal::NUM_CONSTANTS; i++)
+    EXPECT_EQ(0.0, calibration.value(static_cast<Cal::Constant>(i)));
+}
+
+TEST(CostCalibrationTest, ProportionalToDefaults) {
+  // Timings with the same ratios as the defaults give the defaults.
+  Cal calibration;
+  set_proportional(&calibration, 1234.5);
+  EXPECT_TRUE(calibration.is_measured());
+  for (int i = 0; i < Cal::NUM_CONSTANTS; i++) {
+    const Cal::Constant c = static_cast<Cal::Constant>(i);
+    EXPECT_DOUBLE_EQ(Cal::default_value(c), calibration.value(c));
+  }
+}
+
+TEST(CostCalibrationTest, Ratios) {
+  Cal calibration;
+  set_proportional(&calibration, 10.0);
+  calibration.set_time(Cal::IO_BLOCK_READ,
+                       calibration.time(Cal::IO_BLOCK_READ) * 16.0);
+
+  // The values follow the timings.
+  EXPECT_DOUBLE_EQ(
+      16.0 * Cal::default_value(Cal::IO_BLOCK_READ) /
+          Cal::default_value(Cal::MEMORY_BLOCK_READ),
+      calibration.value(Cal::IO_BLOCK_READ) /
+          calibration.value(Cal::MEMORY_BLOCK_READ));
+
+  // The geometric mean of the ratios to the defaults is 1.
+  double product = 1.0;
+  for (int i = 0; i < Cal::NUM_CONSTANTS; i++) {
+    const Cal::Constant c = static_cast<Cal::Constant>(i);
+    product *= calibration.value(c) / Cal::default_value(c);
+  }
+  EXPECT_NEAR(1.0, product, 1e-9);
+}
+
+TEST(CostCalibrationTest, PartlyMeasured) {
+  // A timing which is not measured does not affect the others.
+  Cal calibration;
+  set_proportional(&calibration, 3.0);
+  calibration.set_time(Cal::IO_BLOCK_READ, 0.0);
+  EXPECT_EQ(0.0, calibration.value(Cal::IO_BLOCK_READ));
+  EXPECT_DOUBLE_EQ(Cal::default_value(Cal::ROW_EVALUATE),
+                   calibration.value(Cal::ROW_EVALUATE));
+
+  // A single timing gives its default.
+  Cal single;
+  single.set_time(Cal::KEY_COMPARE, 42.0);
+  EXPECT_DOUBLE_EQ(Cal::default_value(Cal::KEY_COMPARE),
+                   single.value(Cal::KEY_COMPARE));
+}
+
+TEST(CostCalibrationTest, Limited) {
+  Cal calibration;
+  set_proportional(&calibration, 1.0);
+  calibration.set_time(Cal::KEY_COMPARE, 1e-12);
+  calibration.set_time(Cal::IO_BLOCK_READ, 1e12);
+  EXPECT_DOUBLE_EQ(Cal::default_value(Cal::KEY_COMPARE) / Cal::MAX_FACTOR,
+                   calibration.value(Cal::KEY_COMPARE));
+  EXPECT_DOUBLE_EQ(Cal::default_value(Cal::IO_BLOCK_READ) * Cal::MAX_FACTOR,
+                   calibration.value(Cal::IO_BLOCK_READ));
+}
+
+TEST(CostCalibrationTest, Apply) {
+  Server_initializer initializer;
+  initializer.SetUp();
+
+  Cal calibration;
+  set_proportional(&calibration, 5.0);
+  calibration.set_time(Cal::ROW_EVALUATE,
+                       calibration.time(Cal::ROW_EVALUATE) * 4.0);
+
+  Cost_model_constants cost_constants;
+  calibration.apply(initializer.thd(), &cost_constants);
+  const Server_cost_constants *server =
+      cost_constants.get_server_cost_constants();
+  EXPECT_DOUBLE_EQ(calibration.value(Cal::ROW_EVALUATE),
+                   server->row_evaluate_cost());
+  EXPECT_DOUBLE_EQ(calibration.value(Cal::KEY_COMPARE),
+                   server->key_compare_cost());
+  EXPECT_DOUBLE_EQ(calibration.value(Cal::MEMORY_TEMPTABLE_ROW),
+                   server->memory_temptable_row_cost());
+
+  // Constants which are not measured keep their defaults.
+  const Server_cost_constants defaults;
+  EXPECT_EQ(defaults.disk_temptable_row_cost(),
+            server->disk_temptable_row_cost());
+
+  initializer.TearDown();
+}
+
+}  // namespace costcalibration_unittest
@@ -0,0 +1,253 @@
+/* Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "my_sys.h"
+#include "sql/rpl_gtid.h"
+#include "unittest/gunit/benchmark.h"
+
+namespace rpl_gtid_set_unittest {
+
+static const char UUID_A[] = "aaaaaaaa-aaaa-aaaa-aaaa-aaaaaaaaaaaa";
+static const char UUID_B[] = "bbbbbbbb-bbbb-bbbb-bbbb-bbbbbbbbbbbb";
+
+class GtidSetTest : public ::testing::Test {
+ protected:
+  GtidSetTest() : m_sid_map(NULL) {}
+
+  /// Return the text form of a Gtid_set.
+  static std::string str(const Gtid_set &set) {
+    char *buf;
+    set.to_string(&buf);
+    std::string ret(buf);
+    my_free(buf);
+    return ret;
+  }
+
+  /// Return the text form of a set given as text, as the set prints it.
+  std::string set_of(const std::string &text) {
+    Gtid_set set(&m_sid_map);
+    EXPECT_EQ(RETURN_STATUS_OK, set.add_gtid_text(text.c_str()));
+    return str(set);
+  }
+
+  /// Expect "a + b" and "a - b" to be as given.
+  void check(const std::string &a, const std::string &b,
+             const std::string &sum, const std::string &difference) {
+    Gtid_set set_a(&m_sid_map), set_b(&m_sid_map);
+    ASSERT_EQ(RETURN_STATUS_OK, set_a.add_gtid_text(a.c_str()));
+    ASSERT_EQ(RETURN_STATUS_OK, set_b.add_gtid_text(b.c_str()));
+
+    Gtid_set result(&m_sid_map);
+    ASSERT_EQ(RETURN_STATUS_OK, result.add_gtid_set(&set_a));
+    ASSERT_EQ(RETURN_STATUS_OK, result.add_gtid_set(&set_b));
+    EXPECT_EQ(set_of(sum), str(result));
+    EXPECT_TRUE(set_a.is_subset(&result));
+    EXPECT_TRUE(set_b.is_subset(&result));
+
+    result.clear();
+    ASSERT_EQ(RETURN_STATUS_OK, result.add_gtid_set(&set_a));
+    result.remove_gtid_set(&set_b);
+    EXPECT_EQ(set_of(difference), str(result));
+    EXPECT_FALSE(result.is_intersection_nonempty(&set_b));
+  }
+
+  Sid_map m_sid_map;
+};
+
+TEST_F(GtidSetTest, AddAndContains) {
+  Gtid_set set(&m_sid_map);
+  rpl_sid sid;
+  ASSERT_EQ(0, sid.parse(UUID_A, binary_log::Uuid::TEXT_LENGTH));
+  rpl_sidno sidno = m_sid_map.add_sid(sid);
+  ASSERT_EQ(RETURN_STATUS_OK, set.ensure_sidno(sidno));
+
+  // Out of order, adjacent and overlapping single GTIDs.
+  const rpl_gno gnos[] = {10, 3, 4, 12, 11, 1, 20, 2, 15, 15};
+  for (rpl_gno gno : gnos) set._add_gtid(sidno, gno);
+  EXPECT_EQ(set_of(std::string(UUID_A) + ":1-4:10-12:15:20"), str(set));
+  EXPECT_EQ(20, set.get_last_gno(sidno));
+
+  for (rpl_gno gno = 1; gno <= 21; gno++) {
+    bool expected = (gno <= 4) || (gno >= 10 && gno <= 12) || gno == 15 ||
+                    gno == 20;
+    EXPECT_EQ(expected, set.contains_gtid(sidno, gno)) << gno;
+  }
+
+  // Removing from the middle of an interval splits it.
+  set._remove_gtid(sidno, 11);
+  set._remove_gtid(sidno, 1);
+  set._remove_gtid(sidno, 20);
+  EXPECT_EQ(set_of(std::string(UUID_A) + ":2-4:10:12:15"), str(set));
+  EXPECT_FALSE(set.contains_gtid(sidno, 11));
+  EXPECT_EQ(15, set.get_last_gno(sidno));
+}
+
+TEST_F(GtidSetTest, AddAndRemoveSets) {
+  const std::string a(UUID_A), b(UUID_B);
+
+  // Appending, and merging adjacent intervals.
+  check(a + ":1-10", a + ":11-20:30", a + ":1-20:30", a + ":1-10");
+  // Intervals of the second set overlapping several in the first one.
+  check(a + ":1-5:10-15:20-25:30-35:40", a + ":3-12:14-31:50-60",
+        a + ":1-35:40:50-60", a + ":1-2:13:32-35:40");
+  // One interval covering all of the other set.
+  check(a + ":5-6:8:10-12", a + ":1-100", a + ":1-100", "");
+  check(a + ":1-100", a + ":5-6:8:10-12:99-120", a + ":1-120",
+        a + ":1-4:7:9:13-98");
+  // Several SIDs, only some of them in both sets.
+  check(a + ":1-3:7-9," + b + ":1", b + ":2-4:6",
+        a + ":1-3:7-9," + b + ":1-4:6", a + ":1-3:7-9," + b + ":1");
+  check(a + ":1-3:7-9", a + ":1-3:7-9", a + ":1-3:7-9", "");
+}
+
+/// Return the text form of the GTIDs of UUID_A set in a bitmap.
+static std::string text_of(const std::vector<bool> &gnos) {
+  std::string text(UUID_A);
+  for (size_t gno = 1; gno < gnos.size(); gno++) {
+    if (!gnos[gno] || gnos[gno - 1]) continue;
+    size_t end = gno;
+    while (end + 1 < gnos.size() && gnos[end + 1]) end++;
+    text += ":" + std::to_string(gno);
+    if (end > gno) text += "-" + std::to_string(end);
+  }
+  return text;
+}
+
+TEST_F(GtidSetTest, Random) {
+  std::mt19937 rng(4711);
+  const size_t max_gno = 200;
+  for (int round = 0; round < 500; round++) {
+    // Sets of few or many intervals, to exercise both the one by one and
+    // the bulk paths.
+    std::vector<bool> a(max_gno + 1), b(max_gno + 1);
+    const unsigned density_a = 1 + rng() % 5, density_b = 1 + rng() % 5;
+    for (size_t gno = 1; gno <= max_gno; gno++) {
+      a[gno] = rng() % 6 < density_a;
+      b[gno] = rng() % 6 < density_b && rng() % 4 != 0;
+    }
+    std::vector<bool> sum(max_gno + 1), difference(max_gno + 1);
+    for (size_t gno = 1; gno <= max_gno; gno++) {
+      sum[gno] = a[gno] || b[gno];
+      difference[gno] = a[gno] && !b[gno];
+    }
+    SCOPED_TRACE(text_of(a) + " " + text_of(b));
+    check(text_of(a), text_of(b), text_of(sum), text_of(difference));
+  }
+}
+
+TEST_F(GtidSetTest, Encoding) {
+  Gtid_set set(&m_sid_map);
+  ASSERT_EQ(RETURN_STATUS_OK,
+            set.add_gtid_text((std::string(UUID_A) + ":1-3:5:7-100," +
+                               std::string(UUID_B) + ":42")
+                                  .c_str()));
+
+  uchar buf[1024];
+  ASSERT_LE(set.get_encoded_length(), sizeof(buf));
+  set.encode(buf);
+
+  Gtid_set decoded(&m_sid_map);
+  ASSERT_EQ(RETURN_STATUS_OK,
+            decoded.add_gtid_encoding(buf, set.get_encoded_length()));
+  EXPECT_EQ(str(set), str(decoded));
+}
+
+/*
+  Fill a set as seen by a replica of many sources, where the GTIDs of
+  each source are fragmented in many intervals.
+*/
+static void make_fragmented_set(Gtid_set *set, int num_sids,
+                                int num_intervals) {
+  std::string text;
+  char buf[100];
+  for (int sid = 0; sid < num_sids; sid++) {
+    snprintf(buf, sizeof(buf), "%08x-0000-0000-0000-000000000000", sid + 1);
+    if (sid > 0) text += ",";
+    text += buf;
+    for (int i = 0; i < num_intervals; i++) {
+      snprintf(buf, sizeof(buf), ":%d-%d", i * 10 + 1, i * 10 + 5);
+      text += buf;
+    }
+  }
+  set->add_gtid_text(text.c_str());
+}
+
+/**
+  Microbenchmark for contains_gtid() on a set of many fragmented SIDs.
+*/
+static void BM_GtidSetContains(size_t num_iterations) {
+  StopBenchmarkTiming();
+  Sid_map sid_map(NULL);
+  Gtid_set set(&sid_map);
+  make_fragmented_set(&set, 1000, 100);
+  StartBenchmarkTiming();
+
+  size_t found = 0;
+  for (size_t i = 0; i < num_iterations; i++) {
+    for (rpl_sidno sidno = 1; sidno <= 1000; sidno++)
+      if (set.contains_gtid(sidno, (i * 7 + sidno) % 1000 + 1)) found++;
+  }
+
+  StopBenchmarkTiming();
+  EXPECT_NE(0U, found);
+}
+BENCHMARK(BM_GtidSetContains);
+
+/**
+  Microbenchmark for add_gtid_set() merging two fragmented sets with
+  interleaved intervals, as when a replica updates gtid_executed with the
+  GTIDs of many sources.
+*/
+static void BM_GtidSetMerge(size_t num_iterations) {
+  StopBenchmarkTiming();
+  Sid_map sid_map(NULL);
+  Gtid_set base(&sid_map), other(&sid_map), set(&sid_map);
+  make_fragmented_set(&base, 1000, 100);
+  make_fragmented_set(&other, 1000, 100);
+  // Shift the intervals of the second set so they interleave with the
+  // first one.
+  Gtid_set shift(&sid_map);
+  for (rpl_sidno sidno = 1; sidno <= 1000; sidno++) {
+    shift.ensure_sidno(sidno);
+    for (rpl_gno gno = 1; gno <= 1000; gno += 10) shift._add_gtid(sidno, gno);
+  }
+  other.remove_gtid_set(&shift);
+  StartBenchmarkTiming();
+
+  for (size_t i = 0; i < num_iterations; i++) {
+    set.clear();
+    set.add_gtid_set(&base);
+    set.add_gtid_set(&other);
+  }
+
+  StopBenchmarkTiming();
+}
+BENCHMARK(BM_GtidSetMerge);
+
+}  // namespace rpl_gtid_set_unittest
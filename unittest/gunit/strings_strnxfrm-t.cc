@@ -49,6 +49,7 @@
 #include <sys/types.h>
 #include <algorithm>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -1487,6 +1488,59 @@ static void BM_NewlineFilledUTF8MB4(size_t num_iterations) {
 }
 BENCHMARK(BM_NewlineFilledUTF8MB4);
 
+/*
+  A long ASCII string, which is mostly handled 16 bytes at a time by the
+  vectorized fast path. Compare with BM_ShortAsciiRunsUTF8MB4 below, which
+  has the same length and number of weights, but is confined to the scalar
+  fast path.
+*/
+static void BM_LongAsciiUTF8MB4(size_t num_iterations) {
+  StopBenchmarkTiming();
+
+  CHARSET_INFO *cs = init_collation("utf8mb4_0900_ai_ci");
+
+  std::string content;
+  for (int i = 0; i < 1024; ++i) content.push_back('A' + i % 26);
+  std::vector<uchar> dest(content.size() * 2);
+
+  StartBenchmarkTiming();
+  for (size_t i = 0; i < num_iterations; ++i) {
+    my_strnxfrm(cs, dest.data(), dest.size(),
+                pointer_cast<const uchar *>(content.data()), content.size());
+  }
+  StopBenchmarkTiming();
+
+  SetBytesProcessed(num_iterations * content.size());
+}
+BENCHMARK(BM_LongAsciiUTF8MB4);
+
+/*
+  The same as BM_LongAsciiUTF8MB4, except that every 15th character is a
+  DEL, which has a single weight but is outside the fast path's range. No
+  run of 16 fast path characters remains, so the rest is processed four
+  bytes at a time.
+*/
+static void BM_ShortAsciiRunsUTF8MB4(size_t num_iterations) {
+  StopBenchmarkTiming();
+
+  CHARSET_INFO *cs = init_collation("utf8mb4_0900_ai_ci");
+
+  std::string content;
+  for (int i = 0; i < 1024; ++i)
+    content.push_back(i % 15 == 14 ? '\x7f' : 'A' + i % 26);
+  std::vector<uchar> dest(content.size() * 2);
+
+  StartBenchmarkTiming();
+  for (size_t i = 0; i < num_iterations; ++i) {
+    my_strnxfrm(cs, dest.data(), dest.size(),
+                pointer_cast<const uchar *>(content.data()), content.size());
+  }
+  StopBenchmarkTiming();
+
+  SetBytesProcessed(num_iterations * content.size());
+}
+BENCHMARK(BM_ShortAsciiRunsUTF8MB4);
+
 static void BM_HashSimpleUTF8MB4(size_t num_iterations) {
   StopBenchmarkTiming();
 
@@ -1894,7 +1948,7 @@ TEST(PadCollationTest, BasicTest) {
       0);
 }
 
-TEST(StrxfrmTest, NoPadCollation) {
+TEST(StrXfrmTest, NoPadCollation) {
   CHARSET_INFO *ai_ci = init_collation("utf8mb4_0900_ai_ci");
   CHARSET_INFO *as_cs = init_collation("utf8mb4_0900_as_cs");
   CHARSET_INFO *as_ci = init_collation("utf8mb4_0900_as_ci");
@@ -1936,7 +1990,7 @@ TEST(StrxfrmTest, NoPadCollation) {
   EXPECT_LT(compare_through_strxfrm(as_cs, "", "\t"), 0);
 }
 
-TEST(StrxfrmTest, Contractions) {
+TEST(StrXfrmTest, Contractions) {
   CHARSET_INFO *hu_ai_ci = init_collation("utf8mb4_hu_0900_ai_ci");
 
   // Basic sanity checks.
@@ -2009,6 +2063,117 @@ TEST(BitfiddlingTest, FastOutOfRange16) {
   }
 }
 
+/*
+  A version of FastOutOfRange for the 64-bit variant of the trick, used by
+  the 16 byte fast path when no vector instructions are available. Carries
+  and borrows may cross byte boundaries, so test all pairs of neighbouring
+  bytes, surrounded by bytes in range.
+*/
+TEST(BitfiddlingTest, FastOutOfRange64) {
+  for (int pos = 0; pos < 7; ++pos) {
+    unsigned char bytes[8];
+    memset(bytes, 'a', sizeof(bytes));
+    for (int a = 0; a < 256; ++a) {
+      bytes[pos] = a;
+      for (int b = 0; b < 256; ++b) {
+        bytes[pos + 1] = b;
+        bool any_out_of_range_slow =
+            (a < 0x20 || a > 0x7e) || (b < 0x20 || b > 0x7e);
+
+        uint64 eight_bytes;
+        memcpy(&eight_bytes, bytes, sizeof(eight_bytes));
+        bool any_out_of_range_fast =
+            (((eight_bytes + 0x0101010101010101ULL) |
+              (eight_bytes - 0x2020202020202020ULL)) &
+             0x8080808080808080ULL);
+
+        EXPECT_EQ(any_out_of_range_slow, any_out_of_range_fast);
+      }
+    }
+  }
+}
+
+/*
+  Split a sort key into its levels, each a string of 16-bit weights.
+*/
+static std::vector<std::string> sort_key_levels(CHARSET_INFO *cs,
+                                                const std::string &str) {
+  std::vector<uchar> key(str.size() * 64 + 64);
+  const size_t len =
+      my_strnxfrm(cs, key.data(), key.size(),
+                  pointer_cast<const uchar *>(str.data()), str.size());
+  std::vector<std::string> levels(1);
+  for (size_t i = 0; i + 1 < len; i += 2) {
+    if (key[i] == 0 && key[i + 1] == 0)
+      levels.emplace_back();
+    else
+      levels.back().append(pointer_cast<const char *>(&key[i]), 2);
+  }
+  return levels;
+}
+
+/*
+  Verify that the fast paths for ASCII give the same weights as looking
+  up each character on its own, for runs of every length and alignment,
+  interrupted by characters which are not handled by the fast paths.
+*/
+TEST(StrXfrmTest, AsciiRuns) {
+  for (const char *name : {"utf8mb4_0900_ai_ci", "utf8mb4_0900_as_cs"}) {
+    CHARSET_INFO *cs = init_collation(name);
+    for (const char *breaker : {"\t", "\x7f", "\xc3\xa9"}) {
+      for (size_t len = 0; len < 40; ++len) {
+        for (size_t pos = 0; pos <= len; ++pos) {
+          std::vector<std::string> chars;
+          for (size_t i = 0; i < len; ++i) {
+            if (i == pos) chars.push_back(breaker);
+            chars.push_back(std::string(1, 'a' + (i * 7) % 26));
+            if (i % 3 == 0) chars.back()[0] -= 'a' - 'A';
+          }
+
+          std::string str;
+          std::vector<std::string> expected;
+          for (const std::string &chr : chars) {
+            str += chr;
+            const std::vector<std::string> levels = sort_key_levels(cs, chr);
+            expected.resize(levels.size());
+            for (size_t level = 0; level < levels.size(); ++level)
+              expected[level] += levels[level];
+          }
+          if (expected.empty()) expected.resize(sort_key_levels(cs, "").size());
+
+          EXPECT_EQ(expected, sort_key_levels(cs, str))
+              << name << " length " << len << " break at " << pos;
+        }
+      }
+    }
+  }
+}
+
+/*
+  Verify that the fast paths for ASCII stop at the end of a destination
+  buffer which is shorter than a block of weights, and that the truncated
+  sort key is a prefix of the full one.
+*/
+TEST(StrXfrmTest, AsciiRunsShortBuffer) {
+  CHARSET_INFO *cs = init_collation("utf8mb4_0900_ai_ci");
+  std::string str;
+  for (int i = 0; i < 64; ++i) str.push_back('a' + i % 26);
+
+  std::vector<uchar> full(str.size() * 64 + 64);
+  const size_t full_len =
+      my_strnxfrm(cs, full.data(), full.size(),
+                  pointer_cast<const uchar *>(str.data()), str.size());
+
+  for (size_t dstlen = 2; dstlen <= 2 * str.size() + 2; dstlen += 2) {
+    std::unique_ptr<uchar[]> dst(new uchar[dstlen]);
+    const size_t len =
+        my_strnxfrm(cs, dst.get(), dstlen,
+                    pointer_cast<const uchar *>(str.data()), str.size());
+    EXPECT_EQ(std::min(dstlen, full_len), len) << "buffer " << dstlen;
+    EXPECT_EQ(0, memcmp(full.data(), dst.get(), len)) << "buffer " << dstlen;
+  }
+}
+
 ulong hash(CHARSET_INFO *cs, const char *str) {
   ulong nr1 = 1, nr2 = 4;
   cs->coll->hash_sort(cs, pointer_cast<const uchar *>(str), strlen(str), &nr1,
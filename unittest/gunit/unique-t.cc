@@ -26,6 +26,7 @@
 #include <gtest/gtest.h>
 #include <stddef.h>
 #include <sys/types.h>
+#include <vector>
 
 #include "sql/sql_class.h"
 #include "sql/uniques.h"
@@ -65,4 +66,57 @@ TEST_F(UniqueCostTest, GetUseCost) {
   EXPECT_GT(dup_removal_cost, 0.0);
 }
 
+static int int_cmp(const void *, const void *a, const void *b) {
+  const int x = *static_cast<const int *>(a);
+  const int y = *static_cast<const int *>(b);
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+static int collect_int(void *element, element_count count, void *arg) {
+  EXPECT_EQ(1U, count);
+  static_cast<std::vector<int> *>(arg)->push_back(
+      *static_cast<int *>(element));
+  return 0;
+}
+
+// Duplicates are removed and the elements are returned in sorted order.
+TEST(UniqueHashSetTest, InsertAndWalkSorted) {
+  Unique_hash_set set(sizeof(int), 10000);
+  for (int i = 0; i < 3000; ++i) {
+    const int value = (i * 7919) % 1000;
+    EXPECT_FALSE(set.insert(&value));
+  }
+  EXPECT_EQ(1000U, set.elements());
+
+  std::vector<int> values;
+  EXPECT_EQ(0, set.walk_sorted(int_cmp, nullptr, collect_int, &values));
+  ASSERT_EQ(1000U, values.size());
+  for (int i = 0; i < 1000; ++i) EXPECT_EQ(i, values[i]);
+
+  set.clear();
+  EXPECT_EQ(0U, set.elements());
+  const int value = 42;
+  EXPECT_FALSE(set.insert(&value));
+  EXPECT_FALSE(set.insert(&value));
+  EXPECT_EQ(1U, set.elements());
+}
+
+class UniqueTest : public UniqueCostTest {};
+
+// A hash based Unique gives the same result whether or not it spills.
+TEST_F(UniqueTest, HashWalkWithSpill) {
+  // Room for only a few hundred elements in memory.
+  Unique unique(int_cmp, nullptr, sizeof(int), 4096, true);
+  for (int i = 0; i < 5000; ++i) {
+    int value = (i * 7919) % 2000;
+    EXPECT_FALSE(unique.unique_add(&value));
+  }
+  EXPECT_GT(unique.elements, 0U);
+
+  std::vector<int> values;
+  EXPECT_FALSE(unique.walk(collect_int, &values));
+  ASSERT_EQ(2000U, values.size());
+  for (int i = 0; i < 2000; ++i) EXPECT_EQ(i, values[i]);
+}
+
 }  // namespace unique_unittest
@@ -107,6 +107,57 @@ TEST_F(Crud_statement_builder_test, add_filter_with_arg) {
   EXPECT_EQ(" WHERE (`A` > 1)", query.get());
 }
 
+TEST_F(Crud_statement_builder_test, add_filter_with_arg_marker) {
+  args = Expression_args{1, "abc"};
+  Expression_generator::Prep_stmt_placeholder_list placeholders;
+
+  builder();
+  expr_gen->set_prep_stmt_placeholder_list(&placeholders);
+  ASSERT_NO_THROW(stub->add_filter(Filter(
+      Operator("&&", Operator(">", ColumnIdentifier("A"), Placeholder(0)),
+               Operator("==", ColumnIdentifier("B"), Placeholder(1))))));
+  EXPECT_EQ(" WHERE ((`A` > ?) AND (`B` = ?))", query.get());
+  EXPECT_EQ(Expression_generator::Prep_stmt_placeholder_list({0, 1}),
+            placeholders);
+}
+
+TEST_F(Crud_statement_builder_test, add_filter_with_arg_not_bindable) {
+  args = Expression_args{1.0};
+  Expression_generator::Prep_stmt_placeholder_list placeholders;
+
+  builder();
+  expr_gen->set_prep_stmt_placeholder_list(&placeholders);
+  ASSERT_NO_THROW(stub->add_filter(
+      Filter(Operator(">", ColumnIdentifier("A"), Placeholder(0)))));
+  EXPECT_EQ(" WHERE (`A` > 1)", query.get());
+  EXPECT_TRUE(placeholders.empty());
+}
+
+TEST_F(Crud_statement_builder_test, add_filter_with_string_arg_marker) {
+  args = Expression_args{Scalar::String("abc"), Scalar::String("def", 45)};
+  Expression_generator::Prep_stmt_placeholder_list placeholders;
+
+  builder();
+  expr_gen->set_prep_stmt_placeholder_list(&placeholders);
+  ASSERT_NO_THROW(stub->add_filter(Filter(
+      Operator("&&", Operator("==", ColumnIdentifier("A"), Placeholder(0)),
+               Operator("==", ColumnIdentifier("B"), Placeholder(1))))));
+  EXPECT_EQ(" WHERE ((`A` = ?) AND (`B` = 'def'))", query.get());
+  EXPECT_EQ(Expression_generator::Prep_stmt_placeholder_list({0}),
+            placeholders);
+}
+
+TEST_F(Crud_statement_builder_test, add_order_placeholder_no_marker) {
+  args = Expression_args{2};
+  Expression_generator::Prep_stmt_placeholder_list placeholders;
+
+  builder();
+  expr_gen->set_prep_stmt_placeholder_list(&placeholders);
+  ASSERT_NO_THROW(stub->add_order(Order_list{{Placeholder(0)}}));
+  EXPECT_EQ(" ORDER BY 2", query.get());
+  EXPECT_TRUE(placeholders.empty());
+}
+
 TEST_F(Crud_statement_builder_test, add_filter_missing_arg) {
   ASSERT_THROW(builder().add_filter(Filter(
                    Operator(">", ColumnIdentifier("A"), Placeholder(0)))),
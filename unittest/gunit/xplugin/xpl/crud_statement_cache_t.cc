@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms,
+ * as designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+ */
+
+#include <gtest/gtest.h>
+
+#include "plugin/x/src/crud_statement_cache.h"
+
+namespace xpl {
+namespace test {
+
+class Crud_statement_cache_test : public ::testing::Test {
+ public:
+  Crud_statement_cache_test() : cache(2) {}
+
+  Crud_statement_cache::Statement_id find(const std::string &query) {
+    Crud_statement_cache::Statement_id stmt_id = 42;
+    if (!cache.find(query, &stmt_id)) return 42;
+    return stmt_id;
+  }
+
+  Crud_statement_cache cache;
+};
+
+TEST_F(Crud_statement_cache_test, find_in_empty) {
+  EXPECT_EQ(42u, find("SELECT 1"));
+  EXPECT_EQ(0u, cache.size());
+}
+
+TEST_F(Crud_statement_cache_test, add_and_find) {
+  EXPECT_EQ(Crud_statement_cache::k_not_prepared, cache.add("SELECT 1", 1));
+  EXPECT_EQ(Crud_statement_cache::k_not_prepared, cache.add("SELECT 2", 2));
+  EXPECT_EQ(1u, find("SELECT 1"));
+  EXPECT_EQ(2u, find("SELECT 2"));
+  EXPECT_EQ(2u, cache.size());
+}
+
+TEST_F(Crud_statement_cache_test, add_not_prepared) {
+  cache.add("SELECT 1", Crud_statement_cache::k_not_prepared);
+  EXPECT_EQ(Crud_statement_cache::k_not_prepared, find("SELECT 1"));
+}
+
+TEST_F(Crud_statement_cache_test, add_evicts_least_recently_used) {
+  cache.add("SELECT 1", 1);
+  cache.add("SELECT 2", 2);
+  EXPECT_EQ(1u, find("SELECT 1"));
+  EXPECT_EQ(2u, cache.add("SELECT 3", 3));
+  EXPECT_EQ(42u, find("SELECT 2"));
+  EXPECT_EQ(1u, find("SELECT 1"));
+  EXPECT_EQ(3u, find("SELECT 3"));
+  EXPECT_EQ(2u, cache.size());
+}
+
+TEST_F(Crud_statement_cache_test, add_replaces_same_query) {
+  cache.add("SELECT 1", 1);
+  EXPECT_EQ(1u, cache.add("SELECT 1", 2));
+  EXPECT_EQ(2u, find("SELECT 1"));
+  EXPECT_EQ(1u, cache.size());
+}
+
+TEST_F(Crud_statement_cache_test, add_with_zero_capacity) {
+  Crud_statement_cache no_cache(0);
+  EXPECT_EQ(1u, no_cache.add("SELECT 1", 1));
+  EXPECT_EQ(0u, no_cache.size());
+}
+
+TEST_F(Crud_statement_cache_test, remove) {
+  cache.add("SELECT 1", 1);
+  EXPECT_EQ(1u, cache.remove("SELECT 1"));
+  EXPECT_EQ(Crud_statement_cache::k_not_prepared, cache.remove("SELECT 1"));
+  EXPECT_EQ(42u, find("SELECT 1"));
+  EXPECT_EQ(0u, cache.size());
+}
+
+}  // namespace test
+}  // namespace xpl
@@ -156,6 +156,12 @@ class Mock_sql_data_context : public ngs::Sql_session_interface {
                           const Authentication_interface &, bool));
   MOCK_METHOD3(execute,
                Error_code(const char *, std::size_t, Resultset_interface *));
+  MOCK_METHOD3(prepare_prep_stmt,
+               Error_code(const char *, std::size_t, uint32_t *));
+  MOCK_METHOD4(execute_prep_stmt, Error_code(uint32_t, const PS_PARAM *,
+                                             std::size_t,
+                                             Resultset_interface *));
+  MOCK_METHOD1(deallocate_prep_stmt, Error_code(uint32_t));
   MOCK_METHOD0(attach, Error_code());
   MOCK_METHOD0(detach, Error_code());
 };
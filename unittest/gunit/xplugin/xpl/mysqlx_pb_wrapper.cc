@@ -105,6 +105,11 @@ Scalar::Scalar(Scalar::Null) {
 
 Scalar::String::String(const std::string &value) { m_base.set_value(value); }
 
+Scalar::String::String(const std::string &value, const uint64_t collation) {
+  m_base.set_value(value);
+  m_base.set_collation(collation);
+}
+
 Scalar::Octets::Octets(const std::string &value, const unsigned type) {
   m_base.set_value(value);
   m_base.set_content_type(type);
@@ -24,6 +24,7 @@
 #define XPLUGIN_MYSQLX_PB_WRAPPER_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <initializer_list>
 #include <map>
 #include <string>
@@ -100,6 +101,7 @@ class Scalar : public Wrapper<::Mysqlx::Datatypes::Scalar> {
 
   struct String : public Wrapper<::Mysqlx::Datatypes::Scalar_String> {
     String(const std::string &value);  // NOLINT(runtime/explicit)
+    String(const std::string &value, const uint64_t collation);
   };
 
   struct Octets : public Wrapper<::Mysqlx::Datatypes::Scalar_Octets> {
@@ -172,6 +172,29 @@ TEST_F(Update_statement_builder_test, build_update_for_table) {
       query.get().c_str());
 }
 
+TEST_F(Update_statement_builder_test, build_update_for_table_with_markers) {
+  fill_table_msg();
+  args = Expression_args{"booom", 1};
+  *msg.mutable_operation() =
+      Operation_list{{Update_operation::Base::SET, ColumnIdentifier("yfield"),
+                      Placeholder(0)}};
+  *msg.mutable_criteria() =
+      Filter(Operator(">", ColumnIdentifier("xfield"), Placeholder(1)));
+  Expression_generator::Prep_stmt_placeholder_list placeholders;
+
+  builder();
+  expr_gen->set_prep_stmt_placeholder_list(&placeholders);
+  EXPECT_NO_THROW(stub->build(msg));
+  EXPECT_STREQ(
+      "UPDATE `xschema`.`xtable`"
+      " SET `yfield`='booom'"
+      " WHERE (`xfield` > ?)"
+      " ORDER BY `xfield` DESC",
+      query.get().c_str());
+  EXPECT_EQ(Expression_generator::Prep_stmt_placeholder_list({1}),
+            placeholders);
+}
+
 TEST_F(Update_statement_builder_test,
        build_update_for_table_forrbiden_offset_in_limit) {
   fill_table_msg();